@@ -95,6 +95,16 @@ AC_CHECK_DECLS([ethtool_cmd_speed, SPEED_UNKNOWN], [], [],
                [#include <linux/ethtool.h>])
 
 
+#
+# io_uring kernel interface (used without liburing)
+#
+AC_CHECK_HEADERS([linux/io_uring.h])
+AC_CHECK_DECLS([__NR_io_uring_setup, __NR_io_uring_enter,
+                __NR_io_uring_register, IORING_OP_RECV], [], [],
+               [#include <sys/syscall.h>
+                #include <linux/io_uring.h>])
+
+
 #
 # PowerPC "sys/platform/ppc.h" header
 #
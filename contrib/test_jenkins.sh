@@ -1178,8 +1178,9 @@ run_tests() {
 	# configuration related tests
 	run_configure_tests
 
-	# build for devel tests and gtest
-	build devel --enable-gtest
+	# build for devel tests and gtest, including the UCG component which is
+	# disabled by default
+	build devel --enable-gtest --enable-ucg
 
 	# devel mode tests
 	do_distributed_task 0 4 test_unused_env_var
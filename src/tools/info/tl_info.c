@@ -283,6 +283,11 @@ static void print_iface_info(uct_worker_h worker, uct_md_h md,
 
         printf("#      device priority: %d\n", iface_attr.priority);
         printf("#     device num paths: %d\n", iface_attr.dev_num_paths);
+        if (iface_attr.numa_node != UCS_NUMA_NODE_UNDEFINED) {
+            printf("#     memory numa node: %d\n", iface_attr.numa_node);
+        } else {
+            printf("#     memory numa node: default\n");
+        }
         printf("#              max eps: %s\n",
                ucs_memunits_to_str(iface_attr.max_num_eps, max_eps_str,
                                    sizeof(max_eps_str)));
@@ -75,6 +75,15 @@ typedef enum {
 } ucx_perf_wait_mode_t;
 
 
+typedef enum {
+    UCX_PERF_PATTERN_PAIRS,          /* Rank i runs with rank N-1-i */
+    UCX_PERF_PATTERN_PERMUTATION,    /* Random perfect matching of the ranks */
+    UCX_PERF_PATTERN_ALL_TO_ALL,     /* Pairwise exchange, one matching per round */
+    UCX_PERF_PATTERN_INCAST,         /* All ranks send to rank 0 */
+    UCX_PERF_PATTERN_LAST
+} ucx_perf_pattern_t;
+
+
 enum ucx_perf_test_flags {
     UCX_PERF_TEST_FLAG_VALIDATE         = UCS_BIT(1), /* Validate data. Affects performance. */
     UCX_PERF_TEST_FLAG_ONE_SIDED        = UCS_BIT(2), /* For tests which involves only one side,
@@ -254,6 +263,9 @@ typedef struct ucx_perf_params {
     ucs_memory_type_t      send_mem_type;   /* Send memory type */
     ucs_memory_type_t      recv_mem_type;   /* Recv memory type */
     unsigned               flags;           /* See ucx_perf_test_flags. */
+    ucx_perf_pattern_t     pattern;         /* How the ranks are paired */
+    unsigned               pattern_round;   /* Matching round, for patterns
+                                               which have several of them */
 
     size_t                 *msg_size_list;  /* Test message sizes list. The size
                                                of the array is in msg_size_cnt */
@@ -324,6 +336,23 @@ const char *ucp_perf_daemon_am_id_name(ucp_perf_daemon_am_id_t id);
 void ucx_perf_global_init();
 
 
+/**
+ * @return Number of rounds needed to cover the traffic pattern by a group of
+ *         the given size.
+ */
+unsigned ucx_perf_pattern_num_rounds(ucx_perf_pattern_t pattern,
+                                     unsigned group_size);
+
+
+/**
+ * @return Nonzero if ranks @a index1 and @a index2 exchange data in the
+ *         current round of the traffic pattern described by @a params.
+ */
+int ucx_perf_pattern_is_peer(const ucx_perf_params_t *params,
+                             unsigned group_size, unsigned index1,
+                             unsigned index2);
+
+
 /**
  * Run a UCT performance test.
  */
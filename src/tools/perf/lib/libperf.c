@@ -655,6 +655,13 @@ static ucs_status_t uct_perf_test_setup_endpoints(ucx_perf_context_t *perf)
     void *buffer;
     void *req;
 
+    group_size = rte_call(perf, group_size);
+    if (group_size > 2) {
+        ucs_error("UCT perftest requires group size of at most 2 "
+                  "(actual group size: %u)", group_size);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
     buffer = malloc(buffer_size);
     if (buffer == NULL) {
         ucs_error("Failed to allocate RTE buffer");
@@ -716,9 +723,8 @@ static ucs_status_t uct_perf_test_setup_endpoints(ucx_perf_context_t *perf)
         }
     }
 
-    group_size  = rte_call(perf, group_size);
     group_index = rte_call(perf, group_index);
-    peer_index  = rte_peer_index(group_size, group_index);
+    peer_index  = rte_peer_index(&perf->params, group_size, group_index);
 
     perf->uct.peers = calloc(group_size, sizeof(*perf->uct.peers));
     if (perf->uct.peers == NULL) {
@@ -1002,6 +1008,39 @@ static void ucp_perf_test_destroy_self_eps(ucx_perf_context_t *perf)
     ucp_perf_release_requests_in_progress(perf, reqs, num_in_prog);
 }
 
+static void ucp_perf_test_destroy_incast_eps(ucx_perf_context_t *perf)
+{
+    ucx_perf_context_t *thread_perf = &perf->ucp.tctx[0].perf;
+    ucp_ep_h *peer_eps              = thread_perf->ucp.peer_eps;
+    unsigned num_peer_eps           = thread_perf->ucp.num_peer_eps;
+    unsigned num_in_prog            = 0;
+    ucs_status_ptr_t *reqs;
+    ucs_status_ptr_t req;
+    unsigned i;
+
+    if (peer_eps == NULL) {
+        return;
+    }
+
+    /* The default endpoint was already destroyed with the thread context */
+    reqs = ucs_alloca(num_peer_eps * sizeof(*reqs));
+    for (i = 0; i < num_peer_eps; ++i) {
+        if (peer_eps[i] == thread_perf->ucp.ep) {
+            continue;
+        }
+
+        req = ucp_perf_test_destroy_ep(peer_eps[i], 0);
+        if (req != NULL) {
+            reqs[num_in_prog++] = req;
+        }
+    }
+
+    ucp_perf_release_requests_in_progress(perf, reqs, num_in_prog);
+    free(peer_eps);
+    thread_perf->ucp.peer_eps     = NULL;
+    thread_perf->ucp.num_peer_eps = 0;
+}
+
 static void ucp_perf_test_destroy_eps(ucx_perf_context_t *perf)
 {
     unsigned thread_count  = perf->params.thread_count;
@@ -1020,6 +1059,7 @@ static void ucp_perf_test_destroy_eps(ucx_perf_context_t *perf)
     }
 
     ucp_perf_release_requests_in_progress(perf, reqs, num_in_prog);
+    ucp_perf_test_destroy_incast_eps(perf);
 }
 
 static ucs_status_t
@@ -1130,6 +1170,8 @@ static void ucp_perf_test_init_endpoints(ucx_perf_context_t *perf)
         perf->ucp.tctx[i].perf.ucp.self_ep        = NULL;
         perf->ucp.tctx[i].perf.ucp.self_send_rkey = NULL;
         perf->ucp.tctx[i].perf.ucp.self_recv_rkey = NULL;
+        perf->ucp.tctx[i].perf.ucp.peer_eps       = NULL;
+        perf->ucp.tctx[i].perf.ucp.num_peer_eps   = 0;
     }
 }
 
@@ -1410,7 +1452,8 @@ static ucs_status_t ucp_perf_setup_daemon_endpoints(ucx_perf_context_t *perf)
     /* Sender and receiver roles for DPU daemons are defined by perftest
      * group_index property */
     unsigned group_index      = rte_call(perf, group_index);
-    unsigned peer_group_index = rte_peer_index(rte_call(perf, group_size),
+    unsigned peer_group_index = rte_peer_index(&perf->params,
+                                               rte_call(perf, group_size),
                                                group_index);
     int is_local_sender       = (group_index % 2) != 0;
     int is_remote_sender      = (peer_group_index % 2) != 0;
@@ -1586,12 +1629,92 @@ out:
     return status;
 }
 
+static ucs_status_t ucp_perf_test_check_pattern(ucx_perf_context_t *perf,
+                                                unsigned group_size)
+{
+    const ucx_perf_params_t *params = &perf->params;
+
+    if (group_size < 2) {
+        ucs_error("perftest p2p requires group size of at least 2 "
+                  "(actual group size: %u)", group_size);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    if ((group_size > 2) &&
+        ((params->ucp.is_daemon_mode) || (params->thread_count > 1))) {
+        ucs_error("perftest with more than 2 processes does not support "
+                  "daemon mode and multiple threads");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    if (params->pattern != UCX_PERF_PATTERN_INCAST) {
+        if ((group_size % 2) != 0) {
+            ucs_error("perftest pattern requires an even group size "
+                      "(actual group size: %u)", group_size);
+            return UCS_ERR_UNSUPPORTED;
+        }
+
+        return UCS_OK;
+    }
+
+    if ((group_size > 2) &&
+        ((params->test_type != UCX_PERF_TEST_TYPE_STREAM_UNI) ||
+         ((params->command != UCX_PERF_CMD_TAG) &&
+          (params->command != UCX_PERF_CMD_TAG_SYNC) &&
+          (params->command != UCX_PERF_CMD_AM)))) {
+        ucs_error("incast pattern supports only tag and am bandwidth tests");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return UCS_OK;
+}
+
+/* The incast root creates an endpoint to every sender, and keeps them in the
+ * first thread context. The endpoint to rank 1 is used as the default one. */
+static ucs_status_t
+ucp_perf_test_connect_incast_senders(ucx_perf_context_t *perf,
+                                     unsigned group_size)
+{
+    ucx_perf_context_t *thread_perf = &perf->ucp.tctx[0].perf;
+    ucp_ep_h *peer_eps;
+    ucs_status_t status;
+    unsigned i;
+
+    peer_eps = calloc(group_size - 1, sizeof(*peer_eps));
+    if (peer_eps == NULL) {
+        ucs_error("failed to allocate incast endpoints array");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    for (i = group_size - 1; i > 0; --i) {
+        status = ucp_perf_test_receive_remote_data(perf, i);
+        if (status != UCS_OK) {
+            goto err_destroy_eps;
+        }
+
+        peer_eps[i - 1] = thread_perf->ucp.ep;
+    }
+
+    thread_perf->ucp.peer_eps     = peer_eps;
+    thread_perf->ucp.num_peer_eps = group_size - 1;
+    return UCS_OK;
+
+err_destroy_eps:
+    /* The failed endpoint was destroyed by ucp_perf_test_receive_remote_data */
+    thread_perf->ucp.ep           = NULL;
+    thread_perf->ucp.peer_eps     = peer_eps;
+    thread_perf->ucp.num_peer_eps = group_size - 1;
+    ucp_perf_test_destroy_incast_eps(perf);
+    return status;
+}
+
 static ucs_status_t ucp_perf_test_setup_endpoints(ucx_perf_context_t *perf,
                                                   uint64_t features)
 {
     unsigned group_size  = rte_call(perf, group_size);
     unsigned group_index = rte_call(perf, group_index);
-    unsigned peer_index  = rte_peer_index(group_size, group_index);
+    unsigned peer_index  = rte_peer_index(&perf->params, group_size,
+                                          group_index);
     ucs_status_t status;
 
     if ((perf->params.flags & UCX_PERF_TEST_FLAG_LOOPBACK) &&
@@ -1601,11 +1724,11 @@ static ucs_status_t ucp_perf_test_setup_endpoints(ucx_perf_context_t *perf,
         return UCS_ERR_UNSUPPORTED;
     }
 
-    if (!(perf->params.flags & UCX_PERF_TEST_FLAG_LOOPBACK) &&
-        (group_size != 2)) {
-        ucs_error("perftest p2p requires group size to be exactly 2 "
-                  "(actual group size: %u)", group_size);
-        return UCS_ERR_UNSUPPORTED;
+    if (!(perf->params.flags & UCX_PERF_TEST_FLAG_LOOPBACK)) {
+        status = ucp_perf_test_check_pattern(perf, group_size);
+        if (status != UCS_OK) {
+            return status;
+        }
     }
 
     if (perf->params.ucp.is_daemon_mode) {
@@ -1621,7 +1744,12 @@ static ucs_status_t ucp_perf_test_setup_endpoints(ucx_perf_context_t *perf,
         }
 
         /* Receive remote peer's endpoints' data and connect to them */
-        status = ucp_perf_test_receive_remote_data(perf, peer_index);
+        if ((perf->params.pattern == UCX_PERF_PATTERN_INCAST) &&
+            (group_index == 0)) {
+            status = ucp_perf_test_connect_incast_senders(perf, group_size);
+        } else {
+            status = ucp_perf_test_receive_remote_data(perf, peer_index);
+        }
         if (status != UCS_OK) {
             goto err;
         }
@@ -2232,6 +2360,8 @@ ucs_status_t ucx_perf_run(const ucx_perf_params_t *params,
             perf->ucp.self_ep        = perf->ucp.tctx[0].perf.ucp.self_ep;
             perf->ucp.self_send_rkey = perf->ucp.tctx[0].perf.ucp.self_send_rkey;
             perf->ucp.self_recv_rkey = perf->ucp.tctx[0].perf.ucp.self_recv_rkey;
+            perf->ucp.peer_eps       = perf->ucp.tctx[0].perf.ucp.peer_eps;
+            perf->ucp.num_peer_eps   = perf->ucp.tctx[0].perf.ucp.num_peer_eps;
         }
 
         status = ucx_perf_do_warmup(perf, params);
@@ -2274,12 +2404,106 @@ size_t ucx_perf_get_message_size(const ucx_perf_params_t *params)
     return length;
 }
 
-unsigned rte_peer_index(unsigned group_size, unsigned group_index)
+/* Deterministic shuffle, so all ranks compute the same permutation */
+static unsigned
+ucx_perf_pattern_shuffled_index(unsigned group_size, unsigned round,
+                                unsigned group_index, int reverse)
 {
-    unsigned peer_index = group_size - 1 - group_index;
+    unsigned *ranks = ucs_alloca(group_size * sizeof(*ranks));
+    uint64_t seed   = 0x5851f42d4c957f2dull + round;
+    unsigned i, j, tmp;
+
+    for (i = 0; i < group_size; ++i) {
+        ranks[i] = i;
+    }
+
+    for (i = group_size - 1; i > 0; --i) {
+        seed     = (seed * 6364136223846793005ull) + 1442695040888963407ull;
+        j        = (seed >> 33) % (i + 1);
+        tmp      = ranks[i];
+        ranks[i] = ranks[j];
+        ranks[j] = tmp;
+    }
+
+    if (!reverse) {
+        return ranks[group_index];
+    }
+
+    for (i = 0; i < group_size; ++i) {
+        if (ranks[i] == group_index) {
+            return i;
+        }
+    }
+
+    ucs_fatal("rank %u not found in permutation of %u", group_index,
+              group_size);
+}
+
+unsigned rte_peer_index(const ucx_perf_params_t *params, unsigned group_size,
+                        unsigned group_index)
+{
+    unsigned round = params->pattern_round;
+    unsigned position;
 
     ucs_assert(group_index < group_size);
-    return peer_index;
+
+    switch (params->pattern) {
+    case UCX_PERF_PATTERN_PERMUTATION:
+        /* Ranks at positions 2k and 2k+1 of the permutation are peers */
+        position = ucx_perf_pattern_shuffled_index(group_size, round,
+                                                   group_index, 1);
+        return ucx_perf_pattern_shuffled_index(group_size, round,
+                                               position ^ 1, 0);
+    case UCX_PERF_PATTERN_ALL_TO_ALL:
+        /* Round-robin tournament: the last rank is fixed, and the others
+         * rotate around it */
+        if (group_index == (group_size - 1)) {
+            return round;
+        } else if (group_index == round) {
+            return group_size - 1;
+        }
+        return ((2 * round) + (group_size - 1) - group_index) %
+               (group_size - 1);
+    case UCX_PERF_PATTERN_INCAST:
+        /* The root is connected to all others, report the first one */
+        return (group_index == 0) ? 1 : 0;
+    default:
+        return group_size - 1 - group_index;
+    }
+}
+
+unsigned ucx_perf_group_role(ucx_perf_context_t *perf)
+{
+    unsigned group_size  = rte_call(perf, group_size);
+    unsigned group_index = rte_call(perf, group_index);
+
+    if (group_size == 1) {
+        return 0;
+    }
+
+    return group_index > rte_peer_index(&perf->params, group_size,
+                                        group_index);
+}
+
+unsigned ucx_perf_pattern_num_rounds(ucx_perf_pattern_t pattern,
+                                     unsigned group_size)
+{
+    if ((pattern == UCX_PERF_PATTERN_ALL_TO_ALL) && (group_size > 2)) {
+        return group_size - 1;
+    }
+
+    return 1;
+}
+
+int ucx_perf_pattern_is_peer(const ucx_perf_params_t *params,
+                             unsigned group_size, unsigned index1,
+                             unsigned index2)
+{
+    if (params->pattern == UCX_PERF_PATTERN_INCAST) {
+        return (index1 != index2) && ((index1 == 0) || (index2 == 0));
+    }
+
+    return rte_peer_index(params, group_size, index1) == index2;
 }
 
 void ucx_perf_report(ucx_perf_context_t *perf)
@@ -136,6 +136,8 @@ struct ucx_perf_context {
             ucp_ep_h                   self_ep;
             ucp_rkey_h                 self_send_rkey;
             ucp_rkey_h                 self_recv_rkey;
+            ucp_ep_h                   *peer_eps;     /* Incast root only */
+            unsigned                   num_peer_eps;
         } ucp;
     };
 };
@@ -167,7 +169,9 @@ typedef struct {
 
 extern ucx_perf_funcs_t ucx_perf_funcs[];
 
-unsigned rte_peer_index(unsigned group_size, unsigned group_index);
+unsigned rte_peer_index(const ucx_perf_params_t *params, unsigned group_size,
+                        unsigned group_index);
+unsigned ucx_perf_group_role(ucx_perf_context_t *perf);
 void ucx_perf_test_start_clock(ucx_perf_context_t *perf);
 void uct_perf_ep_flush_b(ucx_perf_context_t *perf, int peer_index);
 void uct_perf_iface_flush_b(ucx_perf_context_t *perf);
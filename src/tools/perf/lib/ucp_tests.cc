@@ -737,8 +737,17 @@ public:
             return;
         }
 
-        send(m_perf.ucp.ep, buffer, 1, datatype, 0, m_perf.ucp.remote_addr,
-             m_perf.ucp.rkey, false);
+        if (m_perf.ucp.peer_eps == NULL) {
+            send(m_perf.ucp.ep, buffer, 1, datatype, 0,
+                 m_perf.ucp.remote_addr, m_perf.ucp.rkey, false);
+        } else {
+            /* Incast root acknowledges every sender */
+            for (unsigned i = 0; i < m_perf.ucp.num_peer_eps; ++i) {
+                send(m_perf.ucp.peer_eps[i], buffer, 1, datatype, 0,
+                     m_perf.ucp.remote_addr, m_perf.ucp.rkey, false);
+                wait_send_window(1);
+            }
+        }
         wait_send_window(m_max_outstanding);
     }
 
@@ -817,7 +826,7 @@ public:
 
         ucp_perf_barrier(&m_perf);
 
-        my_index = rte_call(&m_perf, group_index);
+        my_index = ucx_perf_group_role(&m_perf);
 
         ucx_perf_test_start_clock(&m_perf);
 
@@ -855,7 +864,7 @@ public:
 
     ucs_status_t run_stream_uni()
     {
-        unsigned my_index;
+        unsigned my_index, num_senders, i;
         ucp_worker_h worker;
         ucp_ep_h ep;
         void *send_buffer, *recv_buffer;
@@ -881,7 +890,7 @@ public:
 
         ucp_perf_barrier(&m_perf);
 
-        my_index = rte_call(&m_perf, group_index);
+        my_index = ucx_perf_group_role(&m_perf);
 
         ucx_perf_test_start_clock(&m_perf);
 
@@ -899,9 +908,14 @@ public:
             wait_send_window(m_max_outstanding);
             wait_recv_window(m_max_outstanding);
         } else if (my_index == 0) {
+            /* Incast root receives a message from every sender per iteration */
+            num_senders = ucs_max(m_perf.ucp.num_peer_eps, 1);
             UCX_PERF_TEST_FOREACH(&m_perf) {
-                recv(worker, ep, recv_buffer, recv_length, recv_datatype, sn);
-                ucx_perf_update(&m_perf, 1, length);
+                for (i = 0; i < num_senders; ++i) {
+                    recv(worker, ep, recv_buffer, recv_length, recv_datatype,
+                         sn);
+                }
+                ucx_perf_update(&m_perf, 1, length * num_senders);
                 ++sn;
             }
 
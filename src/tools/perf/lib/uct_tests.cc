@@ -437,7 +437,7 @@ public:
         uct_perf_barrier(&m_perf);
 
         my_index   = rte_call(&m_perf, group_index);
-        peer_index = rte_peer_index(group_size, my_index);
+        peer_index = rte_peer_index(&m_perf.params, group_size, my_index);
 
         ucx_perf_test_start_clock(&m_perf);
 
@@ -674,7 +674,7 @@ public:
         }
 
         my_index   = rte_call(&m_perf, group_index);
-        peer_index = rte_peer_index(group_size, my_index);
+        peer_index = rte_peer_index(&m_perf.params, group_size, my_index);
 
         uct_perf_barrier(&m_perf);
 
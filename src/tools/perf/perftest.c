@@ -188,6 +188,8 @@ ucs_status_t init_test_params(perftest_params_t *params)
     params->super.report_interval   = 1.0;
     params->super.percentile_rank   = 50.0;
     params->super.flags             = UCX_PERF_TEST_FLAG_VERBOSE;
+    params->super.pattern           = UCX_PERF_PATTERN_PAIRS;
+    params->super.pattern_round     = 0;
     params->super.uct.fc_window     = UCT_PERF_TEST_MAX_FC_WINDOW;
     params->super.uct.data_layout   = UCT_PERF_DATA_LAYOUT_SHORT;
     params->super.uct.am_hdr_size   = 8;
@@ -625,6 +627,7 @@ static void mpi_rte_barrier(void *rte_group, void (*progress)(void *arg),
 static void mpi_rte_post_vec(void *rte_group, const struct iovec *iovec,
                              int iovcnt, void **req)
 {
+    struct perftest_context *ctx = rte_group;
     size_t total_length = ucs_iovec_total_length(iovec, iovcnt);
     int group_size;
     int my_rank;
@@ -637,7 +640,8 @@ static void mpi_rte_post_vec(void *rte_group, const struct iovec *iovec,
                        "total_length=%zu", total_length);
 
     for (dest = 0; dest < group_size; ++dest) {
-        if (dest != rte_peer_index(group_size, my_rank)) {
+        if (!ucx_perf_pattern_is_peer(ctx->run_params, group_size, my_rank,
+                                      dest)) {
             continue;
         }
 
@@ -654,6 +658,7 @@ static void mpi_rte_post_vec(void *rte_group, const struct iovec *iovec,
 static void mpi_rte_recv(void *rte_group, unsigned src, void *buffer, size_t max,
                          void *req)
 {
+    struct perftest_context *ctx = rte_group;
     MPI_Status status;
     int my_rank, size;
     size_t offset;
@@ -662,7 +667,7 @@ static void mpi_rte_recv(void *rte_group, unsigned src, void *buffer, size_t max
     MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
     MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-    if (src != rte_peer_index(size, my_rank)) {
+    if (!ucx_perf_pattern_is_peer(ctx->run_params, size, my_rank, src)) {
         return;
     }
 
@@ -712,8 +717,8 @@ static ucs_status_t mpi_rte_setup(void *arg)
     }
 
     if (!(ctx->params.super.flags & UCX_PERF_TEST_FLAG_LOOPBACK) &&
-        (size != 2)) {
-        ucs_error("This test should be run with exactly 2 processes "
+        (size < 2)) {
+        ucs_error("This test should be run with at least 2 processes "
                   "in p2p case (actual: %d)", size);
         return UCS_ERR_INVALID_PARAM;
     }
@@ -732,7 +737,7 @@ static ucs_status_t mpi_rte_setup(void *arg)
         ctx->flags |= TEST_FLAG_PRINT_RESULTS;
     }
 
-    ctx->params.super.rte_group  = NULL;
+    ctx->params.super.rte_group  = ctx;
     ctx->params.super.rte        = &mpi_rte;
     return UCS_OK;
 }
@@ -58,6 +58,9 @@ struct perftest_context {
     const char                   *mad_port;
 
     sock_rte_group_t             sock_rte_group;
+
+    /* Parameters of the running test, used by the RTE to find the peers */
+    const ucx_perf_params_t      *run_params;
 };
 
 
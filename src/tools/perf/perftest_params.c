@@ -98,6 +98,11 @@ static void usage(const struct perftest_context *ctx, const char *program)
     printf("     -6             Use IPv6 address for in data exchange\n");
 #ifdef HAVE_MPI
     printf("     -P <0|1>       disable/enable MPI mode (%d)\n", ctx->mpi);
+    printf("     -a <pattern>   traffic pattern between the MPI ranks (pairs)\n");
+    printf("                        pairs  - rank i runs with rank N-1-i\n");
+    printf("                        perm   - random pairing of the ranks\n");
+    printf("                        a2a    - every pair of ranks, in N-1 rounds\n");
+    printf("                        incast - all ranks send to rank 0 (UCP tag_bw/am_bw)\n");
 #endif
     printf("     -K <ca:port>   use MAD for test setup and synchronization\n");
     printf("     -h             show this help message\n");
@@ -510,6 +515,20 @@ ucs_status_t parse_test_params(perftest_params_t *params, char opt,
     case 'z':
         params->super.flags |= UCX_PERF_TEST_FLAG_PREREG;
         return UCS_OK;
+    case 'a':
+        if (!strcmp(opt_arg, "pairs")) {
+            params->super.pattern = UCX_PERF_PATTERN_PAIRS;
+        } else if (!strcmp(opt_arg, "perm")) {
+            params->super.pattern = UCX_PERF_PATTERN_PERMUTATION;
+        } else if (!strcmp(opt_arg, "a2a")) {
+            params->super.pattern = UCX_PERF_PATTERN_ALL_TO_ALL;
+        } else if (!strcmp(opt_arg, "incast")) {
+            params->super.pattern = UCX_PERF_PATTERN_INCAST;
+        } else {
+            ucs_error("Invalid option argument for -a");
+            return UCS_ERR_INVALID_PARAM;
+        }
+        return UCS_OK;
     default:
        return UCS_ERR_INVALID_PARAM;
     }
@@ -259,12 +259,140 @@ static ucs_status_t read_batch_file(FILE *batch_file, const char *file_name,
     return UCS_OK;
 }
 
+#if defined (HAVE_MPI)
+static const char *pattern_names[] = {
+    [UCX_PERF_PATTERN_PAIRS]       = "pairs",
+    [UCX_PERF_PATTERN_PERMUTATION] = "perm",
+    [UCX_PERF_PATTERN_ALL_TO_ALL]  = "a2a",
+    [UCX_PERF_PATTERN_INCAST]      = "incast"
+};
+
+enum {
+    PATTERN_RESULT_PEER,
+    PATTERN_RESULT_LATENCY,
+    PATTERN_RESULT_BANDWIDTH,
+    PATTERN_RESULT_MSGRATE,
+    PATTERN_RESULT_LAST
+};
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double*)a, y = *(const double*)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Gather the results of all ranks to the printing rank, and show them along
+ * with the aggregate bandwidth of the senders and latency percentiles */
+static void print_pattern_results(struct perftest_context *ctx,
+                                  const ucx_perf_params_t *params,
+                                  unsigned group_size, unsigned num_rounds,
+                                  const ucx_perf_result_t *result)
+{
+    double local[PATTERN_RESULT_LAST], *all, *latency;
+    double bandwidth, msgrate;
+    unsigned i, peer;
+    int rank;
+
+    if (!ctx->mpi || (group_size <= 2) ||
+        (ctx->flags & TEST_FLAG_PRINT_CSV)) {
+        return;
+    }
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    local[PATTERN_RESULT_PEER]      = rte_peer_index(params, group_size, rank);
+    local[PATTERN_RESULT_LATENCY]   = result->latency.total_average * 1e6;
+    local[PATTERN_RESULT_BANDWIDTH] = result->bandwidth.total_average /
+                                      (1024.0 * 1024.0);
+    local[PATTERN_RESULT_MSGRATE]   = result->msgrate.total_average;
+
+    all     = calloc(group_size * PATTERN_RESULT_LAST, sizeof(*all));
+    latency = calloc(group_size, sizeof(*latency));
+    if ((all == NULL) || (latency == NULL)) {
+        ucs_error("failed to allocate pattern results");
+        goto out;
+    }
+
+    MPI_Gather(local, PATTERN_RESULT_LAST, MPI_DOUBLE, all,
+               PATTERN_RESULT_LAST, MPI_DOUBLE, group_size - 1,
+               MPI_COMM_WORLD);
+    if (!(ctx->flags & TEST_FLAG_PRINT_RESULTS)) {
+        goto out;
+    }
+
+    printf("| pattern %s, round %u of %u\n", pattern_names[params->pattern],
+           params->pattern_round + 1, num_rounds);
+    printf("|  rank -> peer | latency (usec) | bandwidth (MB/s) |"
+           " message rate (msg/s) |\n");
+
+    bandwidth = 0;
+    msgrate   = 0;
+    for (i = 0; i < group_size; ++i) {
+        peer       = all[(i * PATTERN_RESULT_LAST) + PATTERN_RESULT_PEER];
+        latency[i] = all[(i * PATTERN_RESULT_LAST) + PATTERN_RESULT_LATENCY];
+        printf("| %5u -> %-4u | %14.3f | %16.2f | %20.0f |\n", i, peer,
+               latency[i],
+               all[(i * PATTERN_RESULT_LAST) + PATTERN_RESULT_BANDWIDTH],
+               all[(i * PATTERN_RESULT_LAST) + PATTERN_RESULT_MSGRATE]);
+
+        /* Count every sender (or the second rank of a pair) once */
+        if (i > peer) {
+            bandwidth += all[(i * PATTERN_RESULT_LAST) +
+                             PATTERN_RESULT_BANDWIDTH];
+            msgrate   += all[(i * PATTERN_RESULT_LAST) +
+                             PATTERN_RESULT_MSGRATE];
+        }
+    }
+
+    qsort(latency, group_size, sizeof(*latency), compare_double);
+    printf("| aggregate: %.2f MB/s, %.0f msg/s, latency p50 %.3f p90 %.3f "
+           "max %.3f usec\n", bandwidth, msgrate,
+           latency[(group_size - 1) / 2], latency[((group_size - 1) * 9) / 10],
+           latency[group_size - 1]);
+    fflush(stdout);
+
+out:
+    free(latency);
+    free(all);
+}
+#endif
+
+static ucs_status_t run_test_pattern(struct perftest_context *ctx,
+                                     const perftest_params_t *test_params)
+{
+    ucx_perf_params_t params = test_params->super;
+    ucx_perf_result_t result;
+    unsigned UCS_V_UNUSED group_size, num_rounds;
+    ucs_status_t status;
+
+    group_size = params.rte->group_size(params.rte_group);
+    num_rounds = ucx_perf_pattern_num_rounds(params.pattern, group_size);
+
+    /* The RTE looks up the peers of every round in the running parameters */
+    ctx->run_params = &params;
+    status          = UCS_OK;
+    for (params.pattern_round = 0; params.pattern_round < num_rounds;
+         ++params.pattern_round) {
+        status = ucx_perf_run(&params, &result);
+        if (status != UCS_OK) {
+            break;
+        }
+
+#if defined (HAVE_MPI)
+        print_pattern_results(ctx, &params, group_size, num_rounds, &result);
+#endif
+    }
+
+    ctx->run_params = NULL;
+    return status;
+}
+
 static ucs_status_t run_test_recurs(struct perftest_context *ctx,
                                     const perftest_params_t *parent_params,
                                     unsigned depth)
 {
     perftest_params_t params;
-    ucx_perf_result_t result;
     ucs_status_t status;
     FILE *batch_file;
     int line_num;
@@ -278,7 +406,7 @@ static ucs_status_t run_test_recurs(struct perftest_context *ctx,
             return status;
         }
 
-        return ucx_perf_run(&parent_params->super, &result);
+        return run_test_pattern(ctx, parent_params);
     }
 
     batch_file = fopen(ctx->batch_files[depth], "r");
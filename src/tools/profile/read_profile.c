@@ -73,6 +73,7 @@ typedef struct options {
 typedef struct {
     const ucs_profile_thread_header_t   *header;
     const ucs_profile_thread_location_t *locations;
+    const ucs_profile_hist_t            *hists;
     const ucs_profile_record_t          *records;
 } profile_thread_data_t;
 
@@ -190,6 +191,12 @@ static int read_profile_data(const char *file_name, profile_data_t *data)
         ptr                = thread->header + 1;
         thread->locations  = ptr;
         ptr                = thread->locations + data->num_locations;
+        if (data->header->mode & UCS_BIT(UCS_PROFILE_MODE_HIST)) {
+            thread->hists  = ptr;
+            ptr            = thread->hists + data->num_locations;
+        } else {
+            thread->hists  = NULL;
+        }
         thread->records    = ptr;
         ptr                = thread->records + thread->header->num_records;
         total_num_records += thread->header->num_records;
@@ -464,6 +471,96 @@ out:
     return ret;
 }
 
+static int compare_hist_locations(const void *l1, const void *l2)
+{
+    const profile_sorted_location_t *loc1 = l1;
+    const profile_sorted_location_t *loc2 = l2;
+    return (loc1->count > loc2->count) ? -1 :
+           (loc1->count < loc2->count) ? +1 :
+           0;
+}
+
+static int show_profile_data_hist(profile_data_t *data, options_t *opts)
+{
+    static const double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+    const uint32_t            num_locations     = data->num_locations;
+    profile_sorted_location_t *sorted_locations = NULL;
+    ucs_profile_hist_t        *hists            = NULL;
+    const profile_thread_data_t *thread;
+    const ucs_profile_location_t *loc;
+    profile_sorted_location_t *sorted_loc;
+    unsigned location_idx, bucket, i;
+    ucs_profile_hist_t *hist;
+    char title[20];
+    int ret;
+    int *t;
+
+    sorted_locations = calloc(num_locations, sizeof(*sorted_locations));
+    hists            = calloc(num_locations, sizeof(*hists));
+    if ((sorted_locations == NULL) || (hists == NULL)) {
+        print_error("failed to allocate histograms");
+        ret = -ENOMEM;
+        goto out;
+    }
+
+    /* Sum the histograms of the threads provided by the user */
+    for (location_idx = 0; location_idx < num_locations; ++location_idx) {
+        sorted_loc               = &sorted_locations[location_idx];
+        sorted_loc->location_idx = location_idx;
+        hist                     = &hists[location_idx];
+
+        for (t = opts->thread_list; *t != -1; ++t) {
+            thread = &data->threads[*t - 1];
+            for (bucket = 0; bucket < UCS_PROFILE_HIST_NUM_BUCKETS; ++bucket) {
+                hist->counts[bucket] +=
+                        thread->hists[location_idx].counts[bucket];
+                sorted_loc->count    +=
+                        thread->hists[location_idx].counts[bucket];
+            }
+        }
+    }
+
+    qsort(sorted_locations, num_locations, sizeof(*sorted_locations),
+          compare_hist_locations);
+
+    printf("%s%*s %12s", HEAD_COLOR, FUNC_NAME_MAX_LEN, "NAME", "COUNT");
+    for (i = 0; i < ucs_static_array_size(percentiles); ++i) {
+        snprintf(title, sizeof(title), "P%g %s", percentiles[i],
+                 time_units_str[opts->time_units]);
+        printf(" %13s", title);
+    }
+    printf(" %18s%-6s  %-*s%s\n", "FILE", ":LINE", FUNC_NAME_MAX_LEN,
+           "FUNCTION", CLEAR_COLOR);
+
+    for (sorted_loc = sorted_locations;
+         sorted_loc < (sorted_locations + num_locations); ++sorted_loc) {
+        if (sorted_loc->count == 0) {
+            continue;
+        }
+
+        loc  = &data->locations[sorted_loc->location_idx];
+        hist = &hists[sorted_loc->location_idx];
+
+        printf("%s%*.*s%s %12zu", NAME_COLOR, FUNC_NAME_MAX_LEN,
+               FUNC_NAME_MAX_LEN, loc->name, CLEAR_COLOR, sorted_loc->count);
+        for (i = 0; i < ucs_static_array_size(percentiles); ++i) {
+            printf(" %13.3f",
+                   time_to_units(data, opts,
+                                 ucs_profile_hist_percentile(hist,
+                                                             percentiles[i])));
+        }
+        printf(" %s%18s:%-6d %-*s%s\n", LOC_COLOR, loc->file, loc->line,
+               FUNC_NAME_MAX_LEN, loc->function, CLEAR_COLOR);
+    }
+
+    ret = 0;
+
+out:
+    free(hists);
+    free(sorted_locations);
+    return ret;
+}
+
 KHASH_MAP_INIT_INT64(request_ids, size_t)
 
 static void show_profile_data_log(profile_data_t *data, options_t *opts,
@@ -660,6 +757,12 @@ static int redirect_output(const profile_data_t *data, options_t *opts)
                      1; /* locations footer */
     }
 
+    if (data->header->mode & UCS_BIT(UCS_PROFILE_MODE_HIST)) {
+        num_lines += 1 + /* histograms title */
+                     data->num_locations + /* histograms data */
+                     1; /* histograms footer */
+    }
+
     if (data->header->mode & UCS_BIT(UCS_PROFILE_MODE_LOG)) {
         for (t = opts->thread_list; *t != -1; ++t) {
             num_lines += 3; /* thread header */
@@ -813,6 +916,11 @@ static int show_profile_data(profile_data_t *data, options_t *opts)
         printf("\n");
     }
 
+    if (data->header->mode & UCS_BIT(UCS_PROFILE_MODE_HIST)) {
+        show_profile_data_hist(data, opts);
+        printf("\n");
+    }
+
     if (data->header->mode & UCS_BIT(UCS_PROFILE_MODE_LOG)) {
         for (t = opts->thread_list; *t != -1; ++t) {
             show_profile_data_log(data, opts, *t - 1);
@@ -0,0 +1,365 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <ucp/core/ucp_request_trace.h>
+
+#include <stdlib.h>
+#include <getopt.h>
+#include <string.h>
+#include <stdio.h>
+
+
+#define print_error(_fmt, ...) \
+    fprintf(stderr, "Error: " _fmt "\n", ## __VA_ARGS__)
+
+
+typedef struct {
+    const char *filename;
+    int        by_op;
+} options_t;
+
+
+typedef struct {
+    double   *values;
+    size_t   count;
+    size_t   capacity;
+} samples_t;
+
+
+/* Traced requests of one protocol (and operation, with -o) */
+typedef struct {
+    char      proto_name[UCP_REQUEST_TRACE_NAME_MAX];
+    char      op_name[UCP_REQUEST_TRACE_NAME_MAX];
+    size_t    num_requests;
+    samples_t stages[UCP_REQUEST_TRACE_STAGE_LAST];
+} group_t;
+
+
+typedef struct {
+    char    stage_names[UCP_REQUEST_TRACE_STAGE_LAST][UCP_REQUEST_TRACE_NAME_MAX];
+    group_t *groups;
+    size_t  num_groups;
+} report_t;
+
+
+static int samples_add(samples_t *samples, double value)
+{
+    size_t capacity;
+    double *values;
+
+    if (samples->count == samples->capacity) {
+        capacity = (samples->capacity == 0) ? 64 : (samples->capacity * 2);
+        values   = realloc(samples->values, capacity * sizeof(*values));
+        if (values == NULL) {
+            print_error("failed to allocate %zu samples", capacity);
+            return -1;
+        }
+
+        samples->values   = values;
+        samples->capacity = capacity;
+    }
+
+    samples->values[samples->count++] = value;
+    return 0;
+}
+
+static group_t *report_get_group(report_t *report, const char *proto_name,
+                                 const char *op_name)
+{
+    group_t *groups, *group;
+
+    for (group = report->groups; group < report->groups + report->num_groups;
+         ++group) {
+        if (!strcmp(group->proto_name, proto_name) &&
+            !strcmp(group->op_name, op_name)) {
+            return group;
+        }
+    }
+
+    groups = realloc(report->groups,
+                     (report->num_groups + 1) * sizeof(*report->groups));
+    if (groups == NULL) {
+        print_error("failed to allocate report group");
+        return NULL;
+    }
+
+    report->groups = groups;
+    group          = &groups[report->num_groups++];
+    memset(group, 0, sizeof(*group));
+    memcpy(group->proto_name, proto_name, sizeof(group->proto_name));
+    memcpy(group->op_name, op_name, sizeof(group->op_name));
+    return group;
+}
+
+static int read_block(report_t *report, const options_t *opts, FILE *stream,
+                      const ucp_request_trace_header_t *header)
+{
+    size_t names_size = UCP_REQUEST_TRACE_NAME_MAX *
+                        (header->num_stages + header->num_ops +
+                         header->num_protocols);
+    ucp_request_trace_record_t record;
+    const char *proto_name, *op_name;
+    char (*names)[UCP_REQUEST_TRACE_NAME_MAX];
+    uint64_t record_idx;
+    unsigned stage;
+    group_t *group;
+    int ret;
+
+    if (header->magic != UCP_REQUEST_TRACE_FILE_MAGIC) {
+        print_error("invalid trace file magic 0x%lx",
+                    (unsigned long)header->magic);
+        return -1;
+    }
+
+    if (header->version != UCP_REQUEST_TRACE_FILE_VERSION) {
+        print_error("unsupported trace file version %u (expected %u)",
+                    header->version, UCP_REQUEST_TRACE_FILE_VERSION);
+        return -1;
+    }
+
+    if (header->num_stages != UCP_REQUEST_TRACE_STAGE_LAST) {
+        print_error("unexpected number of stages %u", header->num_stages);
+        return -1;
+    }
+
+    names = malloc(names_size);
+    if (names == NULL) {
+        print_error("failed to allocate %zu bytes for names", names_size);
+        return -1;
+    }
+
+    if (fread(names, names_size, 1, stream) != 1) {
+        print_error("truncated trace file names");
+        ret = -1;
+        goto out;
+    }
+
+    memcpy(report->stage_names, names, sizeof(report->stage_names));
+    for (stage = 0; stage < UCP_REQUEST_TRACE_STAGE_LAST; ++stage) {
+        report->stage_names[stage][UCP_REQUEST_TRACE_NAME_MAX - 1] = '\0';
+    }
+
+    for (record_idx = 0; record_idx < header->num_records; ++record_idx) {
+        if (fread(&record, sizeof(record), 1, stream) != 1) {
+            print_error("truncated trace file record %lu",
+                        (unsigned long)record_idx);
+            ret = -1;
+            goto out;
+        }
+
+        if ((record.proto_id >= header->num_protocols) ||
+            (record.op_id >= header->num_ops)) {
+            print_error("invalid trace record %lu: proto %u op %u",
+                        (unsigned long)record_idx, record.proto_id,
+                        record.op_id);
+            ret = -1;
+            goto out;
+        }
+
+        op_name    = opts->by_op ? names[header->num_stages + record.op_id] : "";
+        proto_name = names[header->num_stages + header->num_ops +
+                           record.proto_id];
+        group      = report_get_group(report, proto_name, op_name);
+        if (group == NULL) {
+            ret = -1;
+            goto out;
+        }
+
+        ++group->num_requests;
+        for (stage = UCP_REQUEST_TRACE_STAGE_SUBMIT + 1;
+             stage < UCP_REQUEST_TRACE_STAGE_LAST; ++stage) {
+            if (record.stamps[stage] == 0) {
+                continue;
+            }
+
+            ret = samples_add(&group->stages[stage],
+                              (record.stamps[stage] -
+                               record.stamps[UCP_REQUEST_TRACE_STAGE_SUBMIT]) *
+                              1e6 / header->one_second);
+            if (ret < 0) {
+                goto out;
+            }
+        }
+    }
+
+    ret = 0;
+
+out:
+    free(names);
+    return ret;
+}
+
+static int read_trace(report_t *report, const options_t *opts)
+{
+    ucp_request_trace_header_t header;
+    FILE *stream;
+    int ret;
+
+    stream = fopen(opts->filename, "r");
+    if (stream == NULL) {
+        print_error("failed to open %s: %m", opts->filename);
+        return -1;
+    }
+
+    /* The file has a block for every worker which traced requests */
+    ret = 0;
+    while (fread(&header, sizeof(header), 1, stream) == 1) {
+        ret = read_block(report, opts, stream, &header);
+        if (ret < 0) {
+            break;
+        }
+    }
+
+    fclose(stream);
+    return ret;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double d1 = *(const double*)a;
+    double d2 = *(const double*)b;
+
+    return (d1 < d2) ? -1 : (d1 > d2);
+}
+
+static int compare_groups(const void *a, const void *b)
+{
+    const group_t *g1 = a;
+    const group_t *g2 = b;
+
+    return (g1->num_requests < g2->num_requests) -
+           (g1->num_requests > g2->num_requests);
+}
+
+static double samples_percentile(const samples_t *samples, double percent)
+{
+    size_t index = (size_t)((percent / 100.0) * (samples->count - 1) + 0.5);
+
+    return samples->values[index];
+}
+
+static void show_report(report_t *report)
+{
+    samples_t *samples;
+    group_t *group;
+    unsigned stage;
+    double total;
+    size_t i;
+
+    qsort(report->groups, report->num_groups, sizeof(*report->groups),
+          compare_groups);
+
+    for (group = report->groups; group < report->groups + report->num_groups;
+         ++group) {
+        printf("\n%s%s%s: %zu requests\n", group->proto_name,
+               (group->op_name[0] != '\0') ? " " : "", group->op_name,
+               group->num_requests);
+        printf("    %-10s %10s %12s %12s %12s %12s\n", "stage", "count",
+               "avg(usec)", "p50(usec)", "p99(usec)", "max(usec)");
+
+        for (stage = UCP_REQUEST_TRACE_STAGE_SUBMIT + 1;
+             stage < UCP_REQUEST_TRACE_STAGE_LAST; ++stage) {
+            samples = &group->stages[stage];
+            if (samples->count == 0) {
+                continue;
+            }
+
+            qsort(samples->values, samples->count, sizeof(*samples->values),
+                  compare_double);
+            total = 0;
+            for (i = 0; i < samples->count; ++i) {
+                total += samples->values[i];
+            }
+
+            printf("    %-10s %10zu %12.3f %12.3f %12.3f %12.3f\n",
+                   report->stage_names[stage], samples->count,
+                   total / samples->count, samples_percentile(samples, 50.0),
+                   samples_percentile(samples, 99.0),
+                   samples->values[samples->count - 1]);
+        }
+    }
+}
+
+static void release_report(report_t *report)
+{
+    group_t *group;
+    unsigned stage;
+
+    for (group = report->groups; group < report->groups + report->num_groups;
+         ++group) {
+        for (stage = 0; stage < UCP_REQUEST_TRACE_STAGE_LAST; ++stage) {
+            free(group->stages[stage].values);
+        }
+    }
+
+    free(report->groups);
+}
+
+static void usage()
+{
+    printf("Usage: ucx_trace_report [options] [trace-file]\n");
+    printf("Shows the time from submission to each stage of the requests "
+           "traced with UCX_REQUEST_TRACE_SAMPLE and UCX_REQUEST_TRACE_FILE,\n"
+           "per protocol.\n");
+    printf("Options are:\n");
+    printf("  -o              Show every operation type separately\n");
+    printf("  -h              Show this help message\n");
+}
+
+static int parse_args(int argc, char **argv, options_t *opts)
+{
+    int c;
+
+    opts->by_op = 0;
+
+    while ( (c = getopt(argc, argv, "oh")) != -1 ) {
+        switch (c) {
+        case 'o':
+            opts->by_op = 1;
+            break;
+        case 'h':
+            usage();
+            return -127;
+        default:
+            usage();
+            return -1;
+        }
+    }
+
+    if (optind >= argc) {
+        print_error("missing trace file argument\n");
+        usage();
+        return -1;
+    }
+
+    opts->filename = argv[optind];
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    report_t report = {};
+    options_t opts;
+    int ret;
+
+    ret = parse_args(argc, argv, &opts);
+    if (ret < 0) {
+        return (ret == -127) ? 0 : ret;
+    }
+
+    /* coverity[tainted_argument] */
+    ret = read_trace(&report, &opts);
+    if (ret == 0) {
+        show_report(&report);
+    }
+
+    release_report(&report);
+    return ret;
+}
@@ -0,0 +1,251 @@
+/*
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#ifndef UCG_H_
+#define UCG_H_
+
+#include <ucs/type/status.h>
+#include <ucs/sys/compiler_def.h>
+#include <stddef.h>
+#include <stdint.h>
+
+BEGIN_C_DECLS
+
+/**
+ * @defgroup UCG_API Group Collective Operations (UCG) API
+ * @{
+ * This section describes UCG API, which implements collective operations
+ * among the processes of a group which run on the same node. The members of a
+ * group map a shared memory segment, allocated by the UCT shared memory
+ * transports, and synchronize through flags in that segment.
+ * @}
+ */
+
+
+/**
+ * @defgroup UCG_GROUP UCG Group
+ * @ingroup UCG_API
+ * @{
+ * UCG Group routines
+ * @}
+ */
+
+
+/**
+ * @defgroup UCG_COLL UCG Collective operations
+ * @ingroup UCG_API
+ * @{
+ * UCG Collective operations. Every member of the group must call the same
+ * collective operations, in the same order, with matching arguments. The
+ * operations are blocking and return after the local buffers can be reused.
+ * If another member exited, or did not reach the operation within
+ * UCX_UCG_TIMEOUT, the operation fails with UCS_ERR_CONNECTION_RESET or
+ * UCS_ERR_TIMED_OUT. The members are out of sync after such a failure, so the
+ * next operations on the group fail as well, and it can only be destroyed.
+ * @}
+ */
+
+
+/**
+ * @ingroup UCG_GROUP
+ * @brief UCG group handle.
+ */
+typedef struct ucg_group *ucg_group_h;
+
+
+/**
+ * @ingroup UCG_COLL
+ * @brief Data types of the elements reduced by the collective operations.
+ */
+typedef enum {
+    UCG_DT_INT32,
+    UCG_DT_UINT32,
+    UCG_DT_INT64,
+    UCG_DT_UINT64,
+    UCG_DT_FLOAT,
+    UCG_DT_DOUBLE,
+    UCG_DT_LAST
+} ucg_dt_t;
+
+
+/**
+ * @ingroup UCG_COLL
+ * @brief Reduction operations.
+ */
+typedef enum {
+    UCG_OP_SUM,
+    UCG_OP_PROD,
+    UCG_OP_MIN,
+    UCG_OP_MAX,
+    UCG_OP_LAST
+} ucg_op_t;
+
+
+/**
+ * @ingroup UCG_GROUP
+ * @brief Out-of-band broadcast, used to create a group.
+ *
+ * Broadcast @a length bytes from the buffer of member @a root to the buffers
+ * of all other members. Called collectively by all group members during
+ * @ref ucg_group_create.
+ *
+ * @param [inout] buffer  Data to send on the root, filled on other members.
+ * @param [in]    length  Size of the data, the same on all members.
+ * @param [in]    root    Rank of the member which sends the data.
+ * @param [in]    arg     User-defined argument, @ref ucg_group_params_t.oob_arg.
+ *
+ * @return Error code as defined by @ref ucs_status_t.
+ */
+typedef ucs_status_t (*ucg_oob_bcast_func_t)(void *buffer, size_t length,
+                                             unsigned root, void *arg);
+
+
+/**
+ * @ingroup UCG_GROUP
+ * @brief UCG group parameters field mask.
+ *
+ * The enumeration allows specifying which fields in @ref ucg_group_params_t
+ * are present. All of them are required.
+ */
+enum ucg_group_params_field {
+    UCG_GROUP_PARAM_FIELD_MEMBER_COUNT = UCS_BIT(0), /**< member_count */
+    UCG_GROUP_PARAM_FIELD_MY_RANK      = UCS_BIT(1), /**< my_rank */
+    UCG_GROUP_PARAM_FIELD_OOB_BCAST    = UCS_BIT(2), /**< oob_bcast */
+    UCG_GROUP_PARAM_FIELD_OOB_ARG      = UCS_BIT(3)  /**< oob_arg */
+};
+
+
+/**
+ * @ingroup UCG_GROUP
+ * @brief Parameters for creating a UCG group.
+ */
+typedef struct ucg_group_params {
+    /**
+     * Mask of valid fields in this structure, using bits from
+     * @ref ucg_group_params_field.
+     */
+    uint64_t             field_mask;
+
+    /**
+     * Number of processes in the group. All of them must run on the same node.
+     */
+    unsigned             member_count;
+
+    /**
+     * Rank of the calling process in the group, in the range
+     * 0..(member_count - 1).
+     */
+    unsigned             my_rank;
+
+    /**
+     * Out-of-band broadcast routine, used to distribute the shared segment.
+     */
+    ucg_oob_bcast_func_t oob_bcast;
+
+    /**
+     * User-defined argument passed to @ref ucg_group_params_t.oob_bcast.
+     */
+    void                 *oob_arg;
+} ucg_group_params_t;
+
+
+/**
+ * @ingroup UCG_GROUP
+ * @brief Create a group.
+ *
+ * This routine is called collectively by all members of the group. The member
+ * with rank 0 allocates the shared segment of the group, and the others map it.
+ * The routine returns after all members have mapped the segment. It fails
+ * with UCS_ERR_INVALID_PARAM if the group size or UCX_UCG_SLOT_SIZE of the
+ * member differ from those of rank 0.
+ *
+ * @param [in]  params   Group parameters.
+ * @param [out] group_p  Filled with the handle of the new group.
+ *
+ * @return Error code as defined by @ref ucs_status_t.
+ */
+ucs_status_t ucg_group_create(const ucg_group_params_t *params,
+                              ucg_group_h *group_p);
+
+
+/**
+ * @ingroup UCG_GROUP
+ * @brief Destroy a group.
+ *
+ * This routine is called collectively by all members of the group, and
+ * releases the shared segment after all members stopped using it.
+ *
+ * @param [in]  group  Group to destroy.
+ */
+void ucg_group_destroy(ucg_group_h group);
+
+
+/**
+ * @ingroup UCG_COLL
+ * @brief Wait until all members of the group enter the barrier.
+ *
+ * @param [in]  group  Group handle.
+ *
+ * @return Error code as defined by @ref ucs_status_t.
+ */
+ucs_status_t ucg_barrier(ucg_group_h group);
+
+
+/**
+ * @ingroup UCG_COLL
+ * @brief Broadcast a buffer from the root to all members.
+ *
+ * @param [in]    group   Group handle.
+ * @param [inout] buffer  Data to send on the root, filled on other members.
+ * @param [in]    length  Size of the data in bytes.
+ * @param [in]    root    Rank of the member which sends the data.
+ *
+ * @return Error code as defined by @ref ucs_status_t.
+ */
+ucs_status_t ucg_bcast(ucg_group_h group, void *buffer, size_t length,
+                       unsigned root);
+
+
+/**
+ * @ingroup UCG_COLL
+ * @brief Reduce the buffers of all members to the root.
+ *
+ * @param [in]  group   Group handle.
+ * @param [in]  sbuf    Elements contributed by the calling member.
+ * @param [out] rbuf    Filled with the reduced elements on the root, ignored
+ *                      on other members. May be equal to @a sbuf.
+ * @param [in]  count   Number of elements.
+ * @param [in]  dt      Data type of the elements.
+ * @param [in]  op      Reduction operation.
+ * @param [in]  root    Rank of the member which receives the result.
+ *
+ * @return Error code as defined by @ref ucs_status_t.
+ */
+ucs_status_t ucg_reduce(ucg_group_h group, const void *sbuf, void *rbuf,
+                        size_t count, ucg_dt_t dt, ucg_op_t op, unsigned root);
+
+
+/**
+ * @ingroup UCG_COLL
+ * @brief Reduce the buffers of all members, and distribute the result to all
+ *        of them.
+ *
+ * @param [in]  group   Group handle.
+ * @param [in]  sbuf    Elements contributed by the calling member.
+ * @param [out] rbuf    Filled with the reduced elements. May be equal to
+ *                      @a sbuf.
+ * @param [in]  count   Number of elements.
+ * @param [in]  dt      Data type of the elements.
+ * @param [in]  op      Reduction operation.
+ *
+ * @return Error code as defined by @ref ucs_status_t.
+ */
+ucs_status_t ucg_allreduce(ucg_group_h group, const void *sbuf, void *rbuf,
+                           size_t count, ucg_dt_t dt, ucg_op_t op);
+
+END_C_DECLS
+
+#endif
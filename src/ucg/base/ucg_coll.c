@@ -0,0 +1,320 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ucg_group.h"
+#include "ucg_reduce.h"
+
+#include <ucs/debug/log.h>
+#include <string.h>
+
+
+/*
+ * Every collective operation is a sequence of steps, numbered by the group
+ * sequence number which all members advance in the same order. In each step a
+ * member waits for the flags of its tree neighbors to reach the step, and then
+ * sets its own flags to the step:
+ *  - "arrive" tells the parent that the data in the slot of the member is
+ *    ready, or that the member no longer uses the slot of the parent.
+ *  - "release" tells the children that the data in the slot of the member is
+ *    ready, or that the member no longer uses their slots.
+ */
+
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucg_coll_check_group(ucg_group_h group)
+{
+    if (ucs_unlikely(group->status != UCS_OK)) {
+        ucs_error("group %p: a previous operation failed with %s", group,
+                  ucs_status_string(group->status));
+    }
+
+    return group->status;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucg_coll_check_root(ucg_group_h group, unsigned root)
+{
+    if (root >= group->member_count) {
+        ucs_error("group %p: invalid root %u, member count %u", group, root,
+                  group->member_count);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    return UCS_OK;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucg_coll_check_reduce(ucg_group_h group, ucg_dt_t dt, ucg_op_t op)
+{
+    if ((dt >= UCG_DT_LAST) || (op >= UCG_OP_LAST)) {
+        ucs_error("group %p: invalid reduction datatype %d or operation %d",
+                  group, dt, op);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    return UCS_OK;
+}
+
+/**
+ * Reduce the elements of the member with the elements in the slots of its
+ * children, which have arrived at the step, into @a dst.
+ */
+static ucs_status_t
+ucg_coll_reduce_children(ucg_group_h group, unsigned root,
+                         const ucg_group_tree_t *tree, const void *src,
+                         void *dst, size_t count, ucg_dt_t dt, ucg_op_t op,
+                         uint64_t seq)
+{
+    ucg_reduce_func_t reduce = ucg_reduce_funcs[op][dt];
+    unsigned i, child;
+    ucs_status_t status;
+
+    if (dst != src) {
+        memcpy(dst, src, count * ucg_dt_sizes[dt]);
+    }
+
+    for (i = 0; i < tree->num_children; ++i) {
+        child  = ucg_group_rank(group, tree->first_child + i, root);
+        status = ucg_group_wait(group, child, &group->ctrl[child].arrive, seq);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        reduce(dst, ucg_group_slot(group, child), count);
+    }
+
+    return UCS_OK;
+}
+
+ucs_status_t ucg_barrier(ucg_group_h group)
+{
+    ucg_group_ctrl_t *ctrl = &group->ctrl[group->my_rank];
+    ucg_group_tree_t tree;
+    ucs_status_t status;
+    uint64_t seq;
+
+    status = ucg_coll_check_group(group);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ucg_group_tree(group, 0, &tree);
+    seq = ++group->seq;
+
+    status = ucg_group_wait_children(group, 0, &tree, seq);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ucg_group_post(&ctrl->arrive, seq);
+    if (tree.parent != UINT_MAX) {
+        status = ucg_group_wait(group, tree.parent,
+                                &group->ctrl[tree.parent].release, seq);
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+    ucg_group_post(&ctrl->release, seq);
+
+    return UCS_OK;
+}
+
+ucs_status_t ucg_bcast(ucg_group_h group, void *buffer, size_t length,
+                       unsigned root)
+{
+    ucg_group_ctrl_t *ctrl = &group->ctrl[group->my_rank];
+    void *slot             = ucg_group_slot(group, group->my_rank);
+    ucg_group_tree_t tree;
+    size_t offset, chunk;
+    ucs_status_t status;
+    void *data, *src;
+    uint64_t seq;
+
+    status = ucg_coll_check_group(group);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucg_coll_check_root(group, root);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ucg_group_tree(group, root, &tree);
+
+    for (offset = 0; offset < length; offset += chunk) {
+        chunk = ucs_min(length - offset, group->slot_size);
+        data  = UCS_PTR_BYTE_OFFSET(buffer, offset);
+        seq   = ++group->seq;
+
+        if (tree.parent == UINT_MAX) {
+            memcpy(slot, data, chunk);
+        } else {
+            status = ucg_group_wait(group, tree.parent,
+                                    &group->ctrl[tree.parent].release, seq);
+            if (status != UCS_OK) {
+                return status;
+            }
+
+            src = ucg_group_slot(group, tree.parent);
+            memcpy(data, src, chunk);
+            if (tree.num_children > 0) {
+                memcpy(slot, src, chunk);
+            }
+        }
+
+        /* Let the children copy the data, and wait until they are done before
+         * the slot is reused */
+        ucg_group_post(&ctrl->release, seq);
+        status = ucg_group_wait_children(group, root, &tree, seq);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        ucg_group_post(&ctrl->arrive, seq);
+    }
+
+    return UCS_OK;
+}
+
+ucs_status_t ucg_reduce(ucg_group_h group, const void *sbuf, void *rbuf,
+                        size_t count, ucg_dt_t dt, ucg_op_t op, unsigned root)
+{
+    ucg_group_ctrl_t *ctrl = &group->ctrl[group->my_rank];
+    void *slot             = ucg_group_slot(group, group->my_rank);
+    ucg_group_tree_t tree;
+    size_t offset, chunk, max_chunk, dt_size;
+    ucs_status_t status;
+    uint64_t seq;
+    void *dst;
+
+    status = ucg_coll_check_group(group);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucg_coll_check_root(group, root);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucg_coll_check_reduce(group, dt, op);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ucg_group_tree(group, root, &tree);
+    dt_size   = ucg_dt_sizes[dt];
+    max_chunk = group->slot_size / dt_size;
+
+    for (offset = 0; offset < count; offset += chunk) {
+        chunk = ucs_min(count - offset, max_chunk);
+        dst   = (tree.parent == UINT_MAX) ?
+                UCS_PTR_BYTE_OFFSET(rbuf, offset * dt_size) : slot;
+        seq   = ++group->seq;
+
+        status = ucg_coll_reduce_children(group, root, &tree,
+                                          UCS_PTR_BYTE_OFFSET(sbuf,
+                                                              offset * dt_size),
+                                          dst, chunk, dt, op, seq);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        /* The slots of the children can be reused */
+        ucg_group_post(&ctrl->release, seq);
+
+        if (tree.parent != UINT_MAX) {
+            /* Wait for the parent to consume the partial result */
+            ucg_group_post(&ctrl->arrive, seq);
+            status = ucg_group_wait(group, tree.parent,
+                                    &group->ctrl[tree.parent].release, seq);
+            if (status != UCS_OK) {
+                return status;
+            }
+        }
+    }
+
+    return UCS_OK;
+}
+
+ucs_status_t ucg_allreduce(ucg_group_h group, const void *sbuf, void *rbuf,
+                           size_t count, ucg_dt_t dt, ucg_op_t op)
+{
+    ucg_group_ctrl_t *ctrl = &group->ctrl[group->my_rank];
+    void *slot             = ucg_group_slot(group, group->my_rank);
+    ucg_group_tree_t tree;
+    size_t offset, chunk, max_chunk, dt_size;
+    ucs_status_t status;
+    void *data, *src;
+    uint64_t seq;
+
+    status = ucg_coll_check_group(group);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucg_coll_check_reduce(group, dt, op);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ucg_group_tree(group, 0, &tree);
+    dt_size   = ucg_dt_sizes[dt];
+    max_chunk = group->slot_size / dt_size;
+
+    for (offset = 0; offset < count; offset += chunk) {
+        chunk = ucs_min(count - offset, max_chunk);
+        data  = UCS_PTR_BYTE_OFFSET(rbuf, offset * dt_size);
+        seq   = ++group->seq;
+
+        /* Reduce towards the root, which keeps the result in its slot */
+        status = ucg_coll_reduce_children(group, 0, &tree,
+                                          UCS_PTR_BYTE_OFFSET(sbuf,
+                                                              offset * dt_size),
+                                          slot, chunk, dt, op, seq);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        if (tree.parent == UINT_MAX) {
+            memcpy(data, slot, chunk * dt_size);
+        } else {
+            /* The parent releases its slot once it holds the result, which
+             * also means it consumed the partial result of this member */
+            ucg_group_post(&ctrl->arrive, seq);
+            status = ucg_group_wait(group, tree.parent,
+                                    &group->ctrl[tree.parent].release, seq);
+            if (status != UCS_OK) {
+                return status;
+            }
+
+            src = ucg_group_slot(group, tree.parent);
+            memcpy(data, src, chunk * dt_size);
+            if (tree.num_children > 0) {
+                memcpy(slot, src, chunk * dt_size);
+            }
+        }
+
+        ucg_group_post(&ctrl->release, seq);
+
+        /* Wait until the children copied the result before the slot is
+         * reused */
+        seq    = ++group->seq;
+        status = ucg_group_wait_children(group, 0, &tree, seq);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        ucg_group_post(&ctrl->arrive, seq);
+    }
+
+    return UCS_OK;
+}
@@ -0,0 +1,429 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ucg_group.h"
+
+#include <ucs/config/parser.h>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/string.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/* Segment information sent by rank 0 to the other members */
+typedef struct {
+    int8_t   status;       /* Whether the segment was allocated */
+    uint32_t member_count; /* Group size on rank 0 */
+    uint64_t address;      /* Segment address on rank 0 */
+    uint64_t length;       /* Segment length */
+    /* Packed rkey follows */
+} UCS_S_PACKED ucg_group_seg_info_t;
+
+
+static const char *ucg_algorithm_names[] = {
+    [UCG_ALGORITHM_AUTO] = "auto",
+    [UCG_ALGORITHM_FLAT] = "flat",
+    [UCG_ALGORITHM_TREE] = "tree",
+    [UCG_ALGORITHM_LAST] = NULL
+};
+
+static ucs_config_field_t ucg_config_table[] = {
+  {"MM_COMPONENT", "posix",
+   "UCT shared memory component which allocates the segment of a group, for\n"
+   "example \"posix\" or \"sysv\".",
+   ucs_offsetof(ucg_config_t, mm_component), UCS_CONFIG_TYPE_STRING},
+
+  {"SLOT_SIZE", "64k",
+   "Size of the data slot of each member in the segment of a group. Larger\n"
+   "buffers are transferred in several steps.",
+   ucs_offsetof(ucg_config_t, slot_size), UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"ALGORITHM", "auto",
+   "How the members of a group synchronize:\n"
+   " flat - all members exchange data and flags directly with the root.\n"
+   " tree - the members form a tree with UCX_UCG_TREE_RADIX children per node.\n"
+   " auto - flat for groups of up to UCX_UCG_FLAT_MAX members, tree otherwise.",
+   ucs_offsetof(ucg_config_t, algorithm),
+   UCS_CONFIG_TYPE_ENUM(ucg_algorithm_names)},
+
+  {"TREE_RADIX", "4",
+   "Number of children of each member in the tree algorithm.",
+   ucs_offsetof(ucg_config_t, tree_radix), UCS_CONFIG_TYPE_UINT},
+
+  {"FLAT_MAX", "8",
+   "Maximal number of group members for which the auto algorithm is flat.",
+   ucs_offsetof(ucg_config_t, flat_max), UCS_CONFIG_TYPE_UINT},
+
+  {"SPIN_COUNT", "1000",
+   "Number of times to poll a flag of another member before yielding the CPU.",
+   ucs_offsetof(ucg_config_t, spin_count), UCS_CONFIG_TYPE_UINT},
+
+  {"TIMEOUT", "inf",
+   "Time to wait for another member in a collective operation before failing\n"
+   "it with UCS_ERR_TIMED_OUT. If the process of the member exited, the\n"
+   "operation fails with UCS_ERR_CONNECTION_RESET without waiting for the\n"
+   "timeout.",
+   ucs_offsetof(ucg_config_t, timeout), UCS_CONFIG_TYPE_TIME_UNITS},
+
+  {NULL}
+};
+
+UCS_CONFIG_REGISTER_TABLE(ucg_config_table, "UCG", "UCG_", ucg_config_t,
+                          &ucs_config_global_list)
+
+
+static ucs_status_t ucg_group_md_open(ucg_group_h group, const char *name)
+{
+    uct_component_attr_t component_attr;
+    uct_component_h *components;
+    unsigned num_components, i;
+    uct_md_config_t *md_config;
+    uct_md_attr_t md_attr;
+    ucs_status_t status;
+
+    status = uct_query_components(&components, &num_components);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    group->component = NULL;
+    for (i = 0; i < num_components; ++i) {
+        component_attr.field_mask = UCT_COMPONENT_ATTR_FIELD_NAME;
+        status = uct_component_query(components[i], &component_attr);
+        if ((status == UCS_OK) && !strcmp(component_attr.name, name)) {
+            group->component = components[i];
+            break;
+        }
+    }
+
+    if (group->component == NULL) {
+        ucs_error("shared memory component '%s' is not available", name);
+        status = UCS_ERR_NO_DEVICE;
+        goto out_release_components;
+    }
+
+    status = uct_md_config_read(group->component, NULL, NULL, &md_config);
+    if (status != UCS_OK) {
+        goto out_release_components;
+    }
+
+    /* Shared memory components have a single memory domain, named after the
+     * component */
+    status = uct_md_open(group->component, name, md_config, &group->md);
+    uct_config_release(md_config);
+    if (status != UCS_OK) {
+        goto out_release_components;
+    }
+
+    status = uct_md_query(group->md, &md_attr);
+    if (status != UCS_OK) {
+        goto err_md_close;
+    }
+
+    if (!ucs_test_all_flags(md_attr.cap.flags,
+                            UCT_MD_FLAG_ALLOC | UCT_MD_FLAG_RKEY_PTR)) {
+        ucs_error("memory domain '%s' cannot allocate shared memory", name);
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_md_close;
+    }
+
+    status = UCS_OK;
+    goto out_release_components;
+
+err_md_close:
+    uct_md_close(group->md);
+out_release_components:
+    uct_release_component_list(components);
+    return status;
+}
+
+static ucs_status_t ucg_group_seg_alloc(ucg_group_h group, size_t length)
+{
+    uct_alloc_method_t method = UCT_ALLOC_METHOD_MD;
+    uct_mem_alloc_params_t params;
+
+    params.field_mask = UCT_MEM_ALLOC_PARAM_FIELD_FLAGS    |
+                        UCT_MEM_ALLOC_PARAM_FIELD_MEM_TYPE |
+                        UCT_MEM_ALLOC_PARAM_FIELD_MDS      |
+                        UCT_MEM_ALLOC_PARAM_FIELD_NAME;
+    params.flags      = UCT_MD_MEM_ACCESS_ALL;
+    params.mem_type   = UCS_MEMORY_TYPE_HOST;
+    params.mds.mds    = &group->md;
+    params.mds.count  = 1;
+    params.name       = "ucg_group_seg";
+
+    return uct_mem_alloc(length, &method, 1, &params, &group->mem);
+}
+
+static ucs_status_t
+ucg_group_seg_map(ucg_group_h group, const ucg_group_params_t *params,
+                  size_t length)
+{
+    size_t info_length, rkey_size;
+    ucg_group_seg_info_t *info;
+    uct_md_attr_t md_attr;
+    ucs_status_t status;
+    void *address;
+
+    status = uct_md_query(group->md, &md_attr);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    rkey_size   = md_attr.rkey_packed_size;
+    info_length = sizeof(*info) + rkey_size;
+    info        = ucs_calloc(1, info_length, "ucg_group_seg_info");
+    if (info == NULL) {
+        ucs_error("failed to allocate group segment information");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    if (group->my_rank == 0) {
+        status = ucg_group_seg_alloc(group, length);
+        if (status == UCS_OK) {
+            status = uct_md_mkey_pack(group->md, group->mem.memh, info + 1);
+            if (status != UCS_OK) {
+                uct_mem_free(&group->mem);
+            }
+        }
+
+        if (status == UCS_OK) {
+            info->member_count = group->member_count;
+            info->address      = (uintptr_t)group->mem.address;
+            info->length       = length;
+            memset(group->mem.address, 0, length);
+        } else {
+            ucs_error("failed to allocate group segment of %zu bytes: %s",
+                      length, ucs_status_string(status));
+        }
+
+        /* The other members wait for the segment, so send it also on error */
+        info->status = status;
+    }
+
+    status = params->oob_bcast(info, info_length, 0, params->oob_arg);
+    if (status != UCS_OK) {
+        ucs_error("out-of-band broadcast of group segment failed: %s",
+                  ucs_status_string(status));
+        goto err_free_seg;
+    }
+
+    if (info->status != UCS_OK) {
+        status = (ucs_status_t)info->status;
+        goto err_free_info;
+    }
+
+    if (group->my_rank == 0) {
+        address = group->mem.address;
+    } else {
+        status = uct_rkey_unpack(group->component, info + 1, &group->rkey_ob);
+        if (status != UCS_OK) {
+            goto err_free_info;
+        }
+
+        status = uct_rkey_ptr(group->component, &group->rkey_ob, info->address,
+                              &address);
+        if (status != UCS_OK) {
+            ucs_error("failed to map group segment: %s",
+                      ucs_status_string(status));
+            goto err_release_rkey;
+        }
+    }
+
+    /* Let the other members detect that this member exited, also when the
+     * group is not created because of the check below */
+    if (group->my_rank < info->member_count) {
+        ((ucg_group_ctrl_t*)address)[group->my_rank].pid = getpid();
+    }
+
+    if ((info->member_count != group->member_count) ||
+        (info->length != length)) {
+        ucs_error("group segment of rank 0 has %u members and %" PRIu64
+                  " bytes, while rank %u expects %u members and %zu bytes; "
+                  "UCX_UCG_SLOT_SIZE must be equal on all members",
+                  info->member_count, info->length, group->my_rank,
+                  group->member_count, length);
+        status = UCS_ERR_INVALID_PARAM;
+        goto err_release_rkey;
+    }
+
+    group->ctrl  = address;
+    group->slots = UCS_PTR_BYTE_OFFSET(address, sizeof(*group->ctrl) *
+                                                group->member_count);
+    ucs_free(info);
+    return UCS_OK;
+
+err_release_rkey:
+    if (group->my_rank != 0) {
+        uct_rkey_release(group->component, &group->rkey_ob);
+    }
+err_free_seg:
+    if ((group->my_rank == 0) && (info->status == UCS_OK)) {
+        uct_mem_free(&group->mem);
+    }
+err_free_info:
+    ucs_free(info);
+    return status;
+}
+
+static void ucg_group_seg_unmap(ucg_group_h group)
+{
+    if (group->my_rank == 0) {
+        uct_mem_free(&group->mem);
+    } else {
+        uct_rkey_release(group->component, &group->rkey_ob);
+    }
+}
+
+ucs_status_t ucg_group_create(const ucg_group_params_t *params,
+                              ucg_group_h *group_p)
+{
+    const uint64_t required_fields = UCG_GROUP_PARAM_FIELD_MEMBER_COUNT |
+                                     UCG_GROUP_PARAM_FIELD_MY_RANK      |
+                                     UCG_GROUP_PARAM_FIELD_OOB_BCAST    |
+                                     UCG_GROUP_PARAM_FIELD_OOB_ARG;
+    ucg_config_t config;
+    ucg_group_h group;
+    ucs_status_t status;
+    size_t seg_length;
+
+    if (!ucs_test_all_flags(params->field_mask, required_fields) ||
+        (params->member_count == 0) ||
+        (params->my_rank >= params->member_count)) {
+        ucs_error("invalid group parameters: field_mask 0x%" PRIx64
+                  " member_count %u my_rank %u", params->field_mask,
+                  params->member_count, params->my_rank);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    status = ucs_config_parser_fill_opts(&config,
+                                         UCS_CONFIG_GET_TABLE(ucg_config_table),
+                                         UCS_DEFAULT_ENV_PREFIX, 0);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    group = ucs_calloc(1, sizeof(*group), "ucg_group");
+    if (group == NULL) {
+        ucs_error("failed to allocate group");
+        status = UCS_ERR_NO_MEMORY;
+        goto out_release_config;
+    }
+
+    group->member_count = params->member_count;
+    group->my_rank      = params->my_rank;
+    group->slot_size    = ucs_align_up_pow2(ucs_max(config.slot_size,
+                                                    UCS_SYS_CACHE_LINE_SIZE),
+                                            UCS_SYS_CACHE_LINE_SIZE);
+    group->spin_count   = ucs_max(config.spin_count, 1);
+    group->timeout      = config.timeout;
+    group->status       = UCS_OK;
+    group->seq          = 0;
+
+    if ((config.algorithm == UCG_ALGORITHM_TREE) ||
+        ((config.algorithm == UCG_ALGORITHM_AUTO) &&
+         (group->member_count > config.flat_max))) {
+        group->radix = ucs_max(config.tree_radix, 1);
+    } else {
+        group->radix = ucs_max(group->member_count - 1, 1);
+    }
+
+    status = ucg_group_md_open(group, config.mm_component);
+    if (status != UCS_OK) {
+        goto err_free_group;
+    }
+
+    seg_length = (sizeof(*group->ctrl) + group->slot_size) *
+                 group->member_count;
+    status     = ucg_group_seg_map(group, params, seg_length);
+    if (status != UCS_OK) {
+        goto err_md_close;
+    }
+
+    /* Rank 0 may release the segment only after all members mapped it */
+    status = ucg_barrier(group);
+    if (status != UCS_OK) {
+        goto err_seg_unmap;
+    }
+
+    ucs_debug("created group %p rank %u/%u, %s segment of %zu bytes, radix %u",
+              group, group->my_rank, group->member_count, config.mm_component,
+              seg_length, group->radix);
+
+    *group_p = group;
+    status   = UCS_OK;
+    goto out_release_config;
+
+err_seg_unmap:
+    ucg_group_seg_unmap(group);
+err_md_close:
+    uct_md_close(group->md);
+err_free_group:
+    ucs_free(group);
+out_release_config:
+    ucs_config_parser_release_opts(&config, ucg_config_table);
+    return status;
+}
+
+void ucg_group_destroy(ucg_group_h group)
+{
+    /* Wait for all members to complete their operations on the segment, unless
+     * they are out of sync */
+    if (group->status == UCS_OK) {
+        ucg_barrier(group);
+    }
+
+    ucs_debug("destroy group %p rank %u/%u", group, group->my_rank,
+              group->member_count);
+
+    ucg_group_seg_unmap(group);
+    uct_md_close(group->md);
+    ucs_free(group);
+}
+
+ucs_status_t ucg_group_wait_slow(ucg_group_h group, unsigned rank,
+                                 volatile uint64_t *flag, uint64_t seq)
+{
+    ucs_time_t start_time = ucs_get_time();
+    unsigned count        = 0;
+    pid_t pid;
+
+    while (*flag < seq) {
+        if (++count < group->spin_count) {
+            continue;
+        }
+
+        count = 0;
+        sched_yield();
+
+        pid = group->ctrl[rank].pid;
+        if ((pid != 0) && (kill(pid, 0) < 0) && (errno == ESRCH)) {
+            ucs_error("group %p: member %u (pid %d) exited", group, rank, pid);
+            group->status = UCS_ERR_CONNECTION_RESET;
+            return group->status;
+        }
+
+        if ((group->timeout != UCS_TIME_INFINITY) &&
+            ((ucs_get_time() - start_time) > group->timeout)) {
+            ucs_error("group %p: member %u did not reach step %" PRIu64
+                      " within %.3f seconds", group, rank, seq,
+                      ucs_time_to_sec(group->timeout));
+            group->status = UCS_ERR_TIMED_OUT;
+            return group->status;
+        }
+    }
+
+    ucs_memory_cpu_load_fence();
+    return UCS_OK;
+}
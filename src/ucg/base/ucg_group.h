@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCG_GROUP_H_
+#define UCG_GROUP_H_
+
+#include <ucg/api/ucg.h>
+#include <uct/api/uct.h>
+#include <ucs/arch/atomic.h>
+#include <ucs/arch/cpu.h>
+#include <ucs/sys/compiler_def.h>
+#include <ucs/sys/math.h>
+#include <ucs/sys/ptr_arith.h>
+#include <ucs/time/time.h>
+#include <limits.h>
+#include <sched.h>
+#include <sys/types.h>
+
+
+/**
+ * Algorithms to synchronize the group members
+ */
+typedef enum {
+    UCG_ALGORITHM_AUTO,
+    UCG_ALGORITHM_FLAT, /* All members communicate directly with the root */
+    UCG_ALGORITHM_TREE, /* Members form a k-ary tree rooted at the root */
+    UCG_ALGORITHM_LAST
+} ucg_algorithm_t;
+
+
+/**
+ * UCG configuration
+ */
+typedef struct {
+    char            *mm_component; /* UCT shared memory component */
+    size_t          slot_size;     /* Data slot of each member in the segment */
+    ucg_algorithm_t algorithm;     /* Synchronization algorithm */
+    unsigned        tree_radix;    /* Radix of the tree algorithm */
+    unsigned        flat_max;      /* Maximal group size to select flat */
+    unsigned        spin_count;    /* Polls of a flag before yielding the CPU */
+    ucs_time_t      timeout;       /* Time to wait for another member */
+} ucg_config_t;
+
+
+/**
+ * Synchronization flags of a group member in the shared segment. Each member
+ * writes only its own flags, with increasing step sequence numbers.
+ */
+typedef struct {
+    /* Last step in which the member made its data available to its parent */
+    volatile uint64_t arrive;
+    /* Last step in which the member made its data available to its children,
+     * or released their slots */
+    volatile uint64_t release;
+    /* Process of the member, or 0 if it did not map the segment yet */
+    volatile pid_t    pid;
+} UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) ucg_group_ctrl_t;
+
+
+/**
+ * Position of a member in the tree of a collective operation
+ */
+typedef struct {
+    unsigned parent;      /* Rank of the parent, or UINT_MAX on the root */
+    unsigned first_child; /* Rank of the first child, relative to the root */
+    unsigned num_children;
+} ucg_group_tree_t;
+
+
+/**
+ * Group of members which share a memory segment. The segment starts with the
+ * flags of all members, followed by their data slots.
+ */
+struct ucg_group {
+    unsigned               member_count;
+    unsigned               my_rank;
+    unsigned               radix;       /* Children of a tree node */
+    size_t                 slot_size;
+    unsigned               spin_count;
+    ucs_time_t             timeout;     /* Time to wait for another member */
+    ucs_status_t           status;      /* Error which failed an operation,
+                                           the members are out of sync */
+    uint64_t               seq;         /* Sequence number of the last step */
+    ucg_group_ctrl_t       *ctrl;       /* Flags of the members */
+    void                   *slots;      /* Data slots of the members */
+
+    uct_component_h        component;
+    uct_md_h               md;
+    uct_allocated_memory_t mem;         /* Segment allocated by rank 0 */
+    uct_rkey_bundle_t      rkey_ob;     /* Segment mapped by other ranks */
+};
+
+
+static UCS_F_ALWAYS_INLINE void *
+ucg_group_slot(const struct ucg_group *group, unsigned rank)
+{
+    return UCS_PTR_BYTE_OFFSET(group->slots, group->slot_size * rank);
+}
+
+
+static UCS_F_ALWAYS_INLINE unsigned
+ucg_group_rank(const struct ucg_group *group, unsigned vrank, unsigned root)
+{
+    return (vrank + root) % group->member_count;
+}
+
+
+static UCS_F_ALWAYS_INLINE void
+ucg_group_tree(const struct ucg_group *group, unsigned root,
+               ucg_group_tree_t *tree)
+{
+    unsigned vrank = (group->my_rank + group->member_count - root) %
+                     group->member_count;
+    unsigned first = (vrank * group->radix) + 1;
+
+    tree->parent       = (vrank == 0) ? UINT_MAX :
+                         ucg_group_rank(group, (vrank - 1) / group->radix,
+                                        root);
+    tree->first_child  = first;
+    tree->num_children = (first >= group->member_count) ? 0 :
+                         ucs_min(group->radix, group->member_count - first);
+}
+
+
+/**
+ * Wait until the flag of another member reaches the step, yielding the CPU
+ * between polls. Fails if the member exited or the timeout expired.
+ */
+ucs_status_t ucg_group_wait_slow(struct ucg_group *group, unsigned rank,
+                                 volatile uint64_t *flag, uint64_t seq);
+
+
+/**
+ * Wait until a flag of the member @a rank reaches the step.
+ */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucg_group_wait(struct ucg_group *group, unsigned rank, volatile uint64_t *flag,
+               uint64_t seq)
+{
+    unsigned count;
+
+    for (count = 0; *flag < seq; ++count) {
+        if (count >= group->spin_count) {
+            return ucg_group_wait_slow(group, rank, flag, seq);
+        }
+    }
+
+    /* Read the data only after the flag */
+    ucs_memory_cpu_load_fence();
+    return UCS_OK;
+}
+
+
+/**
+ * Publish the data of the member for the step, by setting its flag.
+ */
+static UCS_F_ALWAYS_INLINE void
+ucg_group_post(volatile uint64_t *flag, uint64_t seq)
+{
+    ucs_memory_cpu_store_fence();
+    *flag = seq;
+}
+
+
+/**
+ * Wait for all children to arrive at the step.
+ */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucg_group_wait_children(struct ucg_group *group, unsigned root,
+                        const ucg_group_tree_t *tree, uint64_t seq)
+{
+    unsigned i, child;
+    ucs_status_t status;
+
+    for (i = 0; i < tree->num_children; ++i) {
+        child  = ucg_group_rank(group, tree->first_child + i, root);
+        status = ucg_group_wait(group, child, &group->ctrl[child].arrive, seq);
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
+    return UCS_OK;
+}
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ucg_reduce.h"
+
+#include <stdint.h>
+
+
+/*
+ * The kernels operate on non-overlapping arrays without dependencies between
+ * the elements, so the compiler vectorizes them with the SIMD instructions of
+ * the target.
+ */
+#define UCG_REDUCE_OP_sum(_a, _b)  ((_a) + (_b))
+#define UCG_REDUCE_OP_prod(_a, _b) ((_a) * (_b))
+#define UCG_REDUCE_OP_min(_a, _b)  (((_b) < (_a)) ? (_b) : (_a))
+#define UCG_REDUCE_OP_max(_a, _b)  (((_b) > (_a)) ? (_b) : (_a))
+
+#define UCG_REDUCE_FUNC(_op, _name, _type) \
+    static void ucg_reduce_##_op##_##_name(void *restrict dst, \
+                                           const void *restrict src, \
+                                           size_t count) \
+    { \
+        _type *restrict d       = dst; \
+        const _type *restrict s = src; \
+        size_t i; \
+        \
+        for (i = 0; i < count; ++i) { \
+            d[i] = UCG_REDUCE_OP_##_op(d[i], s[i]); \
+        } \
+    }
+
+#define UCG_REDUCE_OP_FUNCS(_op) \
+    UCG_REDUCE_FUNC(_op, int32,  int32_t) \
+    UCG_REDUCE_FUNC(_op, uint32, uint32_t) \
+    UCG_REDUCE_FUNC(_op, int64,  int64_t) \
+    UCG_REDUCE_FUNC(_op, uint64, uint64_t) \
+    UCG_REDUCE_FUNC(_op, float,  float) \
+    UCG_REDUCE_FUNC(_op, double, double)
+
+#define UCG_REDUCE_OP_ENTRY(_op) \
+    { \
+        [UCG_DT_INT32]  = ucg_reduce_##_op##_int32, \
+        [UCG_DT_UINT32] = ucg_reduce_##_op##_uint32, \
+        [UCG_DT_INT64]  = ucg_reduce_##_op##_int64, \
+        [UCG_DT_UINT64] = ucg_reduce_##_op##_uint64, \
+        [UCG_DT_FLOAT]  = ucg_reduce_##_op##_float, \
+        [UCG_DT_DOUBLE] = ucg_reduce_##_op##_double \
+    }
+
+
+UCG_REDUCE_OP_FUNCS(sum)
+UCG_REDUCE_OP_FUNCS(prod)
+UCG_REDUCE_OP_FUNCS(min)
+UCG_REDUCE_OP_FUNCS(max)
+
+
+const size_t ucg_dt_sizes[] = {
+    [UCG_DT_INT32]  = sizeof(int32_t),
+    [UCG_DT_UINT32] = sizeof(uint32_t),
+    [UCG_DT_INT64]  = sizeof(int64_t),
+    [UCG_DT_UINT64] = sizeof(uint64_t),
+    [UCG_DT_FLOAT]  = sizeof(float),
+    [UCG_DT_DOUBLE] = sizeof(double)
+};
+
+const ucg_reduce_func_t ucg_reduce_funcs[UCG_OP_LAST][UCG_DT_LAST] = {
+    [UCG_OP_SUM]  = UCG_REDUCE_OP_ENTRY(sum),
+    [UCG_OP_PROD] = UCG_REDUCE_OP_ENTRY(prod),
+    [UCG_OP_MIN]  = UCG_REDUCE_OP_ENTRY(min),
+    [UCG_OP_MAX]  = UCG_REDUCE_OP_ENTRY(max)
+};
@@ -0,0 +1,29 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCG_REDUCE_H_
+#define UCG_REDUCE_H_
+
+#include <ucg/api/ucg.h>
+#include <stddef.h>
+
+
+/**
+ * Reduce @a count elements of @a src into @a dst, in place. The buffers must
+ * not overlap.
+ */
+typedef void (*ucg_reduce_func_t)(void *restrict dst, const void *restrict src,
+                                  size_t count);
+
+
+/* Size of an element of each data type */
+extern const size_t ucg_dt_sizes[];
+
+
+/* Reduction kernels, indexed by operation and data type */
+extern const ucg_reduce_func_t ucg_reduce_funcs[UCG_OP_LAST][UCG_DT_LAST];
+
+#endif
@@ -240,7 +240,16 @@ typedef enum {
     /**< Pack addresses of network devices only. Using such shortened addresses
      *   for the remote node peers will reduce the amount of wireup data being
      *   exchanged during connection establishment phase. */
-    UCP_WORKER_ADDRESS_FLAG_NET_ONLY = UCS_BIT(0)
+    UCP_WORKER_ADDRESS_FLAG_NET_ONLY = UCS_BIT(0),
+
+    /**< Pack only a reference to the node profile of the worker, instead of
+     *   the attributes of its network devices and interfaces. Such addresses
+     *   are much smaller, but can be used only by a peer which already knows
+     *   the profile: from an address it has obtained from its own worker,
+     *   or from a full address of another worker on the same type of node.
+     *   Otherwise @ref ucp_ep_create "ucp_ep_create()" with the address fails
+     *   with @ref UCS_ERR_NO_ELEM. Requires UCX_ADDRESS_VERSION=v2. */
+    UCP_WORKER_ADDRESS_FLAG_PROFILE_REF = UCS_BIT(1)
 } ucp_worker_address_flags_t;
 
 
@@ -293,7 +302,7 @@ enum ucp_ep_params_flags_field {
                                                            send to a particular
                                                            remote endpoint, for
                                                            example stream */
-    UCP_EP_PARAMS_FLAGS_SEND_CLIENT_ID = UCS_BIT(2)   /**< Send client id
+    UCP_EP_PARAMS_FLAGS_SEND_CLIENT_ID = UCS_BIT(2),  /**< Send client id
                                                            when connecting to remote
                                                            socket address as part of the
                                                            connection request payload.
@@ -301,6 +310,22 @@ enum ucp_ep_params_flags_field {
                                                            can be obtained from
                                                            @ref ucp_conn_request_h using
                                                            @ref ucp_conn_request_query */
+    UCP_EP_PARAMS_FLAGS_AGGREGATE      = UCS_BIT(3)   /**< Aggregate consecutive
+                                                           small active messages
+                                                           and tagged messages
+                                                           sent on the endpoint
+                                                           into one transport
+                                                           message. The aggregated
+                                                           messages are sent when
+                                                           the aggregation buffer
+                                                           is full, when the
+                                                           UCX_AGGREGATE_TIMEOUT
+                                                           expires during worker
+                                                           progress, or when the
+                                                           endpoint or the worker
+                                                           is flushed. Messages
+                                                           may be delayed, but
+                                                           their order is kept. */
 };
 
 
@@ -532,6 +557,26 @@ enum ucp_datatype_attr_field {
 };
 
 
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief UCP strided datatype parameters field mask.
+ *
+ * The enumeration allows specifying which fields in
+ * @ref ucp_dt_strided_params_t are present.
+ */
+enum ucp_dt_strided_params_field {
+    /** @ref ucp_dt_strided_params_t::block_size field is set. */
+    UCP_DT_STRIDED_PARAM_FIELD_BLOCK_SIZE = UCS_BIT(0),
+
+    /** @ref ucp_dt_strided_params_t::dims and
+     *  @ref ucp_dt_strided_params_t::num_dims fields are set. */
+    UCP_DT_STRIDED_PARAM_FIELD_DIMS       = UCS_BIT(1),
+
+    /** @ref ucp_dt_strided_params_t::extent field is set. */
+    UCP_DT_STRIDED_PARAM_FIELD_EXTENT     = UCS_BIT(2)
+};
+
+
 /**
  * @ingroup UCP_MEM
  * @brief UCP memory mapping flags.
@@ -610,7 +655,17 @@ enum ucp_am_cb_flags {
      * so the data will be accessible outside the callback, until
      * @ref ucp_am_data_release is called.
      */
-    UCP_AM_FLAG_PERSISTENT_DATA = UCS_BIT(1)
+    UCP_AM_FLAG_PERSISTENT_DATA = UCS_BIT(1),
+
+    /**
+     * Deliver the messages to the @ref ucp_am_handler_param_t.batch_cb
+     * callback in batches. Single fragment eager messages, which are received
+     * during one call to @ref ucp_worker_progress, are passed to one invocation
+     * of the callback, in the order of their arrival. Other messages, such as
+     * rendezvous requests, are passed to the callback in a batch of one
+     * message, after the messages which arrived before them.
+     */
+    UCP_AM_FLAG_BATCH           = UCS_BIT(2)
 };
 
 
@@ -740,12 +795,19 @@ typedef enum {
                                                         operation, fail if the
                                                         operation cannot be
                                                         completed immediately */
-    UCP_OP_ATTR_FLAG_MULTI_SEND     = UCS_BIT(19)  /**< optimize for bandwidth of
+    UCP_OP_ATTR_FLAG_MULTI_SEND     = UCS_BIT(19), /**< optimize for bandwidth of
                                                         multiple in-flight operations,
                                                         rather than for the latency
                                                         of a single operation.
                                                         This flag and UCP_OP_ATTR_FLAG_FAST_CMPL
                                                         are mutually exclusive. */
+    UCP_OP_ATTR_FLAG_NO_AGGREGATE   = UCS_BIT(20)  /**< send the message
+                                                        directly, even if the
+                                                        endpoint was created with
+                                                        @ref UCP_EP_PARAMS_FLAGS_AGGREGATE.
+                                                        Messages previously
+                                                        aggregated on the endpoint
+                                                        are sent before it. */
 } ucp_op_attr_t;
 
 
@@ -818,7 +880,11 @@ enum ucp_am_handler_param_field {
     /**
      * Indicates that @ref ucp_am_handler_param_t.arg field is valid.
      */
-    UCP_AM_HANDLER_PARAM_FIELD_ARG     = UCS_BIT(3)
+    UCP_AM_HANDLER_PARAM_FIELD_ARG     = UCS_BIT(3),
+    /**
+     * Indicates that @ref ucp_am_handler_param_t.batch_cb field is valid.
+     */
+    UCP_AM_HANDLER_PARAM_FIELD_BATCH_CB = UCS_BIT(4)
 };
 
 
@@ -873,6 +939,26 @@ typedef struct ucp_dt_iov {
 } ucp_dt_iov_t;
 
 
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Maximal number of dimensions of a strided datatype.
+ */
+#define UCP_DT_STRIDED_MAX_DIMS 3
+
+
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Dimension of a strided datatype.
+ *
+ * This structure describes one dimension of a strided datatype: @a count
+ * items which are placed @a stride bytes apart from each other in memory.
+ */
+typedef struct ucp_dt_strided_dim {
+    size_t  count;    /**< Number of items in this dimension */
+    size_t  stride;   /**< Distance in bytes between consecutive items */
+} ucp_dt_strided_dim_t;
+
+
 /**
  * @ingroup UCP_DATATYPE
  * @brief UCP generic data type descriptor
@@ -1025,6 +1111,56 @@ typedef struct ucp_datatype_attr {
 } ucp_datatype_attr_t;
 
 
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief UCP strided datatype parameters
+ *
+ * This structure describes a strided datatype created by
+ * @ref ucp_dt_create_strided. A single element of the datatype is a set of
+ * contiguous blocks of @a block_size bytes, arranged in up to
+ * @ref UCP_DT_STRIDED_MAX_DIMS nested dimensions. For example, a face of a
+ * 3D array of doubles with dimensions NX x NY x NZ, which is orthogonal to the
+ * Y axis, is described by block_size=8, dims={{NX, 8}, {NZ, NX*NY*8}}.
+ * When a send or receive operation is called with a count of N, the data
+ * consists of N consecutive elements, placed @a extent bytes apart.
+ */
+typedef struct ucp_dt_strided_params {
+    /**
+     * Mask of valid fields in this structure, using bits from
+     * @ref ucp_dt_strided_params_field. Fields not specified in this mask
+     * will be ignored. Provides ABI compatibility with respect to adding new
+     * fields.
+     */
+    uint64_t                   field_mask;
+
+    /**
+     * Size in bytes of every contiguous block. This field is mandatory.
+     */
+    size_t                     block_size;
+
+    /**
+     * Array of @a num_dims dimensions, starting from the innermost one. The
+     * stride of the innermost dimension is the distance between blocks.
+     * This field is mandatory.
+     */
+    const ucp_dt_strided_dim_t *dims;
+
+    /**
+     * Number of entries in @a dims, between 1 and
+     * @ref UCP_DT_STRIDED_MAX_DIMS.
+     */
+    unsigned                   num_dims;
+
+    /**
+     * Distance in bytes between consecutive elements of the datatype.
+     * This value is optional. If @ref UCP_DT_STRIDED_PARAM_FIELD_EXTENT is
+     * not set in @ref field_mask, the value of this field defaults to
+     * dims[num_dims - 1].count * dims[num_dims - 1].stride.
+     */
+    size_t                     extent;
+} ucp_dt_strided_params_t;
+
+
 /**
  * @ingroup UCP_CONFIG
  * @brief Tuning parameters for UCP library.
@@ -1598,6 +1734,40 @@ typedef struct ucp_stream_poll_ep {
 } ucp_stream_poll_ep_t;
 
 
+/**
+ * @ingroup UCP_COMM
+ * @brief Ring buffer for receiving stream data of an endpoint.
+ *
+ * The structure is allocated by the application and set on an endpoint with
+ * @ref ucp_stream_ring_set. The stream data which arrives on the endpoint is
+ * written by UCP directly to the ring, in the order it was sent. The bytes
+ * between @a head and @a tail are ready to be consumed, starting from offset
+ * (@a head % @a size) of @a buffer and wrapping around its end.
+ */
+typedef struct ucp_stream_ring {
+    /**
+     * Ring memory, must remain valid while the ring is set on the endpoint.
+     */
+    void              *buffer;
+
+    /**
+     * Size of @a buffer in bytes, must be a power of 2.
+     */
+    size_t            size;
+
+    /**
+     * Number of bytes consumed by the application. Advanced only by
+     * @ref ucp_stream_ring_release.
+     */
+    volatile uint64_t head;
+
+    /**
+     * Number of bytes written by UCP. Advanced when stream data is received.
+     */
+    volatile uint64_t tail;
+} ucp_stream_ring_t;
+
+
 /**
  * @ingroup UCP_MEM
  * @brief Tuning parameters for the UCP memory mapping.
@@ -1901,6 +2071,14 @@ typedef struct ucp_am_handler_param {
      * @ref ucp_am_recv_callback_t function as the @a arg argument.
      */
     void                     *arg;
+
+    /**
+     * Active Message batch callback, used instead of
+     * @ref ucp_am_handler_param_t.cb when @ref UCP_AM_FLAG_BATCH is set in
+     * @ref ucp_am_handler_param_t.flags. It is passed the
+     * @ref ucp_am_handler_param_t.arg argument.
+     */
+    ucp_am_recv_batch_callback_t batch_cb;
 } ucp_am_handler_param_t;
 
 
@@ -1923,6 +2101,49 @@ struct ucp_am_recv_param {
 };
 
 
+/**
+ * @ingroup UCP_WORKER
+ * @brief Active Message provided in @ref ucp_am_recv_batch_callback_t
+ *        callback.
+ */
+struct ucp_am_recv_msg {
+    /**
+     * User defined active message header. Valid only during the callback.
+     */
+    const void          *header;
+
+    /**
+     * Active message header length in bytes.
+     */
+    size_t              header_length;
+
+    /**
+     * Received data, or data descriptor, as the @a data argument of
+     * @ref ucp_am_recv_callback_t.
+     */
+    void                *data;
+
+    /**
+     * Length of data, as the @a length argument of
+     * @ref ucp_am_recv_callback_t.
+     */
+    size_t              length;
+
+    /**
+     * Data receive parameters.
+     */
+    ucp_am_recv_param_t param;
+
+    /**
+     * Initialized to UCS_OK. The callback may set it to any value which
+     * @ref ucp_am_recv_callback_t may return for this message, for example
+     * UCS_INPROGRESS to keep the data until @ref ucp_am_data_release is
+     * called.
+     */
+    ucs_status_t        status;
+};
+
+
 /**
  * @ingroup UCP_CONTEXT
  * @brief Get attributes of the UCP library.
@@ -2386,6 +2607,10 @@ ucs_status_t ucp_worker_get_efd(ucp_worker_h worker, int *fd);
  * notification and may not progress some of the requests as it would when
  * calling @ref ucp_worker_progress (which is not invoked in that duration).
  *
+ * @note If busy polling is enabled by the UCX_WAKEUP_BUSY_POLL configuration
+ * variable, this routine first calls @ref ucp_worker_progress for a limited
+ * time, and returns without blocking if it has progressed some events.
+ *
  * @note UCP @ref ucp_feature "features" have to be triggered
  *   with @ref UCP_FEATURE_WAKEUP to select proper transport
  *
@@ -3517,6 +3742,51 @@ ucs_status_ptr_t ucp_stream_recv_nbx(ucp_ep_h ep, void *buffer, size_t count,
 ucs_status_ptr_t ucp_stream_recv_data_nb(ucp_ep_h ep, size_t *length);
 
 
+/**
+ * @ingroup UCP_COMM
+ * @brief Receive the stream data of an endpoint into a ring buffer.
+ *
+ * This routine sets a ring buffer to which the stream data received on
+ * endpoint @a ep is written directly, from the transport receive buffers,
+ * without allocating a UCP descriptor per message. The @a head and @a tail of
+ * the ring are reset to 0, and data which was received before and not consumed
+ * yet is written to the ring first. When the ring is full, incoming data is
+ * kept by UCP and written to the ring when the application releases space by
+ * @ref ucp_stream_ring_release. The endpoint is reported by
+ * @ref ucp_stream_worker_poll when data is written to the ring.
+ *
+ * While a ring is set, @ref ucp_stream_recv_nbx and
+ * @ref ucp_stream_recv_data_nb return UCS_ERR_UNSUPPORTED for the endpoint.
+ *
+ * @param [in]  ep    Endpoint to receive the stream data from.
+ * @param [in]  ring  Ring to write the data to, or NULL to stop writing to the
+ *                    previously set ring.
+ *
+ * @return UCS_OK                - The ring is set.
+ * @return UCS_ERR_BUSY          - There are stream receive requests in progress
+ *                                 on the endpoint.
+ * @return UCS_ERR_INVALID_PARAM - The buffer or the size of the ring is invalid.
+ */
+ucs_status_t ucp_stream_ring_set(ucp_ep_h ep, ucp_stream_ring_t *ring);
+
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Release consumed data of a stream ring buffer.
+ *
+ * This routine advances the @a head of the ring set on endpoint @a ep by
+ * @a length bytes, after the application consumed them, and writes the data
+ * which did not fit in the ring to the released space.
+ *
+ * @param [in]  ep      Endpoint the ring is set on.
+ * @param [in]  length  Number of consumed bytes, not larger than
+ *                      (@a tail - @a head).
+ *
+ * @return Error code as defined by @ref ucs_status_t
+ */
+ucs_status_t ucp_stream_ring_release(ucp_ep_h ep, size_t length);
+
+
 /**
  * @ingroup UCP_COMM
  * @brief Non-blocking tagged-receive operation.
@@ -3973,6 +4243,28 @@ ucs_status_t ucp_dt_create_generic(const ucp_generic_dt_ops_t *ops, void *contex
                                    ucp_datatype_t *datatype_p);
 
 
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Create a strided datatype.
+ *
+ * This routine creates a strided datatype object, which describes blocks of
+ * contiguous data arranged in one or more nested dimensions, as defined by
+ * @ref ucp_dt_strided_params_t. Unlike generic datatypes, strided datatypes
+ * are packed and unpacked by UCP directly, without calling back to the
+ * application. The data must reside in host memory.
+ * The application is responsible for releasing the @a datatype_p object using
+ * @ref ucp_dt_destroy "ucp_dt_destroy()" routine.
+ *
+ * @param [in]  params       Strided datatype parameters as defined by
+ *                           @ref ucp_dt_strided_params_t.
+ * @param [out] datatype_p   A pointer to datatype object.
+ *
+ * @return Error code as defined by @ref ucs_status_t
+ */
+ucs_status_t ucp_dt_create_strided(const ucp_dt_strided_params_t *params,
+                                   ucp_datatype_t *datatype_p);
+
+
 /**
  * @ingroup UCP_DATATYPE
  * @brief Destroy a datatype and release its resources.
@@ -3980,7 +4272,8 @@ ucs_status_t ucp_dt_create_generic(const ucp_generic_dt_ops_t *ops, void *contex
  * This routine destroys the @a datatype object and
  * releases any resources that are associated with the object.
  * The @a datatype object must be allocated using @ref ucp_dt_create_generic
- * "ucp_dt_create_generic()" routine.
+ * "ucp_dt_create_generic()" or @ref ucp_dt_create_strided
+ * "ucp_dt_create_strided()" routine.
  *
  * @warning
  * @li Once the @a datatype object is released an access to this object may
@@ -37,6 +37,13 @@ typedef struct ucp_tag_recv_info             ucp_tag_recv_info_t;
 typedef struct ucp_am_recv_param             ucp_am_recv_param_t;
 
 
+/**
+ * @ingroup UCP_WORKER
+ * @brief Active Message provided in @ref ucp_am_recv_batch_callback_t callback.
+ */
+typedef struct ucp_am_recv_msg               ucp_am_recv_msg_t;
+
+
 /**
  * @ingroup UCP_CONTEXT
  * @brief UCP Application Context
@@ -673,6 +680,30 @@ typedef ucs_status_t (*ucp_am_recv_callback_t)(void *arg, const void *header,
                                                const ucp_am_recv_param_t *param);
 
 
+/**
+ * @ingroup UCP_WORKER
+ * @brief Callback to process a batch of incoming Active Messages.
+ *
+ * When the callback is registered with @ref UCP_AM_FLAG_BATCH flag, it is
+ * called instead of @ref ucp_am_recv_callback_t with an array of messages,
+ * which were received during one call to @ref ucp_worker_progress. The
+ * callback has the same restrictions as @ref ucp_am_recv_callback_t. The data
+ * of single fragment eager messages is always delivered with
+ * UCP_AM_RECV_ATTR_FLAG_DATA flag.
+ *
+ * @param [in]    arg    User-defined argument.
+ * @param [inout] msgs   Received messages. The callback sets the
+ *                       @ref ucp_am_recv_msg_t.status of each message instead
+ *                       of returning it.
+ * @param [in]    count  Number of messages in @a msgs.
+ *
+ * @note This callback should be set and released
+ *       by @ref ucp_worker_set_am_recv_handler function.
+ */
+typedef void (*ucp_am_recv_batch_callback_t)(void *arg, ucp_am_recv_msg_t *msgs,
+                                             size_t count);
+
+
 /**
  * @ingroup UCP_ENDPOINT
  * @brief Tuning parameters for the UCP endpoint.
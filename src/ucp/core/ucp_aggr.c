@@ -0,0 +1,355 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ucp_aggr.h"
+
+#include <ucp/core/ucp_ep.inl>
+#include <ucp/core/ucp_request.inl>
+#include <ucp/core/ucp_worker.h>
+#include <ucp/dt/dt_contig.h>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/time/time.h>
+#include <string.h>
+
+
+static size_t ucp_ep_aggr_pack(void *dest, void *arg)
+{
+    const struct iovec *iov = arg;
+
+    memcpy(dest, iov->iov_base, iov->iov_len);
+    return iov->iov_len;
+}
+
+/* Length of the whole messages starting at offset which fit in max_length */
+static size_t ucp_ep_aggr_chunk_length(const void *buffer, size_t offset,
+                                       size_t length, size_t max_length)
+{
+    size_t chunk_length = 0;
+    const ucp_aggr_hdr_t *hdr;
+    size_t msg_length;
+
+    while ((offset + chunk_length) < length) {
+        hdr        = UCS_PTR_BYTE_OFFSET(buffer, offset + chunk_length);
+        msg_length = sizeof(*hdr) + hdr->length;
+        if ((chunk_length + msg_length) > max_length) {
+            break;
+        }
+
+        chunk_length += msg_length;
+    }
+
+    return chunk_length;
+}
+
+/*
+ * Send the aggregated messages from *offset_p, in as many active messages as
+ * needed by the current maximal bcopy size of the lane.
+ */
+static ucs_status_t
+ucp_ep_aggr_send(ucp_ep_h ep, const void *buffer, size_t *offset_p,
+                 size_t length)
+{
+    size_t max_bcopy = ucp_ep_get_max_bcopy(ep, ep->am_lane);
+    struct iovec iov;
+    ssize_t packed_len;
+
+    while (*offset_p < length) {
+        iov.iov_base = UCS_PTR_BYTE_OFFSET(buffer, *offset_p);
+        iov.iov_len  = ucp_ep_aggr_chunk_length(buffer, *offset_p, length,
+                                                max_bcopy);
+        if (iov.iov_len == 0) {
+            return UCS_ERR_EXCEEDS_LIMIT;
+        }
+
+        packed_len = uct_ep_am_bcopy(ucp_ep_get_am_uct_ep(ep),
+                                     UCP_AM_ID_AGGREGATE, ucp_ep_aggr_pack,
+                                     &iov, 0);
+        if (packed_len < 0) {
+            return (ucs_status_t)packed_len;
+        }
+
+        *offset_p += iov.iov_len;
+    }
+
+    return UCS_OK;
+}
+
+ucs_status_t ucp_ep_aggr_progress(uct_pending_req_t *self)
+{
+    ucp_request_t *req = ucs_container_of(self, ucp_request_t, send.uct);
+    ucp_ep_h ep        = req->send.ep;
+    ucs_status_t status;
+
+    req->send.lane = ep->am_lane;
+    status         = ucp_ep_aggr_send(ep, req->send.buffer,
+                                      &req->send.state.dt.offset,
+                                      req->send.length);
+    if (status == UCS_ERR_NO_RESOURCE) {
+        return status;
+    } else if (status != UCS_OK) {
+        ucs_diag("ep %p: failed to send aggregated messages: %s", ep,
+                 ucs_status_string(status));
+        ucp_ep_set_failed_schedule(ep, req->send.lane, status);
+    }
+
+    ucs_free(req->send.buffer);
+    ucp_request_mem_free(req);
+    return UCS_OK;
+}
+
+void ucp_ep_aggr_flush(ucp_ep_h ep)
+{
+    ucp_ep_aggr_t *aggr = ep->ext->aggr;
+    size_t offset       = 0;
+    ucp_request_t *req;
+    ucs_status_t status;
+
+    if ((aggr == NULL) || (aggr->length == 0)) {
+        return;
+    }
+
+    ucs_list_del(&aggr->list);
+
+    if (ep->flags & UCP_EP_FLAG_FAILED) {
+        ucs_debug("ep %p: dropping %zu bytes of aggregated messages", ep,
+                  aggr->length);
+        aggr->length = 0;
+        return;
+    }
+
+    status = ucp_ep_aggr_send(ep, aggr->buffer, &offset, aggr->length);
+    if (ucs_likely(status == UCS_OK)) {
+        aggr->length = 0;
+        return;
+    } else if (status != UCS_ERR_NO_RESOURCE) {
+        goto err;
+    }
+
+    /* Pass the rest of the buffer to a request, and allocate a new buffer for
+     * the next messages */
+    req = ucp_request_mem_alloc("ucp_ep_aggr_req");
+    if (req == NULL) {
+        status = UCS_ERR_NO_MEMORY;
+        goto err;
+    }
+
+    req->flags         = 0;
+    req->send.ep       = ep;
+    req->send.uct.func = ucp_ep_aggr_progress;
+    req->send.datatype = ucp_dt_make_contig(1);
+    ucp_request_send_state_init(req, ucp_dt_make_contig(1), 0);
+    req->send.buffer          = aggr->buffer;
+    req->send.length          = aggr->length;
+    req->send.state.dt.offset = offset;
+
+    aggr->buffer = NULL;
+    aggr->length = 0;
+
+    ucp_request_send(req);
+    /* coverity[leaked_storage] */
+    return;
+
+err:
+    ucs_diag("ep %p: failed to send aggregated messages: %s", ep,
+             ucs_status_string(status));
+    ucp_ep_set_failed_schedule(ep, ep->am_lane, status);
+    aggr->length = 0;
+}
+
+static ucp_ep_aggr_t *ucp_ep_aggr_get(ucp_ep_h ep)
+{
+    ucp_ep_aggr_t *aggr = ep->ext->aggr;
+
+    if (ucs_unlikely(aggr == NULL)) {
+        aggr = ucs_malloc(sizeof(*aggr), "ucp_ep_aggr");
+        if (aggr == NULL) {
+            return NULL;
+        }
+
+        aggr->ep      = ep;
+        aggr->length  = 0;
+        aggr->buffer  = NULL;
+        ep->ext->aggr = aggr;
+    }
+
+    if (ucs_unlikely(aggr->buffer == NULL)) {
+        aggr->buffer = ucs_malloc(ep->worker->context->config.ext.aggr_max_size,
+                                  "ucp_ep_aggr_buffer");
+        if (aggr->buffer == NULL) {
+            return NULL;
+        }
+    }
+
+    return aggr;
+}
+
+ucs_status_t ucp_ep_aggr_add(ucp_ep_h ep, uint8_t am_id, const void *hdr,
+                             size_t hdr_length, const void *buffer,
+                             size_t count, const void *trailer,
+                             size_t trailer_length,
+                             const ucp_request_param_t *param)
+{
+    ucp_worker_h worker     = ep->worker;
+    ucp_context_h context   = worker->context;
+    ucp_datatype_t datatype = ucp_request_param_datatype(param);
+    ucp_aggr_hdr_t *msg_hdr;
+    ucp_ep_aggr_t *aggr;
+    size_t length, max_length;
+    void *ptr;
+
+    if ((param->op_attr_mask & (UCP_OP_ATTR_FLAG_NO_AGGREGATE |
+                                UCP_OP_ATTR_FLAG_NO_IMM_CMPL)) ||
+        !UCP_DT_IS_CONTIG(datatype) ||
+        (ep->flags & UCP_EP_FLAG_FAILED) || (ep->am_lane == UCP_NULL_LANE)) {
+        goto not_aggregated;
+    }
+
+    length = ucp_contig_dt_length(datatype, count);
+    if (((hdr_length + length + trailer_length) >
+         context->config.ext.aggr_max_msg) ||
+        (ucp_request_get_memory_type(context, buffer, count, datatype, length,
+                                     param) != UCS_MEMORY_TYPE_HOST)) {
+        goto not_aggregated;
+    }
+
+    max_length = ucs_min(context->config.ext.aggr_max_size,
+                         ucp_ep_get_max_bcopy(ep, ep->am_lane));
+    if ((sizeof(*msg_hdr) + hdr_length + length + trailer_length) >
+        max_length) {
+        goto not_aggregated;
+    }
+
+    aggr = ep->ext->aggr;
+    if ((aggr != NULL) &&
+        ((aggr->length + sizeof(*msg_hdr) + hdr_length + length +
+          trailer_length) > max_length)) {
+        ucp_ep_aggr_flush(ep);
+    }
+
+    aggr = ucp_ep_aggr_get(ep);
+    if (aggr == NULL) {
+        goto not_aggregated;
+    }
+
+    if (aggr->length == 0) {
+        aggr->start_time = ucs_get_time();
+        ucs_list_add_tail(&worker->aggr_eps, &aggr->list);
+    }
+
+    msg_hdr         = UCS_PTR_BYTE_OFFSET(aggr->buffer, aggr->length);
+    msg_hdr->am_id  = am_id;
+    msg_hdr->length = hdr_length + length + trailer_length;
+
+    ptr = msg_hdr + 1;
+    memcpy(ptr, hdr, hdr_length);
+    ptr = UCS_PTR_BYTE_OFFSET(ptr, hdr_length);
+    if (length > 0) {
+        memcpy(ptr, buffer, length);
+        ptr = UCS_PTR_BYTE_OFFSET(ptr, length);
+    }
+    if (trailer_length > 0) {
+        memcpy(ptr, trailer, trailer_length);
+    }
+
+    aggr->length += sizeof(*msg_hdr) + msg_hdr->length;
+    return UCS_OK;
+
+not_aggregated:
+    ucp_ep_aggr_flush_pending(ep);
+    return UCS_ERR_UNSUPPORTED;
+}
+
+void ucp_ep_aggr_cleanup(ucp_ep_h ep)
+{
+    ucp_ep_aggr_t *aggr = ep->ext->aggr;
+
+    if (aggr == NULL) {
+        return;
+    }
+
+    if (aggr->length > 0) {
+        ucs_debug("ep %p: dropping %zu bytes of aggregated messages", ep,
+                  aggr->length);
+        ucs_list_del(&aggr->list);
+    }
+
+    ucs_free(aggr->buffer);
+    ucs_free(aggr);
+    ep->ext->aggr = NULL;
+}
+
+void ucp_worker_aggr_progress(ucp_worker_h worker)
+{
+    ucs_time_t timeout = worker->context->config.ext.aggr_timeout;
+    ucs_time_t now     = ucs_get_time();
+    ucp_ep_aggr_t *aggr, *tmp;
+
+    /* The endpoints are ordered by the time of their first message */
+    ucs_list_for_each_safe(aggr, tmp, &worker->aggr_eps, list) {
+        if ((now - aggr->start_time) < timeout) {
+            break;
+        }
+
+        ucp_ep_aggr_flush(aggr->ep);
+    }
+}
+
+void ucp_worker_aggr_flush(ucp_worker_h worker)
+{
+    ucp_ep_aggr_t *aggr, *tmp;
+
+    ucs_list_for_each_safe(aggr, tmp, &worker->aggr_eps, list) {
+        ucp_ep_aggr_flush(aggr->ep);
+    }
+}
+
+static ucs_status_t
+ucp_aggr_handler(void *arg, void *data, size_t length, unsigned am_flags)
+{
+    ucp_worker_h worker = arg;
+    size_t remaining    = length;
+    ucp_aggr_hdr_t *hdr;
+    ucs_status_t UCS_V_UNUSED status;
+
+    /* The data of the aggregated messages is not kept after they are handled,
+     * so their handlers are called without UCT_CB_PARAM_FLAG_DESC */
+    while (remaining > 0) {
+        hdr = data;
+        if (ucs_unlikely((remaining < sizeof(*hdr)) ||
+                         (hdr->length > (remaining - sizeof(*hdr))))) {
+            ucs_error("worker %p: truncated aggregated message at offset %zu"
+                      " of %zu, dropping the rest", worker,
+                      length - remaining, length);
+            break;
+        }
+
+        if (ucs_unlikely((hdr->am_id < UCP_AM_ID_FIRST) ||
+                         (hdr->am_id >= UCP_AM_ID_LAST) ||
+                         (hdr->am_id == UCP_AM_ID_AGGREGATE) ||
+                         (ucp_am_handlers[hdr->am_id] == NULL))) {
+            ucs_error("worker %p: invalid aggregated message id %u, dropping"
+                      " it", worker, hdr->am_id);
+        } else {
+            status = ucp_am_handlers[hdr->am_id]->cb(worker, hdr + 1,
+                                                     hdr->length, 0);
+            ucs_assertv(status == UCS_OK, "status=%s",
+                        ucs_status_string(status));
+        }
+
+        data       = UCS_PTR_BYTE_OFFSET(hdr + 1, hdr->length);
+        remaining -= sizeof(*hdr) + hdr->length;
+    }
+
+    return UCS_OK;
+}
+
+UCP_DEFINE_AM_WITH_PROXY(UCP_FEATURE_AM | UCP_FEATURE_TAG, UCP_AM_ID_AGGREGATE,
+                         ucp_aggr_handler, NULL, 0);
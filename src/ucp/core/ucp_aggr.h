@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_AGGR_H_
+#define UCP_AGGR_H_
+
+#include <ucp/core/ucp_ep.h>
+#include <ucs/datastruct/list.h>
+#include <ucs/sys/compiler_def.h>
+#include <ucs/time/time_def.h>
+
+
+/**
+ * Header of a message in an aggregated active message. The message data, as it
+ * would be sent in a separate active message, follows the header.
+ */
+typedef struct {
+    uint8_t  am_id;  /* Active message id of the message */
+    uint32_t length; /* Length of the message data */
+} UCS_S_PACKED ucp_aggr_hdr_t;
+
+
+/**
+ * Messages aggregated on an endpoint created with UCP_EP_PARAMS_FLAGS_AGGREGATE
+ * and not sent yet.
+ */
+struct ucp_ep_aggr {
+    ucs_list_link_t list;       /* Entry in worker->aggr_eps, if length > 0 */
+    ucp_ep_h        ep;         /* Endpoint the messages are sent on */
+    ucs_time_t      start_time; /* Time the first message was aggregated */
+    size_t          length;     /* Total length of the aggregated messages */
+    void            *buffer;    /* Buffer of UCX_AGGREGATE_MAX_SIZE bytes,
+                                   allocated on demand */
+};
+
+
+ucs_status_t ucp_ep_aggr_add(ucp_ep_h ep, uint8_t am_id, const void *hdr,
+                             size_t hdr_length, const void *buffer,
+                             size_t count, const void *trailer,
+                             size_t trailer_length,
+                             const ucp_request_param_t *param);
+
+
+void ucp_ep_aggr_flush(ucp_ep_h ep);
+
+
+void ucp_ep_aggr_cleanup(ucp_ep_h ep);
+
+
+ucs_status_t ucp_ep_aggr_progress(uct_pending_req_t *self);
+
+
+void ucp_worker_aggr_progress(ucp_worker_h worker);
+
+
+void ucp_worker_aggr_flush(ucp_worker_h worker);
+
+
+/**
+ * Send the messages aggregated on the endpoint, if any. Must be called before
+ * sending a message which could overtake them.
+ */
+static UCS_F_ALWAYS_INLINE void ucp_ep_aggr_flush_pending(ucp_ep_h ep)
+{
+    if (ucs_unlikely((ep->flags & UCP_EP_FLAG_AGGREGATE) &&
+                     (ep->ext->aggr != NULL) &&
+                     (ep->ext->aggr->length > 0))) {
+        ucp_ep_aggr_flush(ep);
+    }
+}
+
+#endif
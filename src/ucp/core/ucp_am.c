@@ -11,6 +11,7 @@
 #endif
 
 #include "ucp_am.h"
+#include "ucp_aggr.h"
 #include <ucp/am/ucp_am.inl>
 
 #include <ucp/core/ucp_ep.h>
@@ -31,15 +32,29 @@ ucs_status_t ucp_am_init(ucp_worker_h worker)
     }
 
     ucs_array_init_dynamic(&worker->am.cbs);
+    ucs_array_init_dynamic(&worker->am.batch_msgs);
+    ucs_array_init_dynamic(&worker->am.batch_ids);
     return UCS_OK;
 }
 
 void ucp_am_cleanup(ucp_worker_h worker)
 {
+    ucp_am_recv_msg_t *msg;
+
     if (!(worker->context->config.features & UCP_FEATURE_AM)) {
         return;
     }
 
+    if (!ucs_array_is_empty(&worker->am.batch_msgs)) {
+        ucs_debug("worker %p: dropping %u undelivered batched active messages",
+                  worker, ucs_array_length(&worker->am.batch_msgs));
+        ucs_array_for_each(msg, &worker->am.batch_msgs) {
+            ucp_recv_desc_release((ucp_recv_desc_t*)msg->data - 1);
+        }
+    }
+
+    ucs_array_cleanup_dynamic(&worker->am.batch_ids);
+    ucs_array_cleanup_dynamic(&worker->am.batch_msgs);
     ucs_array_cleanup_dynamic(&worker->am.cbs);
 }
 
@@ -85,27 +100,6 @@ void ucp_am_ep_cleanup(ucp_ep_h ep)
                    " dropped on ep %p", ep->worker, count, ep);
 }
 
-static void ucp_am_rndv_send_ats(ucp_worker_h worker, ucp_rndv_rts_hdr_t *rts,
-                                 ucs_status_t status)
-{
-    ucp_request_t *req;
-    ucp_ep_h ep;
-
-    UCP_WORKER_GET_EP_BY_ID(&ep, worker, rts->sreq.ep_id, return,
-                            "AM RNDV ATS");
-    req = ucp_request_get(worker);
-    if (ucs_unlikely(req == NULL)) {
-        ucs_error("failed to allocate request for AM RNDV ATS");
-        return;
-    }
-
-    req->send.ep = ep;
-    req->flags   = 0;
-
-    ucp_rndv_req_send_ack(req, rts->size, rts->sreq.req_id, status,
-                          UCP_AM_ID_RNDV_ATS, "send_ats");
-}
-
 static UCS_F_ALWAYS_INLINE void ucp_am_release_long_desc(ucp_recv_desc_t *desc)
 {
     /* Don't use UCS_PTR_BYTE_OFFSET here due to coverity false positive report.
@@ -136,6 +130,39 @@ ucp_am_rdesc_in_progress(ucp_recv_desc_t *desc, ucs_status_t am_cb_status)
     return 1;
 }
 
+void ucp_am_batch_dispatch(ucp_worker_h worker)
+{
+    ucp_am_recv_msg_t *msgs = ucs_array_begin(&worker->am.batch_msgs);
+    uint16_t *ids           = ucs_array_begin(&worker->am.batch_ids);
+    unsigned count          = ucs_array_length(&worker->am.batch_msgs);
+    ucp_am_entry_t *am_cb;
+    ucp_recv_desc_t *desc;
+    unsigned first, i;
+
+    /* Deliver each run of consecutive messages with the same id in one call */
+    for (first = 0, i = 1; i <= count; ++i) {
+        if ((i < count) && (ids[i] == ids[first])) {
+            continue;
+        }
+
+        am_cb = &ucs_array_elem(&worker->am.cbs, ids[first]);
+        am_cb->batch_cb(am_cb->context, &msgs[first], i - first);
+        first = i;
+    }
+
+    for (i = 0; i < count; ++i) {
+        desc = (ucp_recv_desc_t*)msgs[i].data - 1;
+        if (ucp_am_rdesc_in_progress(desc, msgs[i].status)) {
+            desc->flags &= ~UCP_RECV_DESC_FLAG_AM_CB_INPROGRESS;
+        } else {
+            ucp_recv_desc_release(desc);
+        }
+    }
+
+    ucs_array_clear(&worker->am.batch_msgs);
+    ucs_array_clear(&worker->am.batch_ids);
+}
+
 UCS_PROFILE_FUNC_VOID(ucp_am_data_release, (worker, data),
                       ucp_worker_h worker, void *data)
 {
@@ -156,7 +183,7 @@ UCS_PROFILE_FUNC_VOID(ucp_am_data_release, (worker, data),
 
         /* This data is not needed (rndv receive was not initiated), send ATS
          * back to the sender to complete its send request. */
-        ucp_am_rndv_send_ats(worker, data, UCS_OK);
+        ucp_rndv_rts_send_ats(worker, data, UCS_OK);
     }
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
@@ -201,6 +228,11 @@ static ucs_status_t ucp_worker_set_am_handler_common(ucp_worker_h worker,
         return UCS_ERR_INVALID_PARAM;
     }
 
+    /* Messages for the previous handler are delivered to it */
+    if (!ucs_array_is_empty(&worker->am.batch_msgs)) {
+        ucp_am_batch_dispatch(worker);
+    }
+
     /* User handlers may be registered in any order, we need to resize the
      * lookup array only when new ID is equal or above the current length */
     if (id >= ucs_array_length(&worker->am.cbs)) {
@@ -216,6 +248,12 @@ ucs_status_t ucp_worker_set_am_handler(ucp_worker_h worker, uint16_t id,
 {
     ucs_status_t status;
 
+    if (flags & UCP_AM_FLAG_BATCH) {
+        ucs_error("batch AM handlers must be registered with "
+                  "ucp_worker_set_am_recv_handler()");
+        return UCS_ERR_INVALID_PARAM;
+    }
+
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
 
     status = ucp_worker_set_am_handler_common(worker, id, flags);
@@ -327,8 +365,11 @@ ucs_status_t ucp_worker_set_am_recv_handler(ucp_worker_h worker,
     uint16_t id;
     unsigned flags;
 
-    if (!ucs_test_all_flags(param->field_mask, UCP_AM_HANDLER_PARAM_FIELD_ID |
-                                               UCP_AM_HANDLER_PARAM_FIELD_CB)) {
+    flags = UCP_PARAM_VALUE(AM_HANDLER, param, flags, FLAGS, 0);
+    if (!(param->field_mask & UCP_AM_HANDLER_PARAM_FIELD_ID) ||
+        !(param->field_mask & ((flags & UCP_AM_FLAG_BATCH) ?
+                               UCP_AM_HANDLER_PARAM_FIELD_BATCH_CB :
+                               UCP_AM_HANDLER_PARAM_FIELD_CB))) {
         return UCS_ERR_INVALID_PARAM;
     }
 
@@ -337,8 +378,7 @@ ucs_status_t ucp_worker_set_am_recv_handler(ucp_worker_h worker,
         return status;
     }
 
-    id    = param->id;
-    flags = UCP_PARAM_VALUE(AM_HANDLER, param, flags, FLAGS, 0);
+    id = param->id;
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
 
@@ -350,8 +390,11 @@ ucs_status_t ucp_worker_set_am_recv_handler(ucp_worker_h worker,
     /* cb should always be set (can be NULL) */
     ucp_worker_am_init_handler(worker, id,
                                UCP_PARAM_VALUE(AM_HANDLER, param, arg, ARG, NULL),
-                               flags | UCP_AM_CB_PRIV_FLAG_NBX,
-                               NULL, param->cb);
+                               flags | UCP_AM_CB_PRIV_FLAG_NBX, NULL,
+                               (flags & UCP_AM_FLAG_BATCH) ? NULL : param->cb);
+    if (flags & UCP_AM_FLAG_BATCH) {
+        ucs_array_elem(&worker->am.cbs, id).batch_cb = param->batch_cb;
+    }
 
 out:
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
@@ -890,6 +933,24 @@ ucp_am_try_send_short(ucp_ep_h ep, uint16_t id, uint32_t flags,
     return UCS_ERR_NO_RESOURCE;
 }
 
+static ucs_status_t
+ucp_am_send_aggr(ucp_ep_h ep, uint16_t id, uint32_t flags, const void *header,
+                 size_t header_length, const void *buffer, size_t count,
+                 const ucp_request_param_t *param)
+{
+    ucp_am_hdr_t am_hdr;
+
+    if (flags & (UCP_AM_SEND_FLAG_REPLY | UCP_AM_SEND_FLAG_RNDV)) {
+        ucp_ep_aggr_flush_pending(ep);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    /* Same layout as a single fragment message */
+    ucp_am_fill_short_header(&am_hdr, id, flags, header_length);
+    return ucp_ep_aggr_add(ep, UCP_AM_ID_AM_SINGLE, &am_hdr, sizeof(am_hdr),
+                           buffer, count, header, header_length, param);
+}
+
 static UCS_F_ALWAYS_INLINE uint8_t ucp_am_send_nbx_get_op_flag(uint32_t flags)
 {
     if (flags & UCP_AM_SEND_FLAG_EAGER) {
@@ -991,6 +1052,15 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
         goto out;
     }
 
+    if (ucs_unlikely(ep->flags & UCP_EP_FLAG_AGGREGATE)) {
+        status = ucp_am_send_aggr(ep, id, flags, header, header_length, buffer,
+                                  count, param);
+        if (status == UCS_OK) {
+            ret = UCS_STATUS_PTR(UCS_OK);
+            goto out;
+        }
+    }
+
     if (ucs_likely(attr_mask == 0)) {
         status = ucp_am_try_send_short(ep, id, flags, header, header_length,
                                        buffer, count, max_short, param);
@@ -1155,7 +1225,7 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_recv_data_nbx,
 
     if (desc->flags & UCP_RECV_DESC_FLAG_RNDV) {
         /* Nothing to receive, send ack to sender to complete its request */
-        ucp_am_rndv_send_ats(worker, data_desc, UCS_OK);
+        ucp_rndv_rts_send_ats(worker, data_desc, UCS_OK);
         recv_length = 0ul;
         status      = UCS_OK;
     } else {
@@ -1202,6 +1272,106 @@ out:
     return ret;
 }
 
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_am_invoke_nbx_cb(ucp_worker_h worker, ucp_am_entry_t *am_cb,
+                     const void *user_hdr, size_t user_hdr_length, void *data,
+                     size_t data_length, const ucp_am_recv_param_t *param)
+{
+    ucp_am_recv_msg_t msg;
+
+    if (ucs_likely(!(am_cb->flags & UCP_AM_FLAG_BATCH))) {
+        return am_cb->cb(am_cb->context, user_hdr, user_hdr_length, data,
+                         data_length, param);
+    }
+
+    /* Deliver the messages which arrived before this one first */
+    if (!ucs_array_is_empty(&worker->am.batch_msgs)) {
+        ucp_am_batch_dispatch(worker);
+    }
+
+    msg.header        = user_hdr;
+    msg.header_length = user_hdr_length;
+    msg.data          = data;
+    msg.length        = data_length;
+    msg.param         = *param;
+    msg.status        = UCS_OK;
+    am_cb->batch_cb(am_cb->context, &msg, 1);
+
+    return msg.status;
+}
+
+static ucs_status_t
+ucp_am_batch_add(ucp_worker_h worker, uint16_t am_id, void *user_hdr,
+                 uint32_t user_hdr_length, void *data, size_t data_length,
+                 ucp_ep_h reply_ep, unsigned am_flags, uint64_t recv_flags,
+                 const char *name)
+{
+    ucp_am_entry_t *am_cb = &ucs_array_elem(&worker->am.cbs, am_id);
+    ucp_am_recv_param_t param;
+    ucp_am_recv_msg_t *msg;
+    ucp_recv_desc_t *desc;
+    ucs_status_t status;
+    uint16_t *id;
+
+    if (ucs_unlikely((uintptr_t)data % worker->am.alignment)) {
+        am_flags &= ~UCT_CB_PARAM_FLAG_DESC;
+    }
+
+    /* The data is used after the UCT callback returns, so it is always held
+     * in a descriptor. The user header follows the data in the message, and
+     * is copied together with it. */
+    status = ucp_recv_desc_init(worker, data, data_length + user_hdr_length,
+                                0, am_flags, 0,
+                                UCP_RECV_DESC_FLAG_AM_CB_INPROGRESS,
+                                -(int)sizeof(ucp_am_hdr_t),
+                                worker->am.alignment, name, &desc);
+    if (ucs_unlikely(UCS_STATUS_IS_ERR(status))) {
+        ucs_debug("worker %p could not allocate descriptor for active"
+                  " message on callback : %u, delivering it in place",
+                  worker, am_id);
+        goto err_deliver;
+    }
+
+    msg = ucs_array_append(&worker->am.batch_msgs, goto err_release);
+    id  = ucs_array_append(&worker->am.batch_ids,
+                           ucs_array_pop_back(&worker->am.batch_msgs);
+                           goto err_release);
+
+    desc->length         = data_length;
+    *id                  = am_id;
+    msg->data            = desc + 1;
+    msg->length          = data_length;
+    msg->header          = (user_hdr_length == 0) ? NULL :
+                           UCS_PTR_BYTE_OFFSET(msg->data, data_length);
+    msg->header_length   = user_hdr_length;
+    msg->param.recv_attr = recv_flags | UCP_AM_RECV_ATTR_FLAG_DATA;
+    msg->param.reply_ep  = reply_ep;
+    msg->status          = UCS_OK;
+
+    return status;
+
+err_release:
+    ucs_debug("worker %p could not queue active message on callback : %u,"
+              " delivering it in place", worker, am_id);
+    if (!(desc->flags & UCP_RECV_DESC_FLAG_UCT_DESC)) {
+        ucp_recv_desc_release(desc);
+    }
+err_deliver:
+    /* Do not drop the message: deliver it alone, after the queued ones, while
+     * the transport buffer is still valid. The data can not be held by the
+     * user in this case. */
+    param.recv_attr = recv_flags;
+    param.reply_ep  = reply_ep;
+    status          = ucp_am_invoke_nbx_cb(worker, am_cb, user_hdr,
+                                           user_hdr_length, data, data_length,
+                                           &param);
+    if (ucs_unlikely(status == UCS_INPROGRESS)) {
+        ucs_error("can't hold data, FLAG_DATA flag is not set");
+    }
+
+    return UCS_OK;
+}
+
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucp_am_invoke_cb(ucp_worker_h worker, uint16_t am_id, void *user_hdr,
                  uint32_t user_hdr_length, void *data, size_t data_length,
@@ -1219,8 +1389,8 @@ ucp_am_invoke_cb(ucp_worker_h worker, uint16_t am_id, void *user_hdr,
         param.recv_attr = recv_flags;
         param.reply_ep  = reply_ep;
 
-        return am_cb->cb(am_cb->context, user_hdr, user_hdr_length, data,
-                         data_length, &param);
+        return ucp_am_invoke_nbx_cb(worker, am_cb, user_hdr, user_hdr_length,
+                                    data, data_length, &param);
     }
 
     if (ucs_unlikely(user_hdr_length != 0)) {
@@ -1254,6 +1424,13 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_am_handler_common(
 
     ucs_assert(total_length >= am_hdr->header_length + sizeof(*am_hdr));
 
+    if (ucs_unlikely(am_cb->flags & UCP_AM_FLAG_BATCH) &&
+        ucp_am_recv_check_id(worker, am_id)) {
+        return ucp_am_batch_add(worker, am_id, user_hdr, user_hdr_size, data,
+                                data_length, reply_ep, am_flags, recv_flags,
+                                name);
+    }
+
     /* Initialize desc in advance, so the user could invoke ucp_am_recv_data_nbx
      * from the AM callback directly. The only exception is inline data when
      * AM callback is registered without UCP_AM_FLAG_PERSISTENT_DATA flag.
@@ -1673,8 +1850,9 @@ ucs_status_t ucp_am_rndv_process_rts(void *arg, void *data, size_t length,
     param.recv_attr = UCP_AM_RECV_ATTR_FLAG_RNDV |
                       ucp_am_hdr_reply_ep(worker, am->flags, ep,
                                           &param.reply_ep);
-    status          = am_cb->cb(am_cb->context, hdr, am->header_length,
-                                desc + 1, rts->size, &param);
+    status          = ucp_am_invoke_nbx_cb(worker, am_cb, hdr,
+                                           am->header_length, desc + 1,
+                                           rts->size, &param);
     if (ucp_am_rdesc_in_progress(desc, status)) {
         /* User either wants to save descriptor for later use or initiated
          * rendezvous receive (by ucp_am_recv_data_nbx) in the callback. */
@@ -1698,7 +1876,7 @@ ucs_status_t ucp_am_rndv_process_rts(void *arg, void *data, size_t length,
 out_send_ats:
     /* Some error occurred or user does not need this data. Send ATS back to the
      * sender to complete its send request. */
-    ucp_am_rndv_send_ats(worker, rts, status);
+    ucp_rndv_rts_send_ats(worker, rts, status);
 
 out:
     if (desc != NULL) {
@@ -40,6 +40,7 @@ typedef struct ucp_am_entry {
     union {
         ucp_am_callback_t      cb_old;   /* user defined callback, used by legacy API */
         ucp_am_recv_callback_t cb;       /* user defined callback */
+        ucp_am_recv_batch_callback_t batch_cb; /* user defined batch callback */
     };
     void                       *context;   /* user defined callback argument */
     unsigned                   flags;      /* flags affecting callback behavior
@@ -48,8 +49,11 @@ typedef struct ucp_am_entry {
 
 
 typedef struct ucp_am_info {
-    size_t                                alignment;
-    ucs_array_s(unsigned, ucp_am_entry_t) cbs;
+    size_t                                   alignment;
+    ucs_array_s(unsigned, ucp_am_entry_t)    cbs;
+    /* Messages for batch callbacks, received during the current progress */
+    ucs_array_s(unsigned, ucp_am_recv_msg_t) batch_msgs;
+    ucs_array_s(unsigned, uint16_t)          batch_ids;
 } ucp_am_info_t;
 
 
@@ -133,6 +137,8 @@ ucs_status_t ucp_am_init(ucp_worker_h worker);
 
 void ucp_am_cleanup(ucp_worker_h worker);
 
+void ucp_am_batch_dispatch(ucp_worker_h worker);
+
 void ucp_am_ep_init(ucp_ep_h ep);
 
 void ucp_am_ep_cleanup(ucp_ep_h ep);
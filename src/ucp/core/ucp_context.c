@@ -55,7 +55,8 @@
     _macro(UCP_AM_ID_AM_SINGLE) \
     _macro(UCP_AM_ID_AM_FIRST) \
     _macro(UCP_AM_ID_AM_MIDDLE) \
-    _macro(UCP_AM_ID_AM_SINGLE_REPLY)
+    _macro(UCP_AM_ID_AM_SINGLE_REPLY) \
+    _macro(UCP_AM_ID_AGGREGATE)
 
 #define UCP_AM_HANDLER_DECL(_id) extern ucp_am_handler_t ucp_am_handler_##_id;
 
@@ -154,6 +155,9 @@ const char *ucp_extra_op_attr_flags_names[] = {
 static UCS_CONFIG_DEFINE_ARRAY(memunit_sizes, sizeof(size_t),
                                UCS_CONFIG_TYPE_MEMUNITS);
 
+static UCS_CONFIG_DEFINE_ARRAY(cpu_ids, sizeof(unsigned),
+                               UCS_CONFIG_TYPE_UINT);
+
 static ucs_config_field_t ucp_context_config_table[] = {
   {"SELECT_DISTANCE_MD", "cuda_cpy",
    "MD whose distance is queried when evaluating transport selection score",
@@ -336,6 +340,32 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "selected automatically according to the performance characteristics.",
    ucs_offsetof(ucp_context_config_t, tm_sw_rndv), UCS_CONFIG_TYPE_TERNARY},
 
+  {"TM_MASK_CLASSES", "0",
+   "Maximal number of distinct wildcard tag masks for which expected receive\n"
+   "requests are indexed by the masked tag, instead of being kept in a single\n"
+   "wildcard queue. Speeds up matching when many wildcard receives (e.g. with\n"
+   "any source) are posted. Requests with other wildcard masks are kept in the\n"
+   "wildcard queue. The value is limited to a small internal maximum,\n"
+   "0 - disabled.",
+   ucs_offsetof(ucp_context_config_t, tm_mask_classes), UCS_CONFIG_TYPE_UINT},
+
+  {"UNEXP_SPILL_THRESH", "inf",
+   "Total length of unexpected tag messages above which newly arrived unexpected\n"
+   "messages are copied to the worker memory pool, releasing the transport\n"
+   "receive buffers they arrived in.",
+   ucs_offsetof(ucp_context_config_t, unexp_spill_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"UNEXP_MAX_SIZE", "inf",
+   "Maximal total length of unexpected tag messages, including the fragments\n"
+   "of unexpected multi-fragment messages, kept by a worker. A new unexpected\n"
+   "message which would exceed it is not stored: an eager message is dropped,\n"
+   "and a synchronous eager send or a rendezvous send is completed on the sender\n"
+   "with UCS_ERR_EXCEEDS_LIMIT. Messages received by hardware tag matching are\n"
+   "not limited. Fragments which arrive before the first fragment of their\n"
+   "message may exceed the limit.",
+   ucs_offsetof(ucp_context_config_t, unexp_max_size), UCS_CONFIG_TYPE_MEMUNITS},
+
   {"NUM_EPS", "auto",
    "An optimization hint of how many endpoints would be created on this context.\n"
    "Does not affect semantics, but only transport selection criteria and the\n"
@@ -429,6 +459,48 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "(inf - check all endpoints on every round, must be greater than 0)",
    ucs_offsetof(ucp_context_config_t, keepalive_num_eps), UCS_CONFIG_TYPE_UINT},
 
+  {"WAKEUP_BUSY_POLL", "0",
+   "Maximal time for ucp_worker_wait() to busy poll the worker before arming\n"
+   "it and blocking on its event file descriptor. The busy polling time is\n"
+   "adapted to the recent time between events: it is twice the average time\n"
+   "ucp_worker_wait() waited for an event, or 0 if the average is above the\n"
+   "maximal time. 0 - disabled.",
+   ucs_offsetof(ucp_context_config_t, wakeup_busy_poll),
+   UCS_CONFIG_TYPE_TIME_UNITS},
+
+  {"PROGRESS_THREAD_TLS", "",
+   "Comma-separated list of transports whose interfaces are progressed by\n"
+   "dedicated threads, for example \"tcp,posix\". The active messages, send\n"
+   "completions and errors received by these threads are dispatched by the\n"
+   "thread calling ucp_worker_progress(), so the worker thread mode is not\n"
+   "changed. Worker creation fails if such an interface does not support\n"
+   "synchronous callbacks or uses tag offload.",
+   ucs_offsetof(ucp_context_config_t, progress_thread_tls),
+   UCS_CONFIG_TYPE_STRING_ARRAY},
+
+  {"PROGRESS_THREAD_CPUS", "",
+   "Comma-separated list of CPUs to pin the interface progress threads to, in\n"
+   "the order of the interfaces. If there are more threads than CPUs, the list\n"
+   "is reused from its start. Empty list means the threads are not pinned.",
+   ucs_offsetof(ucp_context_config_t, progress_thread_cpus),
+   UCS_CONFIG_TYPE_ARRAY(cpu_ids)},
+
+  {"AGGREGATE_MAX_SIZE", "8k",
+   "Maximal size of the buffer in which the small messages sent on an endpoint\n"
+   "created with UCP_EP_PARAMS_FLAGS_AGGREGATE are aggregated. The buffer is\n"
+   "also limited by the maximal bcopy size of the active message lane.",
+   ucs_offsetof(ucp_context_config_t, aggr_max_size), UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"AGGREGATE_MAX_MSG", "256",
+   "Maximal size of a message, including the protocol headers, which can be\n"
+   "aggregated. Larger messages are sent directly.",
+   ucs_offsetof(ucp_context_config_t, aggr_max_msg), UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"AGGREGATE_TIMEOUT", "10us",
+   "Maximal time that aggregated messages are delayed before being sent. The\n"
+   "aggregated messages are also sent when the endpoint or the worker is flushed.",
+   ucs_offsetof(ucp_context_config_t, aggr_timeout), UCS_CONFIG_TYPE_TIME_UNITS},
+
   {"DYNAMIC_TL_SWITCH_INTERVAL", "inf",
    "Time interval between dynamic transport switching rounds. Must be\n"
    "non-zero value. use 'inf' to disable this feature.",
@@ -480,6 +552,14 @@ static ucs_config_field_t ucp_context_config_table[] = {
    ucs_offsetof(ucp_context_config_t, worker_addr_version),
    UCS_CONFIG_TYPE_ENUM(ucp_object_versions)},
 
+  {"ADDRESS_PROFILE", "n",
+   "Pack the device and iface attributes of the worker address as a node profile,\n"
+   "identified by its hash. Peers cache the profiles they unpack, so the\n"
+   "attributes of addresses of workers on the same type of node are unpacked\n"
+   "only once. Requires UCX_ADDRESS_VERSION=v2.",
+   ucs_offsetof(ucp_context_config_t, worker_addr_profile),
+   UCS_CONFIG_TYPE_BOOL},
+
   {"PROTO_INFO", "n",
    "Enable printing protocols information. The value is interpreted as follows:\n"
    " 'y'          : Print information for all protocols\n"
@@ -498,6 +578,59 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "directory.",
    ucs_offsetof(ucp_context_config_t, proto_info_dir), UCS_CONFIG_TYPE_STRING},
 
+  {"PROTO_CACHE_DIR", "",
+   "If non-empty, protocol selection results are saved to a cache file in this\n"
+   "directory, and processes with the same UCX version, transport resources\n"
+   "and UCX_ environment variables probe only the protocols selected before.",
+   ucs_offsetof(ucp_context_config_t, proto_cache_dir), UCS_CONFIG_TYPE_STRING},
+
+  {"PROTO_FEEDBACK", "n",
+   "Measure the completion time of send operations and update the protocol\n"
+   "selection thresholds when it diverges from the estimated performance.",
+   ucs_offsetof(ucp_context_config_t, proto_feedback), UCS_CONFIG_TYPE_BOOL},
+
+  {"PROTO_FEEDBACK_SAMPLES", "64",
+   "Number of completed operations of the same protocol and message size range\n"
+   "to collect before comparing them with the estimated performance.",
+   ucs_offsetof(ucp_context_config_t, proto_feedback_samples),
+   UCS_CONFIG_TYPE_UINT},
+
+  {"PROTO_FEEDBACK_TOLERANCE", "0.2",
+   "Relative difference between the measured and the previously used\n"
+   "performance which triggers an update of the protocol selection.",
+   ucs_offsetof(ucp_context_config_t, proto_feedback_tolerance),
+   UCS_CONFIG_TYPE_DOUBLE},
+
+  {"PROTO_FEEDBACK_MAX_UPDATES", "16",
+   "Maximal number of times the protocol selection of an operation type is\n"
+   "updated by measured performance.",
+   ucs_offsetof(ucp_context_config_t, proto_feedback_max_updates),
+   UCS_CONFIG_TYPE_UINT},
+
+  {"REQUEST_TRACE_SAMPLE", "0",
+   "Record the time a send request spends in each stage (protocol selection,\n"
+   "pending queue, first post, rendezvous reply and completion) for one of\n"
+   "every N requests, and report it per protocol in the worker statistics.\n"
+   "0 disables tracing. Requires UCX built with --enable-request-trace.",
+   ucs_offsetof(ucp_context_config_t, request_trace_sample),
+   UCS_CONFIG_TYPE_UINT},
+
+  {"REQUEST_TRACE_FILE", "",
+   "If non-empty, write the stage timestamps of every traced request to this\n"
+   "file, which can be read by ucx_trace_report. The following substitutions\n"
+   "are performed on this string:\n"
+   "  %p - Replaced with process ID\n"
+   "  %h - Replaced with host name\n"
+   "The records of all workers in the process are appended to the file.",
+   ucs_offsetof(ucp_context_config_t, request_trace_file),
+   UCS_CONFIG_TYPE_STRING},
+
+  {"REQUEST_TRACE_BUFFER_SIZE", "4096",
+   "Number of traced requests a worker keeps in memory. When the buffer is\n"
+   "full, its records are appended to UCX_REQUEST_TRACE_FILE.",
+   ucs_offsetof(ucp_context_config_t, request_trace_buffer_size),
+   UCS_CONFIG_TYPE_UINT},
+
   {"REG_NONBLOCK_MEM_TYPES", "",
    "Perform only non-blocking memory registration for these memory types.\n"
    "Non-blocking registration means that the page registration may be\n"
@@ -108,6 +108,14 @@ typedef struct ucp_context_config {
     size_t                                 tm_max_bb_size;
     /** Enabling SW rndv protocol with tag offload mode */
     ucs_ternary_auto_value_t               tm_sw_rndv;
+    /** Maximal number of wildcard tag masks indexed by the expected queue */
+    unsigned                               tm_mask_classes;
+    /** Length of unexpected tag messages above which they are copied to the
+     *  worker memory pool */
+    size_t                                 unexp_spill_thresh;
+    /** Length of unexpected tag messages above which transport receive
+     *  buffers are not released */
+    size_t                                 unexp_max_size;
     /** Pack debug information in worker address */
     int                                    address_debug_info;
     /** Maximal size of worker address name for debugging */
@@ -151,6 +159,18 @@ typedef struct ucp_context_config {
     /** Maximal number of endpoints to check on every keepalive round
      * (0 - disabled, inf - check all endpoints on every round) */
     unsigned                               keepalive_num_eps;
+    /** Maximal time to busy poll in ucp_worker_wait before blocking */
+    ucs_time_t                             wakeup_busy_poll;
+    /** Transports whose interfaces are progressed by dedicated threads */
+    ucs_config_names_array_t               progress_thread_tls;
+    /** CPUs to pin the interface progress threads to */
+    UCS_CONFIG_ARRAY_FIELD(unsigned, cpus) progress_thread_cpus;
+    /** Maximal size of an endpoint aggregation buffer */
+    size_t                                 aggr_max_size;
+    /** Maximal size of an aggregated message */
+    size_t                                 aggr_max_msg;
+    /** Maximal time to delay aggregated messages */
+    ucs_time_t                             aggr_timeout;
     /** Time period between dynamic transport switching rounds */
     ucs_time_t                             dynamic_tl_switch_interval;
     /** Number of usage tracker rounds performed for each progress operation */
@@ -173,6 +193,8 @@ typedef struct ucp_context_config {
     int                                    rkey_mpool_max_md;
     /** Worker address format version */
     ucp_object_version_t                   worker_addr_version;
+    /** Pack worker address device and iface attributes as a node profile */
+    int                                    worker_addr_profile;
     /** Threshold for enabling RNDV data split alignment */
     size_t                                 rndv_align_thresh;
     /** Print protocols information */
@@ -181,6 +203,22 @@ typedef struct ucp_context_config {
     char                                   *select_distance_md;
     /** Directory to write protocol selection information */
     char                                   *proto_info_dir;
+    /** Directory of the protocol selection cache file */
+    char                                   *proto_cache_dir;
+    /** Update protocol selection by measured performance */
+    int                                    proto_feedback;
+    /** Number of samples to collect before updating protocol selection */
+    unsigned                               proto_feedback_samples;
+    /** Relative performance change which updates protocol selection */
+    double                                 proto_feedback_tolerance;
+    /** Maximal number of protocol selection updates */
+    unsigned                               proto_feedback_max_updates;
+    /** Trace one of every N send requests, 0 to disable */
+    unsigned                               request_trace_sample;
+    /** File to write the traced requests to */
+    char                                   *request_trace_file;
+    /** Number of traced requests to buffer before writing them to the file */
+    unsigned                               request_trace_buffer_size;
     /** Memory types that perform non-blocking registration by default */
     uint64_t                               reg_nb_mem_types;
     /** Prefer native RMA transports for RMA/AMO protocols */
@@ -9,6 +9,7 @@
 #  include "config.h"
 #endif
 
+#include "ucp_aggr.h"
 #include "ucp_ep.h"
 #include "ucp_worker.h"
 #include "ucp_am.h"
@@ -228,6 +229,7 @@ static ucp_ep_h ucp_ep_allocate(ucp_worker_h worker, const char *peer_name)
     ep->ext->peer_mem                     = NULL;
     ep->ext->unflushed_lanes              = 0;
     ep->ext->fence_seq                    = 0;
+    ep->ext->aggr                         = NULL;
     ep->ext->uct_eps                      = NULL;
 
     UCS_STATIC_ASSERT(sizeof(ep->ext->ep_match) >=
@@ -511,6 +513,7 @@ void ucp_ep_destroy_base(ucp_ep_h ep)
     ucs_callbackq_remove_oneshot(&worker->uct->progress_q, ep,
                                  ucp_ep_remove_filter, ep);
     UCS_STATS_NODE_FREE(ep->stats);
+    ucp_ep_aggr_cleanup(ep);
     if (ep->ext->peer_mem != NULL) {
         kh_foreach_value(ep->ext->peer_mem, data, {
             ucp_ep_peer_mem_destroy(worker->context, &data);
@@ -1215,6 +1218,9 @@ ucs_status_t ucp_ep_create(ucp_worker_h worker, const ucp_ep_params_t *params,
 #endif
 
         ucp_ep_params_check_err_handling(ep, params);
+        if (flags & UCP_EP_PARAMS_FLAGS_AGGREGATE) {
+            ucp_ep_update_flags(ep, UCP_EP_FLAG_AGGREGATE, 0);
+        }
         ucp_ep_update_flags(ep, UCP_EP_FLAG_USED, 0);
         *ep_p = ep;
     } else {
@@ -1764,6 +1770,7 @@ ucs_status_ptr_t ucp_ep_close_nbx(ucp_ep_h ep, const ucp_request_param_t *param)
     ucp_ep_update_flags(ep, UCP_EP_FLAG_CLOSED, 0);
 
     if (ucp_request_param_flags(param) & UCP_EP_CLOSE_FLAG_FORCE) {
+        ucp_ep_aggr_cleanup(ep);
         ucp_ep_discard_lanes(ep, UCS_ERR_CANCELED);
         ucp_ep_disconnected(ep, 1);
     } else {
@@ -104,7 +104,7 @@ enum {
                                                         while merging pending queues */
     UCP_EP_FLAG_CONNECT_PRE_REQ_QUEUED = UCS_BIT(9), /* Pre-Connection request was queued */
     UCP_EP_FLAG_CLOSED                 = UCS_BIT(10),/* EP was closed */
-    /* 11 bit is vacant for a flag */
+    UCP_EP_FLAG_AGGREGATE              = UCS_BIT(11),/* aggregate small sends */
     UCP_EP_FLAG_ERR_HANDLER_INVOKED    = UCS_BIT(12),/* error handler was called */
     UCP_EP_FLAG_INTERNAL               = UCS_BIT(13),/* the internal EP which holds
                                                         temporary wireup configuration or
@@ -536,6 +536,8 @@ typedef struct ucp_ep_ext {
         ucs_list_link_t           ready_list;     /* List entry in worker's EP list */
         ucs_queue_head_t          match_q;        /* Queue of receive data or requests,
                                                      depends on UCP_EP_FLAG_STREAM_HAS_DATA */
+        ucp_stream_ring_t         *ring;          /* User ring to write received
+                                                     data to, or NULL */
     } stream;
 
     struct {
@@ -548,6 +550,8 @@ typedef struct ucp_ep_ext {
                                                       unflushed operations */
     uint64_t                      fence_seq;       /* Sequence number for fence
                                                       detection */
+    ucp_ep_aggr_t                 *aggr;           /* Aggregated sends, allocated
+                                                      on demand */
 
     /**
      * UCT endpoints for every slow-path lane that has no room in the base endpoint
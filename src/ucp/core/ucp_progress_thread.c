@@ -0,0 +1,1165 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ucp_progress_thread.h"
+
+#include <ucp/core/ucp_request.h>
+#include <ucp/core/ucp_worker.h>
+#include <ucs/arch/cpu.h>
+#include <ucs/datastruct/mpool.inl>
+#include <ucs/datastruct/queue.h>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/preprocessor.h>
+#include <ucs/sys/stubs.h>
+#include <ucs/sys/sys.h>
+#include <string.h>
+#include <poll.h>
+
+
+#define UCP_PROGRESS_THREAD_RING_MASK (UCP_PROGRESS_THREAD_RING_SIZE - 1)
+
+/* Number of idle iterations after which the thread waits for interface
+ * events */
+#define UCP_PROGRESS_THREAD_IDLE_SPINS 1024
+
+/* Time to wait for interface events in milliseconds, bounds the time it takes
+ * the thread to notice it should exit */
+#define UCP_PROGRESS_THREAD_WAIT_TIMEOUT 10
+
+
+#define UCP_PROGRESS_THREAD_PASTE_ARG_NAME(_, _index) \
+    , UCS_PP_TOKENPASTE(arg, _index)
+
+#define UCP_PROGRESS_THREAD_PASTE_ARG_TYPE(_, _bundle) \
+    , UCS_PP_TUPLE_1 _bundle UCS_PP_TOKENPASTE(arg, UCS_PP_TUPLE_0 _bundle)
+
+/* Generate list of typed arguments for a wrapper function prototype */
+#define UCP_PROGRESS_THREAD_FUNC_ARGS(_obj, ...) \
+    _obj \
+    UCS_PP_FOREACH(UCP_PROGRESS_THREAD_PASTE_ARG_TYPE, _, \
+                   UCS_PP_ZIP((UCS_PP_SEQ(UCS_PP_NUM_ARGS(__VA_ARGS__))), \
+                              (__VA_ARGS__)))
+
+/* Generate a list of arguments passed to the transport function */
+#define UCP_PROGRESS_THREAD_FUNC_CALL(_obj, ...) \
+    _obj \
+    UCS_PP_FOREACH(UCP_PROGRESS_THREAD_PASTE_ARG_NAME, _, \
+                   UCS_PP_SEQ(UCS_PP_NUM_ARGS(__VA_ARGS__)))
+
+
+/*
+ * Define an endpoint operation which is serialized with the progress thread.
+ * If _check_pending is set, the operation fails with UCS_ERR_NO_RESOURCE while
+ * the endpoint has deferred pending requests, to keep the send order.
+ */
+#define UCP_PROGRESS_THREAD_DEFINE_EP_FUNC(_retval, _name, _func, \
+                                           _check_pending, ...) \
+    static _retval ucp_progress_thread_##_name( \
+            UCP_PROGRESS_THREAD_FUNC_ARGS(uct_ep_h ep, __VA_ARGS__)) \
+    { \
+        ucp_progress_thread_t *thread = ucp_progress_thread_get(ep->iface); \
+        _retval ret; \
+        \
+        UCS_ASYNC_BLOCK(&thread->async); \
+        if ((_check_pending) && \
+            ucp_progress_thread_ep_is_blocked(thread, ep)) { \
+            ret = UCS_ERR_NO_RESOURCE; \
+        } else { \
+            ret = thread->_func(UCP_PROGRESS_THREAD_FUNC_CALL(ep, __VA_ARGS__)); \
+        } \
+        UCS_ASYNC_UNBLOCK(&thread->async); \
+        return ret; \
+    }
+
+#define UCP_PROGRESS_THREAD_DEFINE_EP_OP(_retval, _name, _check_pending, ...) \
+    UCP_PROGRESS_THREAD_DEFINE_EP_FUNC(_retval, _name, ops._name, \
+                                       _check_pending, __VA_ARGS__)
+
+#define UCP_PROGRESS_THREAD_DEFINE_EP_INTERNAL_OP(_retval, _name, \
+                                                  _check_pending, ...) \
+    UCP_PROGRESS_THREAD_DEFINE_EP_FUNC(_retval, _name, internal_ops->_name, \
+                                       _check_pending, __VA_ARGS__)
+
+
+/*
+ * Define an endpoint operation with a completion argument. The transport gets
+ * a completion which passes the event to the worker through the ring.
+ */
+#define UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(_name, _check_pending, ...) \
+    static ucs_status_t ucp_progress_thread_##_name( \
+            UCP_PROGRESS_THREAD_FUNC_ARGS(uct_ep_h ep, __VA_ARGS__), \
+            uct_completion_t *comp) \
+    { \
+        ucp_progress_thread_t *thread = ucp_progress_thread_get(ep->iface); \
+        uct_completion_t *tl_comp; \
+        ucs_status_t status; \
+        \
+        UCS_ASYNC_BLOCK(&thread->async); \
+        if ((_check_pending) && \
+            ucp_progress_thread_ep_is_blocked(thread, ep)) { \
+            status = UCS_ERR_NO_RESOURCE; \
+        } else { \
+            status = ucp_progress_thread_comp_get(thread, comp, &tl_comp); \
+            if (status == UCS_OK) { \
+                status = thread->ops._name( \
+                        UCP_PROGRESS_THREAD_FUNC_CALL(ep, __VA_ARGS__), \
+                        tl_comp); \
+                ucp_progress_thread_comp_put(tl_comp, status); \
+            } \
+        } \
+        UCS_ASYNC_UNBLOCK(&thread->async); \
+        return status; \
+    }
+
+
+/*
+ * Define an interface operation which is serialized with the progress thread.
+ */
+#define UCP_PROGRESS_THREAD_DEFINE_IFACE_FUNC(_retval, _name, _func, ...) \
+    static _retval ucp_progress_thread_##_name( \
+            UCP_PROGRESS_THREAD_FUNC_ARGS(uct_iface_h iface, __VA_ARGS__)) \
+    { \
+        ucp_progress_thread_t *thread = ucp_progress_thread_get(iface); \
+        _retval ret; \
+        \
+        UCS_ASYNC_BLOCK(&thread->async); \
+        ret = thread->_func(UCP_PROGRESS_THREAD_FUNC_CALL(iface, __VA_ARGS__)); \
+        UCS_ASYNC_UNBLOCK(&thread->async); \
+        return ret; \
+    }
+
+#define UCP_PROGRESS_THREAD_DEFINE_IFACE_OP(_retval, _name, ...) \
+    UCP_PROGRESS_THREAD_DEFINE_IFACE_FUNC(_retval, _name, ops._name, \
+                                          __VA_ARGS__)
+
+#define UCP_PROGRESS_THREAD_DEFINE_IFACE_INTERNAL_OP(_retval, _name, ...) \
+    UCP_PROGRESS_THREAD_DEFINE_IFACE_FUNC(_retval, _name, internal_ops->_name, \
+                                          __VA_ARGS__)
+
+
+#define ucp_progress_thread_ep_hash_key(_uct_ep) \
+    kh_int64_hash_func((uintptr_t)(_uct_ep))
+
+
+KHASH_IMPL(ucp_progress_thread_ep_hash, uct_ep_h, ucp_progress_thread_ep_t, 1,
+           ucp_progress_thread_ep_hash_key, kh_int64_hash_equal);
+
+
+static ucs_mpool_ops_t ucp_progress_thread_mpool_ops = {
+    .chunk_alloc   = ucs_mpool_chunk_malloc,
+    .chunk_release = ucs_mpool_chunk_free,
+    .obj_init      = NULL,
+    .obj_cleanup   = NULL,
+    .obj_str       = NULL
+};
+
+
+static UCS_F_ALWAYS_INLINE ucp_progress_thread_t *
+ucp_progress_thread_get(uct_iface_h iface)
+{
+    /* The error handler of a progressed interface is replaced, and its
+     * argument is the thread */
+    return ucs_derived_of(iface, uct_base_iface_t)->err_handler_arg;
+}
+
+static UCS_F_ALWAYS_INLINE void *
+ucp_progress_thread_msg_data(ucp_progress_thread_msg_t *msg)
+{
+    return UCS_PTR_BYTE_OFFSET(msg + 1, UCP_WORKER_HEADROOM_SIZE);
+}
+
+static ucp_progress_thread_msg_t *
+ucp_progress_thread_msg_get(ucp_progress_thread_t *thread, size_t length)
+{
+    ucp_progress_thread_msg_t *msg;
+    ucs_mpool_t *mp;
+
+    if (ucs_likely(length <= thread->small_size)) {
+        mp = &thread->small_mp;
+    } else if (length <= thread->large_size) {
+        mp = &thread->large_mp;
+    } else {
+        return NULL;
+    }
+
+    ucs_spin_lock(&thread->mp_lock);
+    msg = ucs_mpool_get_inline(mp);
+    ucs_spin_unlock(&thread->mp_lock);
+    if (ucs_unlikely(msg == NULL)) {
+        return NULL;
+    }
+
+    msg->thread       = thread;
+    msg->release_desc = &thread->release_desc;
+    return msg;
+}
+
+static void ucp_progress_thread_msg_put(ucp_progress_thread_msg_t *msg)
+{
+    ucp_progress_thread_t *thread = msg->thread;
+
+    ucs_spin_lock(&thread->mp_lock);
+    ucs_mpool_put_inline(msg);
+    ucs_spin_unlock(&thread->mp_lock);
+}
+
+static void ucp_progress_thread_release_desc(uct_recv_desc_t *self, void *desc)
+{
+    ucp_progress_thread_msg_put((ucp_progress_thread_msg_t*)desc - 1);
+}
+
+static int ucp_progress_thread_ring_push(ucp_progress_thread_t *thread,
+                                         ucp_progress_thread_msg_t *msg)
+{
+    uint32_t tail = thread->tail;
+    uint32_t head = thread->head;
+
+    if ((tail - head) == UCP_PROGRESS_THREAD_RING_SIZE) {
+        return 0;
+    }
+
+    thread->ring[tail & UCP_PROGRESS_THREAD_RING_MASK] = msg;
+
+    /* Publish the entry only after it is filled */
+    ucs_memory_cpu_store_fence();
+    thread->tail = tail + 1;
+
+    if (tail == head) {
+        /* Wake up the thread which may be waiting for worker events */
+        ucp_worker_signal_internal(thread->wiface->worker);
+    }
+
+    return 1;
+}
+
+/* Move the events which did not fit the ring, called with the lock held */
+static void ucp_progress_thread_overflow_flush(ucp_progress_thread_t *thread)
+{
+    ucp_progress_thread_msg_t *msg;
+
+    while (!ucs_queue_is_empty(&thread->overflow)) {
+        msg = ucs_queue_head_elem_non_empty(&thread->overflow,
+                                            ucp_progress_thread_msg_t, queue);
+        if (!ucp_progress_thread_ring_push(thread, msg)) {
+            break;
+        }
+
+        ucs_queue_pull_non_empty(&thread->overflow);
+    }
+}
+
+/* Pass an event to the worker, in the order of the events */
+static void ucp_progress_thread_push(ucp_progress_thread_t *thread,
+                                     ucp_progress_thread_msg_t *msg)
+{
+    /* Events are produced by the transport, which may also report errors
+     * from the async thread, so producers are serialized by the thread async
+     * lock */
+    UCS_ASYNC_BLOCK(&thread->async);
+    if (!ucs_queue_is_empty(&thread->overflow) ||
+        !ucp_progress_thread_ring_push(thread, msg)) {
+        ucs_queue_push(&thread->overflow, &msg->queue);
+    }
+    UCS_ASYNC_UNBLOCK(&thread->async);
+}
+
+static void ucp_progress_thread_comp_cb(uct_completion_t *self)
+{
+    ucp_progress_thread_msg_t *msg = ucs_container_of(self,
+                                                      ucp_progress_thread_msg_t,
+                                                      comp.super);
+
+    if (ucs_unlikely(msg->thread->detached)) {
+        /* Operation was started before the interface was returned to the
+         * worker, which progresses it now */
+        uct_invoke_completion(msg->comp.comp, self->status);
+        ucp_progress_thread_msg_put(msg);
+        return;
+    }
+
+    ucp_progress_thread_push(msg->thread, msg);
+}
+
+static ucs_status_t
+ucp_progress_thread_comp_get(ucp_progress_thread_t *thread,
+                             uct_completion_t *comp, uct_completion_t **tl_comp_p)
+{
+    ucp_progress_thread_msg_t *msg;
+
+    if (comp == NULL) {
+        *tl_comp_p = NULL;
+        return UCS_OK;
+    }
+
+    msg = ucp_progress_thread_msg_get(thread, 0);
+    if (ucs_unlikely(msg == NULL)) {
+        ucs_error("progress thread %p: failed to allocate completion", thread);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    msg->type              = UCP_PROGRESS_THREAD_MSG_COMP;
+    msg->comp.super.func   = ucp_progress_thread_comp_cb;
+    msg->comp.super.count  = 1;
+    msg->comp.super.status = UCS_OK;
+    msg->comp.comp         = comp;
+    *tl_comp_p             = &msg->comp.super;
+    return UCS_OK;
+}
+
+static void
+ucp_progress_thread_comp_put(uct_completion_t *tl_comp, ucs_status_t status)
+{
+    if ((tl_comp != NULL) && (status != UCS_INPROGRESS)) {
+        /* The transport will not call the completion */
+        ucp_progress_thread_msg_put(
+                ucs_container_of(tl_comp, ucp_progress_thread_msg_t,
+                                 comp.super));
+    }
+}
+
+static ucs_status_t
+ucp_progress_thread_err_handler(void *arg, uct_ep_h ep, ucs_status_t status)
+{
+    ucp_progress_thread_t *thread = arg;
+    ucp_progress_thread_msg_t *msg;
+
+    msg = ucp_progress_thread_msg_get(thread, 0);
+    if (ucs_unlikely(msg == NULL)) {
+        ucs_error("progress thread %p: failed to allocate error of ep %p: %s",
+                  thread, ep, ucs_status_string(status));
+        return status;
+    }
+
+    msg->type          = UCP_PROGRESS_THREAD_MSG_EP_ERR;
+    msg->ep_err.ep     = ep;
+    msg->ep_err.status = status;
+    ucp_progress_thread_push(thread, msg);
+    return UCS_OK;
+}
+
+ucs_status_t ucp_progress_thread_am_handler(void *arg, void *data,
+                                            size_t length, unsigned flags)
+{
+    ucp_progress_thread_am_arg_t *am_arg = arg;
+    ucp_progress_thread_t *thread        = am_arg->thread;
+    ucp_progress_thread_msg_t *msg;
+
+    msg = ucp_progress_thread_msg_get(thread, length);
+    if (ucs_unlikely(msg == NULL)) {
+        ucs_error("progress thread %p: failed to allocate active message id %u"
+                  " length %zu, dropping it", thread, am_arg->am_id, length);
+        return UCS_OK;
+    }
+
+    /* The data is valid only during the callback, so keep a copy, which is
+     * passed to the worker as a receive descriptor */
+    msg->type      = UCP_PROGRESS_THREAD_MSG_AM;
+    msg->am.length = length;
+    msg->am.flags  = flags | UCT_CB_PARAM_FLAG_DESC;
+    msg->am.am_id  = am_arg->am_id;
+    memcpy(ucp_progress_thread_msg_data(msg), data, length);
+    ucp_progress_thread_push(thread, msg);
+    return UCS_OK;
+}
+
+static int ucp_progress_thread_ep_is_blocked(ucp_progress_thread_t *thread,
+                                             uct_ep_h ep)
+{
+    return (thread->num_pending_eps > 0) && (ep != thread->dispatching_ep) &&
+           (kh_get(ucp_progress_thread_ep_hash, &thread->pending_eps, ep) !=
+            kh_end(&thread->pending_eps));
+}
+
+/* Remove the deferred pending requests of an endpoint from a queue */
+static void ucp_progress_thread_pending_extract(ucp_progress_thread_t *thread,
+                                                ucs_queue_head_t *queue,
+                                                uct_ep_h ep,
+                                                ucs_queue_head_t *purged)
+{
+    ucp_progress_thread_pending_t *pending;
+    ucs_queue_iter_t iter;
+
+    ucs_queue_for_each_safe(pending, iter, queue, queue) {
+        if (pending->ep == ep) {
+            ucs_queue_del_iter(queue, iter);
+            ucs_queue_push(purged, &pending->queue);
+        }
+    }
+}
+
+/* Remove all deferred pending requests of an endpoint, called with the lock
+ * held */
+static void ucp_progress_thread_pending_remove(ucp_progress_thread_t *thread,
+                                               uct_ep_h ep,
+                                               ucs_queue_head_t *purged)
+{
+    khiter_t iter;
+
+    iter = kh_get(ucp_progress_thread_ep_hash, &thread->pending_eps, ep);
+    if (iter == kh_end(&thread->pending_eps)) {
+        return;
+    }
+
+    ucp_progress_thread_pending_extract(thread, &thread->pending_q, ep, purged);
+    ucp_progress_thread_pending_extract(thread, &thread->dispatch_q, ep,
+                                        purged);
+    ucp_progress_thread_pending_extract(thread, &thread->blocked_q, ep, purged);
+    kh_del(ucp_progress_thread_ep_hash, &thread->pending_eps, iter);
+    --thread->num_pending_eps;
+}
+
+static UCS_F_ALWAYS_INLINE uct_pending_req_t *
+ucp_progress_thread_pending_req(ucp_progress_thread_pending_t *pending)
+{
+    return ucs_container_of(pending, uct_pending_req_t, priv);
+}
+
+static ucs_status_t ucp_progress_thread_ep_pending_add(uct_ep_h ep,
+                                                       uct_pending_req_t *req,
+                                                       unsigned flags)
+{
+    ucp_progress_thread_t *thread          = ucp_progress_thread_get(ep->iface);
+    ucp_progress_thread_pending_t *pending = (void*)req->priv;
+    ucp_progress_thread_ep_t *pending_ep;
+    khiter_t iter;
+    int ret;
+
+    UCS_STATIC_ASSERT(sizeof(*pending) <= UCT_PENDING_REQ_PRIV_LEN);
+
+    UCS_ASYNC_BLOCK(&thread->async);
+
+    iter = kh_put(ucp_progress_thread_ep_hash, &thread->pending_eps, ep, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        UCS_ASYNC_UNBLOCK(&thread->async);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    pending_ep = &kh_val(&thread->pending_eps, iter);
+    if (ret != UCS_KH_PUT_KEY_PRESENT) {
+        pending_ep->count       = 0;
+        pending_ep->blocked_gen = thread->pending_gen - 1;
+        ++thread->num_pending_eps;
+    }
+
+    /* The request is dispatched by the worker, when it is progressed */
+    ++pending_ep->count;
+    pending->ep = ep;
+    ucs_queue_push(&thread->pending_q, &pending->queue);
+
+    UCS_ASYNC_UNBLOCK(&thread->async);
+    return UCS_OK;
+}
+
+static void
+ucp_progress_thread_ep_pending_purge(uct_ep_h ep,
+                                     uct_pending_purge_callback_t cb, void *arg)
+{
+    ucp_progress_thread_t *thread = ucp_progress_thread_get(ep->iface);
+    ucp_progress_thread_pending_t *pending;
+    ucs_queue_head_t purged;
+
+    ucs_queue_head_init(&purged);
+
+    UCS_ASYNC_BLOCK(&thread->async);
+    ucp_progress_thread_pending_remove(thread, ep, &purged);
+    UCS_ASYNC_UNBLOCK(&thread->async);
+
+    ucs_queue_for_each_extract(pending, &purged, queue, 1) {
+        cb(ucp_progress_thread_pending_req(pending), arg);
+    }
+}
+
+static void ucp_progress_thread_ep_destroy(uct_ep_h ep)
+{
+    ucp_progress_thread_t *thread = ucp_progress_thread_get(ep->iface);
+    ucp_progress_thread_msg_t *msg;
+    ucs_queue_head_t purged;
+    uint32_t index;
+
+    ucs_queue_head_init(&purged);
+
+    UCS_ASYNC_BLOCK(&thread->async);
+
+    /* Drop the errors of the endpoint which were not handled yet */
+    for (index = thread->head; index != thread->tail; ++index) {
+        msg = thread->ring[index & UCP_PROGRESS_THREAD_RING_MASK];
+        if ((msg->type == UCP_PROGRESS_THREAD_MSG_EP_ERR) &&
+            (msg->ep_err.ep == ep)) {
+            msg->ep_err.ep = NULL;
+        }
+    }
+
+    ucs_queue_for_each(msg, &thread->overflow, queue) {
+        if ((msg->type == UCP_PROGRESS_THREAD_MSG_EP_ERR) &&
+            (msg->ep_err.ep == ep)) {
+            msg->ep_err.ep = NULL;
+        }
+    }
+
+    ucp_progress_thread_pending_remove(thread, ep, &purged);
+    if (!ucs_queue_is_empty(&purged)) {
+        ucs_warn("progress thread %p: ep %p is destroyed with %zu pending "
+                 "requests", thread, ep, ucs_queue_length(&purged));
+    }
+
+    thread->ops.ep_destroy(ep);
+
+    UCS_ASYNC_UNBLOCK(&thread->async);
+}
+
+static ucs_status_t
+ucp_progress_thread_ep_create(const uct_ep_params_t *params, uct_ep_h *ep_p)
+{
+    ucp_progress_thread_t *thread = ucp_progress_thread_get(params->iface);
+    ucs_status_t status;
+
+    UCS_ASYNC_BLOCK(&thread->async);
+    status = thread->ops.ep_create(params, ep_p);
+    UCS_ASYNC_UNBLOCK(&thread->async);
+    return status;
+}
+
+static ucs_status_t ucp_progress_thread_iface_flush(uct_iface_h iface,
+                                                    unsigned flags,
+                                                    uct_completion_t *comp)
+{
+    ucp_progress_thread_t *thread = ucp_progress_thread_get(iface);
+    uct_completion_t *tl_comp;
+    ucs_status_t status;
+
+    UCS_ASYNC_BLOCK(&thread->async);
+    status = ucp_progress_thread_comp_get(thread, comp, &tl_comp);
+    if (status == UCS_OK) {
+        status = thread->ops.iface_flush(iface, flags, tl_comp);
+        ucp_progress_thread_comp_put(tl_comp, status);
+    }
+    UCS_ASYNC_UNBLOCK(&thread->async);
+    return status;
+}
+
+static unsigned ucp_progress_thread_iface_progress(uct_iface_h iface)
+{
+    ucp_progress_thread_t *thread = ucp_progress_thread_get(iface);
+    unsigned count;
+
+    UCS_ASYNC_BLOCK(&thread->async);
+    count = thread->ops.iface_progress(iface);
+    UCS_ASYNC_UNBLOCK(&thread->async);
+    return count;
+}
+
+
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_put_short, 1, const void*,
+                                 unsigned, uint64_t, uct_rkey_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ssize_t, ep_put_bcopy, 1, uct_pack_callback_t,
+                                 void*, uint64_t, uct_rkey_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(ep_put_zcopy, 1, const uct_iov_t*,
+                                      size_t, uint64_t, uct_rkey_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_get_short, 1, void*,
+                                 unsigned, uint64_t, uct_rkey_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(ep_get_bcopy, 1, uct_unpack_callback_t,
+                                      void*, size_t, uint64_t, uct_rkey_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(ep_get_zcopy, 1, const uct_iov_t*,
+                                      size_t, uint64_t, uct_rkey_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_am_short, 1, uint8_t,
+                                 uint64_t, const void*, unsigned)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_am_short_iov, 1, uint8_t,
+                                 const uct_iov_t*, size_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ssize_t, ep_am_bcopy, 1, uint8_t,
+                                 uct_pack_callback_t, void*, unsigned)
+UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(ep_am_zcopy, 1, uint8_t, const void*,
+                                      unsigned, const uct_iov_t*, size_t,
+                                      unsigned)
+UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(ep_atomic_cswap64, 1, uint64_t, uint64_t,
+                                      uint64_t, uct_rkey_t, uint64_t*)
+UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(ep_atomic_cswap32, 1, uint32_t, uint32_t,
+                                      uint64_t, uct_rkey_t, uint32_t*)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_atomic32_post, 1,
+                                 uct_atomic_op_t, uint32_t, uint64_t,
+                                 uct_rkey_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_atomic64_post, 1,
+                                 uct_atomic_op_t, uint64_t, uint64_t,
+                                 uct_rkey_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(ep_atomic32_fetch, 1, uct_atomic_op_t,
+                                      uint32_t, uint32_t*, uint64_t,
+                                      uct_rkey_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(ep_atomic64_fetch, 1, uct_atomic_op_t,
+                                      uint64_t, uint64_t*, uint64_t,
+                                      uct_rkey_t)
+UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(ep_flush, 1, unsigned)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_fence, 0, unsigned)
+UCP_PROGRESS_THREAD_DEFINE_EP_COMP_OP(ep_check, 0, unsigned)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_connect, 0,
+                                 const uct_ep_connect_params_t*)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_disconnect, 0, unsigned)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_get_address, 0,
+                                 uct_ep_addr_t*)
+UCP_PROGRESS_THREAD_DEFINE_EP_OP(ucs_status_t, ep_connect_to_ep, 0,
+                                 const uct_device_addr_t*,
+                                 const uct_ep_addr_t*)
+UCP_PROGRESS_THREAD_DEFINE_IFACE_OP(ucs_status_t, iface_fence, unsigned)
+UCP_PROGRESS_THREAD_DEFINE_IFACE_OP(ucs_status_t, iface_event_fd_get, int*)
+UCP_PROGRESS_THREAD_DEFINE_IFACE_OP(ucs_status_t, iface_event_arm, unsigned)
+UCP_PROGRESS_THREAD_DEFINE_IFACE_OP(ucs_status_t, iface_query,
+                                    uct_iface_attr_t*)
+UCP_PROGRESS_THREAD_DEFINE_IFACE_OP(ucs_status_t, iface_get_device_address,
+                                    uct_device_addr_t*)
+UCP_PROGRESS_THREAD_DEFINE_IFACE_OP(ucs_status_t, iface_get_address,
+                                    uct_iface_addr_t*)
+UCP_PROGRESS_THREAD_DEFINE_IFACE_OP(int, iface_is_reachable,
+                                    const uct_device_addr_t*,
+                                    const uct_iface_addr_t*)
+
+UCP_PROGRESS_THREAD_DEFINE_EP_INTERNAL_OP(ucs_status_t, ep_query, 0,
+                                          uct_ep_attr_t*)
+UCP_PROGRESS_THREAD_DEFINE_EP_INTERNAL_OP(ucs_status_t, ep_invalidate, 0,
+                                          unsigned)
+UCP_PROGRESS_THREAD_DEFINE_EP_INTERNAL_OP(ucs_status_t, ep_connect_to_ep_v2, 0,
+                                          const uct_device_addr_t*,
+                                          const uct_ep_addr_t*,
+                                          const uct_ep_connect_to_ep_params_t*)
+UCP_PROGRESS_THREAD_DEFINE_EP_INTERNAL_OP(int, ep_is_connected, 0,
+                                          const uct_ep_is_connected_params_t*)
+UCP_PROGRESS_THREAD_DEFINE_EP_INTERNAL_OP(ssize_t, ep_am_short_batch, 1,
+                                          const uct_am_short_batch_elem_t*,
+                                          size_t, unsigned)
+UCP_PROGRESS_THREAD_DEFINE_IFACE_INTERNAL_OP(ucs_status_t, iface_estimate_perf,
+                                             uct_perf_attr_t*)
+UCP_PROGRESS_THREAD_DEFINE_IFACE_INTERNAL_OP(int, iface_is_reachable_v2,
+                                             const uct_iface_is_reachable_params_t*)
+
+
+/* Replace the interface operations by wrappers which take the thread lock */
+static void ucp_progress_thread_attach(ucp_progress_thread_t *thread)
+{
+    uct_base_iface_t *iface = ucs_derived_of(thread->wiface->iface,
+                                             uct_base_iface_t);
+    uct_iface_ops_t *ops    = &iface->super.ops;
+
+    #define UCP_PROGRESS_THREAD_SET_OP(_ops, _name) \
+        if ((_ops)->_name != NULL) { \
+            (_ops)->_name = ucp_progress_thread_##_name; \
+        }
+
+    thread->ops             = *ops;
+    thread->internal_ops    = iface->internal_ops;
+    thread->err_handler     = iface->err_handler;
+    thread->err_handler_arg = iface->err_handler_arg;
+
+    /* Tag offload operations are not replaced, since such interfaces are not
+     * progressed by a thread. The interface is closed by the worker after the
+     * thread is detached. */
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_put_short);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_put_bcopy);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_put_zcopy);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_get_short);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_get_bcopy);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_get_zcopy);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_am_short);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_am_short_iov);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_am_bcopy);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_am_zcopy);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_atomic_cswap64);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_atomic_cswap32);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_atomic32_post);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_atomic64_post);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_atomic32_fetch);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_atomic64_fetch);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_pending_add);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_pending_purge);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_flush);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_fence);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_check);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_create);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_connect);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_disconnect);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_destroy);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_get_address);
+    UCP_PROGRESS_THREAD_SET_OP(ops, ep_connect_to_ep);
+    UCP_PROGRESS_THREAD_SET_OP(ops, iface_flush);
+    UCP_PROGRESS_THREAD_SET_OP(ops, iface_fence);
+    UCP_PROGRESS_THREAD_SET_OP(ops, iface_progress);
+    UCP_PROGRESS_THREAD_SET_OP(ops, iface_event_fd_get);
+    UCP_PROGRESS_THREAD_SET_OP(ops, iface_event_arm);
+    UCP_PROGRESS_THREAD_SET_OP(ops, iface_query);
+    UCP_PROGRESS_THREAD_SET_OP(ops, iface_get_device_address);
+    UCP_PROGRESS_THREAD_SET_OP(ops, iface_get_address);
+    UCP_PROGRESS_THREAD_SET_OP(ops, iface_is_reachable);
+
+    thread->locked_internal_ops = *thread->internal_ops;
+    UCP_PROGRESS_THREAD_SET_OP(&thread->locked_internal_ops, ep_query);
+    UCP_PROGRESS_THREAD_SET_OP(&thread->locked_internal_ops, ep_invalidate);
+    UCP_PROGRESS_THREAD_SET_OP(&thread->locked_internal_ops,
+                               ep_connect_to_ep_v2);
+    UCP_PROGRESS_THREAD_SET_OP(&thread->locked_internal_ops, ep_is_connected);
+    UCP_PROGRESS_THREAD_SET_OP(&thread->locked_internal_ops,
+                               ep_am_short_batch);
+    UCP_PROGRESS_THREAD_SET_OP(&thread->locked_internal_ops,
+                               iface_estimate_perf);
+    UCP_PROGRESS_THREAD_SET_OP(&thread->locked_internal_ops,
+                               iface_is_reachable_v2);
+    iface->internal_ops = &thread->locked_internal_ops;
+
+    iface->err_handler     = ucp_progress_thread_err_handler;
+    iface->err_handler_arg = thread;
+    thread->attached       = 1;
+
+    #undef UCP_PROGRESS_THREAD_SET_OP
+}
+
+/* Return the transport operations to the interface */
+static void ucp_progress_thread_detach(ucp_progress_thread_t *thread)
+{
+    uct_base_iface_t *iface = ucs_derived_of(thread->wiface->iface,
+                                             uct_base_iface_t);
+
+    UCS_ASYNC_BLOCK(&thread->async);
+    if (thread->attached) {
+        iface->super.ops       = thread->ops;
+        iface->internal_ops    = thread->internal_ops;
+        iface->err_handler     = thread->err_handler;
+        iface->err_handler_arg = thread->err_handler_arg;
+        thread->attached       = 0;
+    }
+    thread->detached = 1;
+    UCS_ASYNC_UNBLOCK(&thread->async);
+}
+
+/* Block until the interface has events, or a timeout expires */
+static void ucp_progress_thread_wait(ucp_progress_thread_t *thread, int fd,
+                                     unsigned events)
+{
+    uct_iface_h iface = thread->wiface->iface;
+    struct pollfd pfd;
+    ucs_status_t status;
+
+    UCS_ASYNC_BLOCK(&thread->async);
+    status = thread->ops.iface_event_arm(iface, events);
+    UCS_ASYNC_UNBLOCK(&thread->async);
+    if (status != UCS_OK) {
+        return;
+    }
+
+    pfd.fd      = fd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+    if ((poll(&pfd, 1, UCP_PROGRESS_THREAD_WAIT_TIMEOUT) < 0) &&
+        (errno != EINTR)) {
+        ucs_warn("progress thread %p: poll(fd=%d) failed: %m", thread, fd);
+    }
+}
+
+static void *ucp_progress_thread_func(void *arg)
+{
+    ucp_progress_thread_t *thread = arg;
+    ucp_worker_iface_t *wiface    = thread->wiface;
+    unsigned num_idle             = 0;
+    unsigned events               = 0;
+    int fd                        = -1;
+    ucs_sys_cpuset_t cpuset;
+    unsigned count;
+
+    if (thread->cpu >= 0) {
+        CPU_ZERO(&cpuset);
+        CPU_SET(thread->cpu, &cpuset);
+        if (ucs_sys_setaffinity(&cpuset) < 0) {
+            ucs_warn("failed to pin progress thread of iface %p to cpu %d: %m",
+                     wiface->iface, thread->cpu);
+        }
+    }
+
+    if (wiface->attr.cap.event_flags & UCT_IFACE_FLAG_EVENT_FD) {
+        if (wiface->attr.cap.event_flags & UCT_IFACE_FLAG_EVENT_RECV) {
+            events |= UCT_EVENT_RECV;
+        }
+        if (wiface->attr.cap.event_flags & UCT_IFACE_FLAG_EVENT_RECV_SIG) {
+            events |= UCT_EVENT_RECV_SIG;
+        }
+        if (wiface->attr.cap.event_flags & UCT_IFACE_FLAG_EVENT_SEND_COMP) {
+            events |= UCT_EVENT_SEND_COMP;
+        }
+        if ((events != 0) &&
+            (thread->ops.iface_event_fd_get(wiface->iface, &fd) != UCS_OK)) {
+            fd = -1;
+        }
+    }
+
+    ucs_debug("progress thread of iface %p started on cpu %d, event fd %d",
+              wiface->iface, thread->cpu, fd);
+
+    while (!thread->stop) {
+        /* The interface async events are deferred while it is progressed */
+        UCS_ASYNC_BLOCK(&thread->async);
+        ucp_progress_thread_overflow_flush(thread);
+        count = uct_worker_progress(thread->uct);
+        UCS_ASYNC_UNBLOCK(&thread->async);
+        ucs_async_check_miss(&thread->async);
+
+        if (count > 0) {
+            num_idle = 0;
+        } else if (++num_idle < UCP_PROGRESS_THREAD_IDLE_SPINS) {
+            continue;
+        } else if (fd >= 0) {
+            /* Sleep until the interface has events */
+            ucp_progress_thread_wait(thread, fd, events);
+            num_idle = 0;
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static ucs_status_t
+ucp_progress_thread_mpool_init(ucp_progress_thread_t *thread, ucs_mpool_t *mp,
+                               size_t max_length, const char *name)
+{
+    ucs_mpool_params_t mp_params;
+
+    ucs_mpool_params_reset(&mp_params);
+    mp_params.elem_size       = sizeof(ucp_progress_thread_msg_t) +
+                                UCP_WORKER_HEADROOM_SIZE + max_length;
+    mp_params.align_offset    = sizeof(ucp_progress_thread_msg_t) +
+                                UCP_WORKER_HEADROOM_SIZE;
+    mp_params.alignment       = UCS_SYS_CACHE_LINE_SIZE;
+    mp_params.elems_per_chunk = 128;
+    mp_params.ops             = &ucp_progress_thread_mpool_ops;
+    mp_params.name            = name;
+    return ucs_mpool_init(&mp_params, mp);
+}
+
+ucs_status_t ucp_progress_thread_create(ucp_worker_iface_t *wiface,
+                                        ucp_progress_thread_t **thread_p)
+{
+    ucp_worker_h worker = wiface->worker;
+    ucp_progress_thread_t *thread;
+    ucs_status_t status;
+    unsigned am_id;
+
+    UCS_STATIC_ASSERT(ucs_is_pow2_or_zero(UCP_PROGRESS_THREAD_RING_SIZE));
+    /* The descriptor release callback is found before the descriptor */
+    UCS_STATIC_ASSERT(ucs_offsetof(ucp_progress_thread_msg_t, release_desc) +
+                      sizeof(uct_recv_desc_t*) ==
+                      sizeof(ucp_progress_thread_msg_t));
+
+    thread = ucs_calloc(1, sizeof(*thread), "ucp_progress_thread");
+    if (thread == NULL) {
+        ucs_error("failed to allocate progress thread");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    thread->wiface          = wiface;
+    thread->cpu             = -1;
+    thread->release_desc.cb = ucp_progress_thread_release_desc;
+    ucs_queue_head_init(&thread->overflow);
+    ucs_queue_head_init(&thread->pending_q);
+    ucs_queue_head_init(&thread->dispatch_q);
+    ucs_queue_head_init(&thread->blocked_q);
+    kh_init_inplace(ucp_progress_thread_ep_hash, &thread->pending_eps);
+    for (am_id = 0; am_id < UCP_AM_ID_LAST; ++am_id) {
+        thread->am_args[am_id].thread = thread;
+        thread->am_args[am_id].am_id  = am_id;
+    }
+
+    status = ucs_async_context_init(&thread->async, worker->async.mode);
+    if (status != UCS_OK) {
+        goto err_free;
+    }
+
+    /* The interface is used by the progress thread and, under the thread
+     * async lock, by the thread which progresses the worker */
+    status = uct_worker_create(&thread->async, UCS_THREAD_MODE_SERIALIZED,
+                               &thread->uct);
+    if (status != UCS_OK) {
+        goto err_cleanup_async;
+    }
+
+    status = ucs_spinlock_init(&thread->mp_lock, 0);
+    if (status != UCS_OK) {
+        goto err_destroy_uct_worker;
+    }
+
+    *thread_p = thread;
+    return UCS_OK;
+
+err_destroy_uct_worker:
+    uct_worker_destroy(thread->uct);
+err_cleanup_async:
+    ucs_async_context_cleanup(&thread->async);
+err_free:
+    kh_destroy_inplace(ucp_progress_thread_ep_hash, &thread->pending_eps);
+    ucs_free(thread);
+    return status;
+}
+
+ucs_status_t ucp_progress_thread_start(ucp_progress_thread_t *thread, int cpu)
+{
+    const uct_iface_attr_t *attr = &thread->wiface->attr;
+    ucs_status_t status;
+
+    thread->cpu        = cpu;
+    thread->small_size = ucs_max(attr->cap.am.max_short,
+                                 attr->cap.am.max_bcopy);
+    thread->large_size = ucs_max(thread->small_size,
+                                 attr->cap.am.max_hdr + attr->cap.am.max_zcopy);
+
+    status = ucp_progress_thread_mpool_init(thread, &thread->small_mp,
+                                            thread->small_size,
+                                            "ucp_progress_thread_small");
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucp_progress_thread_mpool_init(thread, &thread->large_mp,
+                                            thread->large_size,
+                                            "ucp_progress_thread_large");
+    if (status != UCS_OK) {
+        goto err_cleanup_small_mp;
+    }
+
+    thread->mpools_init = 1;
+    ucp_progress_thread_attach(thread);
+
+    status = ucs_pthread_create(&thread->thread_id, ucp_progress_thread_func,
+                                thread, "ucp_progress_%d",
+                                thread->wiface->rsc_index);
+    if (status != UCS_OK) {
+        /* The interface is returned to the worker by ucp_progress_thread_stop,
+         * and the pools are released with the thread */
+        return status;
+    }
+
+    thread->started = 1;
+    return UCS_OK;
+
+err_cleanup_small_mp:
+    ucs_mpool_cleanup(&thread->small_mp, 1);
+    return status;
+}
+
+/* Return the deferred pending requests to the transport */
+static void ucp_progress_thread_pending_restore(ucp_progress_thread_t *thread)
+{
+    ucp_progress_thread_pending_t *pending;
+    uct_pending_req_t *req;
+    ucs_status_t status;
+    uct_ep_h ep;
+
+    ucs_assert(ucs_queue_is_empty(&thread->dispatch_q));
+    ucs_assert(ucs_queue_is_empty(&thread->blocked_q));
+
+    ucs_queue_for_each_extract(pending, &thread->pending_q, queue, 1) {
+        ep  = pending->ep;
+        req = ucp_progress_thread_pending_req(pending);
+        do {
+            status = uct_ep_pending_add(ep, req, 0);
+            if (status != UCS_ERR_BUSY) {
+                break;
+            }
+
+            /* The endpoint has resources, so the request can be progressed */
+            status = req->func(req);
+        } while (status != UCS_OK);
+
+        if (status != UCS_OK) {
+            ucs_error("progress thread %p: failed to return pending request %p "
+                      "to ep %p: %s", thread, req, ep,
+                      ucs_status_string(status));
+        }
+    }
+
+    kh_clear(ucp_progress_thread_ep_hash, &thread->pending_eps);
+    thread->num_pending_eps = 0;
+}
+
+void ucp_progress_thread_stop(ucp_progress_thread_t *thread)
+{
+    if (thread->started) {
+        thread->stop = 1;
+        pthread_join(thread->thread_id, NULL);
+        thread->started = 0;
+    }
+
+    if (!thread->detached) {
+        ucp_progress_thread_detach(thread);
+        ucp_progress_thread_pending_restore(thread);
+    }
+}
+
+void ucp_progress_thread_destroy(ucp_progress_thread_t *thread)
+{
+    ucs_assertv(ucs_queue_is_empty(&thread->overflow) &&
+                (thread->head == thread->tail),
+                "progress thread %p: %u events were not dispatched", thread,
+                thread->tail - thread->head);
+
+    if (thread->mpools_init) {
+        ucs_mpool_cleanup(&thread->large_mp, 1);
+        ucs_mpool_cleanup(&thread->small_mp, 1);
+    }
+
+    ucs_spinlock_destroy(&thread->mp_lock);
+    uct_worker_destroy(thread->uct);
+    ucs_async_context_cleanup(&thread->async);
+    kh_destroy_inplace(ucp_progress_thread_ep_hash, &thread->pending_eps);
+    ucs_free(thread);
+}
+
+static void ucp_progress_thread_msg_handle(ucp_progress_thread_t *thread,
+                                           ucp_progress_thread_msg_t *msg)
+{
+    ucp_worker_h worker = thread->wiface->worker;
+    uct_completion_t *comp;
+    ucs_status_t status;
+
+    switch (msg->type) {
+    case UCP_PROGRESS_THREAD_MSG_AM:
+        status = ucp_am_handlers[msg->am.am_id]->cb(
+                worker, ucp_progress_thread_msg_data(msg), msg->am.length,
+                msg->am.flags);
+        if (status != UCS_INPROGRESS) {
+            ucp_progress_thread_msg_put(msg);
+        }
+        break;
+    case UCP_PROGRESS_THREAD_MSG_COMP:
+        comp   = msg->comp.comp;
+        status = msg->comp.super.status;
+        ucp_progress_thread_msg_put(msg);
+        uct_invoke_completion(comp, status);
+        break;
+    case UCP_PROGRESS_THREAD_MSG_EP_ERR:
+        if (msg->ep_err.ep != NULL) {
+            status = thread->err_handler(thread->err_handler_arg,
+                                         msg->ep_err.ep, msg->ep_err.status);
+            if (status != UCS_OK) {
+                ucs_diag("progress thread %p: error %s of ep %p was not "
+                         "handled", thread,
+                         ucs_status_string(msg->ep_err.status),
+                         msg->ep_err.ep);
+            }
+        }
+        ucp_progress_thread_msg_put(msg);
+        break;
+    default:
+        ucs_fatal("progress thread %p: invalid event type %d", thread,
+                  msg->type);
+    }
+}
+
+static unsigned ucp_progress_thread_pending_dispatch(ucp_progress_thread_t *thread)
+{
+    unsigned count = 0;
+    ucp_progress_thread_pending_t *pending;
+    uct_pending_req_t *req;
+    ucs_status_t status;
+    khiter_t iter;
+    unsigned gen;
+    uct_ep_h ep;
+
+    if (thread->num_pending_eps == 0) {
+        return 0;
+    }
+
+    UCS_ASYNC_BLOCK(&thread->async);
+
+    /* Requests added during the pass are dispatched by the next one */
+    ucs_queue_splice(&thread->dispatch_q, &thread->pending_q);
+    gen = ++thread->pending_gen;
+
+    while (!ucs_queue_is_empty(&thread->dispatch_q)) {
+        pending = ucs_queue_pull_elem_non_empty(&thread->dispatch_q,
+                                                ucp_progress_thread_pending_t,
+                                                queue);
+        ep      = pending->ep;
+        iter    = kh_get(ucp_progress_thread_ep_hash, &thread->pending_eps,
+                         ep);
+        ucs_assert(iter != kh_end(&thread->pending_eps));
+
+        if (kh_val(&thread->pending_eps, iter).blocked_gen == gen) {
+            /* Keep the order of the endpoint requests */
+            ucs_queue_push(&thread->blocked_q, &pending->queue);
+            continue;
+        }
+
+        req                    = ucp_progress_thread_pending_req(pending);
+        thread->dispatching_ep = ep;
+        UCS_ASYNC_UNBLOCK(&thread->async);
+
+        do {
+            status = req->func(req);
+        } while (status == UCS_INPROGRESS);
+
+        UCS_ASYNC_BLOCK(&thread->async);
+        thread->dispatching_ep = NULL;
+
+        iter = kh_get(ucp_progress_thread_ep_hash, &thread->pending_eps, ep);
+        if (status == UCS_OK) {
+            ++count;
+            if ((iter != kh_end(&thread->pending_eps)) &&
+                (--kh_val(&thread->pending_eps, iter).count == 0)) {
+                kh_del(ucp_progress_thread_ep_hash, &thread->pending_eps,
+                       iter);
+                --thread->num_pending_eps;
+            }
+        } else if (iter != kh_end(&thread->pending_eps)) {
+            kh_val(&thread->pending_eps, iter).blocked_gen = gen;
+            ucs_queue_push(&thread->blocked_q, &pending->queue);
+        } else {
+            /* The other requests of the endpoint were purged by the callback,
+             * so keep the request as a new one */
+            ucp_progress_thread_ep_pending_add(ep, req, 0);
+        }
+    }
+
+    ucs_queue_splice(&thread->blocked_q, &thread->pending_q);
+    ucs_queue_splice(&thread->pending_q, &thread->blocked_q);
+
+    UCS_ASYNC_UNBLOCK(&thread->async);
+    return count;
+}
+
+unsigned ucp_progress_thread_dispatch(ucp_progress_thread_t *thread)
+{
+    uint32_t head  = thread->head;
+    uint32_t tail  = thread->tail;
+    unsigned count = tail - head;
+    ucp_progress_thread_msg_t *msg;
+
+    /* Read the entries only after reading the tail */
+    ucs_memory_cpu_load_fence();
+
+    for (; head != tail; ++head) {
+        msg          = thread->ring[head & UCP_PROGRESS_THREAD_RING_MASK];
+        /* The handler may destroy endpoints, which scrubs the next events */
+        thread->head = head + 1;
+        ucp_progress_thread_msg_handle(thread, msg);
+    }
+
+    if (ucs_unlikely(thread->detached)) {
+        /* There is no producer, so the events which did not fit the ring are
+         * handled here, and the interface is progressed by the worker */
+        ucs_queue_for_each_extract(msg, &thread->overflow, queue, 1) {
+            ucp_progress_thread_msg_handle(thread, msg);
+            ++count;
+        }
+
+        count += uct_worker_progress(thread->uct);
+        ucs_async_check_miss(&thread->async);
+    }
+
+    return count + ucp_progress_thread_pending_dispatch(thread);
+}
+
+int ucp_progress_thread_is_busy(const ucp_progress_thread_t *thread)
+{
+    return (thread->head != thread->tail) || (thread->num_pending_eps > 0);
+}
@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_PROGRESS_THREAD_H_
+#define UCP_PROGRESS_THREAD_H_
+
+#include <ucp/core/ucp_types.h>
+#include <uct/base/uct_iface.h>
+#include <ucs/async/async.h>
+#include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/mpool.h>
+#include <ucs/datastruct/queue_types.h>
+#include <ucs/type/spinlock.h>
+#include <ucs/type/status.h>
+#include <pthread.h>
+#include <stdint.h>
+
+
+/* Number of events a progress thread can queue, must be a power of 2. Events
+ * which do not fit are kept by the thread until the ring has room. */
+#define UCP_PROGRESS_THREAD_RING_SIZE 1024
+
+
+/**
+ * Type of an event received by a progress thread
+ */
+typedef enum {
+    UCP_PROGRESS_THREAD_MSG_AM,   /* Active message */
+    UCP_PROGRESS_THREAD_MSG_COMP, /* Send operation completion */
+    UCP_PROGRESS_THREAD_MSG_EP_ERR /* Endpoint error */
+} ucp_progress_thread_msg_type_t;
+
+
+/**
+ * Event received by a progress thread and not dispatched yet. Active message
+ * data follows the structure, in the layout of a UCT receive descriptor with
+ * @ref UCP_WORKER_HEADROOM_SIZE headroom.
+ */
+typedef struct {
+    ucs_queue_elem_t               queue;   /* Overflow queue element */
+    ucp_progress_thread_t          *thread;
+    ucp_progress_thread_msg_type_t type;
+    union {
+        struct {
+            size_t                 length;  /* Message length */
+            unsigned               flags;   /* UCT_CB_PARAM_FLAG_xx */
+            uint8_t                am_id;   /* Active message id */
+        } am;
+        struct {
+            uct_completion_t       super;   /* Passed to the transport */
+            uct_completion_t       *comp;   /* Completion of the caller */
+        } comp;
+        struct {
+            uct_ep_h               ep;      /* Failed endpoint, or NULL if it
+                                               was destroyed */
+            ucs_status_t           status;  /* Error status */
+        } ep_err;
+    };
+    uct_recv_desc_t                *release_desc; /* Must be last, releases
+                                                     the active message */
+} ucp_progress_thread_msg_t;
+
+
+/**
+ * Argument of the active message handlers of an interface which is progressed
+ * by a thread, identifies the message type.
+ */
+typedef struct {
+    ucp_progress_thread_t          *thread;
+    uint8_t                        am_id;
+} ucp_progress_thread_am_arg_t;
+
+
+/**
+ * Pending request of an endpoint, deferred by the thread to be dispatched when
+ * the worker is progressed. Kept in uct_pending_req_t::priv.
+ */
+typedef struct {
+    ucs_queue_elem_t               queue;
+    uct_ep_h                       ep;
+} ucp_progress_thread_pending_t;
+
+
+/**
+ * Deferred pending requests of an endpoint
+ */
+typedef struct {
+    unsigned                       count;       /* Number of requests */
+    unsigned                       blocked_gen; /* Dispatch pass in which the
+                                                   endpoint ran out of
+                                                   resources */
+} ucp_progress_thread_ep_t;
+
+
+KHASH_TYPE(ucp_progress_thread_ep_hash, uct_ep_h, ucp_progress_thread_ep_t);
+
+
+/**
+ * Thread which progresses a single interface of the worker. The interface is
+ * opened on a UCT worker and an async context owned by the thread, so it is
+ * progressed without the worker lock, and its operations are replaced by
+ * wrappers which take the thread async lock. Active messages, send completions
+ * and endpoint errors received by the thread are passed through a
+ * single-producer single-consumer ring to the thread which progresses the
+ * worker, and are handled there. Pending requests are deferred to the same
+ * thread as well, so worker callbacks are never called by the progress thread.
+ */
+struct ucp_progress_thread {
+    ucp_worker_iface_t             *wiface;      /* Progressed interface */
+    pthread_t                      thread_id;
+    int                            cpu;          /* CPU to run on, or -1 */
+    int                            started;      /* Thread is running */
+    int                            mpools_init;  /* Event pools are created */
+    int                            attached;     /* Interface operations are
+                                                    replaced */
+    volatile int                   stop;         /* Thread should exit */
+    int                            detached;     /* Interface was returned to
+                                                    the worker */
+
+    /* Serializes the interface between the thread and the worker, taken after
+     * the worker lock */
+    ucs_async_context_t            async;
+    uct_worker_h                   uct;          /* UCT worker of the interface */
+    uct_iface_ops_t                ops;          /* Transport operations */
+    uct_iface_internal_ops_t       *internal_ops;/* Transport internal
+                                                    operations */
+    uct_iface_internal_ops_t       locked_internal_ops;
+    uct_error_handler_t            err_handler;  /* Worker error handler */
+    void                           *err_handler_arg;
+
+    /* Events passed to the worker */
+    volatile uint32_t              head;         /* Next event to dispatch */
+    volatile uint32_t              tail;         /* Next event to fill */
+    ucp_progress_thread_msg_t      *ring[UCP_PROGRESS_THREAD_RING_SIZE];
+    ucs_queue_head_t               overflow;     /* Events which did not fit
+                                                    the ring */
+
+    /* Event memory, released by both threads */
+    ucs_spinlock_t                 mp_lock;
+    ucs_mpool_t                    small_mp;     /* Short and bcopy messages,
+                                                    completions and errors */
+    ucs_mpool_t                    large_mp;     /* Zcopy messages */
+    size_t                         small_size;   /* Max. message in small_mp */
+    size_t                         large_size;   /* Max. message in large_mp */
+    uct_recv_desc_t                release_desc;
+    ucp_progress_thread_am_arg_t   am_args[UCP_AM_ID_LAST];
+
+    /* Pending requests deferred to the worker */
+    ucs_queue_head_t               pending_q;    /* Requests to dispatch */
+    ucs_queue_head_t               dispatch_q;   /* Requests of current pass */
+    ucs_queue_head_t               blocked_q;    /* Requests which could not
+                                                    be dispatched in current
+                                                    pass */
+    khash_t(ucp_progress_thread_ep_hash) pending_eps;
+    unsigned                       num_pending_eps; /* Endpoints which have
+                                                       deferred requests */
+    unsigned                       pending_gen;  /* Dispatch pass number */
+    uct_ep_h                       dispatching_ep; /* Endpoint whose pending
+                                                      request is dispatched */
+};
+
+
+/**
+ * Create the UCT worker and the async context of a progress thread. The
+ * interface should be opened on @a thread->uct, and while the thread is not
+ * detached, its active message handlers should be set to
+ * @ref ucp_progress_thread_am_handler.
+ *
+ * @param [in]  wiface    Interface to progress, not opened yet.
+ * @param [out] thread_p  Filled with the new thread.
+ */
+ucs_status_t ucp_progress_thread_create(ucp_worker_iface_t *wiface,
+                                        ucp_progress_thread_t **thread_p);
+
+
+/**
+ * Replace the operations of the opened interface by wrappers which serialize
+ * them with the thread, and start the thread. From this point, the interface
+ * must not be progressed by the worker.
+ *
+ * @param [in]  thread    Thread to start.
+ * @param [in]  cpu       CPU to pin the thread to, or -1 to not pin it.
+ */
+ucs_status_t ucp_progress_thread_start(ucp_progress_thread_t *thread, int cpu);
+
+
+/**
+ * Stop and join the thread, return the interface operations and the deferred
+ * pending requests to the transport. Must be called with the worker lock held.
+ * The events queued by the thread should be dispatched after the worker
+ * active message handlers are restored, and from this point the interface is
+ * progressed by @ref ucp_progress_thread_dispatch.
+ */
+void ucp_progress_thread_stop(ucp_progress_thread_t *thread);
+
+
+/**
+ * Release a stopped thread, after its interface is closed.
+ */
+void ucp_progress_thread_destroy(ucp_progress_thread_t *thread);
+
+
+/**
+ * Handle the events received by the thread, in arrival order, and dispatch the
+ * deferred pending requests. If the thread is stopped, progress its interface
+ * as well. Must be called by the thread which progresses the worker.
+ *
+ * @return Number of handled events and completed pending requests.
+ */
+unsigned ucp_progress_thread_dispatch(ucp_progress_thread_t *thread);
+
+
+/**
+ * Check whether the thread has events or pending requests which were not
+ * dispatched yet.
+ */
+int ucp_progress_thread_is_busy(const ucp_progress_thread_t *thread);
+
+
+/**
+ * Active message handler to set on the progressed interface instead of the
+ * worker handler, with @ref ucp_progress_thread_am_arg_t argument.
+ */
+ucs_status_t ucp_progress_thread_am_handler(void *arg, void *data,
+                                            size_t length, unsigned flags);
+
+#endif
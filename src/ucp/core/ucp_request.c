@@ -8,6 +8,7 @@
 #  include "config.h"
 #endif
 
+#include "ucp_aggr.h"
 #include "ucp_context.h"
 #include "ucp_worker.h"
 #include "ucp_request.inl"
@@ -332,6 +333,7 @@ int ucp_request_pending_add(ucp_request_t *req)
         ucs_trace_data("ep %p: added pending uct request %p to lane[%d]=%p",
                        req->send.ep, req, req->send.lane, uct_ep);
         req->send.pending_lane = req->send.lane;
+        UCP_REQUEST_TRACE_STAMP(req, PENDING);
         return 1;
     } else if (status == UCS_ERR_BUSY) {
         /* Could not add, try to send again */
@@ -674,7 +676,8 @@ void ucp_request_send_state_ff(ucp_request_t *req, ucs_status_t status)
 
     if (req->send.uct.func == ucp_proto_progress_am_single) {
         req->send.proto.comp_cb(req);
-    } else if (req->send.uct.func == ucp_wireup_msg_progress) {
+    } else if ((req->send.uct.func == ucp_wireup_msg_progress) ||
+               (req->send.uct.func == ucp_ep_aggr_progress)) {
         ucs_free(req->send.buffer);
         ucp_request_mem_free(req);
     } else if (req->send.state.uct_comp.func == ucp_ep_flush_completion) {
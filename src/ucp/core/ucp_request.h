@@ -24,6 +24,7 @@
 #include <ucp/wireup/wireup.h>
 #include <ucp/core/ucp_am.h>
 #include <ucp/core/ucp_worker.h>
+#include <ucp/core/ucp_request_trace.h>
 
 
 #define ucp_trace_req(_sreq, _message, ...) \
@@ -37,6 +38,7 @@ enum {
     UCP_REQUEST_FLAG_COMPLETED             = UCS_BIT(0),
     UCP_REQUEST_FLAG_RELEASED              = UCS_BIT(1),
     UCP_REQUEST_FLAG_PROTO_SEND            = UCS_BIT(2),
+    UCP_REQUEST_FLAG_PROTO_FEEDBACK        = UCS_BIT(3),
     UCP_REQUEST_FLAG_SYNC_LOCAL_COMPLETED  = UCS_BIT(4),
     UCP_REQUEST_FLAG_SYNC_REMOTE_COMPLETED = UCS_BIT(5),
     UCP_REQUEST_FLAG_CALLBACK              = UCS_BIT(6),
@@ -62,7 +64,12 @@ enum {
 #else
     UCP_REQUEST_FLAG_STREAM_RECV           = 0,
     UCP_REQUEST_DEBUG_FLAG_EXTERNAL        = 0,
-    UCP_REQUEST_FLAG_SUPER_VALID           = 0
+    UCP_REQUEST_FLAG_SUPER_VALID           = 0,
+#endif
+#if ENABLE_REQUEST_TRACE
+    UCP_REQUEST_FLAG_TRACE                 = UCS_BIT(25)
+#else
+    UCP_REQUEST_FLAG_TRACE                 = 0
 #endif
 };
 
@@ -155,6 +162,12 @@ struct ucp_request {
                                              flush/proto requests */
 
             const ucp_proto_config_t *proto_config; /* Selected protocol for the request */
+            ucs_time_t              start_time; /* Send start time, used to
+                                                   measure protocol performance */
+#if ENABLE_REQUEST_TRACE
+            ucp_request_trace_t     trace; /* Stage timestamps of a sampled
+                                              request */
+#endif
 
             /* This structure holds all mutable fields, and everything else
              * except common send/recv fields 'status' and 'flags' is immutable
@@ -13,6 +13,7 @@
 #include "ucp_mm.inl"
 
 #include <ucp/dt/dt.h>
+#include <ucp/proto/proto_feedback.h>
 #include <ucs/profile/profile.h>
 #include <ucs/datastruct/mpool.inl>
 #include <ucs/datastruct/mpool_set.inl>
@@ -248,6 +249,13 @@ ucp_request_complete_send(ucp_request_t *req, ucs_status_t status)
                   req, req + 1, UCP_REQUEST_FLAGS_ARG(req->flags),
                   ucs_status_string(status));
     UCS_PROFILE_REQUEST_EVENT(req, "complete_send", status);
+    if (ucs_unlikely(req->flags & UCP_REQUEST_FLAG_PROTO_FEEDBACK) &&
+        (status == UCS_OK)) {
+        ucp_proto_feedback_sample(req);
+    }
+    if (ucs_unlikely(req->flags & UCP_REQUEST_FLAG_TRACE)) {
+        ucp_request_trace_complete(req, status);
+    }
     /* Coverity wrongly resolves completion callback function to
      * 'ucp_cm_client_connect_progress'/'ucp_cm_server_conn_request_progress'
      */
@@ -365,6 +373,8 @@ ucp_request_send_state_init(ucp_request_t *req, ucp_datatype_t datatype,
         req->send.state.dt.dt.iov.iovcnt        = dt_count;
         req->send.state.dt.dt.iov.memhs         = NULL;
         return;
+    case UCP_DATATYPE_STRIDED:
+        return;
     case UCP_DATATYPE_GENERIC:
         dt_gen    = ucp_dt_to_generic(datatype);
         state_gen = dt_gen->ops.start_pack(dt_gen->context, req->send.buffer,
@@ -0,0 +1,371 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ucp_request_trace.h"
+
+#include <ucp/core/ucp_context.h>
+#include <ucp/core/ucp_ep.h>
+#include <ucp/core/ucp_request.h>
+#include <ucp/core/ucp_worker.h>
+#include <ucp/proto/proto_select.inl>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/stats/stats.h>
+#include <ucs/sys/string.h>
+#include <ucs/time/time.h>
+#include <stdio.h>
+
+
+#if ENABLE_REQUEST_TRACE
+
+enum {
+    UCP_REQUEST_TRACE_STAT_REQUESTS,
+    UCP_REQUEST_TRACE_STAT_PENDING,
+    UCP_REQUEST_TRACE_STAT_SELECTED_NSEC,
+    UCP_REQUEST_TRACE_STAT_PENDING_NSEC,
+    UCP_REQUEST_TRACE_STAT_POSTED_NSEC,
+    UCP_REQUEST_TRACE_STAT_REMOTE_NSEC,
+    UCP_REQUEST_TRACE_STAT_COMPLETE_NSEC,
+    UCP_REQUEST_TRACE_STAT_LAST
+};
+
+
+static const char *ucp_request_trace_stage_names[] = {
+    [UCP_REQUEST_TRACE_STAGE_SUBMIT]   = "submit",
+    [UCP_REQUEST_TRACE_STAGE_SELECTED] = "selected",
+    [UCP_REQUEST_TRACE_STAGE_PENDING]  = "pending",
+    [UCP_REQUEST_TRACE_STAGE_POSTED]   = "posted",
+    [UCP_REQUEST_TRACE_STAGE_REMOTE]   = "remote",
+    [UCP_REQUEST_TRACE_STAGE_COMPLETE] = "complete"
+};
+
+
+#ifdef ENABLE_STATS
+static ucs_stats_class_t ucp_request_trace_stats_class = {
+    .name          = "request_trace",
+    .num_counters  = UCP_REQUEST_TRACE_STAT_LAST,
+    .class_id      = UCS_STATS_CLASS_ID_INVALID,
+    .counter_names = {
+        [UCP_REQUEST_TRACE_STAT_REQUESTS]      = "requests",
+        [UCP_REQUEST_TRACE_STAT_PENDING]       = "pending",
+        [UCP_REQUEST_TRACE_STAT_SELECTED_NSEC] = "selected_nsec",
+        [UCP_REQUEST_TRACE_STAT_PENDING_NSEC]  = "pending_nsec",
+        [UCP_REQUEST_TRACE_STAT_POSTED_NSEC]   = "posted_nsec",
+        [UCP_REQUEST_TRACE_STAT_REMOTE_NSEC]   = "remote_nsec",
+        [UCP_REQUEST_TRACE_STAT_COMPLETE_NSEC] = "complete_nsec"
+    }
+};
+
+
+/* Statistics counter of the total time from submission to each stage */
+static const int ucp_request_trace_stage_counters[] = {
+    [UCP_REQUEST_TRACE_STAGE_SUBMIT]   = -1,
+    [UCP_REQUEST_TRACE_STAGE_SELECTED] = UCP_REQUEST_TRACE_STAT_SELECTED_NSEC,
+    [UCP_REQUEST_TRACE_STAGE_PENDING]  = UCP_REQUEST_TRACE_STAT_PENDING_NSEC,
+    [UCP_REQUEST_TRACE_STAGE_POSTED]   = UCP_REQUEST_TRACE_STAT_POSTED_NSEC,
+    [UCP_REQUEST_TRACE_STAGE_REMOTE]   = UCP_REQUEST_TRACE_STAT_REMOTE_NSEC,
+    [UCP_REQUEST_TRACE_STAGE_COMPLETE] = UCP_REQUEST_TRACE_STAT_COMPLETE_NSEC
+};
+#endif
+
+
+ucs_status_t ucp_request_trace_init(ucp_worker_h worker)
+{
+    ucp_context_h context = worker->context;
+    unsigned sample       = context->config.ext.request_trace_sample;
+    unsigned buffer_size  = context->config.ext.request_trace_buffer_size;
+    ucp_request_trace_ctx_t *trace;
+    ucs_status_t status;
+
+    worker->request_trace = NULL;
+    if (sample == 0) {
+        return UCS_OK;
+    }
+
+    trace = ucs_malloc(sizeof(*trace), "ucp_request_trace");
+    if (trace == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    trace->stats = ucs_calloc(ucp_protocols_count(), sizeof(*trace->stats),
+                              "ucp_request_trace_stats");
+    if (trace->stats == NULL) {
+        status = UCS_ERR_NO_MEMORY;
+        goto err_free_trace;
+    }
+
+    trace->sample = sample;
+    trace->count  = 0;
+    ucs_array_init_dynamic(&trace->records);
+
+    /* Allocate the record buffer once, it is written to the file when full */
+    if ((context->config.ext.request_trace_file[0] != '\0') &&
+        (buffer_size > 0)) {
+        status = ucs_array_reserve(&trace->records, buffer_size);
+        if (status != UCS_OK) {
+            goto err_free_stats;
+        }
+    }
+
+    worker->request_trace = trace;
+    return UCS_OK;
+
+err_free_stats:
+    ucs_free(trace->stats);
+err_free_trace:
+    ucs_free(trace);
+    return status;
+}
+
+static void ucp_request_trace_write_names(FILE *stream, const char **names,
+                                          unsigned count)
+{
+    char name[UCP_REQUEST_TRACE_NAME_MAX];
+    unsigned i;
+
+    for (i = 0; i < count; ++i) {
+        memset(name, 0, sizeof(name));
+        ucs_strncpy_zero(name, names[i], sizeof(name));
+        fwrite(name, sizeof(name), 1, stream);
+    }
+}
+
+static void ucp_request_trace_write(ucp_worker_h worker)
+{
+    ucp_request_trace_ctx_t *trace = worker->request_trace;
+    unsigned num_protocols         = ucp_protocols_count();
+    const char *proto_names[num_protocols];
+    ucp_request_trace_header_t header;
+    char file_path[PATH_MAX];
+    unsigned proto_id;
+    FILE *stream;
+
+    ucs_fill_filename_template(worker->context->config.ext.request_trace_file,
+                               file_path, sizeof(file_path));
+    stream = fopen(file_path, "a");
+    if (stream == NULL) {
+        ucs_error("failed to open request trace file '%s': %m", file_path);
+        return;
+    }
+
+    header.magic         = UCP_REQUEST_TRACE_FILE_MAGIC;
+    header.version       = UCP_REQUEST_TRACE_FILE_VERSION;
+    header.num_stages    = UCP_REQUEST_TRACE_STAGE_LAST;
+    header.num_ops       = UCP_OP_ID_LAST;
+    header.num_protocols = num_protocols;
+    header.one_second    = ucs_time_from_sec(1.0);
+    header.num_records   = ucs_array_length(&trace->records);
+    fwrite(&header, sizeof(header), 1, stream);
+
+    for (proto_id = 0; proto_id < num_protocols; ++proto_id) {
+        proto_names[proto_id] = ucp_proto_id_field(proto_id, name);
+    }
+
+    ucp_request_trace_write_names(stream, ucp_request_trace_stage_names,
+                                  UCP_REQUEST_TRACE_STAGE_LAST);
+    ucp_request_trace_write_names(stream, ucp_operation_names,
+                                  UCP_OP_ID_LAST);
+    ucp_request_trace_write_names(stream, proto_names, num_protocols);
+    fwrite(ucs_array_begin(&trace->records), sizeof(ucp_request_trace_record_t),
+           ucs_array_length(&trace->records), stream);
+
+    if (fclose(stream) != 0) {
+        ucs_error("failed to write request trace file '%s': %m", file_path);
+        return;
+    }
+
+    ucs_debug("worker %p: wrote %zu traced requests to '%s'", worker,
+              ucs_array_length(&trace->records), file_path);
+}
+
+static void ucp_request_trace_flush(ucp_worker_h worker)
+{
+    ucp_request_trace_ctx_t *trace = worker->request_trace;
+
+    if (!ucs_array_is_empty(&trace->records)) {
+        ucp_request_trace_write(worker);
+        ucs_array_clear(&trace->records);
+    }
+}
+
+void ucp_request_trace_cleanup(ucp_worker_h worker)
+{
+    ucp_request_trace_ctx_t *trace = worker->request_trace;
+    unsigned UCS_V_UNUSED proto_id;
+
+    if (trace == NULL) {
+        return;
+    }
+
+    ucp_request_trace_flush(worker);
+
+    for (proto_id = 0; proto_id < ucp_protocols_count(); ++proto_id) {
+        UCS_STATS_NODE_FREE(trace->stats[proto_id]);
+    }
+
+    ucs_array_cleanup_dynamic(&trace->records);
+    ucs_free(trace->stats);
+    ucs_free(trace);
+    worker->request_trace = NULL;
+}
+
+void ucp_request_trace_start(ucp_worker_h worker, ucp_request_t *req)
+{
+    worker->request_trace->count = 0;
+    req->flags                  |= UCP_REQUEST_FLAG_TRACE;
+    memset(req->send.trace.stamps, 0, sizeof(req->send.trace.stamps));
+    req->send.trace.stamps[UCP_REQUEST_TRACE_STAGE_SUBMIT] = ucs_get_time();
+}
+
+/*
+ * Intercepts the protocol progress function until it posts something, to
+ * stamp the first post whether it is done by the user call or from a pending
+ * queue.
+ */
+static ucs_status_t ucp_request_trace_progress(uct_pending_req_t *self)
+{
+    ucp_request_t *req = ucs_container_of(self, ucp_request_t, send.uct);
+    ucs_status_t status;
+
+    req->send.uct.func = req->send.trace.progress;
+    req->send.trace.stamps[UCP_REQUEST_TRACE_STAGE_POSTED] = ucs_get_time();
+
+    /* The request must not be accessed if it was completed */
+    status = req->send.uct.func(self);
+    if (status == UCS_ERR_NO_RESOURCE) {
+        req->send.trace.stamps[UCP_REQUEST_TRACE_STAGE_POSTED] = 0;
+        req->send.trace.progress = req->send.uct.func;
+        req->send.uct.func       = ucp_request_trace_progress;
+    }
+
+    return status;
+}
+
+void ucp_request_trace_selected(ucp_request_t *req)
+{
+    req->send.trace.stamps[UCP_REQUEST_TRACE_STAGE_SELECTED] = ucs_get_time();
+    req->send.trace.progress = req->send.uct.func;
+    req->send.uct.func       = ucp_request_trace_progress;
+}
+
+static unsigned ucp_request_trace_proto_id(const ucp_proto_config_t *config)
+{
+    unsigned proto_id;
+
+    if (config->init_elem != NULL) {
+        return config->init_elem->proto_id;
+    }
+
+    for (proto_id = 0; ucp_protocols[proto_id] != config->proto; ++proto_id) {
+        ucs_assert(proto_id < ucp_protocols_count());
+    }
+
+    return proto_id;
+}
+
+void ucp_request_trace_complete(ucp_request_t *req, ucs_status_t status)
+{
+    const ucp_proto_config_t *proto_config = req->send.proto_config;
+    ucp_worker_h worker                    = req->send.ep->worker;
+    ucp_request_trace_ctx_t *trace         = worker->request_trace;
+    ucs_time_t *stamps                     = req->send.trace.stamps;
+    ucp_request_trace_record_t *record;
+    unsigned proto_id, stage;
+#ifdef ENABLE_STATS
+    ucs_stats_node_t *stats;
+    ucs_status_t stats_status;
+#endif
+
+    req->flags &= ~UCP_REQUEST_FLAG_TRACE;
+    if ((status != UCS_OK) || (trace == NULL)) {
+        return;
+    }
+
+    stamps[UCP_REQUEST_TRACE_STAGE_COMPLETE] = ucs_get_time();
+    proto_id = ucp_request_trace_proto_id(proto_config);
+
+#ifdef ENABLE_STATS
+    if (trace->stats[proto_id] == NULL) {
+        stats_status = UCS_STATS_NODE_ALLOC(&trace->stats[proto_id],
+                                            &ucp_request_trace_stats_class,
+                                            worker->stats, "-%s",
+                                            ucp_proto_id_field(proto_id, name));
+        if (stats_status != UCS_OK) {
+            trace->stats[proto_id] = NULL;
+        }
+    }
+
+    stats = trace->stats[proto_id];
+    UCS_STATS_UPDATE_COUNTER(stats, UCP_REQUEST_TRACE_STAT_REQUESTS, 1);
+    UCS_STATS_UPDATE_COUNTER(stats, UCP_REQUEST_TRACE_STAT_PENDING,
+                             stamps[UCP_REQUEST_TRACE_STAGE_PENDING] != 0);
+    for (stage = UCP_REQUEST_TRACE_STAGE_SUBMIT + 1;
+         stage < UCP_REQUEST_TRACE_STAGE_LAST; ++stage) {
+        if (stamps[stage] != 0) {
+            UCS_STATS_UPDATE_COUNTER(stats,
+                                     ucp_request_trace_stage_counters[stage],
+                                     ucs_time_to_nsec(
+                                         stamps[stage] -
+                                         stamps[UCP_REQUEST_TRACE_STAGE_SUBMIT]));
+        }
+    }
+#endif
+
+    if (worker->context->config.ext.request_trace_file[0] == '\0') {
+        return;
+    }
+
+    record = ucs_array_append(&trace->records,
+                              ucs_error("failed to allocate request trace record");
+                              return);
+    record->length   = req->send.state.dt_iter.length;
+    record->proto_id = proto_id;
+    record->op_id    = ucp_proto_select_op_id(&proto_config->select_param);
+    memset(record->reserved, 0, sizeof(record->reserved));
+    for (stage = 0; stage < UCP_REQUEST_TRACE_STAGE_LAST; ++stage) {
+        record->stamps[stage] = stamps[stage];
+    }
+
+    if (ucs_array_length(&trace->records) >=
+        worker->context->config.ext.request_trace_buffer_size) {
+        ucp_request_trace_flush(worker);
+    }
+}
+
+#else
+
+ucs_status_t ucp_request_trace_init(ucp_worker_h worker)
+{
+    worker->request_trace = NULL;
+    if (worker->context->config.ext.request_trace_sample != 0) {
+        ucs_warn("UCX_REQUEST_TRACE_SAMPLE is ignored: UCX was built without "
+                 "--enable-request-trace");
+    }
+
+    return UCS_OK;
+}
+
+void ucp_request_trace_cleanup(ucp_worker_h worker)
+{
+}
+
+void ucp_request_trace_start(ucp_worker_h worker, ucp_request_t *req)
+{
+}
+
+void ucp_request_trace_selected(ucp_request_t *req)
+{
+}
+
+void ucp_request_trace_complete(ucp_request_t *req, ucs_status_t status)
+{
+}
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_REQUEST_TRACE_H_
+#define UCP_REQUEST_TRACE_H_
+
+#include <ucp/core/ucp_types.h>
+#include <ucs/datastruct/array.h>
+#include <ucs/stats/stats_fwd.h>
+#include <ucs/time/time_def.h>
+#include <stdint.h>
+
+
+#define UCP_REQUEST_TRACE_FILE_MAGIC   0x45434152545055ul /* "UPTRACE" */
+#define UCP_REQUEST_TRACE_FILE_VERSION 1u
+#define UCP_REQUEST_TRACE_NAME_MAX     32
+
+
+/**
+ * Stages of a send request lifetime. Each traced request records the time it
+ * reached every stage, or 0 if it did not go through the stage.
+ */
+typedef enum {
+    UCP_REQUEST_TRACE_STAGE_SUBMIT,   /* Request was created by the user call */
+    UCP_REQUEST_TRACE_STAGE_SELECTED, /* Protocol was selected */
+    UCP_REQUEST_TRACE_STAGE_PENDING,  /* First time added to a pending queue */
+    UCP_REQUEST_TRACE_STAGE_POSTED,   /* First fragment (or RTS) was posted */
+    UCP_REQUEST_TRACE_STAGE_REMOTE,   /* Rendezvous reply (RTR or ATS) arrived,
+                                         that is the peer matched the RTS */
+    UCP_REQUEST_TRACE_STAGE_COMPLETE, /* Request was completed */
+    UCP_REQUEST_TRACE_STAGE_LAST
+} ucp_request_trace_stage_t;
+
+
+/*
+ * Trace file format: one or more blocks, written by a worker whenever its
+ * record buffer is full and when it is destroyed, each having
+ *
+ *  +-------------------------------+
+ *  | ucp_request_trace_header_t    |
+ *  +-------------------------------+
+ *  | stage names                   | num_stages * UCP_REQUEST_TRACE_NAME_MAX
+ *  | operation names               | num_ops * UCP_REQUEST_TRACE_NAME_MAX
+ *  | protocol names                | num_protocols * UCP_REQUEST_TRACE_NAME_MAX
+ *  +-------------------------------+
+ *  | ucp_request_trace_record_t    | num_records
+ *  | ...                           |
+ *  +-------------------------------+
+ */
+typedef struct {
+    uint64_t magic;         /* UCP_REQUEST_TRACE_FILE_MAGIC */
+    uint32_t version;       /* UCP_REQUEST_TRACE_FILE_VERSION */
+    uint32_t num_stages;    /* Number of timestamps in a record */
+    uint32_t num_ops;       /* Number of operation names */
+    uint32_t num_protocols; /* Number of protocol names */
+    uint64_t one_second;    /* Timestamps per second */
+    uint64_t num_records;   /* Number of records in the block */
+} UCS_S_PACKED ucp_request_trace_header_t;
+
+
+typedef struct {
+    uint64_t length;        /* Message length */
+    uint16_t proto_id;      /* Protocol which completed the request */
+    uint8_t  op_id;         /* Operation type */
+    uint8_t  reserved[5];
+    uint64_t stamps[UCP_REQUEST_TRACE_STAGE_LAST]; /* Per-stage timestamps */
+} UCS_S_PACKED ucp_request_trace_record_t;
+
+
+/**
+ * Per-request stage timestamps
+ */
+typedef struct {
+    ucs_time_t             stamps[UCP_REQUEST_TRACE_STAGE_LAST];
+    uct_pending_callback_t progress; /* Protocol progress function, replaced
+                                        until the first fragment is posted */
+} ucp_request_trace_t;
+
+
+/**
+ * Per-worker tracing state
+ */
+typedef struct {
+    unsigned         sample;  /* Trace one of every 'sample' requests */
+    unsigned         count;   /* Requests since the last traced one */
+    ucs_stats_node_t **stats; /* Per-protocol statistics nodes */
+    ucs_array_s(size_t, ucp_request_trace_record_t) records; /* Buffered
+                                                                records to
+                                                                write to the
+                                                                trace file */
+} ucp_request_trace_ctx_t;
+
+
+#if ENABLE_REQUEST_TRACE
+
+/* Decide whether to trace a new request, and start tracing it */
+#define UCP_REQUEST_TRACE_START(_worker, _req) \
+    do { \
+        if (ucs_unlikely((_worker)->request_trace != NULL) && \
+            (++(_worker)->request_trace->count >= \
+             (_worker)->request_trace->sample)) { \
+            ucp_request_trace_start(_worker, _req); \
+        } \
+    } while (0)
+
+#define UCP_REQUEST_TRACE_STAMP(_req, _stage) \
+    do { \
+        if (ucs_unlikely((_req)->flags & UCP_REQUEST_FLAG_TRACE) && \
+            ((_req)->send.trace.stamps[UCP_REQUEST_TRACE_STAGE_##_stage] == \
+             0)) { \
+            (_req)->send.trace.stamps[UCP_REQUEST_TRACE_STAGE_##_stage] = \
+                    ucs_get_time(); \
+        } \
+    } while (0)
+
+#define UCP_REQUEST_TRACE_SELECTED(_req) \
+    do { \
+        if (ucs_unlikely((_req)->flags & UCP_REQUEST_FLAG_TRACE)) { \
+            ucp_request_trace_selected(_req); \
+        } \
+    } while (0)
+
+#else
+
+#define UCP_REQUEST_TRACE_START(_worker, _req)  do { } while (0)
+#define UCP_REQUEST_TRACE_STAMP(_req, _stage)   do { } while (0)
+#define UCP_REQUEST_TRACE_SELECTED(_req)        do { } while (0)
+
+#endif
+
+
+/**
+ * Create the tracing state of a worker, if tracing is enabled by configuration.
+ */
+ucs_status_t ucp_request_trace_init(ucp_worker_h worker);
+
+
+/**
+ * Write the buffered records to the trace file and release the tracing state
+ * of a worker.
+ */
+void ucp_request_trace_cleanup(ucp_worker_h worker);
+
+
+/**
+ * Start tracing a send request, and stamp its submission.
+ */
+void ucp_request_trace_start(ucp_worker_h worker, ucp_request_t *req);
+
+
+/**
+ * Stamp the protocol selection of a traced request, and intercept its progress
+ * function to stamp the first post.
+ */
+void ucp_request_trace_selected(ucp_request_t *req);
+
+
+/**
+ * Account a completed traced request in the statistics and the trace file.
+ */
+void ucp_request_trace_complete(ucp_request_t *req, ucs_status_t status);
+
+#endif
@@ -67,6 +67,7 @@ typedef struct ucp_recv_desc          ucp_recv_desc_t;
 typedef struct ucp_address_iface_attr ucp_address_iface_attr_t;
 typedef struct ucp_address_entry      ucp_address_entry_t;
 typedef struct ucp_unpacked_address   ucp_unpacked_address_t;
+typedef struct ucp_address_profile    ucp_address_profile_t;
 typedef struct ucp_wireup_ep          ucp_wireup_ep_t;
 typedef struct ucp_request_send_proto ucp_request_send_proto_t;
 typedef struct ucp_worker_iface       ucp_worker_iface_t;
@@ -78,6 +79,8 @@ typedef struct ucp_ep_config_key      ucp_ep_config_key_t;
 typedef struct ucp_rkey_config_key    ucp_rkey_config_key_t;
 typedef struct ucp_proto              ucp_proto_t;
 typedef struct ucp_mem_desc           ucp_mem_desc_t;
+typedef struct ucp_ep_aggr            ucp_ep_aggr_t;
+typedef struct ucp_progress_thread    ucp_progress_thread_t;
 
 
 /**
@@ -201,6 +204,7 @@ typedef enum {
                                           defined AM */
     UCP_AM_ID_AM_SINGLE_REPLY   =  26, /* Single fragment user defined AM
                                           carrying remote ep for reply */
+    UCP_AM_ID_AGGREGATE         =  27, /* Several aggregated messages */
     UCP_AM_ID_LAST
 } ucp_am_id_t;
 
@@ -9,12 +9,15 @@
 #  include "config.h"
 #endif
 
+#include "ucp_aggr.h"
 #include "ucp_am.h"
 #include "ucp_ep_vfs.h"
+#include "ucp_progress_thread.h"
 #include "ucp_worker.h"
 #include "ucp_rkey.h"
 #include "ucp_request.inl"
 
+#include <ucp/proto/proto_cache.h>
 #include <ucp/proto/proto_common.inl>
 #include <ucp/wireup/address.h>
 #include <ucp/wireup/wireup_cm.h>
@@ -47,6 +50,10 @@
 #define UCP_WORKER_USAGE_TRACKER_EXP_DECAY_MULTIPLIER 0.8
 #define UCP_WORKER_USAGE_TRACKER_EXP_DECAY_ADDER      0.2
 
+/* Weight of a new interval in the average time ucp_worker_wait waits for an
+ * event, as a power of 2 divisor */
+#define UCP_WORKER_WAIT_AVG_SHIFT 3
+
 
 #define UCP_WIFACE_FMT "iface %p (" UCT_TL_RESOURCE_DESC_FMT ")"
 #define UCP_WIFACE_ARG(_wiface) \
@@ -97,7 +104,9 @@ static ucs_stats_class_t ucp_worker_stats_class = {
         [UCP_WORKER_STAT_RNDV_GET_ZCOPY]           = "rndv_get_zcopy",
         [UCP_WORKER_STAT_RNDV_RTR]                 = "rndv_rtr",
         [UCP_WORKER_STAT_RNDV_RTR_MTYPE]           = "rndv_rtr_mtype",
-        [UCP_WORKER_STAT_RNDV_RKEY_PTR]            = "rndv_rkey_ptr"
+        [UCP_WORKER_STAT_RNDV_RKEY_PTR]            = "rndv_rkey_ptr",
+        [UCP_WORKER_STAT_WAIT_BUSY_POLL]           = "wait_busy_poll",
+        [UCP_WORKER_STAT_WAIT_BLOCK]               = "wait_block"
     }
 };
 #endif
@@ -203,7 +212,15 @@ static void ucp_worker_set_am_handlers(ucp_worker_iface_t *wiface, int is_proxy)
             continue;
         }
 
-        if (is_proxy && (ucp_am_handlers[am_id]->proxy_cb != NULL)) {
+        if ((wiface->progress_thread != NULL) &&
+            !wiface->progress_thread->detached) {
+            /* Queue the messages received by the progress thread, to be
+             * handled by the thread which progresses the worker */
+            status = uct_iface_set_am_handler(
+                    wiface->iface, am_id, ucp_progress_thread_am_handler,
+                    &wiface->progress_thread->am_args[am_id],
+                    ucp_am_handlers[am_id]->flags);
+        } else if (is_proxy && (ucp_am_handlers[am_id]->proxy_cb != NULL)) {
             /* we care only about sync active messages, and this also makes sure
              * the counter is not accessed from another thread.
              */
@@ -1319,6 +1336,7 @@ ucs_status_t ucp_worker_iface_open(ucp_worker_h worker, ucp_rsc_index_t tl_id,
     uct_iface_config_t *iface_config;
     ucp_worker_iface_t *wiface;
     ucs_sys_dev_distance_t distance;
+    uct_worker_h uct_worker;
     ucs_status_t status;
 
     wiface = ucs_calloc(1, sizeof(*wiface), "ucp_iface");
@@ -1334,12 +1352,27 @@ ucs_status_t ucp_worker_iface_open(ucp_worker_h worker, ucp_rsc_index_t tl_id,
     wiface->proxy_recv_count = 0;
     wiface->post_count       = 0;
     wiface->flags            = 0;
+    wiface->progress_thread  = NULL;
+
+    if (ucs_config_names_search(&context->config.ext.progress_thread_tls,
+                                resource->tl_rsc.tl_name) >= 0) {
+        /* The interface is progressed by a dedicated thread, which owns its
+         * UCT worker and async context */
+        status = ucp_progress_thread_create(wiface, &wiface->progress_thread);
+        if (status != UCS_OK) {
+            goto err_free_iface;
+        }
+
+        uct_worker = wiface->progress_thread->uct;
+    } else {
+        uct_worker = worker->uct;
+    }
 
     /* Read interface or md configuration */
     status = uct_md_iface_config_read(md, resource->tl_rsc.tl_name, NULL, NULL,
                                       &iface_config);
     if (status != UCS_OK) {
-        goto err_free_iface;
+        goto err_destroy_progress_thread;
     }
 
     ucp_apply_uct_config_list(context, iface_config);
@@ -1404,7 +1437,7 @@ ucs_status_t ucp_worker_iface_open(ucp_worker_h worker, ucp_rsc_index_t tl_id,
     iface_params.features    = ucp_worker_get_uct_features(context);
 
     /* Open UCT interface */
-    status = uct_iface_open(md, worker->uct, &iface_params, iface_config,
+    status = uct_iface_open(md, uct_worker, &iface_params, iface_config,
                             &wiface->iface);
     uct_config_release(iface_config);
 
@@ -1412,7 +1445,7 @@ ucs_status_t ucp_worker_iface_open(ucp_worker_h worker, ucp_rsc_index_t tl_id,
         ucs_error("uct_iface_open(" UCT_TL_RESOURCE_DESC_FMT ") failed: %s",
                   UCT_TL_RESOURCE_DESC_ARG(&resource->tl_rsc),
                   ucs_status_string(status));
-        goto err_free_iface;
+        goto err_destroy_progress_thread;
     }
 
     VALGRIND_MAKE_MEM_UNDEFINED(&wiface->attr, sizeof(wiface->attr));
@@ -1440,6 +1473,10 @@ ucs_status_t ucp_worker_iface_open(ucp_worker_h worker, ucp_rsc_index_t tl_id,
 
 err_close_iface:
     uct_iface_close(wiface->iface);
+err_destroy_progress_thread:
+    if (wiface->progress_thread != NULL) {
+        ucp_progress_thread_destroy(wiface->progress_thread);
+    }
 err_free_iface:
     ucs_free(wiface);
     return status;
@@ -1528,6 +1565,9 @@ void ucp_worker_iface_cleanup(ucp_worker_iface_t *wiface)
     ucp_worker_iface_disarm(wiface);
     ucp_worker_iface_remove_event_handler(wiface);
     ucp_worker_uct_iface_close(wiface);
+    if (wiface->progress_thread != NULL) {
+        ucp_progress_thread_destroy(wiface->progress_thread);
+    }
     ucs_free(wiface);
 }
 
@@ -2263,6 +2303,8 @@ static void ucp_worker_destroy_configs(ucp_worker_h worker)
     ucp_ep_config_t *ep_config;
     ucp_rkey_config_t *rkey_config;
 
+    ucp_proto_cache_destroy(worker);
+
     ucs_array_for_each(ep_config, &worker->ep_config) {
         ucp_ep_config_cleanup(worker, ep_config);
     }
@@ -2471,6 +2513,231 @@ static void ucp_worker_usage_tracker_destroy(ucp_worker_h worker)
     ucs_usage_tracker_destroy(worker->usage_tracker.handle);
 }
 
+static unsigned ucp_worker_progress_threads_dispatch(void *arg)
+{
+    ucp_worker_h worker = arg;
+    unsigned count      = 0;
+    unsigned i;
+
+    for (i = 0; i < worker->progress_threads.count; ++i) {
+        count += ucp_progress_thread_dispatch(
+                worker->progress_threads.threads[i]);
+    }
+
+    return count;
+}
+
+static int ucp_worker_progress_threads_is_busy(ucp_worker_h worker)
+{
+    unsigned i;
+
+    for (i = 0; i < worker->progress_threads.count; ++i) {
+        if (ucp_progress_thread_is_busy(worker->progress_threads.threads[i])) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static ucs_status_t
+ucp_worker_iface_check_progress_thread(ucp_worker_iface_t *wiface)
+{
+    /* Worker callbacks are called only by the thread which progresses the
+     * worker, and tag offload operations are not serialized with the thread */
+    if ((wiface->attr.cap.flags & UCT_IFACE_FLAG_CB_SYNC) &&
+        !(wiface->attr.cap.flags & (UCT_IFACE_FLAG_TAG_EAGER_BCOPY |
+                                    UCT_IFACE_FLAG_TAG_RNDV_ZCOPY))) {
+        return UCS_OK;
+    }
+
+    ucs_error("worker %p: " UCP_WIFACE_FMT " can't be progressed by a thread, "
+              "since it does not support synchronous callbacks or uses tag "
+              "offload", wiface->worker, UCP_WIFACE_ARG(wiface));
+    return UCS_ERR_UNSUPPORTED;
+}
+
+static void ucp_worker_progress_threads_stop(ucp_worker_h worker)
+{
+    ucp_progress_thread_t *thread;
+    ucp_worker_iface_t *wiface;
+    unsigned i;
+
+    UCS_ASYNC_BLOCK(&worker->async);
+
+    for (i = 0; i < worker->progress_threads.count; ++i) {
+        thread = worker->progress_threads.threads[i];
+        wiface = thread->wiface;
+        if (thread->detached) {
+            continue;
+        }
+
+        /* Return the interface to the worker, which keeps progressing it by
+         * ucp_progress_thread_dispatch(). The thread does not take the worker
+         * lock, so it is joined with the lock held. */
+        ucp_progress_thread_stop(thread);
+        ucp_worker_set_am_handlers(wiface, 0);
+        ucp_progress_thread_dispatch(thread);
+        ucp_worker_iface_deactivate(wiface, 0);
+    }
+
+    UCS_ASYNC_UNBLOCK(&worker->async);
+}
+
+/* Called before the interfaces are closed, which destroys the threads */
+static void ucp_worker_progress_threads_cleanup(ucp_worker_h worker)
+{
+    uct_worker_progress_unregister_safe(worker->uct,
+                                        &worker->progress_threads.cb_id);
+    ucs_free(worker->progress_threads.threads);
+    worker->progress_threads.threads = NULL;
+    worker->progress_threads.count   = 0;
+}
+
+static ucs_status_t ucp_worker_progress_threads_start(ucp_worker_h worker)
+{
+    const ucp_context_config_t *config = &worker->context->config.ext;
+    ucp_progress_thread_t *thread;
+    ucp_worker_iface_t *wiface;
+    ucs_status_t status;
+    unsigned iface_id;
+    int cpu;
+
+    worker->progress_threads.threads = NULL;
+    worker->progress_threads.count   = 0;
+    worker->progress_threads.cb_id   = UCS_CALLBACKQ_ID_NULL;
+
+    if (config->progress_thread_tls.count == 0) {
+        return UCS_OK;
+    }
+
+    worker->progress_threads.threads = ucs_calloc(
+            worker->num_ifaces, sizeof(*worker->progress_threads.threads),
+            "ucp_progress_threads");
+    if (worker->progress_threads.threads == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    UCS_ASYNC_BLOCK(&worker->async);
+
+    uct_worker_progress_register_safe(worker->uct,
+                                      ucp_worker_progress_threads_dispatch,
+                                      worker, 0,
+                                      &worker->progress_threads.cb_id);
+
+    for (iface_id = 0; iface_id < worker->num_ifaces; ++iface_id) {
+        wiface = worker->ifaces[iface_id];
+        thread = wiface->progress_thread;
+        if (thread == NULL) {
+            continue;
+        }
+
+        status = ucp_worker_iface_check_progress_thread(wiface);
+        if (status != UCS_OK) {
+            goto err;
+        }
+
+        cpu = (config->progress_thread_cpus.count == 0) ? -1 :
+              config->progress_thread_cpus.cpus[
+                      worker->progress_threads.count %
+                      config->progress_thread_cpus.count];
+
+        worker->progress_threads.threads[worker->progress_threads.count++] =
+                thread;
+
+        /* Keep the interface active, with the thread active message handlers,
+         * and progress it only by the thread. The thread wakes up the worker
+         * when it receives events, so the interface is not armed. */
+        ucp_worker_iface_activate(wiface, 0);
+        ucp_worker_set_am_handlers(wiface, 0);
+        ucp_worker_iface_disarm(wiface);
+
+        status = ucp_progress_thread_start(thread, cpu);
+        if (status != UCS_OK) {
+            goto err;
+        }
+
+        ucs_debug("worker %p: " UCP_WIFACE_FMT " is progressed by a thread on "
+                  "cpu %d", worker, UCP_WIFACE_ARG(wiface), cpu);
+    }
+
+    UCS_ASYNC_UNBLOCK(&worker->async);
+    return UCS_OK;
+
+err:
+    UCS_ASYNC_UNBLOCK(&worker->async);
+    ucp_worker_progress_threads_stop(worker);
+    ucp_worker_progress_threads_cleanup(worker);
+    return status;
+}
+
+static void ucp_worker_address_tl_bitmap(ucp_worker_h worker,
+                                         uint32_t address_flags,
+                                         ucp_tl_bitmap_t *tl_bitmap)
+{
+    ucp_rsc_index_t tl_id;
+    const uct_iface_attr_t *iface_attr;
+
+    if (address_flags & UCP_WORKER_ADDRESS_FLAG_NET_ONLY) {
+        UCS_STATIC_BITMAP_RESET_ALL(tl_bitmap);
+        UCS_STATIC_BITMAP_FOR_EACH_BIT(tl_id, &worker->context->tl_bitmap) {
+            iface_attr = ucp_worker_iface_get_attr(worker, tl_id);
+            if (iface_attr->cap.flags & UCT_IFACE_FLAG_INTER_NODE) {
+                UCS_STATIC_BITMAP_SET(tl_bitmap, tl_id);
+            }
+        }
+    } else {
+        UCS_STATIC_BITMAP_SET_ALL(tl_bitmap);
+    }
+}
+
+/*
+ * Cache the profiles of the worker addresses, so the addresses which only
+ * refer to them can be unpacked by the worker. It is done once, because the
+ * cache is also updated when peer addresses are unpacked with the async lock.
+ */
+static ucs_status_t ucp_worker_address_profiles_init(ucp_worker_h worker)
+{
+    static const uint32_t address_flags[] = {
+        0, UCP_WORKER_ADDRESS_FLAG_NET_ONLY
+    };
+    ucp_context_h context = worker->context;
+    unsigned pack_flags   = ucp_worker_default_address_pack_flags(worker) |
+                            UCP_ADDRESS_PACK_FLAG_PROFILE;
+    ucp_unpacked_address_t unpacked_address;
+    ucp_tl_bitmap_t tl_bitmap;
+    size_t address_length;
+    ucs_status_t status;
+    void *address;
+    unsigned i;
+
+    if (context->config.ext.worker_addr_version == UCP_OBJECT_VERSION_V1) {
+        return UCS_OK;
+    }
+
+    for (i = 0; i < ucs_static_array_size(address_flags); ++i) {
+        ucp_worker_address_tl_bitmap(worker, address_flags[i], &tl_bitmap);
+        status = ucp_address_pack(worker, NULL, &tl_bitmap, pack_flags,
+                                  context->config.ext.worker_addr_version,
+                                  NULL, UINT_MAX, &address_length, &address);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        /* The profile is added to the cache when the address is unpacked */
+        status = ucp_address_unpack(worker, address, pack_flags,
+                                    &unpacked_address);
+        ucs_free(address);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        ucs_free(unpacked_address.address_list);
+    }
+
+    return UCS_OK;
+}
+
 ucs_status_t ucp_worker_create(ucp_context_h context,
                                const ucp_worker_params_t *params,
                                ucp_worker_h *worker_p)
@@ -2491,6 +2758,7 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     worker->fence_seq            = 0;
     worker->inprogress           = 0;
     worker->rkey_config_count    = 0;
+    worker->proto_cache          = NULL;
     worker->num_active_ifaces    = 0;
     worker->num_ifaces           = 0;
     worker->am_message_id        = ucs_generate_uuid(0);
@@ -2502,12 +2770,16 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     ucs_list_head_init(&worker->stream_ready_eps);
     ucs_list_head_init(&worker->all_eps);
     ucs_list_head_init(&worker->internal_eps);
+    ucs_list_head_init(&worker->aggr_eps);
     kh_init_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
     kh_init_inplace(ucp_worker_discard_uct_ep_hash, &worker->discard_uct_ep_hash);
+    ucp_address_profile_cache_init(worker);
     worker->counters.ep_creations         = 0;
     worker->counters.ep_creation_failures = 0;
     worker->counters.ep_closures          = 0;
     worker->counters.ep_failures          = 0;
+    worker->wait.busy_poll_max            = context->config.ext.wakeup_busy_poll;
+    worker->wait.avg_interval             = worker->wait.busy_poll_max;
 
     /* Copy user flags, and mask-out unsupported flags for compatibility */
     worker->flags = UCP_PARAM_VALUE(WORKER, params, flags, FLAGS, 0) &
@@ -2593,12 +2865,17 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
         goto err_free_stats;
     }
 
+    status = ucp_request_trace_init(worker);
+    if (status != UCS_OK) {
+        goto err_free_tm_offload_stats;
+    }
+
     status = ucs_async_context_init(&worker->async,
                                     context->config.ext.use_mt_mutex ?
                                     UCS_ASYNC_MODE_THREAD_MUTEX :
                                     UCS_ASYNC_THREAD_LOCK_TYPE);
     if (status != UCS_OK) {
-        goto err_free_tm_offload_stats;
+        goto err_request_trace_cleanup;
     }
 
     /* Create the underlying UCT worker */
@@ -2648,7 +2925,7 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     }
 
     /* Initialize tag matching */
-    status = ucp_tag_match_init(&worker->tm);
+    status = ucp_tag_match_init(&worker->tm, context);
     if (status != UCS_OK) {
         goto err_destroy_mpools;
     }
@@ -2672,6 +2949,11 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
 
     ucp_worker_set_max_am_header(worker);
 
+    status = ucp_worker_address_profiles_init(worker);
+    if (status != UCS_OK) {
+        goto err_am_cleanup;
+    }
+
     ucp_worker_create_vfs(context, worker);
 
     status = ucp_worker_usage_tracker_create(worker);
@@ -2679,9 +2961,16 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
         goto err_am_cleanup;
     }
 
+    status = ucp_worker_progress_threads_start(worker);
+    if (status != UCS_OK) {
+        goto err_usage_tracker_destroy;
+    }
+
     *worker_p = worker;
     return UCS_OK;
 
+err_usage_tracker_destroy:
+    ucp_worker_usage_tracker_destroy(worker);
 err_am_cleanup:
     ucp_am_cleanup(worker);
 err_tag_match_cleanup:
@@ -2701,6 +2990,8 @@ err_destroy_uct_worker:
     uct_worker_destroy(worker->uct);
 err_destroy_async:
     ucs_async_context_cleanup(&worker->async);
+err_request_trace_cleanup:
+    ucp_request_trace_cleanup(worker);
 err_free_tm_offload_stats:
     UCS_STATS_NODE_FREE(worker->tm_offload_stats);
 err_free_stats:
@@ -2711,6 +3002,7 @@ err_destroy_ep_map:
     UCS_PTR_MAP_DESTROY(ep, &worker->ep_map);
 err_free:
     ucs_strided_alloc_cleanup(&worker->ep_alloc);
+    ucp_address_profile_cache_cleanup(worker);
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
     kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
@@ -2911,6 +3203,8 @@ void ucp_worker_destroy(ucp_worker_h worker)
 {
     ucs_debug("destroy worker %p", worker);
 
+    ucp_worker_progress_threads_stop(worker);
+
     UCS_ASYNC_BLOCK(&worker->async);
     uct_worker_progress_unregister_safe(worker->uct, &worker->keepalive.cb_id);
     ucp_worker_usage_tracker_destroy(worker);
@@ -2951,16 +3245,19 @@ void ucp_worker_destroy(ucp_worker_h worker)
     ucp_tag_match_cleanup(&worker->tm);
     ucp_worker_destroy_mpools(worker);
     ucp_worker_close_cms(worker);
+    ucp_worker_progress_threads_cleanup(worker);
     ucp_worker_close_ifaces(worker);
     ucs_conn_match_cleanup(&worker->conn_match_ctx);
     ucp_worker_wakeup_cleanup(worker);
     uct_worker_destroy(worker->uct);
     ucs_async_context_cleanup(&worker->async);
+    ucp_request_trace_cleanup(worker);
     UCS_STATS_NODE_FREE(worker->tm_offload_stats);
     UCS_STATS_NODE_FREE(worker->stats);
     UCS_PTR_MAP_DESTROY(request, &worker->request_map);
     UCS_PTR_MAP_DESTROY(ep, &worker->ep_map);
     ucs_strided_alloc_cleanup(&worker->ep_alloc);
+    ucp_address_profile_cache_cleanup(worker);
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
     kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
@@ -2976,8 +3273,6 @@ static ucs_status_t ucp_worker_address_pack(ucp_worker_h worker,
     ucp_context_h context = worker->context;
     unsigned flags        = ucp_worker_default_address_pack_flags(worker);
     ucp_tl_bitmap_t tl_bitmap;
-    ucp_rsc_index_t tl_id;
-    const uct_iface_attr_t *iface_attr;
 
     /* Make sure that UUID is packed to the address intended for the user,
      * because ucp_worker_address_query routine assumes that uuid is always
@@ -2985,18 +3280,22 @@ static ucs_status_t ucp_worker_address_pack(ucp_worker_h worker,
      */
     ucs_assert(flags & UCP_ADDRESS_PACK_FLAG_WORKER_UUID);
 
-    if (address_flags & UCP_WORKER_ADDRESS_FLAG_NET_ONLY) {
-        UCS_STATIC_BITMAP_RESET_ALL(&tl_bitmap);
-        UCS_STATIC_BITMAP_FOR_EACH_BIT(tl_id, &worker->context->tl_bitmap) {
-            iface_attr = ucp_worker_iface_get_attr(worker, tl_id);
-            if (iface_attr->cap.flags & UCT_IFACE_FLAG_INTER_NODE) {
-                UCS_STATIC_BITMAP_SET(&tl_bitmap, tl_id);
-            }
+    if (address_flags & UCP_WORKER_ADDRESS_FLAG_PROFILE_REF) {
+        if (context->config.ext.worker_addr_version == UCP_OBJECT_VERSION_V1) {
+            ucs_error("worker %p: address profile reference requires "
+                      "UCX_ADDRESS_VERSION=v2", worker);
+            return UCS_ERR_UNSUPPORTED;
         }
-    } else {
-        UCS_STATIC_BITMAP_SET_ALL(&tl_bitmap);
+
+        flags |= UCP_ADDRESS_PACK_FLAG_PROFILE |
+                 UCP_ADDRESS_PACK_FLAG_PROFILE_REF;
+    } else if (context->config.ext.worker_addr_profile &&
+               (context->config.ext.worker_addr_version !=
+                UCP_OBJECT_VERSION_V1)) {
+        flags |= UCP_ADDRESS_PACK_FLAG_PROFILE;
     }
 
+    ucp_worker_address_tl_bitmap(worker, address_flags, &tl_bitmap);
     return ucp_address_pack(worker, NULL, &tl_bitmap, flags,
                             context->config.ext.worker_addr_version, NULL,
                             UINT_MAX, address_length_p, (void**)address_p);
@@ -3015,9 +3314,11 @@ ucs_status_t ucp_worker_query(ucp_worker_h worker,
     if (attr->field_mask & UCP_WORKER_ATTR_FIELD_ADDRESS) {
         address_flags = UCP_ATTR_VALUE(WORKER, attr, address_flags,
                                        ADDRESS_FLAGS, 0);
+        UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
         status        = ucp_worker_address_pack(worker, address_flags,
                                                 &attr->address_length,
                                                 (void**)&attr->address);
+        UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
     }
 
     if (attr->field_mask & UCP_WORKER_ATTR_FIELD_MAX_AM_HEADER) {
@@ -3059,6 +3360,16 @@ unsigned ucp_worker_progress(ucp_worker_h worker)
     count = uct_worker_progress(worker->uct);
     ucs_async_check_miss(&worker->async);
 
+    /* Deliver the active messages which were collected for batch callbacks */
+    if (ucs_unlikely(!ucs_array_is_empty(&worker->am.batch_msgs))) {
+        ucp_am_batch_dispatch(worker);
+    }
+
+    /* Send the aggregated messages which were delayed for too long */
+    if (ucs_unlikely(!ucs_list_is_empty(&worker->aggr_eps))) {
+        ucp_worker_aggr_progress(worker);
+    }
+
     /* coverity[assert_side_effect] */
     ucs_assert(--worker->inprogress == 0);
 
@@ -3184,6 +3495,21 @@ ucs_status_t ucp_worker_arm(ucp_worker_h worker)
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
 
+    /* The progress threads signal the event pipe only when their first event
+     * is queued, so check for events which were not dispatched yet */
+    if (ucp_worker_progress_threads_is_busy(worker)) {
+        UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+        return UCS_ERR_BUSY;
+    }
+
+    /* Aggregated messages are sent only by the worker progress, so the peer
+     * would not get them while we wait for its reply */
+    if (ucs_unlikely(!ucs_list_is_empty(&worker->aggr_eps))) {
+        ucp_worker_aggr_flush(worker);
+        UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+        return UCS_ERR_BUSY;
+    }
+
     /* Go over arm_list of active interfaces which support events and arm them */
     ucs_list_for_each(wiface, &worker->arm_ifaces, arm_list) {
         ucs_assert(wiface->activate_count > 0);
@@ -3204,8 +3530,45 @@ void ucp_worker_wait_mem(ucp_worker_h worker, void *address)
     ucs_arch_wait_mem(address);
 }
 
+static void ucp_worker_wait_update_interval(ucp_worker_h worker,
+                                            ucs_time_t start)
+{
+    /* Intervals longer than the busy polling time only tell that busy polling
+     * is useless, so limit them to adapt quickly when events become frequent */
+    ucs_time_t interval = ucs_min(ucs_get_time() - start,
+                                  2 * worker->wait.busy_poll_max);
+
+    worker->wait.avg_interval += (interval >> UCP_WORKER_WAIT_AVG_SHIFT) -
+                                 (worker->wait.avg_interval >>
+                                  UCP_WORKER_WAIT_AVG_SHIFT);
+}
+
+/* Busy poll the worker for twice the recent average interval between events,
+ * return nonzero if events were found */
+static int ucp_worker_wait_busy_poll(ucp_worker_h worker, ucs_time_t start)
+{
+    ucs_time_t avg_interval = worker->wait.avg_interval;
+    ucs_time_t deadline;
+
+    if (avg_interval > worker->wait.busy_poll_max) {
+        return 0;
+    }
+
+    deadline = start + ucs_min(2 * avg_interval, worker->wait.busy_poll_max);
+    do {
+        if (ucp_worker_progress(worker) != 0) {
+            UCS_STATS_UPDATE_COUNTER(worker->stats,
+                                     UCP_WORKER_STAT_WAIT_BUSY_POLL, 1);
+            return 1;
+        }
+    } while (ucs_get_time() < deadline);
+
+    return 0;
+}
+
 ucs_status_t ucp_worker_wait(ucp_worker_h worker)
 {
+    ucs_time_t start = 0;
     ucp_worker_iface_t *wiface;
     struct pollfd *pfd;
     ucs_status_t status;
@@ -3217,6 +3580,14 @@ ucs_status_t ucp_worker_wait(ucp_worker_h worker)
     UCP_CONTEXT_CHECK_FEATURE_FLAGS(worker->context, UCP_FEATURE_WAKEUP,
                                     return UCS_ERR_INVALID_PARAM);
 
+    if (worker->wait.busy_poll_max != 0) {
+        start = ucs_get_time();
+        if (ucp_worker_wait_busy_poll(worker, start)) {
+            status = UCS_OK;
+            goto out;
+        }
+    }
+
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
 
     status = ucp_worker_arm(worker);
@@ -3258,6 +3629,8 @@ ucs_status_t ucp_worker_wait(ucp_worker_h worker)
         ret = poll(pfd, nfds, -1);
         if (ret >= 0) {
             ucs_assertv(ret == 1, "ret=%d", ret);
+            UCS_STATS_UPDATE_COUNTER(worker->stats, UCP_WORKER_STAT_WAIT_BLOCK,
+                                     1);
             status = UCS_OK;
             goto out;
         } else {
@@ -3272,6 +3645,9 @@ ucs_status_t ucp_worker_wait(ucp_worker_h worker)
 out_unlock:
      UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
 out:
+    if ((worker->wait.busy_poll_max != 0) && (status == UCS_OK)) {
+        ucp_worker_wait_update_interval(worker, start);
+    }
     return status;
 }
 
@@ -12,6 +12,7 @@
 #include "ucp_context.h"
 #include "ucp_thread.h"
 #include "ucp_rkey.h"
+#include "ucp_request_trace.h"
 
 #include <ucp/core/ucp_am.h>
 #include <ucp/tag/tag_match.h>
@@ -155,6 +156,11 @@ enum {
     UCP_WORKER_STAT_RNDV_RTR_MTYPE,
     UCP_WORKER_STAT_RNDV_RKEY_PTR,
 
+    /* Number of ucp_worker_wait calls which found events by busy polling,
+     * and which blocked on the event file descriptor */
+    UCP_WORKER_STAT_WAIT_BUSY_POLL,
+    UCP_WORKER_STAT_WAIT_BLOCK,
+
     UCP_WORKER_STAT_LAST
 };
 
@@ -218,6 +224,11 @@ KHASH_TYPE(ucp_worker_discard_uct_ep_hash, uct_ep_h, ucp_request_t*);
 typedef khash_t(ucp_worker_discard_uct_ep_hash) ucp_worker_discard_uct_ep_hash_t;
 
 
+/* Hash map of node profiles of remote worker addresses, by profile hash */
+KHASH_TYPE(ucp_worker_addr_profile_hash, uint64_t, ucp_address_profile_t*);
+typedef khash_t(ucp_worker_addr_profile_hash) ucp_worker_addr_profile_hash_t;
+
+
 typedef struct ucp_worker_mpool_key {
     ucs_memory_type_t mem_type;  /* memory type of the buffer pool */
     ucs_sys_device_t  sys_dev;   /* identifier for the device,
@@ -253,6 +264,8 @@ struct ucp_worker_iface {
     unsigned                      post_count;    /* Counts uncompleted requests which are
                                                     offloaded to the transport */
     uint8_t                       flags;         /* Interface flags */
+    ucp_progress_thread_t         *progress_thread;/* Thread which progresses
+                                                    the iface, or NULL */
 };
 
 
@@ -309,6 +322,8 @@ typedef struct ucp_worker {
     ucs_list_link_t                  all_eps;             /* List of all endpoints (except internal
                                                            * endpoints) */
     ucs_list_link_t                  internal_eps;        /* List of internal endpoints */
+    ucs_list_link_t                  aggr_eps;            /* List of endpoints with
+                                                             aggregated sends */
     ucs_conn_match_ctx_t             conn_match_ctx;      /* Endpoint-to-endpoint matching context */
     ucp_worker_iface_t               **ifaces;            /* Array of pointers to interfaces,
                                                              one for each resource */
@@ -338,6 +353,8 @@ typedef struct ucp_worker {
 
     ucp_worker_rkey_config_hash_t    rkey_config_hash;    /* RKEY config key -> index */
     ucp_worker_discard_uct_ep_hash_t discard_uct_ep_hash; /* Hash of discarded UCT EPs */
+    ucp_worker_addr_profile_hash_t   addr_profile_hash;   /* Unpacked address
+                                                             node profiles */
     UCS_PTR_MAP_T(ep)                ep_map;              /* UCP ep key to ptr
                                                              mapping */
     UCS_PTR_MAP_T(request)           request_map;         /* UCP requests key to
@@ -348,6 +365,18 @@ typedef struct ucp_worker {
     unsigned                         rkey_config_count;   /* Current number of rkey configurations */
     ucp_rkey_config_t                rkey_config[UCP_WORKER_MAX_RKEY_CONFIG];
 
+    ucp_proto_cache_t                *proto_cache;        /* Protocol selection cache,
+                                                             can be NULL */
+    ucp_request_trace_ctx_t          *request_trace;      /* Request tracing state,
+                                                             can be NULL */
+
+    struct {
+        ucp_progress_thread_t        **threads;           /* Interface progress threads */
+        unsigned                     count;               /* Number of progress threads */
+        uct_worker_cb_id_t           cb_id;               /* Dispatches the events
+                                                           * received by the threads */
+    } progress_threads;
+
     struct {
         int                          timerfd;             /* Timer needed to signal to user's fd when
                                                            * the next keepalive round must be done */
@@ -360,6 +389,14 @@ typedef struct ucp_worker {
         size_t                       round_count;         /* Number of rounds done */
     } keepalive;
 
+    struct {
+        ucs_time_t                   busy_poll_max;       /* Maximal busy polling time in
+                                                           * ucp_worker_wait, 0 - disabled */
+        ucs_time_t                   avg_interval;        /* Moving average of the time
+                                                           * ucp_worker_wait waited for an
+                                                           * event */
+    } wait;
+
     struct {
         /* Number of requests to create endpoint */
         uint64_t                     ep_creations;
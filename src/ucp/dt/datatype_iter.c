@@ -332,6 +332,11 @@ void ucp_datatype_iter_str(const ucp_datatype_iter_t *dt_iter,
                                   dt_iter->type.generic.state);
 
         break;
+    case UCP_DATATYPE_STRIDED:
+        ucs_string_buffer_appendf(strb, " buffer:%p dt_str:%p",
+                                  dt_iter->type.strided.buffer,
+                                  dt_iter->type.strided.dt_str);
+        break;
     default:
         break;
     }
@@ -112,6 +112,19 @@ ucp_datatype_generic_iter_init(ucp_context_h context, void *buffer,
     ucp_memory_info_set_host(&dt_iter->mem_info);
 }
 
+static UCS_F_ALWAYS_INLINE void
+ucp_datatype_strided_iter_init(void *buffer, size_t count,
+                               ucp_datatype_t datatype,
+                               ucp_datatype_iter_t *dt_iter)
+{
+    ucp_dt_strided_t *dt_str = ucp_dt_to_strided(datatype);
+
+    dt_iter->length              = ucp_dt_strided_length(datatype, count);
+    dt_iter->type.strided.buffer = buffer;
+    dt_iter->type.strided.dt_str = dt_str;
+    ucp_memory_info_set_host(&dt_iter->mem_info);
+}
+
 static UCS_F_ALWAYS_INLINE void
 ucp_datatype_iter_iov_set_sg_count(uint8_t *sg_count, size_t iov_count)
 {
@@ -142,6 +155,10 @@ ucp_datatype_iter_init(ucp_context_h context, void *buffer, size_t count,
         length = ucp_dt_iov_length((const ucp_dt_iov_t*)buffer, count);
         return ucp_datatype_iov_iter_init(context, buffer, count, length,
                                           dt_iter, param);
+    } else if (dt_iter->dt_class == UCP_DATATYPE_STRIDED) {
+        *sg_count = 0;
+        ucp_datatype_strided_iter_init(buffer, count, datatype, dt_iter);
+        return UCS_OK;
     } else if (!ENABLE_PARAMS_CHECK ||
                (dt_iter->dt_class == UCP_DATATYPE_GENERIC)) {
         *sg_count = 0;
@@ -180,6 +197,9 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_datatype_iter_init_unpack(
         length = ucp_dt_iov_length((const ucp_dt_iov_t*)buffer, count);
         return ucp_datatype_iov_iter_init(context, buffer, count, length,
                                           dt_iter, param);
+    } else if (dt_iter->dt_class == UCP_DATATYPE_STRIDED) {
+        ucp_datatype_strided_iter_init(buffer, count, datatype, dt_iter);
+        return UCS_OK;
     } else if (!ENABLE_PARAMS_CHECK ||
                (dt_iter->dt_class == UCP_DATATYPE_GENERIC)) {
         ucp_datatype_generic_iter_init(context, buffer, count, datatype, 0,
@@ -393,6 +413,13 @@ ucp_datatype_iter_next_pack(const ucp_datatype_iter_t *dt_iter,
                               (ucs_memory_type_t)dt_iter->mem_info.type,
                               dt_iter->length);
         break;
+    case UCP_DATATYPE_STRIDED:
+        length = ucs_min(dt_iter->length - dt_iter->offset, max_length);
+        UCS_PROFILE_CALL_VOID(ucp_dt_strided_pack,
+                              dt_iter->type.strided.dt_str, dest,
+                              dt_iter->type.strided.buffer, dt_iter->offset,
+                              length);
+        break;
     case UCP_DATATYPE_GENERIC:
         if (max_length != 0) {
             dt_gen = dt_iter->type.generic.dt_gen;
@@ -462,6 +489,13 @@ ucp_datatype_iter_unpack(ucp_datatype_iter_t *dt_iter, ucp_worker_h worker,
         dt_iter->offset += unpacked_length;
         status           = UCS_OK;
         break;
+    case UCP_DATATYPE_STRIDED:
+        UCS_PROFILE_CALL_VOID(ucp_dt_strided_unpack,
+                              dt_iter->type.strided.dt_str,
+                              dt_iter->type.strided.buffer, src, offset,
+                              length);
+        status = UCS_OK;
+        break;
     case UCP_DATATYPE_GENERIC:
         if (length != 0) {
             dt_gen = dt_iter->type.generic.dt_gen;
@@ -671,7 +705,10 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_datatype_iter_mem_reg(
         return ucp_datatype_iter_iov_mem_reg(context, dt_iter, md_map,
                                              uct_flags);
     } else if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_GENERIC,
+                                          dt_mask) ||
+               ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_STRIDED,
                                           dt_mask)) {
+        /* Generic and strided data is always packed by the CPU */
         return UCS_OK;
     } else {
         ucs_error("datatype %s does not support registration",
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+
+#ifndef UCP_DT_STRIDED_H_
+#define UCP_DT_STRIDED_H_
+
+#include <ucp/api/ucp.h>
+#include <ucs/sys/compiler_def.h>
+
+
+/**
+ * Strided datatype structure.
+ *
+ * Dimensions are kept in normalized form: a dimension whose items are
+ * adjacent to each other is folded into the block (or into the next inner
+ * dimension), so a fully contiguous element has num_dims == 0.
+ */
+typedef struct ucp_dt_strided {
+    size_t                   block_size;  /* Contiguous bytes per block */
+    size_t                   packed_size; /* Packed bytes per element */
+    size_t                   extent;      /* Distance between elements */
+    unsigned                 num_dims;    /* Number of valid entries in dims */
+    ucp_dt_strided_dim_t     dims[UCP_DT_STRIDED_MAX_DIMS];
+} ucp_dt_strided_t;
+
+
+#define UCP_DT_IS_STRIDED(_datatype) \
+    (((_datatype) & UCP_DATATYPE_CLASS_MASK) == UCP_DATATYPE_STRIDED)
+
+
+static UCS_F_ALWAYS_INLINE
+ucp_dt_strided_t* ucp_dt_to_strided(ucp_datatype_t datatype)
+{
+    return (ucp_dt_strided_t*)(void*)(datatype & ~UCP_DATATYPE_CLASS_MASK);
+}
+
+
+static UCS_F_ALWAYS_INLINE
+ucp_datatype_t ucp_dt_from_strided(ucp_dt_strided_t* dt_str)
+{
+    return ((uintptr_t)dt_str) | UCP_DATATYPE_STRIDED;
+}
+
+
+static UCS_F_ALWAYS_INLINE size_t
+ucp_dt_strided_length(ucp_datatype_t datatype, size_t count)
+{
+    return ucp_dt_to_strided(datatype)->packed_size * count;
+}
+
+
+/**
+ * Gather packed data from a strided buffer.
+ *
+ * @param [in]  dt_str   Strided datatype.
+ * @param [out] dest     Destination contiguous buffer.
+ * @param [in]  buffer   User buffer described by @a dt_str.
+ * @param [in]  offset   Packed offset to start from.
+ * @param [in]  length   Number of bytes to pack.
+ */
+void ucp_dt_strided_pack(const ucp_dt_strided_t *dt_str, void *dest,
+                         const void *buffer, size_t offset, size_t length);
+
+
+/**
+ * Scatter packed data to a strided buffer.
+ *
+ * @param [in]  dt_str   Strided datatype.
+ * @param [out] buffer   User buffer described by @a dt_str.
+ * @param [in]  src      Source contiguous buffer.
+ * @param [in]  offset   Packed offset to start from.
+ * @param [in]  length   Number of bytes to unpack.
+ */
+void ucp_dt_strided_unpack(const ucp_dt_strided_t *dt_str, void *buffer,
+                           const void *src, size_t offset, size_t length);
+
+#endif
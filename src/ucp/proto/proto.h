@@ -62,6 +62,14 @@ typedef struct ucp_proto_select_param ucp_proto_select_param_t;
 typedef struct ucp_proto_probe_ctx ucp_proto_probe_ctx_t;
 
 
+/* Online performance feedback of a protocol selection */
+typedef struct ucp_proto_feedback ucp_proto_feedback_t;
+
+
+/* Persistent cache of protocol selection results */
+typedef struct ucp_proto_cache ucp_proto_cache_t;
+
+
 /* Protocol stage ID */
 enum {
     /* Initial stage. All protocols start from this stage. */
@@ -0,0 +1,481 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "proto_cache.h"
+#include "proto_select.inl"
+
+#include <ucp/core/ucp_context.h>
+#include <ucp/core/ucp_worker.inl>
+#include <ucs/algorithm/crc.h>
+#include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/string_buffer.h>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/string.h>
+#include <ucs/sys/topo/base/topo.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+
+
+/* Maximal length of a line in the cache file */
+#define UCP_PROTO_CACHE_LINE_MAX 4096
+
+
+/* Environment variables prefix which is part of the cache description */
+#define UCP_PROTO_CACHE_ENV_PREFIX "UCX_"
+
+
+extern char **environ;
+
+
+KHASH_MAP_INIT_STR(ucp_proto_cache_hash, ucp_proto_id_mask_t);
+
+
+/**
+ * Protocol selection cache of a worker, loaded from and saved to a file
+ */
+struct ucp_proto_cache {
+    /* Selection key string -> protocols used by the selection */
+    khash_t(ucp_proto_cache_hash) hash;
+
+    /* Cache file path */
+    char                          *file_path;
+
+    /* Header line which identifies the local setup */
+    char                          header[128];
+
+    /* Whether new entries were added since the file was loaded */
+    int                           dirty;
+};
+
+
+static int ucp_proto_cache_strcmp(const void *str1, const void *str2)
+{
+    return strcmp(*(const char**)str1, *(const char**)str2);
+}
+
+/*
+ * Description of everything that affects protocol selection and is common to
+ * all the endpoints: UCX version, transport resources and configuration.
+ */
+static ucs_status_t ucp_proto_cache_setup_str(ucp_context_h context,
+                                              ucs_string_buffer_t *strb)
+{
+    ucs_array_s(unsigned, const char*) env_vars = UCS_ARRAY_DYNAMIC_INITIALIZER;
+    char bdf_name[UCS_SYS_BDF_NAME_MAX];
+    const ucp_tl_resource_desc_t *rsc;
+    const char **env_var;
+    char **envp;
+
+    ucs_string_buffer_appendf(strb, "ucx-%s", ucp_get_version_string());
+
+    ucs_carray_for_each(rsc, context->tl_rscs, context->num_tls) {
+        ucs_string_buffer_appendf(strb, " %s/%s:%d:%s", rsc->tl_rsc.tl_name,
+                                  rsc->tl_rsc.dev_name, rsc->tl_rsc.dev_type,
+                                  ucs_topo_sys_device_bdf_name(
+                                          rsc->tl_rsc.sys_device, bdf_name,
+                                          sizeof(bdf_name)));
+    }
+
+    ucs_string_buffer_appendf(strb, " protos:%" PRIx64 " op_attr:%" PRIx64,
+                              context->proto_bitmap,
+                              context->config.ext.extra_op_attr_flags);
+
+    /* Environment order is arbitrary, so sort the variables */
+    for (envp = environ; *envp != NULL; ++envp) {
+        if (!strncmp(*envp, UCP_PROTO_CACHE_ENV_PREFIX,
+                     strlen(UCP_PROTO_CACHE_ENV_PREFIX))) {
+            *ucs_array_append(&env_vars, ucs_array_cleanup_dynamic(&env_vars);
+                              return UCS_ERR_NO_MEMORY) = *envp;
+        }
+    }
+
+    if (!ucs_array_is_empty(&env_vars)) {
+        qsort(ucs_array_begin(&env_vars), ucs_array_length(&env_vars),
+              sizeof(*env_var), ucp_proto_cache_strcmp);
+    }
+
+    ucs_array_for_each(env_var, &env_vars) {
+        ucs_string_buffer_appendf(strb, " %s", *env_var);
+    }
+
+    ucs_array_cleanup_dynamic(&env_vars);
+    return UCS_OK;
+}
+
+static void ucp_proto_cache_lanes_str(const ucp_lane_index_t *lanes,
+                                      ucs_string_buffer_t *strb)
+{
+    ucp_lane_index_t i;
+
+    for (i = 0; (i < UCP_MAX_LANES) && (lanes[i] != UCP_NULL_LANE); ++i) {
+        ucs_string_buffer_appendf(strb, "%x.", lanes[i]);
+    }
+    ucs_string_buffer_appendf(strb, "/");
+}
+
+/*
+ * Selection key which does not depend on configuration indexes, so it can be
+ * matched by another process. Contains the same fields that
+ * ucp_ep_config_is_equal() and the rkey configuration hash compare.
+ *
+ * System device indexes are assigned by each process in the order it
+ * discovers the devices, so the local device of the selection parameters is
+ * identified by its bus id. The remote system devices of the lanes and of the
+ * remote key are kept as indexes: they are received from the peer in its own
+ * numbering, so the entry only matches a peer which numbers them the same.
+ */
+static void ucp_proto_cache_key_str(ucp_worker_h worker,
+                                    ucp_worker_cfg_index_t ep_cfg_index,
+                                    ucp_worker_cfg_index_t rkey_cfg_index,
+                                    const ucp_proto_select_param_t *select_param,
+                                    ucs_string_buffer_t *strb)
+{
+    const ucp_ep_config_key_t *key = &ucp_worker_ep_config(worker,
+                                                           ep_cfg_index)->key;
+    const ucp_ep_config_key_lane_t *lane;
+    char bdf_name[UCS_SYS_BDF_NAME_MAX];
+    const ucp_rkey_config_key_t *rkey_key;
+    ucp_proto_select_key_t select_key;
+    int i;
+
+    for (lane = key->lanes; lane < &key->lanes[key->num_lanes]; ++lane) {
+        ucs_string_buffer_appendf(strb, "%x.%x.%x.%x.%x.%zx/", lane->rsc_index,
+                                  lane->dst_md_index, lane->dst_sys_dev,
+                                  lane->path_index, lane->lane_types,
+                                  lane->seg_size);
+    }
+
+    ucs_string_buffer_appendf(strb, "%x.%x.%x.%x.%x.%x/", key->am_lane,
+                              key->tag_lane, key->wireup_msg_lane, key->cm_lane,
+                              key->keepalive_lane, key->rkey_ptr_lane);
+    ucp_proto_cache_lanes_str(key->rma_lanes, strb);
+    ucp_proto_cache_lanes_str(key->rma_bw_lanes, strb);
+    ucp_proto_cache_lanes_str(key->amo_lanes, strb);
+    ucp_proto_cache_lanes_str(key->am_bw_lanes, strb);
+
+    ucs_string_buffer_appendf(strb, "%" PRIx64 ".%" PRIx64 ".%" PRIx64 "/",
+                              key->rma_bw_md_map, key->rma_md_map,
+                              key->reachable_md_map);
+    for (i = 0; i < ucs_popcount(key->reachable_md_map); ++i) {
+        ucs_string_buffer_appendf(strb, "%x.", key->dst_md_cmpts[i]);
+    }
+
+    ucs_string_buffer_appendf(strb, "/%x.%x.%x", key->err_mode, key->flags,
+                              key->dst_version);
+
+    if (rkey_cfg_index != UCP_WORKER_CFG_INDEX_NULL) {
+        rkey_key = &worker->rkey_config[rkey_cfg_index].key;
+        ucs_string_buffer_appendf(strb,
+                                  "/rkey:%" PRIx64 ".%x.%x.%" PRIx64,
+                                  rkey_key->md_map, rkey_key->sys_dev,
+                                  rkey_key->mem_type,
+                                  rkey_key->unreachable_md_map);
+    }
+
+    select_key.param         = *select_param;
+    select_key.param.sys_dev = UCS_SYS_DEVICE_ID_UNKNOWN;
+    ucs_string_buffer_appendf(strb, "/op:%" PRIx64 ".%s", select_key.u64,
+                              ucs_topo_sys_device_bdf_name(
+                                      select_param->sys_dev, bdf_name,
+                                      sizeof(bdf_name)));
+}
+
+static int ucp_proto_cache_find_proto(const char *name,
+                                      ucp_proto_id_t *proto_id_p)
+{
+    ucp_proto_id_t proto_id;
+
+    for (proto_id = 0; proto_id < ucp_protocols_count(); ++proto_id) {
+        if (!strcmp(ucp_proto_id_field(proto_id, name), name)) {
+            *proto_id_p = proto_id;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void ucp_proto_cache_insert(ucp_proto_cache_t *cache, const char *key,
+                                   ucp_proto_id_mask_t proto_mask)
+{
+    khiter_t khiter;
+    char *key_copy;
+    int khret;
+
+    key_copy = ucs_strdup(key, "ucp_proto_cache_key");
+    if (key_copy == NULL) {
+        return;
+    }
+
+    khiter = kh_put(ucp_proto_cache_hash, &cache->hash, key_copy, &khret);
+    if ((khret == UCS_KH_PUT_FAILED) || (khret == UCS_KH_PUT_KEY_PRESENT)) {
+        ucs_free(key_copy);
+        return;
+    }
+
+    kh_value(&cache->hash, khiter) = proto_mask;
+}
+
+static void ucp_proto_cache_load(ucp_proto_cache_t *cache)
+{
+    char line[UCP_PROTO_CACHE_LINE_MAX];
+    ucp_proto_id_mask_t proto_mask;
+    ucp_proto_id_t proto_id;
+    char *key, *name, *saveptr;
+    unsigned count;
+    FILE *stream;
+
+    stream = fopen(cache->file_path, "r");
+    if (stream == NULL) {
+        ucs_debug("protocol cache file %s is not available: %m",
+                  cache->file_path);
+        return;
+    }
+
+    if ((fgets(line, sizeof(line), stream) == NULL) ||
+        strcmp(line, cache->header)) {
+        ucs_debug("protocol cache file %s does not match the local setup",
+                  cache->file_path);
+        goto out;
+    }
+
+    count = 0;
+    while (fgets(line, sizeof(line), stream) != NULL) {
+        key = strtok_r(line, " \n", &saveptr);
+        if (key == NULL) {
+            continue;
+        }
+
+        proto_mask = 0;
+        while ((name = strtok_r(NULL, " \n", &saveptr)) != NULL) {
+            if (!ucp_proto_cache_find_proto(name, &proto_id)) {
+                ucs_debug("protocol cache file %s: unknown protocol '%s'",
+                          cache->file_path, name);
+                proto_mask = 0;
+                break;
+            }
+
+            proto_mask |= UCS_BIT(proto_id);
+        }
+
+        if (proto_mask != 0) {
+            ucp_proto_cache_insert(cache, key, proto_mask);
+            ++count;
+        }
+    }
+
+    ucs_debug("loaded %u entries from protocol cache file %s", count,
+              cache->file_path);
+
+out:
+    fclose(stream);
+}
+
+static void ucp_proto_cache_save(ucp_proto_cache_t *cache)
+{
+    ucp_proto_id_mask_t proto_mask;
+    ucp_proto_id_t proto_id;
+    char *tmp_path;
+    const char *key;
+    ucs_status_t status;
+    FILE *stream;
+
+    /* Merge entries written by other processes since the file was loaded */
+    ucp_proto_cache_load(cache);
+
+    status = ucs_string_alloc_path_buffer(&tmp_path, "tmp_path");
+    if (status != UCS_OK) {
+        return;
+    }
+
+    /* Write to a private file and rename it, so concurrent readers always see
+     * a complete file */
+    ucs_snprintf_safe(tmp_path, PATH_MAX, "%s.%d", cache->file_path, getpid());
+    stream = fopen(tmp_path, "w");
+    if (stream == NULL) {
+        ucs_debug("failed to create %s: %m", tmp_path);
+        goto out;
+    }
+
+    fputs(cache->header, stream);
+    kh_foreach(&cache->hash, key, proto_mask, {
+        fputs(key, stream);
+        ucs_for_each_bit(proto_id, proto_mask) {
+            fprintf(stream, " %s", ucp_proto_id_field(proto_id, name));
+        }
+        fputc('\n', stream);
+    })
+
+    if (fclose(stream) != 0) {
+        ucs_debug("failed to write %s: %m", tmp_path);
+        unlink(tmp_path);
+        goto out;
+    }
+
+    if (rename(tmp_path, cache->file_path) != 0) {
+        ucs_debug("failed to rename %s to %s: %m", tmp_path, cache->file_path);
+        unlink(tmp_path);
+        goto out;
+    }
+
+    ucs_debug("saved %u entries to protocol cache file %s",
+              kh_size(&cache->hash), cache->file_path);
+
+out:
+    ucs_free(tmp_path);
+}
+
+static ucp_proto_cache_t *ucp_proto_cache_get(ucp_worker_h worker)
+{
+    const char *cache_dir = worker->context->config.ext.proto_cache_dir;
+    ucs_string_buffer_t strb = UCS_STRING_BUFFER_INITIALIZER;
+    ucp_proto_cache_t *cache;
+    ucs_status_t status;
+    char *dir_path;
+    uint32_t crc;
+    int ret;
+
+    if ((worker->proto_cache != NULL) || ucs_string_is_empty(cache_dir)) {
+        return worker->proto_cache;
+    }
+
+    status = ucp_proto_cache_setup_str(worker->context, &strb);
+    if (status != UCS_OK) {
+        goto err_cleanup_strb;
+    }
+
+    cache = ucs_calloc(1, sizeof(*cache), "ucp_proto_cache");
+    if (cache == NULL) {
+        goto err_cleanup_strb;
+    }
+
+    status = ucs_string_alloc_path_buffer(&cache->file_path, "file_path");
+    if (status != UCS_OK) {
+        goto err_free_cache;
+    }
+
+    status = ucs_string_alloc_path_buffer(&dir_path, "dir_path");
+    if (status != UCS_OK) {
+        goto err_free_file_path;
+    }
+
+    ucs_fill_filename_template(cache_dir, dir_path, PATH_MAX);
+    ret = mkdir(dir_path, S_IRWXU | S_IRGRP | S_IXGRP);
+    if ((ret != 0) && (errno != EEXIST)) {
+        ucs_debug("failed to create directory %s: %m", dir_path);
+    }
+
+    /* The file name is derived from the setup, and the header validates it */
+    crc = ucs_crc32(0, ucs_string_buffer_cstr(&strb),
+                    ucs_string_buffer_length(&strb));
+    ucs_snprintf_safe(cache->file_path, PATH_MAX, "%s/ucx_proto_%08x.cache",
+                      dir_path, crc);
+    ucs_snprintf_safe(cache->header, sizeof(cache->header),
+                      "# ucx-%s %zu %08x\n", ucp_get_version_string(),
+                      ucs_string_buffer_length(&strb), crc);
+    ucs_free(dir_path);
+    ucs_string_buffer_cleanup(&strb);
+
+    kh_init_inplace(ucp_proto_cache_hash, &cache->hash);
+    ucp_proto_cache_load(cache);
+
+    worker->proto_cache = cache;
+    return cache;
+
+err_free_file_path:
+    ucs_free(cache->file_path);
+err_free_cache:
+    ucs_free(cache);
+err_cleanup_strb:
+    ucs_string_buffer_cleanup(&strb);
+    return NULL;
+}
+
+int ucp_proto_cache_lookup(ucp_worker_h worker,
+                           ucp_worker_cfg_index_t ep_cfg_index,
+                           ucp_worker_cfg_index_t rkey_cfg_index,
+                           const ucp_proto_select_param_t *select_param,
+                           ucp_proto_id_mask_t *proto_mask_p)
+{
+    ucs_string_buffer_t strb = UCS_STRING_BUFFER_INITIALIZER;
+    ucp_proto_cache_t *cache;
+    khiter_t khiter;
+    int found;
+
+    cache = ucp_proto_cache_get(worker);
+    if (cache == NULL) {
+        return 0;
+    }
+
+    ucp_proto_cache_key_str(worker, ep_cfg_index, rkey_cfg_index,
+                            select_param, &strb);
+    khiter = kh_get(ucp_proto_cache_hash, &cache->hash,
+                    ucs_string_buffer_cstr(&strb));
+    found  = (khiter != kh_end(&cache->hash));
+    if (found) {
+        *proto_mask_p = kh_value(&cache->hash, khiter);
+    }
+
+    ucs_string_buffer_cleanup(&strb);
+    return found;
+}
+
+void ucp_proto_cache_add(ucp_worker_h worker,
+                         ucp_worker_cfg_index_t ep_cfg_index,
+                         ucp_worker_cfg_index_t rkey_cfg_index,
+                         const ucp_proto_select_param_t *select_param,
+                         const ucp_proto_threshold_elem_t *thresholds)
+{
+    ucs_string_buffer_t strb       = UCS_STRING_BUFFER_INITIALIZER;
+    ucp_proto_id_mask_t proto_mask = 0;
+    const ucp_proto_threshold_elem_t *thresh_elem;
+    ucp_proto_cache_t *cache;
+
+    cache = ucp_proto_cache_get(worker);
+    if (cache == NULL) {
+        return;
+    }
+
+    thresh_elem = thresholds;
+    do {
+        proto_mask |= UCS_BIT(thresh_elem->proto_config.init_elem->proto_id);
+    } while ((thresh_elem++)->max_msg_length != SIZE_MAX);
+
+    ucp_proto_cache_key_str(worker, ep_cfg_index, rkey_cfg_index,
+                            select_param, &strb);
+    ucp_proto_cache_insert(cache, ucs_string_buffer_cstr(&strb), proto_mask);
+    ucs_string_buffer_cleanup(&strb);
+
+    cache->dirty = 1;
+}
+
+void ucp_proto_cache_destroy(ucp_worker_h worker)
+{
+    ucp_proto_cache_t *cache = worker->proto_cache;
+    const char *key;
+
+    if (cache == NULL) {
+        return;
+    }
+
+    if (cache->dirty) {
+        ucp_proto_cache_save(cache);
+    }
+
+    kh_foreach_key(&cache->hash, key, ucs_free((char*)key));
+    kh_destroy_inplace(ucp_proto_cache_hash, &cache->hash);
+    ucs_free(cache->file_path);
+    ucs_free(cache);
+    worker->proto_cache = NULL;
+}
@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_PROTO_CACHE_H_
+#define UCP_PROTO_CACHE_H_
+
+#include "proto_select.h"
+
+
+/**
+ * Find the protocols which were selected for the same endpoint configuration
+ * and selection parameters by a previous run with the same UCX version,
+ * transport resources and configuration.
+ *
+ * @param [in]  worker          UCP worker.
+ * @param [in]  ep_cfg_index    Endpoint configuration index.
+ * @param [in]  rkey_cfg_index  Remote key configuration index, or
+ *                              UCP_WORKER_CFG_INDEX_NULL.
+ * @param [in]  select_param    Protocol selection parameters.
+ * @param [out] proto_mask_p    Filled with the protocols to probe.
+ *
+ * @return Nonzero if the cache has an entry for the given parameters.
+ */
+int ucp_proto_cache_lookup(ucp_worker_h worker,
+                           ucp_worker_cfg_index_t ep_cfg_index,
+                           ucp_worker_cfg_index_t rkey_cfg_index,
+                           const ucp_proto_select_param_t *select_param,
+                           ucp_proto_id_mask_t *proto_mask_p);
+
+
+/**
+ * Remember the protocols used by a selection thresholds array.
+ */
+void ucp_proto_cache_add(ucp_worker_h worker,
+                         ucp_worker_cfg_index_t ep_cfg_index,
+                         ucp_worker_cfg_index_t rkey_cfg_index,
+                         const ucp_proto_select_param_t *select_param,
+                         const ucp_proto_threshold_elem_t *thresholds);
+
+
+/**
+ * Write new entries to the cache file and release the worker cache.
+ */
+void ucp_proto_cache_destroy(ucp_worker_h worker);
+
+#endif
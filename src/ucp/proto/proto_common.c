@@ -491,8 +491,10 @@ ucp_proto_common_find_lanes(const ucp_proto_init_params_t *params,
     ucs_log_indent(1);
 
     if ((flags & UCP_PROTO_COMMON_INIT_FLAG_SEND_ZCOPY) &&
-        (select_param->dt_class == UCP_DATATYPE_GENERIC)) {
-        /* Generic/IOV datatype cannot be used with zero-copy send */
+        ((select_param->dt_class == UCP_DATATYPE_GENERIC) ||
+         (select_param->dt_class == UCP_DATATYPE_STRIDED))) {
+        /* Generic and strided datatypes cannot be used with zero-copy send,
+         * since UCT iov does not describe them */
         ucs_trace("datatype %s cannot be used with zcopy",
                   ucp_datatype_class_names[select_param->dt_class]);
         goto out;
@@ -240,6 +240,13 @@ static UCS_F_ALWAYS_INLINE ucs_status_ptr_t ucp_proto_request_send_op_common(
     ucs_string_buffer_t strb;
     ucs_status_t status;
 
+    if (ucs_unlikely(worker->context->config.ext.proto_feedback)) {
+        req->flags          |= UCP_REQUEST_FLAG_PROTO_FEEDBACK;
+        req->send.start_time = ucs_get_time();
+    }
+
+    UCP_REQUEST_TRACE_START(worker, req);
+
     status = UCS_PROFILE_CALL(ucp_proto_request_lookup_proto, worker, ep, req,
                               proto_select, rkey_cfg_index, select_param,
                               msg_length);
@@ -248,6 +255,8 @@ static UCS_F_ALWAYS_INLINE ucs_status_ptr_t ucp_proto_request_send_op_common(
         return UCS_STATUS_PTR(status);
     }
 
+    UCP_REQUEST_TRACE_SELECTED(req);
+
     UCS_PROFILE_CALL_VOID(ucp_request_send, req);
     if (req->flags & UCP_REQUEST_FLAG_COMPLETED) {
         /* coverity[offset_free] */
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "proto_feedback.h"
+
+#include <ucp/core/ucp_context.h>
+#include <ucp/core/ucp_ep.h>
+#include <ucp/core/ucp_request.h>
+#include <ucp/core/ucp_worker.h>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/time/time.h>
+#include <float.h>
+#include <math.h>
+
+
+static ucp_proto_feedback_bucket_t *
+ucp_proto_feedback_bucket(const ucp_proto_feedback_t *feedback,
+                          const ucp_proto_init_elem_t *init_elem,
+                          size_t msg_length)
+{
+    unsigned proto_idx = init_elem - feedback->protocols;
+
+    ucs_assertv(proto_idx < feedback->num_protocols, "proto_idx=%u num=%u",
+                proto_idx, feedback->num_protocols);
+    return (ucp_proto_feedback_bucket_t*)
+           &feedback->buckets[(proto_idx * UCP_PROTO_FEEDBACK_NUM_BUCKETS) +
+                              ucp_proto_feedback_bucket_index(msg_length)];
+}
+
+double ucp_proto_feedback_scale(const ucp_proto_feedback_t *feedback,
+                                const ucp_proto_init_elem_t *init_elem,
+                                size_t msg_length)
+{
+    return ucp_proto_feedback_bucket(feedback, init_elem, msg_length)->scale;
+}
+
+ucs_status_t
+ucp_proto_feedback_create(ucp_worker_cfg_index_t ep_cfg_index,
+                          ucp_worker_cfg_index_t rkey_cfg_index,
+                          const ucp_proto_select_param_t *select_param,
+                          ucp_proto_select_init_protocols_t *proto_init,
+                          ucp_proto_feedback_t **feedback_p)
+{
+    unsigned num_protocols = ucs_array_length(&proto_init->protocols);
+    unsigned num_buckets   = num_protocols * UCP_PROTO_FEEDBACK_NUM_BUCKETS;
+    ucp_proto_init_elem_t *init_elem;
+    ucp_proto_feedback_t *feedback;
+    unsigned i;
+
+    feedback = ucs_malloc(sizeof(*feedback) +
+                          (num_buckets * sizeof(*feedback->buckets)),
+                          "ucp_proto_feedback");
+    if (feedback == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    feedback->ep_cfg_index   = ep_cfg_index;
+    feedback->rkey_cfg_index = rkey_cfg_index;
+    feedback->select_param   = *select_param;
+    feedback->protocols      = ucs_array_begin(&proto_init->protocols);
+    feedback->num_protocols  = num_protocols;
+    feedback->num_updates    = 0;
+    ucs_array_init_dynamic(&feedback->retired);
+
+    for (i = 0; i < num_buckets; ++i) {
+        feedback->buckets[i].scale     = 1.0;
+        feedback->buckets[i].min_ratio = DBL_MAX;
+        feedback->buckets[i].count     = 0;
+    }
+
+    ucs_array_for_each(init_elem, &proto_init->protocols) {
+        init_elem->feedback = feedback;
+    }
+
+    *feedback_p = feedback;
+    return UCS_OK;
+}
+
+void ucp_proto_feedback_destroy(ucp_proto_feedback_t *feedback)
+{
+    const ucp_proto_threshold_elem_t **thresholds;
+
+    ucs_array_for_each(thresholds, &feedback->retired) {
+        ucs_free((void*)*thresholds);
+    }
+    ucs_array_cleanup_dynamic(&feedback->retired);
+    ucs_free(feedback);
+}
+
+ucs_status_t
+ucp_proto_feedback_retire(ucp_proto_feedback_t *feedback,
+                          const ucp_proto_threshold_elem_t *thresholds)
+{
+    *ucs_array_append(&feedback->retired,
+                      return UCS_ERR_NO_MEMORY) = thresholds;
+    return UCS_OK;
+}
+
+void ucp_proto_feedback_sample(ucp_request_t *req)
+{
+    const ucp_proto_init_elem_t *init_elem = req->send.proto_config->init_elem;
+    size_t msg_length                      = req->send.state.dt_iter.length;
+    const ucp_proto_flat_perf_range_t *range;
+    const ucp_context_config_t *config;
+    ucp_proto_feedback_bucket_t *bucket;
+    ucp_proto_feedback_t *feedback;
+    double estimated, ratio;
+    ucp_worker_h worker;
+
+    if ((init_elem == NULL) || (init_elem->feedback == NULL)) {
+        return;
+    }
+
+    range = ucp_proto_flat_perf_find_lb(init_elem->flat_perf, msg_length);
+    if ((range == NULL) || (msg_length < range->start)) {
+        return;
+    }
+
+    estimated = ucs_linear_func_apply(range->value, msg_length);
+    if (estimated <= 0) {
+        return;
+    }
+
+    /* Keep the best ratio of the window: it is the least affected by delays
+     * which are not related to the protocol, such as the peer not progressing
+     * or the request waiting behind other requests */
+    feedback          = init_elem->feedback;
+    bucket            = ucp_proto_feedback_bucket(feedback, init_elem,
+                                                  msg_length);
+    ratio             = ucs_time_to_sec(ucs_get_time() - req->send.start_time) /
+                        estimated;
+    bucket->min_ratio = ucs_min(bucket->min_ratio, ratio);
+
+    worker = req->send.ep->worker;
+    config = &worker->context->config.ext;
+    if (++bucket->count < config->proto_feedback_samples) {
+        return;
+    }
+
+    ratio             = bucket->min_ratio;
+    bucket->count     = 0;
+    bucket->min_ratio = DBL_MAX;
+    if (fabs(ratio - bucket->scale) <=
+        (config->proto_feedback_tolerance * bucket->scale)) {
+        return;
+    }
+
+    ucs_debug("proto %s msg_length %zu: measured time is %.2f of estimated, "
+              "was %.2f", ucp_proto_id_field(init_elem->proto_id, name),
+              msg_length, ratio, bucket->scale);
+    bucket->scale = ratio;
+
+    if (feedback->num_updates >= config->proto_feedback_max_updates) {
+        return;
+    }
+
+    ucp_proto_select_feedback_update(worker, feedback);
+}
@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_PROTO_FEEDBACK_H_
+#define UCP_PROTO_FEEDBACK_H_
+
+#include "proto_select.h"
+
+#include <ucs/arch/bitops.h>
+#include <ucs/datastruct/array.h>
+
+
+/* Number of message size buckets, one per power of 2 */
+#define UCP_PROTO_FEEDBACK_NUM_BUCKETS 64
+
+
+/**
+ * Measured performance of a protocol on a range of message sizes
+ * [2^i .. 2^(i+1)-1]
+ */
+typedef struct {
+    double   scale;     /* Measured time relative to the estimation, applied
+                           to the protocol performance on this range */
+    double   min_ratio; /* Lowest measured/estimated ratio of the current
+                           sampling window */
+    unsigned count;     /* Number of samples in the current window */
+} ucp_proto_feedback_bucket_t;
+
+
+/**
+ * Online performance feedback for a protocol selection element. Completed
+ * requests report their measured time, and when it diverges from the
+ * estimation the thresholds of the selection element are rebuilt.
+ */
+struct ucp_proto_feedback {
+    /* Selection element this feedback belongs to */
+    ucp_worker_cfg_index_t      ep_cfg_index;
+    ucp_worker_cfg_index_t      rkey_cfg_index;
+    ucp_proto_select_param_t    select_param;
+
+    /* Protocols of the selection element */
+    const ucp_proto_init_elem_t *protocols;
+    unsigned                    num_protocols;
+
+    /* Number of times the thresholds were rebuilt */
+    unsigned                    num_updates;
+
+    /* Replaced threshold arrays, which may still be used by requests in
+     * progress. Released together with the selection element. */
+    ucs_array_s(unsigned, const ucp_proto_threshold_elem_t*) retired;
+
+    /* Per-protocol buckets, indexed by
+     * proto_idx * UCP_PROTO_FEEDBACK_NUM_BUCKETS + bucket_idx */
+    ucp_proto_feedback_bucket_t buckets[];
+};
+
+
+static UCS_F_ALWAYS_INLINE unsigned
+ucp_proto_feedback_bucket_index(size_t msg_length)
+{
+    return ucs_ilog2_or0(msg_length);
+}
+
+
+static UCS_F_ALWAYS_INLINE size_t
+ucp_proto_feedback_bucket_end(unsigned bucket_idx)
+{
+    return (bucket_idx == (UCP_PROTO_FEEDBACK_NUM_BUCKETS - 1)) ?
+                   SIZE_MAX : (UCS_BIT(bucket_idx + 1) - 1);
+}
+
+
+/* Scale to apply on the estimated performance of a protocol */
+double ucp_proto_feedback_scale(const ucp_proto_feedback_t *feedback,
+                                const ucp_proto_init_elem_t *init_elem,
+                                size_t msg_length);
+
+
+ucs_status_t
+ucp_proto_feedback_create(ucp_worker_cfg_index_t ep_cfg_index,
+                          ucp_worker_cfg_index_t rkey_cfg_index,
+                          const ucp_proto_select_param_t *select_param,
+                          ucp_proto_select_init_protocols_t *proto_init,
+                          ucp_proto_feedback_t **feedback_p);
+
+
+void ucp_proto_feedback_destroy(ucp_proto_feedback_t *feedback);
+
+
+/* Keep a replaced thresholds array until the feedback is destroyed */
+ucs_status_t
+ucp_proto_feedback_retire(ucp_proto_feedback_t *feedback,
+                          const ucp_proto_threshold_elem_t *thresholds);
+
+
+/* Report the completion time of a request sent with feedback enabled */
+void ucp_proto_feedback_sample(ucp_request_t *req);
+
+#endif
@@ -9,7 +9,9 @@
 #endif
 
 #include "proto_init.h"
+#include "proto_cache.h"
 #include "proto_debug.h"
+#include "proto_feedback.h"
 #include "proto_single.h"
 #include "proto_select.inl"
 
@@ -57,9 +59,11 @@ static ucs_status_t ucp_proto_thresholds_next_range(
     const ucp_proto_init_elem_t *proto;
     const char *max_prio_proto_name;
     unsigned max_cfg_priority;
+    ucs_linear_func_t perf;
     ucs_status_t status;
     unsigned proto_idx;
     size_t max_length;
+    double scale;
 
     /*
      * Find the valid and configured protocols starting from 'msg_length'.
@@ -94,6 +98,14 @@ static ucs_status_t ucp_proto_thresholds_next_range(
         max_length = ucs_min(max_length, range->end);
         ucs_dynamic_bitmap_set(proto_mask, proto_idx);
 
+        /* Measured performance is kept per power-of-2 size range */
+        if (proto->feedback != NULL) {
+            max_length = ucs_min(max_length,
+                                 ucp_proto_feedback_bucket_end(
+                                         ucp_proto_feedback_bucket_index(
+                                                 msg_length)));
+        }
+
         /* Apply user threshold configuration */
         if (proto->cfg_thresh != UCS_MEMUNITS_AUTO) {
             if (proto->cfg_thresh == UCS_MEMUNITS_INF) {
@@ -158,11 +170,20 @@ static ucs_status_t ucp_proto_thresholds_next_range(
     UCS_DYNAMIC_BITMAP_FOR_EACH_BIT(proto_idx, proto_mask) {
         proto = &ucs_array_elem(&proto_init->protocols, proto_idx);
         range = ucp_proto_flat_perf_find_lb(proto->flat_perf, msg_length);
+        perf  = range->value;
+
+        /* Correct the estimation by the measured performance */
+        if (proto->feedback != NULL) {
+            scale   = ucp_proto_feedback_scale(proto->feedback, proto,
+                                               msg_length);
+            perf.c *= scale;
+            perf.m *= scale;
+        }
 
         *ucs_array_append(perf_list, status = UCS_ERR_NO_MEMORY;
-                          goto out_unindent) = range->value;
+                          goto out_unindent) = perf;
 
-        ucp_proto_select_perf_str(&range->value, time_str, sizeof(time_str),
+        ucp_proto_select_perf_str(&perf, time_str, sizeof(time_str),
                                   bw_str, sizeof(bw_str));
         ucs_trace("  %-20s %-20s %-18s",
                   ucp_proto_id_field(proto->proto_id, name), time_str, bw_str);
@@ -183,6 +204,7 @@ ucp_proto_select_init_protocols(ucp_worker_h worker,
                                 ucp_worker_cfg_index_t ep_cfg_index,
                                 ucp_worker_cfg_index_t rkey_cfg_index,
                                 const ucp_proto_select_param_t *select_param,
+                                ucp_proto_id_mask_t proto_mask,
                                 ucp_proto_select_init_protocols_t *proto_init)
 {
     UCS_STRING_BUFFER_ONSTACK(strb, UCP_PROTO_CONFIG_STR_MAX);
@@ -213,7 +235,7 @@ ucp_proto_select_init_protocols(ucp_worker_h worker,
     ucs_array_init_dynamic(&proto_init->protocols);
     ucs_array_init_dynamic(&proto_init->priv_buf);
 
-    ucs_for_each_bit(init_params.proto_id, worker->context->proto_bitmap) {
+    ucs_for_each_bit(init_params.proto_id, proto_mask) {
         ucs_assert(init_params.proto_id < ucp_protocols_count()); /* Coverity */
         ucs_trace("probing %s", ucp_proto_id_field(init_params.proto_id, name));
         ucs_log_indent(1);
@@ -319,12 +341,12 @@ static ucs_status_t ucp_proto_select_elem_add_envelope(
 
 static ucs_status_t
 ucp_proto_select_elem_init_thresh(ucp_worker_h worker,
-                                  ucp_proto_select_elem_t *select_elem,
                                   ucp_proto_select_init_protocols_t *proto_init,
                                   ucp_worker_cfg_index_t ep_cfg_index,
                                   ucp_worker_cfg_index_t rkey_cfg_index,
                                   const ucp_proto_select_param_t *select_param,
-                                  int internal)
+                                  int internal,
+                                  const ucp_proto_threshold_elem_t **thresh_p)
 {
     ucp_proto_thresh_t thresholds  = UCS_ARRAY_DYNAMIC_INITIALIZER;
     unsigned last_proto_idx        = UINT_MAX;
@@ -386,12 +408,7 @@ ucp_proto_select_elem_init_thresh(ucp_worker_h worker,
 
     ucs_assert_always(!ucs_array_is_empty(&thresholds));
 
-    /* Set pointer to priv buffer (to release it during cleanup) */
-    select_elem->thresholds  = ucs_array_extract_buffer(&thresholds);
-    select_elem->proto_init  = *proto_init;
-    ucs_array_init_dynamic(&proto_init->priv_buf);
-    ucs_array_init_dynamic(&proto_init->protocols);
-
+    *thresh_p = ucs_array_extract_buffer(&thresholds);
     return UCS_OK;
 
 err_cleanup_envelope:
@@ -450,6 +467,56 @@ ucp_proto_select_wiface_activate(ucp_worker_h worker,
     ep_config->proto_lane_map |= lane_map;
 }
 
+static void
+ucp_proto_select_elem_cleanup(ucp_proto_select_elem_t *select_elem)
+{
+    ucp_proto_select_init_protocols_t *proto_init = &select_elem->proto_init;
+    ucp_proto_feedback_t *feedback;
+
+    /* All protocols of the element share the same feedback object */
+    if (!ucs_array_is_empty(&proto_init->protocols)) {
+        feedback = ucs_array_elem(&proto_init->protocols, 0).feedback;
+        if (feedback != NULL) {
+            ucp_proto_feedback_destroy(feedback);
+        }
+    }
+
+    ucs_free((void*)select_elem->thresholds);
+    ucp_proto_select_cleanup_protocols(&select_elem->proto_init);
+}
+
+static ucs_status_t
+ucp_proto_select_elem_probe(ucp_worker_h worker, int internal,
+                            ucp_worker_cfg_index_t ep_cfg_index,
+                            ucp_worker_cfg_index_t rkey_cfg_index,
+                            const ucp_proto_select_param_t *select_param,
+                            ucp_proto_id_mask_t proto_mask,
+                            ucp_proto_select_elem_t *select_elem)
+{
+    ucp_proto_select_init_protocols_t proto_init;
+    ucs_status_t status;
+
+    status = ucp_proto_select_init_protocols(worker, ep_cfg_index,
+                                             rkey_cfg_index, select_param,
+                                             proto_mask, &proto_init);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucp_proto_select_elem_init_thresh(worker, &proto_init,
+                                               ep_cfg_index, rkey_cfg_index,
+                                               select_param, internal,
+                                               &select_elem->thresholds);
+    if (status != UCS_OK) {
+        ucp_proto_select_cleanup_protocols(&proto_init);
+        return status;
+    }
+
+    /* Set pointer to priv buffer (to release it during cleanup) */
+    select_elem->proto_init = proto_init;
+    return UCS_OK;
+}
+
 static ucs_status_t
 ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
                            ucp_worker_cfg_index_t ep_cfg_index,
@@ -458,10 +525,12 @@ ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
                            ucp_proto_select_elem_t *select_elem)
 {
     ucp_proto_select_param_t select_param_copy = *select_param;
+    ucp_proto_id_mask_t proto_mask = worker->context->proto_bitmap;
     UCS_STRING_BUFFER_ONSTACK(sel_param_strb, UCP_PROTO_SELECT_PARAM_STR_MAX);
     UCS_STRING_BUFFER_ONSTACK(config_name_strb, UCP_PROTO_SELECT_PARAM_STR_MAX);
-    ucp_proto_select_init_protocols_t proto_init;
+    ucp_proto_feedback_t *feedback;
     ucs_status_t status;
+    int cached;
 
     select_param_copy.op_attr |= worker->context->config.ext.extra_op_attr_flags;
 
@@ -475,18 +544,45 @@ ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
 
     ucs_log_indent(1);
 
-    status = ucp_proto_select_init_protocols(worker, ep_cfg_index,
-                                             rkey_cfg_index, &select_param_copy,
-                                             &proto_init);
+    /* Internal selections are used by other protocols to probe their
+     * variants, so they need all the candidates and not only the best ones */
+    cached = !internal && ucp_proto_cache_lookup(worker, ep_cfg_index,
+                                                 rkey_cfg_index, select_param,
+                                                 &proto_mask);
+    proto_mask &= worker->context->proto_bitmap;
+
+    status = ucp_proto_select_elem_probe(worker, internal, ep_cfg_index,
+                                         rkey_cfg_index, &select_param_copy,
+                                         proto_mask, select_elem);
+    if ((status != UCS_OK) && cached) {
+        ucs_debug("worker %p: cached protocols are not usable for %s %s, "
+                  "probing all protocols", worker,
+                  ucs_string_buffer_cstr(&config_name_strb),
+                  ucs_string_buffer_cstr(&sel_param_strb));
+        cached = 0;
+        status = ucp_proto_select_elem_probe(
+                worker, internal, ep_cfg_index, rkey_cfg_index,
+                &select_param_copy, worker->context->proto_bitmap,
+                select_elem);
+    }
     if (status != UCS_OK) {
         goto out;
     }
 
-    status = ucp_proto_select_elem_init_thresh(worker, select_elem, &proto_init,
-                                               ep_cfg_index, rkey_cfg_index,
-                                               &select_param_copy, internal);
-    if (status != UCS_OK) {
-        goto out_cleanup_proto_init;
+    if (!internal && !cached) {
+        ucp_proto_cache_add(worker, ep_cfg_index, rkey_cfg_index, select_param,
+                            select_elem->thresholds);
+    }
+
+    if (worker->context->config.ext.proto_feedback) {
+        status = ucp_proto_feedback_create(ep_cfg_index, rkey_cfg_index,
+                                           select_param,
+                                           &select_elem->proto_init,
+                                           &feedback);
+        if (status != UCS_OK) {
+            ucp_proto_select_elem_cleanup(select_elem);
+            goto out;
+        }
     }
 
     ucp_proto_select_wiface_activate(worker, select_elem, ep_cfg_index);
@@ -498,20 +594,11 @@ ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
 
     status = UCS_OK;
 
-out_cleanup_proto_init:
-    ucp_proto_select_cleanup_protocols(&proto_init);
 out:
     ucs_log_indent(-1);
     return status;
 }
 
-static void
-ucp_proto_select_elem_cleanup(ucp_proto_select_elem_t *select_elem)
-{
-    ucs_free((void*)select_elem->thresholds);
-    ucp_proto_select_cleanup_protocols(&select_elem->proto_init);
-}
-
 static void ucp_proto_select_cache_reset(ucp_proto_select_t *proto_select)
 {
     proto_select->cache.key   = UINT64_MAX;
@@ -585,6 +672,88 @@ void ucp_proto_select_cleanup(ucp_proto_select_t *proto_select)
     kh_destroy(ucp_proto_select_hash, proto_select->hash);
 }
 
+static int
+ucp_proto_select_thresholds_is_equal(const ucp_proto_threshold_elem_t *thresh1,
+                                     const ucp_proto_threshold_elem_t *thresh2)
+{
+    for (;; ++thresh1, ++thresh2) {
+        if ((thresh1->max_msg_length != thresh2->max_msg_length) ||
+            (thresh1->proto_config.proto != thresh2->proto_config.proto) ||
+            (thresh1->proto_config.priv != thresh2->proto_config.priv)) {
+            return 0;
+        }
+
+        if (thresh1->max_msg_length == SIZE_MAX) {
+            return 1;
+        }
+    }
+}
+
+void ucp_proto_select_feedback_update(ucp_worker_h worker,
+                                      ucp_proto_feedback_t *feedback)
+{
+    ucp_worker_cfg_index_t ep_cfg_index   = feedback->ep_cfg_index;
+    ucp_worker_cfg_index_t rkey_cfg_index = feedback->rkey_cfg_index;
+    const ucp_proto_threshold_elem_t *thresholds;
+    ucp_proto_select_elem_t *select_elem;
+    ucp_proto_select_param_t select_param;
+    ucp_proto_select_t *proto_select;
+    ucp_proto_select_key_t key;
+    ucs_status_t status;
+    khiter_t khiter;
+
+    if (rkey_cfg_index == UCP_WORKER_CFG_INDEX_NULL) {
+        proto_select = &ucp_worker_ep_config(worker, ep_cfg_index)->proto_select;
+    } else {
+        proto_select = &worker->rkey_config[rkey_cfg_index].proto_select;
+    }
+
+    /* Hash values may have moved since the feedback was created */
+    key.param = feedback->select_param;
+    khiter    = kh_get(ucp_proto_select_hash, proto_select->hash, key.u64);
+    ucs_assert_always(khiter != kh_end(proto_select->hash));
+    select_elem = &kh_value(proto_select->hash, khiter);
+
+    /* Use the parameters the protocols were initialized with */
+    select_param = select_elem->thresholds[0].proto_config.select_param;
+
+    ucs_log_indent(1);
+    status = ucp_proto_select_elem_init_thresh(worker,
+                                               &select_elem->proto_init,
+                                               ep_cfg_index, rkey_cfg_index,
+                                               &select_param, 1, &thresholds);
+    ucs_log_indent(-1);
+    if (status != UCS_OK) {
+        ucs_debug("worker %p: failed to update protocol selection: %s",
+                  worker, ucs_status_string(status));
+        return;
+    }
+
+    if (ucp_proto_select_thresholds_is_equal(select_elem->thresholds,
+                                             thresholds)) {
+        ucs_free((void*)thresholds);
+        return;
+    }
+
+    /* Requests in progress may still point to the previous thresholds */
+    status = ucp_proto_feedback_retire(feedback, select_elem->thresholds);
+    if (status != UCS_OK) {
+        ucs_free((void*)thresholds);
+        return;
+    }
+
+    ucs_debug("worker %p: updated protocol selection of ep_cfg[%d] rkey[%d] "
+              "by measured performance", worker, ep_cfg_index,
+              rkey_cfg_index);
+
+    select_elem->thresholds = thresholds;
+    ++feedback->num_updates;
+
+    ucp_proto_select_wiface_activate(worker, select_elem, ep_cfg_index);
+    ucp_proto_select_elem_trace(worker, ep_cfg_index, rkey_cfg_index,
+                                &select_param, select_elem);
+}
+
 void ucp_proto_select_add_proto(const ucp_proto_init_params_t *init_params,
                                 size_t cfg_thresh, unsigned cfg_priority,
                                 ucp_proto_perf_t *perf, const void *priv,
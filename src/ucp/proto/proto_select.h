@@ -55,6 +55,7 @@ typedef struct {
     unsigned              cfg_priority; /* Priority of configuration */
     ucp_proto_perf_t      *perf;
     ucp_proto_flat_perf_t *flat_perf; /* Flat performance considering all parts */
+    ucp_proto_feedback_t  *feedback; /* Measured performance, can be NULL */
 } ucp_proto_init_elem_t;
 
 
@@ -231,6 +232,11 @@ void ucp_proto_config_query(ucp_worker_h worker,
                             ucp_proto_query_attr_t *proto_attr);
 
 
+/* Rebuild the thresholds of a selection element using measured performance */
+void ucp_proto_select_feedback_update(ucp_worker_h worker,
+                                      ucp_proto_feedback_t *feedback);
+
+
 int ucp_proto_select_elem_query(ucp_worker_h worker,
                                 const ucp_proto_select_elem_t *select_elem,
                                 size_t msg_length,
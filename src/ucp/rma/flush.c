@@ -8,6 +8,7 @@
 #  include "config.h"
 #endif
 
+#include <ucp/core/ucp_aggr.h>
 #include <ucp/core/ucp_ep.h>
 #include <ucp/core/ucp_ep.inl>
 #include <ucp/core/ucp_request.inl>
@@ -386,6 +387,8 @@ ucs_status_ptr_t ucp_ep_flush_internal(ucp_ep_h ep, unsigned req_flags,
 
     ucs_debug("%s ep %p", debug_name, ep);
 
+    ucp_ep_aggr_flush_pending(ep);
+
     req = ucp_request_get_param(ep->worker, param,
                                 {return UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);});
 
@@ -614,6 +617,10 @@ ucp_worker_flush_nbx_internal(ucp_worker_h worker,
     ucs_status_t status;
     ucp_request_t *req;
 
+    if (ucs_unlikely(!ucs_list_is_empty(&worker->aggr_eps))) {
+        ucp_worker_aggr_flush(worker);
+    }
+
     if (!worker->flush_ops_count) {
         status = ucp_worker_flush_check(worker);
         if ((status != UCS_INPROGRESS) && (status != UCS_ERR_NO_RESOURCE)) {
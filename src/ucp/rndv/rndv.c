@@ -362,6 +362,27 @@ void ucp_rndv_req_send_ack(ucp_request_t *ack_req, size_t ack_size,
     ucp_request_send(ack_req);
 }
 
+void ucp_rndv_rts_send_ats(ucp_worker_h worker, ucp_rndv_rts_hdr_t *rts,
+                           ucs_status_t status)
+{
+    ucp_request_t *req;
+    ucp_ep_h ep;
+
+    UCP_WORKER_GET_EP_BY_ID(&ep, worker, rts->sreq.ep_id, return,
+                            "RNDV ATS");
+    req = ucp_request_get(worker);
+    if (ucs_unlikely(req == NULL)) {
+        ucs_error("failed to allocate request for RNDV ATS");
+        return;
+    }
+
+    req->send.ep = ep;
+    req->flags   = 0;
+
+    ucp_rndv_req_send_ack(req, rts->size, rts->sreq.req_id, status,
+                          UCP_AM_ID_RNDV_ATS, "send_ats");
+}
+
 static UCS_F_ALWAYS_INLINE void
 ucp_rndv_recv_req_complete(ucp_request_t *req, ucs_status_t status)
 {
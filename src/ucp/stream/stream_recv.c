@@ -119,7 +119,11 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_recv_data_nb, (ep, length),
                                     return UCS_STATUS_PTR(UCS_ERR_INVALID_PARAM));
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
-    status_ptr = ucp_stream_recv_data_nb_nolock(ep, length);
+    if (ucs_unlikely(ep->ext->stream.ring != NULL)) {
+        status_ptr = UCS_STATUS_PTR(UCS_ERR_UNSUPPORTED);
+    } else {
+        status_ptr = ucp_stream_recv_data_nb_nolock(ep, length);
+    }
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
 
     return status_ptr;
@@ -243,6 +247,44 @@ ucp_stream_rdesc_advance(ucp_recv_desc_t *rdesc, ssize_t offset,
     return UCS_OK;
 }
 
+/* Write as much of the data as fits to the ring, return the written length */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_stream_ring_write(ucp_stream_ring_t *ring, const void *data, size_t length)
+{
+    size_t offset = ring->tail & (ring->size - 1);
+    size_t first_length;
+
+    length       = ucs_min(length, ring->size - (ring->tail - ring->head));
+    first_length = ucs_min(length, ring->size - offset);
+    memcpy(UCS_PTR_BYTE_OFFSET(ring->buffer, offset), data, first_length);
+    memcpy(ring->buffer, UCS_PTR_BYTE_OFFSET(data, first_length),
+           length - first_length);
+
+    /* Make the data visible before the new tail */
+    ucs_memory_cpu_store_fence();
+    ring->tail += length;
+    return length;
+}
+
+/* Move the data which did not fit in the ring before to the ring */
+static void ucp_stream_ring_fill(ucp_ep_ext_t *ep_ext)
+{
+    ucp_recv_desc_t *rdesc;
+    size_t length, written;
+
+    while (ucp_stream_ep_has_data(ep_ext)) {
+        rdesc   = ucp_stream_rdesc_get(ep_ext);
+        length  = rdesc->length;
+        written = ucp_stream_ring_write(ep_ext->stream.ring,
+                                        ucp_stream_rdesc_payload(rdesc),
+                                        length);
+        ucp_stream_rdesc_advance(rdesc, written, ep_ext);
+        if (written < length) {
+            break;
+        }
+    }
+}
+
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucp_stream_process_rdesc(ucp_recv_desc_t *rdesc, ucp_ep_ext_t *ep_ext,
                          ucp_request_t *req)
@@ -424,6 +466,11 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_recv_nbx,
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
 
+    if (ucs_unlikely(ep->ext->stream.ring != NULL)) {
+        ret = UCS_STATUS_PTR(UCS_ERR_UNSUPPORTED);
+        goto out;
+    }
+
     status = ucp_stream_try_recv_inplace(ep, buffer, count, length, param);
     if (status != UCS_ERR_NO_PROGRESS) {
         ret = UCS_STATUS_PTR(status);
@@ -469,14 +516,28 @@ ucp_stream_am_data_process(ucp_worker_t *worker, ucp_ep_ext_t *ep_ext,
     ucp_recv_desc_t *rdesc;
     ucp_request_t   *req;
     ssize_t          unpacked;
+    size_t           written;
 
     rdesc_tmp.length         = length;
     rdesc_tmp.payload_offset = sizeof(*am_data); /* add sizeof(*rdesc) only if
                                                     am_data won't be handled in
                                                     place */
 
-    /* First, process expected requests */
-    if (!ucp_stream_ep_has_data(ep_ext)) {
+    if (ucs_unlikely(ep_ext->stream.ring != NULL)) {
+        /* Write to the ring, after the data which did not fit in it before */
+        if (!ucp_stream_ep_has_data(ep_ext)) {
+            payload = UCS_PTR_BYTE_OFFSET(am_data, rdesc_tmp.payload_offset);
+            written = ucp_stream_ring_write(ep_ext->stream.ring, payload,
+                                            length);
+            if (written == length) {
+                return UCS_OK;
+            }
+
+            rdesc_tmp.length         -= written;
+            rdesc_tmp.payload_offset += written;
+        }
+    } else if (!ucp_stream_ep_has_data(ep_ext)) {
+        /* First, process expected requests */
         while (!ucs_queue_is_empty(&ep_ext->stream.match_q)) {
             req      = ucs_queue_head_elem_non_empty(&ep_ext->stream.match_q,
                                                      ucp_request_t, recv.queue);
@@ -538,6 +599,7 @@ void ucp_stream_ep_init(ucp_ep_h ep)
         ep_ext->stream.ready_list.prev = NULL;
         ep_ext->stream.ready_list.next = NULL;
         ucs_queue_head_init(&ep_ext->stream.match_q);
+        ep_ext->stream.ring = NULL;
     }
 }
 
@@ -558,6 +620,8 @@ void ucp_stream_ep_cleanup(ucp_ep_h ep, ucs_status_t status)
         ucp_stream_data_release(ep, data);
     }
 
+    ep_ext->stream.ring = NULL;
+
     if (ucp_stream_ep_is_queued(ep_ext)) {
         ucp_stream_ep_dequeue(ep_ext);
     }
@@ -600,18 +664,83 @@ ucp_stream_am_handler(void *am_arg, void *am_data, size_t am_length,
     status = ucp_stream_am_data_process(worker, ep_ext, data,
                                         am_length - sizeof(data->hdr),
                                         am_flags);
-    if (status == UCS_OK) {
+    if ((status == UCS_OK) && (ep_ext->stream.ring == NULL)) {
         /* rdesc was processed in place */
         return UCS_OK;
     }
 
-    ucs_assert(status == UCS_INPROGRESS);
+    ucs_assert((status == UCS_OK) || (status == UCS_INPROGRESS));
 
+    /* The endpoint has queued data, or new data in its ring */
     if (!ucp_stream_ep_is_queued(ep_ext) && (ep->flags & UCP_EP_FLAG_USED)) {
         ucp_stream_ep_enqueue(ep_ext, worker);
     }
 
-    return (am_flags & UCT_CB_PARAM_FLAG_DESC) ? UCS_INPROGRESS : UCS_OK;
+    return ((status == UCS_INPROGRESS) && (am_flags & UCT_CB_PARAM_FLAG_DESC)) ?
+           UCS_INPROGRESS : UCS_OK;
+}
+
+ucs_status_t ucp_stream_ring_set(ucp_ep_h ep, ucp_stream_ring_t *ring)
+{
+    ucp_ep_ext_t *ep_ext = ep->ext;
+    ucs_status_t status;
+
+    UCP_CONTEXT_CHECK_FEATURE_FLAGS(ep->worker->context, UCP_FEATURE_STREAM,
+                                    return UCS_ERR_INVALID_PARAM);
+
+    if ((ring != NULL) && ((ring->buffer == NULL) || !ucs_is_pow2(ring->size))) {
+        ucs_error("ep %p: invalid stream ring buffer %p size %zu", ep,
+                  ring->buffer, ring->size);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
+
+    if (!ucp_stream_ep_has_data(ep_ext) &&
+        !ucs_queue_is_empty(&ep_ext->stream.match_q)) {
+        /* Receive requests are in progress */
+        status = UCS_ERR_BUSY;
+        goto out;
+    }
+
+    ep_ext->stream.ring = ring;
+    if (ring != NULL) {
+        ring->head = 0;
+        ring->tail = 0;
+        ucp_stream_ring_fill(ep_ext);
+    }
+
+    status = UCS_OK;
+
+out:
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
+    return status;
+}
+
+ucs_status_t ucp_stream_ring_release(ucp_ep_h ep, size_t length)
+{
+    ucp_ep_ext_t *ep_ext = ep->ext;
+    ucp_stream_ring_t *ring;
+    ucs_status_t status;
+
+    UCP_CONTEXT_CHECK_FEATURE_FLAGS(ep->worker->context, UCP_FEATURE_STREAM,
+                                    return UCS_ERR_INVALID_PARAM);
+
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
+
+    ring = ep_ext->stream.ring;
+    if ((ring == NULL) || (length > (ring->tail - ring->head))) {
+        status = UCS_ERR_INVALID_PARAM;
+        goto out;
+    }
+
+    ring->head += length;
+    ucp_stream_ring_fill(ep_ext);
+    status = UCS_OK;
+
+out:
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
+    return status;
 }
 
 static void ucp_stream_am_dump(ucp_worker_h worker, uct_am_trace_type_t type,
@@ -71,7 +71,8 @@ typedef struct {
 extern const ucp_request_send_proto_t ucp_tag_eager_proto;
 extern const ucp_request_send_proto_t ucp_tag_eager_sync_proto;
 
-void ucp_tag_eager_sync_send_ack(ucp_worker_h worker, void *hdr, uint16_t recv_flags);
+void ucp_tag_eager_sync_send_ack(ucp_worker_h worker, void *hdr,
+                                 uint16_t recv_flags, ucs_status_t status);
 
 void ucp_tag_eager_sync_completion(ucp_request_t *req, uint32_t flag,
                                    ucs_status_t status);
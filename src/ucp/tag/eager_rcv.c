@@ -60,7 +60,9 @@ ucp_eager_offload_handler(void *arg, void *data, size_t length,
         status = UCS_OK;
     } else {
         status = ucp_recv_desc_init(worker, data, length, sizeof(ucp_tag_t),
-                                    tl_flags, sizeof(ucp_tag_t), flags,
+                                    ucp_tag_unexp_am_flags(&worker->tm,
+                                                           tl_flags),
+                                    sizeof(ucp_tag_t), flags,
                                     sizeof(ucp_tag_t), 1, name, &rdesc);
         if (!UCS_STATUS_IS_ERR(status)) {
             rdesc_hdr  = (ucp_tag_t*)(rdesc + 1);
@@ -72,6 +74,35 @@ ucp_eager_offload_handler(void *arg, void *data, size_t length,
     return status;
 }
 
+/* Drop an unexpected software eager message which does not fit into the
+ * unexpected queue. The sender of a synchronous message gets an error in the
+ * acknowledgment, other senders are not notified. */
+static UCS_F_NOINLINE void
+ucp_eager_tagged_drop(ucp_worker_h worker, void *data, size_t length,
+                      uint16_t flags, uint16_t hdr_len, size_t msg_len)
+{
+    ucp_tag_match_t *tm               = &worker->tm;
+    ucp_eager_first_hdr_t *eagerf_hdr = data;
+
+    ++tm->unexpected.num_dropped;
+    ucs_log((tm->unexpected.num_dropped == 1) ? UCS_LOG_LEVEL_ERROR :
+                                                UCS_LOG_LEVEL_DEBUG,
+            "worker %p: dropped unexpected message with tag 0x%" PRIx64
+            " length %zu, unexpected queue length %zu exceeds"
+            " UCX_UNEXP_MAX_SIZE (%zu)", worker,
+            eagerf_hdr->super.super.tag, msg_len, tm->unexpected.length,
+            tm->unexpected.max_length);
+
+    if (flags & UCP_RECV_DESC_FLAG_EAGER_SYNC) {
+        ucp_tag_eager_sync_send_ack(worker, data, flags, UCS_ERR_EXCEEDS_LIMIT);
+    }
+
+    if (!(flags & UCP_RECV_DESC_FLAG_EAGER_ONLY)) {
+        ucp_tag_frag_drop(tm, eagerf_hdr->msg_id,
+                          eagerf_hdr->total_len - (length - hdr_len));
+    }
+}
+
 /* Common handler for eager only, eager sync only, eager first, eager sync
  * first, eager offload only and eager sync offload only messages
  */
@@ -84,7 +115,7 @@ ucp_eager_tagged_handler(void *arg, void *data, size_t length, unsigned am_flags
     ucp_eager_hdr_t *eager_hdr = data;
     ucp_tag_t recv_tag         = eager_hdr->super.tag;
     ucp_eager_first_hdr_t *eagerf_hdr;
-    size_t recv_len;
+    size_t recv_len, msg_len;
     void *payload;
     ucp_recv_desc_t *rdesc;
     ucp_request_t *req;
@@ -98,7 +129,7 @@ ucp_eager_tagged_handler(void *arg, void *data, size_t length, unsigned am_flags
         ucp_eager_common_matched(worker, req, data, recv_len, recv_tag, flags);
 
         if (flags & UCP_RECV_DESC_FLAG_EAGER_SYNC) {
-            ucp_tag_eager_sync_send_ack(worker, data, flags);
+            ucp_tag_eager_sync_send_ack(worker, data, flags, UCS_OK);
         }
 
         if (flags & UCP_RECV_DESC_FLAG_EAGER_ONLY) {
@@ -123,15 +154,29 @@ ucp_eager_tagged_handler(void *arg, void *data, size_t length, unsigned am_flags
             }
         }
 
-        status = UCS_OK;
-    } else {
-        status = ucp_recv_desc_init(worker, data, length, 0, am_flags, hdr_len,
-                                    flags, priv_length, 1, name, &rdesc);
-        if (!UCS_STATUS_IS_ERR(status)) {
-            ucp_tag_unexp_recv(&worker->tm, rdesc, recv_tag);
+        return UCS_OK;
+    }
+
+    /* Tag offload messages are not dropped, because the offload sync
+     * acknowledgment cannot carry an error status */
+    if (!(flags & UCP_RECV_DESC_FLAG_EAGER_OFFLOAD)) {
+        msg_len = (flags & UCP_RECV_DESC_FLAG_EAGER_ONLY) ?
+                  length :
+                  (hdr_len + ((ucp_eager_first_hdr_t*)data)->total_len);
+        if (ucs_unlikely(ucp_tag_unexp_is_full(&worker->tm, msg_len))) {
+            ucp_eager_tagged_drop(worker, data, length, flags, hdr_len,
+                                  msg_len);
+            return UCS_OK;
         }
     }
 
+    status = ucp_recv_desc_init(worker, data, length, 0,
+                                ucp_tag_unexp_am_flags(&worker->tm, am_flags),
+                                hdr_len, flags, priv_length, 1, name, &rdesc);
+    if (!UCS_STATUS_IS_ERR(status)) {
+        ucp_tag_unexp_recv(&worker->tm, rdesc, recv_tag);
+    }
+
     return status;
 }
 
@@ -171,6 +216,12 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_eager_middle_handler,
     khiter_t iter;
     int ret;
 
+    if (ucs_unlikely(kh_size(&worker->tm.frag_drop_hash) != 0) &&
+        ucp_tag_frag_drop_middle(&worker->tm, hdr->msg_id,
+                                 length - sizeof(*hdr))) {
+        return UCS_OK;
+    }
+
     iter   = kh_put(ucp_tag_frag_hash, &worker->tm.frag_hash, hdr->msg_id, &ret);
     ucs_assert(ret != UCS_KH_PUT_FAILED);
     matchq = &kh_value(&worker->tm.frag_hash, iter);
@@ -185,7 +236,8 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_eager_middle_handler,
                                     sizeof(*hdr), UCP_RECV_DESC_FLAG_EAGER, 0,
                                     1, "eager_middle_handler", &rdesc);
         if (ucs_likely(!UCS_STATUS_IS_ERR(status))) {
-            ucp_tag_frag_match_add_unexp(matchq, rdesc, hdr->offset);
+            ucp_tag_frag_match_add_unexp(&worker->tm, matchq, rdesc,
+                                         hdr->offset);
         } else if (ucs_queue_is_empty(&matchq->unexp_q)) {
             /* If adding the first fragment to the unexpected queue fails,
              * remove the element from the hash. Otherwise hash would contain an
@@ -288,7 +340,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_eager_sync_ack_handler,
                                    return UCS_OK, "EAGER_S ACK %p", rep_hdr);
         ucp_tag_eager_sync_completion(req,
                                       UCP_REQUEST_FLAG_SYNC_REMOTE_COMPLETED,
-                                      UCS_OK);
+                                      rep_hdr->status);
     }
 
     return UCS_OK;
@@ -410,7 +462,7 @@ ucp_tag_offload_eager_middle_handler(ucp_worker_h worker, void *data,
         }
 
         /* Offset is not known at this point, pass 0 */
-        ucp_tag_frag_match_add_unexp(matchq, rdesc, 0ul);
+        ucp_tag_frag_match_add_unexp(&worker->tm, matchq, rdesc, 0ul);
     } else {
         status = ucp_request_recv_offload_data(matchq->exp_req, data, length,
                                                flags);
@@ -297,7 +297,8 @@ const ucp_request_send_proto_t ucp_tag_eager_sync_proto = {
     .only_hdr_size           = sizeof(ucp_eager_sync_hdr_t)
 };
 
-void ucp_tag_eager_sync_send_ack(ucp_worker_h worker, void *hdr, uint16_t recv_flags)
+void ucp_tag_eager_sync_send_ack(ucp_worker_h worker, void *hdr,
+                                 uint16_t recv_flags, ucs_status_t status)
 {
     ucp_request_hdr_t *reqhdr;
     ucp_request_t *req;
@@ -329,6 +330,7 @@ void ucp_tag_eager_sync_send_ack(ucp_worker_h worker, void *hdr, uint16_t recv_f
 
     req->send.proto.am_id         = UCP_AM_ID_EAGER_SYNC_ACK;
     req->send.proto.remote_req_id = reqhdr->req_id;
+    req->send.proto.status        = status;
 
     ucs_trace_req("send_sync_ack req %p ep %p", req, req->send.ep);
 
@@ -114,7 +114,8 @@ UCS_PROFILE_FUNC_VOID(ucp_tag_offload_completed,
         ucp_tag_eager_sync_send_ack(req->recv.worker, &hdr,
                                     UCP_RECV_DESC_FLAG_EAGER_ONLY |
                                     UCP_RECV_DESC_FLAG_EAGER_SYNC |
-                                    UCP_RECV_DESC_FLAG_EAGER_OFFLOAD);
+                                    UCP_RECV_DESC_FLAG_EAGER_OFFLOAD,
+                                    UCS_OK);
     }
 
     if (ucs_unlikely(inline_data != NULL)) {
@@ -452,7 +453,7 @@ UCS_PROFILE_FUNC(int, ucp_tag_offload_post, (req, req_queue),
             UCP_WORKER_STAT_TAG_OFFLOAD(worker, BLOCK_SW_PEND);
             return 0;
         }
-    } else if (worker->tm.expected.wildcard.sw_count ||
+    } else if (worker->tm.expected.wild_sw_count ||
                (req_queue->sw_count && !ucp_tag_offload_post_sw_reqs(req, req_queue))) {
         /* There are some requests which must be completed in SW */
         UCP_WORKER_STAT_TAG_OFFLOAD(worker, BLOCK_SW_PEND);
@@ -12,14 +12,30 @@
 #include <ucp/tag/offload.h>
 
 
-ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
+static void ucp_tag_exp_queue_init(ucp_request_queue_t *req_queue)
+{
+    req_queue->sw_count    = 0;
+    req_queue->block_count = 0;
+    ucs_queue_head_init(&req_queue->queue);
+}
+
+ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm, ucp_context_h context)
 {
     size_t hash_size, bucket;
 
     hash_size = ucs_roundup_pow2(UCP_TAG_MATCH_HASH_SIZE);
 
-    tm->expected.sn           = 0;
-    tm->expected.sw_all_count = 0;
+    tm->expected.sn               = 0;
+    tm->expected.sw_all_count     = 0;
+    tm->expected.wild_sw_count    = 0;
+    tm->expected.num_mask_classes = 0;
+    tm->expected.max_mask_classes = ucs_min(
+            context->config.ext.tm_mask_classes,
+            UCP_TAG_MATCH_MASK_CLASSES_MAX);
+    tm->unexpected.length         = 0;
+    tm->unexpected.spill_thresh   = context->config.ext.unexp_spill_thresh;
+    tm->unexpected.max_length     = context->config.ext.unexp_max_size;
+    tm->unexpected.num_dropped    = 0;
     ucs_queue_head_init(&tm->expected.wildcard.queue);
     ucs_list_head_init(&tm->unexpected.all);
 
@@ -37,13 +53,12 @@ ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
     }
 
     for (bucket = 0; bucket < hash_size; ++bucket) {
-        tm->expected.hash[bucket].sw_count    = 0;
-        tm->expected.hash[bucket].block_count = 0;
-        ucs_queue_head_init(&tm->expected.hash[bucket].queue);
+        ucp_tag_exp_queue_init(&tm->expected.hash[bucket]);
         ucs_list_head_init(&tm->unexpected.hash[bucket]);
     }
 
     kh_init_inplace(ucp_tag_frag_hash, &tm->frag_hash);
+    kh_init_inplace(ucp_tag_frag_drop_hash, &tm->frag_drop_hash);
     ucs_queue_head_init(&tm->offload.sync_reqs);
     kh_init_inplace(ucp_tag_offload_hash, &tm->offload.tag_hash);
     tm->offload.thresh       = SIZE_MAX;
@@ -56,20 +71,60 @@ ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
 void ucp_tag_match_cleanup(ucp_tag_match_t *tm)
 {
     ucp_recv_desc_t *rdesc, *tmp_rdesc;
+    ucp_tag_mask_class_t *mask_class;
 
     ucs_list_for_each_safe(rdesc, tmp_rdesc, &tm->unexpected.all,
                            tag_list[UCP_RDESC_ALL_LIST]) {
         ucs_warn("unexpected tag-receive descriptor %p was not matched", rdesc);
-        ucp_tag_unexp_remove(rdesc);
+        ucp_tag_unexp_remove(tm, rdesc);
         ucp_recv_desc_release(rdesc);
     }
 
     kh_destroy_inplace(ucp_tag_offload_hash, &tm->offload.tag_hash);
     kh_destroy_inplace(ucp_tag_frag_hash, &tm->frag_hash);
+    kh_destroy_inplace(ucp_tag_frag_drop_hash, &tm->frag_drop_hash);
+    ucs_carray_for_each(mask_class, tm->expected.mask_classes,
+                        tm->expected.num_mask_classes) {
+        ucs_free(mask_class->hash);
+    }
     ucs_free(tm->unexpected.hash);
     ucs_free(tm->expected.hash);
 }
 
+ucp_request_queue_t*
+ucp_tag_exp_add_mask_class(ucp_tag_match_t *tm, ucp_tag_t tag,
+                           ucp_tag_t tag_mask)
+{
+    ucp_tag_mask_class_t *mask_class;
+    size_t hash_size, bucket;
+
+    ucs_assert(tm->expected.num_mask_classes < tm->expected.max_mask_classes);
+
+    hash_size  = ucs_roundup_pow2(UCP_TAG_MATCH_HASH_SIZE);
+    mask_class = &tm->expected.mask_classes[tm->expected.num_mask_classes];
+    mask_class->hash = ucs_malloc(sizeof(*mask_class->hash) * hash_size,
+                                  "ucp_tm_exp_mask_class");
+    if (mask_class->hash == NULL) {
+        /* Do not try to add more classes, since requests with this tag mask
+         * are going to be added to the wildcard queue */
+        ucs_debug("failed to allocate tag mask class for mask %"PRIx64,
+                  tag_mask);
+        tm->expected.max_mask_classes = tm->expected.num_mask_classes;
+        return &tm->expected.wildcard;
+    }
+
+    for (bucket = 0; bucket < hash_size; ++bucket) {
+        ucp_tag_exp_queue_init(&mask_class->hash[bucket]);
+    }
+
+    mask_class->tag_mask = tag_mask;
+    ++tm->expected.num_mask_classes;
+
+    ucs_trace("tm %p: added tag mask class %u for mask %"PRIx64, tm,
+              tm->expected.num_mask_classes - 1, tag_mask);
+    return ucp_tag_exp_get_queue_for_class(mask_class, tag);
+}
+
 int ucp_tag_unexp_is_empty(ucp_tag_match_t *tm)
 {
     return ucs_list_is_empty(&tm->unexpected.all);
@@ -101,6 +156,57 @@ static inline uint64_t ucp_tag_exp_req_seq(ucs_queue_iter_t iter)
            ucs_container_of(*iter, ucp_request_t, recv.queue)->recv.tag.sn;
 }
 
+/* Every queue is ordered by sequence number, so the first matching request of
+ * each queue is a candidate, and the candidate with the lowest sequence number
+ * is the one which was posted first */
+static ucp_request_t*
+ucp_tag_exp_search_mask_classes(ucp_tag_match_t *tm,
+                                ucp_request_queue_t *req_queue, ucp_tag_t tag)
+{
+    ucp_request_queue_t *queues[UCP_TAG_MATCH_MASK_CLASSES_MAX + 2];
+    ucp_request_queue_t *queue, *match_queue = NULL;
+    ucs_queue_iter_t iter, match_iter        = NULL;
+    uint64_t match_sn                        = ULONG_MAX;
+    ucp_request_t *req, *match_req           = NULL;
+    ucp_tag_mask_class_t *mask_class;
+    unsigned i, num_queues;
+
+    num_queues           = 0;
+    queues[num_queues++] = req_queue;
+    queues[num_queues++] = &tm->expected.wildcard;
+    ucs_carray_for_each(mask_class, tm->expected.mask_classes,
+                        tm->expected.num_mask_classes) {
+        queues[num_queues++] = ucp_tag_exp_get_queue_for_class(mask_class, tag);
+    }
+
+    for (i = 0; i < num_queues; ++i) {
+        queue = queues[i];
+        ucs_queue_for_each_safe(req, iter, &queue->queue, recv.queue) {
+            if (req->recv.tag.sn >= match_sn) {
+                /* The rest of the queue was posted after the current match */
+                break;
+            }
+
+            if (ucp_tag_is_match(tag, req->recv.tag.tag,
+                                 req->recv.tag.tag_mask)) {
+                match_req   = req;
+                match_sn    = req->recv.tag.sn;
+                match_iter  = iter;
+                match_queue = queue;
+                break;
+            }
+        }
+    }
+
+    if (match_req != NULL) {
+        ucs_trace_req("matched received tag %"PRIx64" to req %p", tag,
+                      match_req);
+        ucp_tag_exp_delete(match_req, tm, match_queue, match_iter);
+    }
+
+    return match_req;
+}
+
 ucp_request_t*
 ucp_tag_exp_search_all(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
                        ucp_tag_t tag)
@@ -111,6 +217,10 @@ ucp_tag_exp_search_all(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
     uint64_t hash_sn, wild_sn, *sn_p;
     ucp_request_t *req;
 
+    if (tm->expected.num_mask_classes != 0) {
+        return ucp_tag_exp_search_mask_classes(tm, req_queue, tag);
+    }
+
     *hash_queue->ptail                 = NULL;
     *tm->expected.wildcard.queue.ptail = NULL;
 
@@ -176,3 +286,61 @@ void ucp_tag_frag_list_process_queue(ucp_tag_match_t *tm, ucp_request_t *req,
     /* request not completed, put it on the hash */
     ucp_tag_frag_hash_init_exp(matchq, req);
 }
+
+void ucp_tag_frag_drop(ucp_tag_match_t *tm, uint64_t msg_id, size_t remaining)
+{
+    ucp_tag_frag_match_t *matchq;
+    ucp_recv_desc_t *rdesc;
+    khiter_t iter;
+    int ret;
+
+    /* Release middle fragments which arrived before the first one */
+    iter = kh_get(ucp_tag_frag_hash, &tm->frag_hash, msg_id);
+    if (iter != kh_end(&tm->frag_hash)) {
+        matchq = &kh_value(&tm->frag_hash, iter);
+        ucs_assert(ucp_tag_frag_match_is_unexp(matchq));
+        ucs_queue_for_each_extract(rdesc, &matchq->unexp_q, tag_frag_queue, 1) {
+            ucs_assert(tm->unexpected.length >= rdesc->length);
+            ucs_assert(remaining >= (rdesc->length - rdesc->payload_offset));
+            tm->unexpected.length -= rdesc->length;
+            remaining             -= rdesc->length - rdesc->payload_offset;
+            ucp_recv_desc_release(rdesc);
+        }
+        kh_del(ucp_tag_frag_hash, &tm->frag_hash, iter);
+    }
+
+    if (remaining == 0) {
+        return;
+    }
+
+    /* Remember the message, to drop its middle fragments when they arrive */
+    iter = kh_put(ucp_tag_frag_drop_hash, &tm->frag_drop_hash, msg_id, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        ucs_error("failed to add message id 0x%" PRIx64 " to dropped messages",
+                  msg_id);
+        return;
+    }
+
+    kh_value(&tm->frag_drop_hash, iter) = remaining;
+}
+
+int ucp_tag_frag_drop_middle(ucp_tag_match_t *tm, uint64_t msg_id,
+                             size_t length)
+{
+    size_t *remaining;
+    khiter_t iter;
+
+    iter = kh_get(ucp_tag_frag_drop_hash, &tm->frag_drop_hash, msg_id);
+    if (iter == kh_end(&tm->frag_drop_hash)) {
+        return 0;
+    }
+
+    remaining = &kh_value(&tm->frag_drop_hash, iter);
+    ucs_assert(*remaining >= length);
+    *remaining -= length;
+    if (*remaining == 0) {
+        kh_del(ucp_tag_frag_drop_hash, &tm->frag_drop_hash, iter);
+    }
+
+    return 1;
+}
@@ -17,6 +17,9 @@
 
 #define UCP_TAG_MASK_FULL     0xffffffffffffffffUL  /* All 1-s */
 
+/* Maximal number of distinct wildcard tag masks which can be indexed */
+#define UCP_TAG_MATCH_MASK_CLASSES_MAX 8
+
 
 KHASH_INIT(ucp_tag_offload_hash, ucp_tag_t, ucp_worker_iface_t *, 1,
            kh_int64_hash_func, kh_int64_hash_equal);
@@ -42,6 +45,16 @@ typedef struct {
 } ucp_request_queue_t;
 
 
+/**
+ * Index of expected requests posted with the same wildcard tag mask
+ */
+typedef struct {
+    ucp_tag_t             tag_mask;    /* Tag mask of the requests in the class */
+    ucp_request_queue_t   *hash;       /* Hash table of expected requests, keyed
+                                          by the masked tag */
+} ucp_tag_mask_class_t;
+
+
 /**
  * Hash table entry for tag message fragments
  */
@@ -55,6 +68,12 @@ KHASH_INIT(ucp_tag_frag_hash, uint64_t, ucp_tag_frag_match_t, 1,
            kh_int64_hash_func, kh_int64_hash_equal);
 
 
+/* Remaining length of multi-fragment messages whose first fragment was
+ * dropped, the key is a globally unique tag message id */
+KHASH_INIT(ucp_tag_frag_drop_hash, uint64_t, size_t, 1,
+           kh_int64_hash_func, kh_int64_hash_equal);
+
+
 /**
  * Tag-matching context
  */
@@ -67,17 +86,44 @@ typedef struct ucp_tag_match {
         uint64_t              sn;
         unsigned              sw_all_count; /* Number of all expected requests which
                                                are not posted to offload */
+        unsigned              wild_sw_count; /* Number of expected wildcard
+                                                requests, either in the wildcard
+                                                queue or in a mask class, which
+                                                are not posted to offload */
+        unsigned              num_mask_classes; /* Number of used mask classes */
+        unsigned              max_mask_classes; /* Maximal number of mask classes,
+                                                   0 - mask classes are disabled */
+        ucp_tag_mask_class_t  mask_classes[UCP_TAG_MATCH_MASK_CLASSES_MAX];
     } expected;
 
     /* Unexpected queue */
     struct {
         ucs_list_link_t       all;        /* Linked list of all tags */
         ucs_list_link_t       *hash;      /* Hash table of unexpected tags */
+        size_t                length;     /* Total length of unexpected
+                                             descriptors, including middle
+                                             fragments of unexpected
+                                             multi-fragment messages */
+        size_t                spill_thresh; /* Above this length, unexpected
+                                               data is copied to the worker
+                                               memory pool to release transport
+                                               receive buffers */
+        size_t                max_length; /* Maximal length of unexpected
+                                             descriptors. Software eager
+                                             messages which would exceed it are
+                                             dropped, and rendezvous requests
+                                             are rejected back to the sender */
+        unsigned long         num_dropped; /* Number of dropped unexpected
+                                              messages */
     } unexpected;
 
     /* Hash for fragment assembly, the key is a globally unique tag message id */
     khash_t(ucp_tag_frag_hash) frag_hash;
 
+    /* Hash of dropped multi-fragment messages whose middle fragments are still
+     * to arrive */
+    khash_t(ucp_tag_frag_drop_hash) frag_drop_hash;
+
     /* Tag offload fields */
     struct {
         ucs_queue_head_t      sync_reqs;        /* Outgoing sync send requests */
@@ -101,7 +147,7 @@ typedef struct ucp_tag_match {
 } ucp_tag_match_t;
 
 
-ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm);
+ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm, ucp_context_h context);
 
 void ucp_tag_match_cleanup(ucp_tag_match_t *tm);
 
@@ -109,6 +155,10 @@ int ucp_tag_exp_remove(ucp_tag_match_t *tm, ucp_request_t *req);
 
 int ucp_tag_unexp_is_empty(ucp_tag_match_t *tm);
 
+ucp_request_queue_t*
+ucp_tag_exp_add_mask_class(ucp_tag_match_t *tm, ucp_tag_t tag,
+                           ucp_tag_t tag_mask);
+
 ucp_request_t*
 ucp_tag_exp_search_all(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
                        ucp_tag_t tag);
@@ -117,4 +167,13 @@ void ucp_tag_frag_list_process_queue(ucp_tag_match_t *tm, ucp_request_t *req,
                                      uint64_t msg_id
                                      UCS_STATS_ARG(int counter_idx));
 
+/* Drop the remaining fragments of a message whose first fragment was dropped,
+ * 'remaining' is the length of the data which was not received yet */
+void ucp_tag_frag_drop(ucp_tag_match_t *tm, uint64_t msg_id, size_t remaining);
+
+/* Returns nonzero if the middle fragment belongs to a dropped message and
+ * should be dropped as well */
+int ucp_tag_frag_drop_middle(ucp_tag_match_t *tm, uint64_t msg_id,
+                             size_t length);
+
 #endif
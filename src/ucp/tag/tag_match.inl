@@ -56,14 +56,36 @@ ucp_tag_exp_get_queue_for_tag(ucp_tag_match_t *tm, ucp_tag_t tag)
     return &tm->expected.hash[ucp_tag_match_calc_hash(tag)];
 }
 
+static UCS_F_ALWAYS_INLINE ucp_request_queue_t*
+ucp_tag_exp_get_queue_for_class(ucp_tag_mask_class_t *mask_class, ucp_tag_t tag)
+{
+    return &mask_class->hash[ucp_tag_match_calc_hash(tag &
+                                                     mask_class->tag_mask)];
+}
+
 static UCS_F_ALWAYS_INLINE ucp_request_queue_t*
 ucp_tag_exp_get_queue(ucp_tag_match_t *tm, ucp_tag_t tag, ucp_tag_t tag_mask)
 {
+    ucp_tag_mask_class_t *mask_class;
+
     if (tag_mask == UCP_TAG_MASK_FULL) {
         return ucp_tag_exp_get_queue_for_tag(tm, tag);
-    } else {
-        return &tm->expected.wildcard;
     }
+
+    ucs_carray_for_each(mask_class, tm->expected.mask_classes,
+                        tm->expected.num_mask_classes) {
+        if (mask_class->tag_mask == tag_mask) {
+            return ucp_tag_exp_get_queue_for_class(mask_class, tag);
+        }
+    }
+
+    /* Mask classes are never released, so if there is a free slot, no request
+     * with this tag mask could be added to the wildcard queue before */
+    if (tm->expected.num_mask_classes < tm->expected.max_mask_classes) {
+        return ucp_tag_exp_add_mask_class(tm, tag, tag_mask);
+    }
+
+    return &tm->expected.wildcard;
 }
 
 static UCS_F_ALWAYS_INLINE ucp_request_queue_t*
@@ -87,6 +109,8 @@ ucp_tag_exp_delete(ucp_request_t *req, ucp_tag_match_t *tm,
     if (!(req->flags & UCP_REQUEST_FLAG_OFFLOADED)) {
         --tm->expected.sw_all_count;
         --req_queue->sw_count;
+        tm->expected.wild_sw_count -= (req->recv.tag.tag_mask !=
+                                       UCP_TAG_MASK_FULL);
         if (req->flags & UCP_REQUEST_FLAG_BLOCK_OFFLOAD) {
             --req_queue->block_count;
         }
@@ -101,7 +125,8 @@ ucp_tag_exp_search(ucp_tag_match_t *tm, ucp_tag_t tag)
     ucs_queue_iter_t iter;
     ucp_request_t *req;
 
-    if (ucs_unlikely(!ucs_queue_is_empty(&tm->expected.wildcard.queue))) {
+    if (ucs_unlikely(!ucs_queue_is_empty(&tm->expected.wildcard.queue) ||
+                     (tm->expected.num_mask_classes != 0))) {
         req_queue = ucp_tag_exp_get_queue_for_tag(tm, tag);
         return ucp_tag_exp_search_all(tm, req_queue, tag);
     }
@@ -133,18 +158,43 @@ ucp_tag_unexp_get_list_for_tag(ucp_tag_match_t *tm, ucp_tag_t tag)
 }
 
 static UCS_F_ALWAYS_INLINE void
-ucp_tag_unexp_remove(ucp_recv_desc_t *rdesc)
+ucp_tag_unexp_remove(ucp_tag_match_t *tm, ucp_recv_desc_t *rdesc)
 {
+    ucs_assert(tm->unexpected.length >= rdesc->length);
+    tm->unexpected.length -= rdesc->length;
     ucs_list_del(&rdesc->tag_list[UCP_RDESC_HASH_LIST]);
     ucs_list_del(&rdesc->tag_list[UCP_RDESC_ALL_LIST] );
 }
 
+/* Get the AM flags to initialize an unexpected descriptor with. When the
+ * unexpected queue is above the spill threshold, drop the UCT descriptor flag
+ * so that the data is copied to the worker memory pool and the transport
+ * receive buffer is released. */
+static UCS_F_ALWAYS_INLINE unsigned
+ucp_tag_unexp_am_flags(ucp_tag_match_t *tm, unsigned am_flags)
+{
+    if (ucs_likely(tm->unexpected.length <= tm->unexpected.spill_thresh)) {
+        return am_flags;
+    }
+
+    return am_flags & ~UCT_CB_PARAM_FLAG_DESC;
+}
+
+/* Check whether a new unexpected message of the given length would exceed the
+ * maximal total length of the unexpected queue */
+static UCS_F_ALWAYS_INLINE int
+ucp_tag_unexp_is_full(const ucp_tag_match_t *tm, size_t length)
+{
+    return (tm->unexpected.length + length) > tm->unexpected.max_length;
+}
+
 static UCS_F_ALWAYS_INLINE void
 ucp_tag_unexp_recv(ucp_tag_match_t *tm, ucp_recv_desc_t *rdesc, ucp_tag_t tag)
 {
     ucs_list_link_t *hash_list;
 
-    hash_list = ucp_tag_unexp_get_list_for_tag(tm, tag);
+    tm->unexpected.length += rdesc->length;
+    hash_list              = ucp_tag_unexp_get_list_for_tag(tm, tag);
     ucs_list_add_tail(hash_list,           &rdesc->tag_list[UCP_RDESC_HASH_LIST]);
     ucs_list_add_tail(&tm->unexpected.all, &rdesc->tag_list[UCP_RDESC_ALL_LIST]);
 
@@ -197,7 +247,7 @@ ucp_tag_unexp_search(ucp_tag_match_t *tm, ucp_tag_t tag, uint64_t tag_mask,
                           "%s tag %"PRIx64"/%"PRIx64, UCP_RECV_DESC_ARG(rdesc),
                           title, tag, tag_mask);
             if (rem) {
-                ucp_tag_unexp_remove(rdesc);
+                ucp_tag_unexp_remove(tm, rdesc);
             }
             return rdesc;
         }
@@ -354,6 +404,8 @@ ucp_tag_frag_list_process_common(ucp_request_t *req,
     ucs_assert(ucp_tag_frag_match_is_unexp(matchq));
     ucs_queue_for_each_extract(rdesc, &matchq->unexp_q, tag_frag_queue,
                                status == UCS_INPROGRESS) {
+        ucs_assert(req->recv.worker->tm.unexpected.length >= rdesc->length);
+        req->recv.worker->tm.unexpected.length -= rdesc->length;
         UCS_STATS_UPDATE_COUNTER(req->recv.worker->stats, counter_idx, 1);
         offset = is_offload ? 0 :
                               ((ucp_eager_middle_hdr_t*)(rdesc + 1))->offset;
@@ -366,13 +418,14 @@ ucp_tag_frag_list_process_common(ucp_request_t *req,
 }
 
 static UCS_F_ALWAYS_INLINE void
-ucp_tag_frag_match_add_unexp(ucp_tag_frag_match_t *frag_list,
-                             ucp_recv_desc_t *rdesc,
-                             size_t offset)
+ucp_tag_frag_match_add_unexp(ucp_tag_match_t *tm,
+                             ucp_tag_frag_match_t *frag_list,
+                             ucp_recv_desc_t *rdesc, size_t offset)
 {
     ucs_trace_req("unexp frag "UCP_RECV_DESC_FMT" offset %zu",
                   UCP_RECV_DESC_ARG(rdesc), offset);
     ucs_assert(ucp_tag_frag_match_is_unexp(frag_list));
+    tm->unexpected.length += rdesc->length;
     ucs_queue_push(&frag_list->unexp_q, &rdesc->tag_frag_queue);
 }
 
@@ -43,7 +43,8 @@ static void ucp_tag_recv_eager_multi(ucp_worker_h worker, ucp_request_t *req,
         msg_id              = first_hdr->msg_id;
 
         if (ucs_unlikely(rdesc->flags & UCP_RECV_DESC_FLAG_EAGER_SYNC)) {
-            ucp_tag_eager_sync_send_ack(worker, rdesc + 1, rdesc->flags);
+            ucp_tag_eager_sync_send_ack(worker, rdesc + 1, rdesc->flags,
+                                        UCS_OK);
         }
 
         status = ucp_tag_recv_request_process_rdesc(req, rdesc, 0, 0);
@@ -83,7 +84,8 @@ static UCS_F_ALWAYS_INLINE ucs_status_ptr_t ucp_tag_recv_common(
         UCP_WORKER_STAT_EAGER_CHUNK(worker, UNEXP);
 
         if (ucs_unlikely(rdesc->flags & UCP_RECV_DESC_FLAG_EAGER_SYNC)) {
-            ucp_tag_eager_sync_send_ack(worker, rdesc + 1, rdesc->flags);
+            ucp_tag_eager_sync_send_ack(worker, rdesc + 1, rdesc->flags,
+                                        UCS_OK);
         }
 
         req->flags                    = UCP_REQUEST_FLAG_COMPLETED |
@@ -51,7 +51,21 @@ ucs_status_t ucp_tag_rndv_process_rts(ucp_worker_h worker,
 
     ucs_assert(length >= sizeof(*rts_hdr));
 
-    status = ucp_recv_desc_init(worker, rts_hdr, length, 0, tl_flags,
+    if (ucs_unlikely(ucp_tag_unexp_is_full(&worker->tm, length))) {
+        ++worker->tm.unexpected.num_dropped;
+        ucs_log((worker->tm.unexpected.num_dropped == 1) ?
+                        UCS_LOG_LEVEL_ERROR : UCS_LOG_LEVEL_DEBUG,
+                "worker %p: rejected unexpected rendezvous request with tag"
+                " 0x%" PRIx64 ", unexpected queue length %zu exceeds"
+                " UCX_UNEXP_MAX_SIZE (%zu)", worker,
+                ucp_tag_hdr_from_rts(rts_hdr)->tag,
+                worker->tm.unexpected.length, worker->tm.unexpected.max_length);
+        ucp_rndv_rts_send_ats(worker, rts_hdr, UCS_ERR_EXCEEDS_LIMIT);
+        return UCS_OK;
+    }
+
+    status = ucp_recv_desc_init(worker, rts_hdr, length, 0,
+                                ucp_tag_unexp_am_flags(&worker->tm, tl_flags),
                                 sizeof(*rts_hdr), UCP_RECV_DESC_FLAG_RNDV, 0, 1,
                                 "tag_rndv_process_rts", &rdesc);
     if (!UCS_STATUS_IS_ERR(status)) {
@@ -12,6 +12,7 @@
 #include "eager.h"
 #include "tag_rndv.h"
 
+#include <ucp/core/ucp_aggr.h>
 #include <ucp/core/ucp_ep.h>
 #include <ucp/core/ucp_worker.h>
 #include <ucp/core/ucp_context.h>
@@ -38,6 +39,7 @@ ucp_tag_get_rndv_threshold(const ucp_request_t *req, size_t count,
     case UCP_DATATYPE_CONTIG:
         return ucs_min(rndv_rma_thresh, rndv_am_thresh);
     case UCP_DATATYPE_GENERIC:
+    case UCP_DATATYPE_STRIDED:
         return rndv_am_thresh;
     default:
         ucs_error("Invalid data type 0x%"PRIx64, req->send.datatype);
@@ -228,6 +230,23 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_tag_send_sync_nb,
     return ucp_tag_send_sync_nbx(ep, buffer, count, tag, &param);
 }
 
+static ucs_status_t
+ucp_tag_send_aggr(ucp_ep_h ep, const void *buffer, size_t count, ucp_tag_t tag,
+                  const ucp_request_param_t *param)
+{
+    ucp_eager_hdr_t hdr;
+
+    /* Messages of an offload lane are matched by the receiver transport */
+    if (ucp_ep_config(ep)->key.tag_lane != UCP_NULL_LANE) {
+        ucp_ep_aggr_flush_pending(ep);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    hdr.super.tag = tag;
+    return ucp_ep_aggr_add(ep, UCP_AM_ID_EAGER_ONLY, &hdr, sizeof(hdr), buffer,
+                           count, NULL, 0, param);
+}
+
 UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_tag_send_nbx,
                  (ep, buffer, count, tag, param),
                  ucp_ep_h ep, const void *buffer, size_t count,
@@ -250,6 +269,14 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_tag_send_nbx,
     ucs_trace_req("send_nbx buffer %p count %zu tag %"PRIx64" to %s",
                   buffer, count, tag, ucp_ep_peer_name(ep));
 
+    if (ucs_unlikely(ep->flags & UCP_EP_FLAG_AGGREGATE)) {
+        status = ucp_tag_send_aggr(ep, buffer, count, tag, param);
+        if (status == UCS_OK) {
+            ret = UCS_STATUS_PTR(UCS_OK);
+            goto out;
+        }
+    }
+
     attr_mask = param->op_attr_mask &
                 (UCP_OP_ATTR_FIELD_DATATYPE | UCP_OP_ATTR_FLAG_NO_IMM_CMPL);
 
@@ -328,6 +355,8 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_tag_send_sync_nbx,
     ucs_trace_req("send_sync_nbx buffer %p count %zu tag %"PRIx64" to %s",
                   buffer, count, tag, ucp_ep_peer_name(ep));
 
+    ucp_ep_aggr_flush_pending(ep);
+
     status = ucp_ep_resolve_remote_id(ep, ucp_ep_config(ep)->tag.lane);
     if (status != UCS_OK) {
         ret = UCS_STATUS_PTR(status);
@@ -13,6 +13,7 @@
 
 #include <ucp/core/ucp_worker.h>
 #include <ucp/core/ucp_ep.inl>
+#include <ucs/algorithm/crc.h>
 #include <ucs/arch/bitops.h>
 #include <ucs/datastruct/array.h>
 #include <ucs/debug/log.h>
@@ -110,6 +111,22 @@
  *           if if_addr_len == 63
  */
 
+/* Address version 2 profile format, when the header has the PROFILE flag:
+ *
+ *   [ header | worker_uuid | client_id | worker_name ]
+ *   [ profile_hash(64bit) ]
+ *   [ profile_len(16bit) | profile(profile_len) ]   - if PROFILE_BODY flag
+ *   [ device1_address | tl1_iface_address | tl2_iface_address | ... ]
+ *   [ device2_address | ... ]
+ *
+ *   * The profile is the list of devices and ifaces in version 2 format, without
+ *     the device and iface addresses, which depend on the worker and follow it.
+ *   * Workers on the same type of node have the same profile. Peers cache the
+ *     profiles they have unpacked by their hash, so the profile is parsed only
+ *     once, and may be omitted from the address (PROFILE_BODY flag is not set).
+ *   * Endpoint addresses are not packed in profile format.
+ */
+
 
 typedef struct {
     size_t           dev_addr_len;
@@ -119,6 +136,7 @@ typedef struct {
     unsigned         num_paths;
     ucs_sys_device_t sys_dev;
     size_t           tl_addrs_size;
+    size_t           iface_addrs_size;
 } ucp_address_packed_device_t;
 
 
@@ -225,9 +243,15 @@ enum {
     UCP_ADDRESS_HEADER_FLAG_DEBUG_INFO  = UCS_BIT(0),  /* Address has debug info */
     UCP_ADDRESS_HEADER_FLAG_WORKER_UUID = UCS_BIT(1),  /* Worker unique id */
     UCP_ADDRESS_HEADER_FLAG_CLIENT_ID   = UCS_BIT(2),  /* Worker client id */
-    UCP_ADDRESS_HEADER_FLAG_AM_ONLY     = UCS_BIT(3)   /* Only AM lane info */
+    UCP_ADDRESS_HEADER_FLAG_AM_ONLY     = UCS_BIT(3),  /* Only AM lane info */
+    UCP_ADDRESS_HEADER_FLAG_PROFILE     = UCS_BIT(4),  /* Profile format */
+    UCP_ADDRESS_HEADER_FLAG_PROFILE_BODY = UCS_BIT(5)  /* Profile is packed */
 };
 
+
+KHASH_IMPL(ucp_worker_addr_profile_hash, uint64_t, ucp_address_profile_t*, 1,
+           kh_int64_hash_func, kh_int64_hash_equal);
+
 static size_t ucp_address_iface_attr_size(ucp_worker_t *worker, uint64_t flags,
                                           ucp_object_version_t addr_version)
 {
@@ -414,7 +438,8 @@ ucp_address_gather_devices(ucp_worker_h worker, const ucp_ep_config_key_t *key,
 
         if (flags & UCP_ADDRESS_PACK_FLAG_IFACE_ADDR) {
             /* iface address (its length will be packed in non-unified mode only) */
-            dev->tl_addrs_size += iface_attr->iface_addr_len;
+            dev->tl_addrs_size    += iface_attr->iface_addr_len;
+            dev->iface_addrs_size += iface_attr->iface_addr_len;
             /* iface address length (+flags) can take 2 bytes with address
              * version 2 in non-unified mode
              */
@@ -463,6 +488,33 @@ ucp_address_gather_devices(ucp_worker_h worker, const ucp_ep_config_key_t *key,
     return UCS_OK;
 }
 
+static int ucp_address_is_profile(uint64_t pack_flags,
+                                  ucp_rsc_index_t num_devices)
+{
+    return (pack_flags & UCP_ADDRESS_PACK_FLAG_PROFILE) && (num_devices > 0);
+}
+
+/* Size of device and iface addresses, packed after the profile */
+static size_t
+ucp_address_profile_addrs_size(const ucp_address_packed_device_t *devices,
+                               ucp_rsc_index_t num_devices)
+{
+    const ucp_address_packed_device_t *dev;
+    size_t size = 0;
+
+    for (dev = devices; dev < (devices + num_devices); ++dev) {
+        size += dev->dev_addr_len + dev->iface_addrs_size;
+    }
+
+    return size;
+}
+
+static uint64_t ucp_address_profile_hash(const void *profile, size_t length)
+{
+    return ((uint64_t)ucs_crc32(0, profile, length) << 32) |
+           ((uint64_t)length << 16) | ucs_crc16(profile, length);
+}
+
 static ssize_t
 ucp_address_packed_size(ucp_worker_h worker,
                         const ucp_address_packed_device_t *devices,
@@ -541,6 +593,11 @@ ucp_address_packed_size(ucp_worker_h worker,
             * ones. */
             size += 2;
         }
+
+        if (ucp_address_is_profile(pack_flags, num_devices)) {
+            size += sizeof(uint64_t); /* profile hash */
+            size += sizeof(uint16_t); /* profile length */
+        }
     }
     return size;
 }
@@ -1190,9 +1247,54 @@ uint8_t ucp_address_is_am_only(const void *address)
     return addr_flags & UCP_ADDRESS_HEADER_FLAG_AM_ONLY;
 }
 
+/*
+ * Set the hash and length of the profile packed at profile_hdr. If the address
+ * should only refer to the profile, move the device and iface addresses to its
+ * place. The worker cache is not updated here, since it may be accessed by the
+ * async thread: the profiles of the worker addresses are cached when the worker
+ * is created.
+ */
+static void
+ucp_address_pack_profile(void *buffer, void *profile_hdr, void *addrs,
+                         size_t addrs_size, unsigned pack_flags,
+                         ucp_object_version_t addr_version, uint8_t *addr_flags,
+                         void **ptr_p)
+{
+    void *profile = UCS_PTR_BYTE_OFFSET(profile_hdr,
+                                        sizeof(uint64_t) + sizeof(uint16_t));
+    size_t profile_length = UCS_PTR_BYTE_DIFF(profile, addrs);
+    uint64_t hash;
+    void *ptr;
+
+    ucs_assertv(profile_length <= UINT16_MAX, "profile_length=%zu",
+                profile_length);
+
+    hash = ucp_address_profile_hash(profile, profile_length);
+    ptr  = profile_hdr;
+    *ucs_serialize_next(&ptr, uint64_t) = hash;
+    *ucs_serialize_next(&ptr, uint16_t) = profile_length;
+
+    if (pack_flags & UCP_ADDRESS_PACK_FLAG_PROFILE_REF) {
+        *addr_flags &= ~UCP_ADDRESS_HEADER_FLAG_PROFILE_BODY;
+        ucp_address_pack_header_flags(buffer, addr_version, *addr_flags);
+        ptr = UCS_PTR_TYPE_OFFSET(profile_hdr, uint64_t);
+        memmove(ptr, addrs, addrs_size);
+    } else {
+        ptr = addrs;
+    }
+
+    ucp_address_trace(pack_flags, "pack profile 0x%" PRIx64 " length %zu%s",
+                      hash, profile_length,
+                      (pack_flags & UCP_ADDRESS_PACK_FLAG_PROFILE_REF) ?
+                      " (reference)" : "");
+
+    *ptr_p = UCS_PTR_BYTE_OFFSET(ptr, addrs_size);
+}
+
 static ucs_status_t
-ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
-                    unsigned pack_flags, ucp_object_version_t addr_version,
+ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer,
+                    size_t *size_p, unsigned pack_flags,
+                    ucp_object_version_t addr_version,
                     const ucp_lane_index_t *lanes2remote,
                     const ucp_address_packed_device_t *devices,
                     ucp_rsc_index_t num_devices)
@@ -1217,6 +1319,8 @@ ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
     void *ptr;
     int enable_amo;
     uint8_t addr_flags;
+    void *profile_hdr, *addrs, **addr_ptr_p;
+    size_t addrs_size;
 
     ptr               = buffer;
     addr_index        = 0;
@@ -1252,6 +1356,12 @@ ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
         }
     }
 
+    if (ucp_address_is_profile(pack_flags, num_devices)) {
+        ucs_assert(!(pack_flags & UCP_ADDRESS_PACK_FLAG_EP_ADDR));
+        addr_flags |= UCP_ADDRESS_HEADER_FLAG_PROFILE |
+                      UCP_ADDRESS_HEADER_FLAG_PROFILE_BODY;
+    }
+
     ucp_address_pack_header_flags(address_header_p, addr_version, addr_flags);
 
     if (num_devices == 0) {
@@ -1260,6 +1370,22 @@ ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
         goto out;
     }
 
+    if (addr_flags & UCP_ADDRESS_HEADER_FLAG_PROFILE) {
+        /* Device and iface addresses are packed after the profile, which is
+         * preceded by its hash and length */
+        addrs_size  = ucp_address_profile_addrs_size(devices, num_devices);
+        profile_hdr = ptr;
+        ptr         = UCS_PTR_BYTE_OFFSET(ptr,
+                                          sizeof(uint64_t) + sizeof(uint16_t));
+        addrs       = UCS_PTR_BYTE_OFFSET(buffer, *size_p - addrs_size);
+        addr_ptr_p  = &addrs;
+    } else {
+        addrs_size  = 0;
+        profile_hdr = NULL;
+        addrs       = NULL;
+        addr_ptr_p  = &ptr;
+    }
+
     for (dev = devices; dev < (devices + num_devices); ++dev) {
         dev_tl_bitmap = context->tl_bitmap;
         UCS_STATIC_BITMAP_AND_INPLACE(&dev_tl_bitmap, dev->tl_bitmap);
@@ -1295,8 +1421,8 @@ ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
         /* Device address */
         if (pack_flags & UCP_ADDRESS_PACK_FLAG_DEVICE_ADDR) {
             wiface = ucp_worker_iface(worker, dev->rsc_index);
-            status = uct_iface_get_device_address(wiface->iface,
-                                                  (uct_device_addr_t*)ptr);
+            status = uct_iface_get_device_address(
+                    wiface->iface, (uct_device_addr_t*)*addr_ptr_p);
             if (status != UCS_OK) {
                 ucp_address_error(
                         pack_flags, "failed to get %s device address %s",
@@ -1305,8 +1431,9 @@ ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
                 return status;
             }
 
-            ucp_address_memcheck(context, ptr, dev->dev_addr_len, dev->rsc_index);
-            ptr = UCS_PTR_BYTE_OFFSET(ptr, dev->dev_addr_len);
+            ucp_address_memcheck(context, *addr_ptr_p, dev->dev_addr_len,
+                                 dev->rsc_index);
+            *addr_ptr_p = UCS_PTR_BYTE_OFFSET(*addr_ptr_p, dev->dev_addr_len);
         }
 
         flags_ptr = NULL;
@@ -1354,8 +1481,8 @@ ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
                                              UCP_ADDRESS_IFACE_LEN_MASK,
                                              iface_addr_len, addr_version, 1);
             if (pack_flags & UCP_ADDRESS_PACK_FLAG_IFACE_ADDR) {
-                status = uct_iface_get_address(wiface->iface,
-                                               (uct_iface_addr_t*)ptr);
+                status = uct_iface_get_address(
+                        wiface->iface, (uct_iface_addr_t*)*addr_ptr_p);
                 if (status != UCS_OK) {
                     ucp_address_error(
                             pack_flags,
@@ -1367,8 +1494,9 @@ ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
                     return status;
                 }
 
-                ucp_address_memcheck(context, ptr, iface_addr_len, rsc_index);
-                ptr = UCS_PTR_BYTE_OFFSET(ptr, iface_addr_len);
+                ucp_address_memcheck(context, *addr_ptr_p, iface_addr_len,
+                                     rsc_index);
+                *addr_ptr_p = UCS_PTR_BYTE_OFFSET(*addr_ptr_p, iface_addr_len);
             }
 
             /* Pack ep address if present: iterate over all lanes which use the
@@ -1493,10 +1621,20 @@ ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
         *(uint8_t*)dev_flags_ptr |= UCP_ADDRESS_FLAG_LAST;
     }
 
+    if (addr_flags & UCP_ADDRESS_HEADER_FLAG_PROFILE) {
+        ucs_assertv((UCS_PTR_BYTE_OFFSET(buffer, *size_p) == addrs) &&
+                    (UCS_PTR_BYTE_OFFSET(ptr, addrs_size) == addrs),
+                    "buffer=%p size=%zu ptr=%p addrs=%p addrs_size=%zu",
+                    buffer, *size_p, ptr, addrs, addrs_size);
+        ucp_address_pack_profile(buffer, profile_hdr, ptr, addrs_size,
+                                 pack_flags, addr_version, &addr_flags, &ptr);
+        *size_p = UCS_PTR_BYTE_DIFF(buffer, ptr);
+    }
+
 out:
-    ucs_assertv(UCS_PTR_BYTE_OFFSET(buffer, size) == ptr,
+    ucs_assertv(UCS_PTR_BYTE_OFFSET(buffer, *size_p) == ptr,
                 "buffer=%p size=%zu ptr=%p ptr-buffer=%zd",
-                buffer, size, ptr, UCS_PTR_BYTE_DIFF(buffer, ptr));
+                buffer, *size_p, ptr, UCS_PTR_BYTE_DIFF(buffer, ptr));
     return UCS_OK;
 }
 
@@ -1545,6 +1683,7 @@ ucs_status_t ucp_address_pack(ucp_worker_h worker, ucp_ep_h ep,
     ucp_rsc_index_t num_devices;
     const ucp_ep_config_key_t *key;
     ucs_status_t status;
+    size_t packed_size;
     void *buffer;
     ssize_t size;
 
@@ -1555,6 +1694,13 @@ ucs_status_t ucp_address_pack(ucp_worker_h worker, ucp_ep_h ep,
         key         = &ucp_ep_config(ep)->key;
     }
 
+    if ((pack_flags & UCP_ADDRESS_PACK_FLAG_PROFILE) &&
+        ((addr_version == UCP_OBJECT_VERSION_V1) ||
+         (pack_flags & UCP_ADDRESS_PACK_FLAG_EP_ADDR))) {
+        ucs_debug("address profile requires version 2 and no ep addresses");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
     /* Collect all devices we want to pack */
     status = ucp_address_gather_devices(worker, key, tl_bitmap, pack_flags,
                                         addr_version, max_num_paths, &devices,
@@ -1581,17 +1727,18 @@ ucs_status_t ucp_address_pack(ucp_worker_h worker, ucp_ep_h ep,
     memset(buffer, 0, size);
 
     /* Pack the address */
-    status = ucp_address_do_pack(worker, ep, buffer, size, pack_flags,
-                                 addr_version, lanes2remote, devices,
-                                 num_devices);
+    packed_size = size;
+    status      = ucp_address_do_pack(worker, ep, buffer, &packed_size,
+                                      pack_flags, addr_version, lanes2remote,
+                                      devices, num_devices);
     if (status != UCS_OK) {
         ucs_free(buffer);
         goto out_free_devices;
     }
 
-    VALGRIND_CHECK_MEM_IS_DEFINED(buffer, size);
+    VALGRIND_CHECK_MEM_IS_DEFINED(buffer, packed_size);
 
-    *size_p   = size;
+    *size_p   = packed_size;
     *buffer_p = buffer;
     status    = UCS_OK;
 
@@ -1646,18 +1793,20 @@ ucp_address_adjust_unpacked_md_index(ucp_unpacked_address_t *unpacked_address)
     }
 }
 
-ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
-                                unsigned unpack_flags,
-                                ucp_unpacked_address_t *unpacked_address)
+static ucs_status_t
+ucp_address_unpack_devices(ucp_worker_h worker, const void *ptr,
+                           const void *addrs, unsigned unpack_flags,
+                           ucp_object_version_t addr_version,
+                           unsigned *dst_version_p,
+                           ucp_address_entry_t *address_list,
+                           unsigned *address_count_p,
+                           ucp_address_profile_lens_t *lens)
 {
     UCS_ARRAY_DEFINE_ONSTACK(ucp_address_remote_device_array_t,
                              remote_device_array, UCP_MAX_RESOURCES);
-    ucp_address_entry_t *address_list, *address;
-    uint8_t addr_flags;
-    ucp_object_version_t addr_version;
-    unsigned dst_version;
+    ucp_address_entry_t *address;
     ucp_address_entry_ep_addr_t *ep_addr;
-    int last_dev, last_tl, last_ep_addr;
+    int last_dev, last_tl, last_ep_addr, new_dev;
     const uct_device_addr_t *dev_addr;
     ucp_rsc_index_t dev_index;
     ucs_sys_device_t sys_dev;
@@ -1668,64 +1817,11 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
     uint8_t dev_addr_len, iface_addr_len, ep_addr_len;
     size_t attr_len;
     uint8_t flags;
-    const void *ptr;
     const void *flags_ptr;
+    const void **addr_ptr_p;
 
-    /* Initialize the unpacked address to empty */
-    unpacked_address->address_count = 0;
-    unpacked_address->address_list  = NULL;
-
-    ptr = ucp_address_unpack_header(buffer, &addr_version, &addr_flags,
-                                    &dst_version);
-
-    ucp_address_trace(unpack_flags,
-                      "unpacking address version %u dst version %u flags 0x%x",
-                      addr_version, dst_version, addr_flags);
-
-    if (((unpack_flags & UCP_ADDRESS_PACK_FLAG_WORKER_UUID) &&
-         (addr_version == UCP_OBJECT_VERSION_V1)) ||
-        (addr_flags & UCP_ADDRESS_HEADER_FLAG_WORKER_UUID)) {
-        /* NOTE:
-         * 1. addr_flags may not contain UCP_ADDRESS_HEADER_FLAG_WORKER_UUID
-         *    even though the worker uuid is packed, because this flags was
-         *    introduced in UCX v1.12.
-         * 2. Unpack worker uuid if addr_flags contains
-         *    UCP_ADDRESS_HEADER_FLAG_WORKER_UUID, even if there is no
-         *    UCP_ADDRESS_PACK_FLAG_WORKER_UUID bit in unpack_flags, to
-         *    correctly unpack the address.
-         */
-        unpacked_address->uuid = ucp_address_get_uuid(buffer);
-        ptr                    = UCS_PTR_TYPE_OFFSET(ptr,
-                                                     unpacked_address->uuid);
-    } else {
-        unpacked_address->uuid = 0ul;
-    }
-
-    if (addr_flags & UCP_ADDRESS_HEADER_FLAG_CLIENT_ID) {
-        ptr = UCS_PTR_TYPE_OFFSET(ptr, uint64_t);
-    }
-
-    if ((addr_flags & UCP_ADDRESS_HEADER_FLAG_DEBUG_INFO) &&
-        (unpack_flags & UCP_ADDRESS_PACK_FLAG_WORKER_NAME)) {
-        ptr = ucp_address_unpack_worker_address_name(ptr,
-                                                     unpacked_address->name);
-    } else {
-        ucs_strncpy_safe(unpacked_address->name, UCP_WIREUP_EMPTY_PEER_NAME,
-                         sizeof(unpacked_address->name));
-    }
-
-    /* Empty address list */
-    if (*(uint8_t*)ptr == UCP_NULL_RESOURCE) {
-        return UCS_OK;
-    }
-
-    /* Allocate address list */
-    address_list = ucs_calloc(UCP_MAX_RESOURCES, sizeof(*address_list),
-                              "ucp_address_list");
-    if (address_list == NULL) {
-        ucs_error("failed to allocate address list");
-        return UCS_ERR_NO_MEMORY;
-    }
+    /* In profile format, device and iface addresses are packed separately */
+    addr_ptr_p = (addrs != NULL) ? &addrs : &ptr;
 
     /* Unpack addresses */
     address   = address_list;
@@ -1760,23 +1856,25 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
              * 3 bits left in md index for future extensions (the most
              * significant bit is occupied by UCP_ADDRESS_FLAG_MD_EMPTY_DEV).
              */
-            dst_version = ucp_address_unpack_release_version(
+            *dst_version_p = ucp_address_unpack_release_version(
                          md_index & UCS_MASK(UCP_ADDRESS_RELEASE_VERSION_BITS));
             ucp_address_trace(unpack_flags,
-                              "unpacked dst release version %u", dst_version);
+                              "unpacked dst release version %u",
+                              *dst_version_p);
         }
 
-        dev_addr = ptr;
-        ptr      = UCS_PTR_BYTE_OFFSET(ptr, dev_addr_len);
+        dev_addr    = *addr_ptr_p;
+        *addr_ptr_p = UCS_PTR_BYTE_OFFSET(*addr_ptr_p, dev_addr_len);
 
         last_tl = empty_dev;
+        new_dev = 1;
         while (!last_tl) {
             if (address >= &address_list[UCP_MAX_RESOURCES]) {
                 ucp_address_error(unpack_flags,
                                   "failed to parse address: number of addresses"
                                   " exceeds %d",
                                   UCP_MAX_RESOURCES);
-                goto err_free;
+                return UCS_ERR_INVALID_PARAM;
             }
 
             /* tl_name_csum */
@@ -1796,7 +1894,7 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
                                                    ptr, unpack_flags,
                                                    addr_version, &attr_len);
             if (status != UCS_OK) {
-                goto err_free;
+                return UCS_ERR_INVALID_PARAM;
             }
 
             flags_ptr = ucp_address_iface_flags_ptr(worker, (void*)ptr,
@@ -1805,9 +1903,10 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
             ptr       = ucp_address_unpack_tl_length(
                                           worker, flags_ptr, ptr, addr_version,
                                           &iface_addr_len, 0, &last_tl);
-            address->iface_addr   = (iface_addr_len > 0) ? ptr : NULL;
+            address->iface_addr   = (iface_addr_len > 0) ? *addr_ptr_p : NULL;
             address->num_ep_addrs = 0;
-            ptr                   = UCS_PTR_BYTE_OFFSET(ptr, iface_addr_len);
+            *addr_ptr_p           = UCS_PTR_BYTE_OFFSET(*addr_ptr_p,
+                                                        iface_addr_len);
             last_ep_addr          = !(*(uint8_t*)flags_ptr &
                                       UCP_ADDRESS_FLAG_HAS_EP_ADDR);
             while (!last_ep_addr) {
@@ -1817,7 +1916,7 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
                             "failed to parse address: number of ep addresses"
                             " exceeds %d",
                             UCP_MAX_LANES);
-                    goto err_free;
+                    return UCS_ERR_INVALID_PARAM;
                 }
 
                 ptr = ucp_address_unpack_tl_length(worker, flags_ptr, ptr,
@@ -1842,6 +1941,11 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
                 ptr           = UCS_PTR_TYPE_OFFSET(ptr, uint8_t);
             }
 
+            if (lens != NULL) {
+                lens[address - address_list].new_dev        = new_dev;
+                lens[address - address_list].iface_addr_len = iface_addr_len;
+            }
+
             ucp_address_trace(unpack_flags,
                               "unpack addr[%d] : sysdev %d paths %d eps %u"
                               " tl_flags 0x%" PRIx64 " bw %.2f/nMBs"
@@ -1861,20 +1965,272 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
                               address->iface_attr.atomic.atomic64.fop_flags);
 
             ++address;
+            new_dev = 0;
         }
 
         ++dev_index;
     } while (!last_dev);
 
-    unpacked_address->addr_version  = addr_version;
+    *address_count_p = address - address_list;
+    return UCS_OK;
+}
+
+void ucp_address_profile_cache_init(ucp_worker_h worker)
+{
+    kh_init_inplace(ucp_worker_addr_profile_hash, &worker->addr_profile_hash);
+}
+
+void ucp_address_profile_cache_cleanup(ucp_worker_h worker)
+{
+    ucp_address_profile_t *profile;
+
+    kh_foreach_value(&worker->addr_profile_hash, profile, {
+        ucs_free(profile);
+    })
+    kh_destroy_inplace(ucp_worker_addr_profile_hash,
+                       &worker->addr_profile_hash);
+}
+
+/*
+ * Unpack the profile at ptr, with the device and iface addresses at addrs, to
+ * address_list, and add it to the worker cache.
+ */
+static ucs_status_t
+ucp_address_profile_add(ucp_worker_h worker, uint64_t hash, const void *ptr,
+                        const void *addrs, unsigned unpack_flags,
+                        ucp_address_entry_t *address_list,
+                        unsigned *address_count_p)
+{
+    ucp_address_profile_lens_t lens[UCP_MAX_RESOURCES];
+    ucp_address_profile_t *profile;
+    unsigned address_count;
+    unsigned dst_version;
+    ucs_status_t status;
+    khiter_t iter;
+    int ret;
+
+    status = ucp_address_unpack_devices(worker, ptr, addrs, unpack_flags,
+                                        UCP_OBJECT_VERSION_V2, &dst_version,
+                                        address_list, &address_count, lens);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    *address_count_p = address_count;
+
+    iter = kh_put(ucp_worker_addr_profile_hash, &worker->addr_profile_hash,
+                  hash, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        return UCS_ERR_NO_MEMORY;
+    } else if (ret == UCS_KH_PUT_KEY_PRESENT) {
+        return UCS_OK;
+    }
+
+    profile = ucs_malloc(sizeof(*profile) +
+                         (address_count * (sizeof(*profile->address_list) +
+                                           sizeof(*profile->lens))),
+                         "ucp_address_profile");
+    if (profile == NULL) {
+        kh_del(ucp_worker_addr_profile_hash, &worker->addr_profile_hash,
+               iter);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    profile->hash          = hash;
+    profile->address_count = address_count;
+    profile->address_list  = (ucp_address_entry_t*)(profile + 1);
+    profile->lens          = (ucp_address_profile_lens_t*)
+                                     (profile->address_list + address_count);
+    memcpy(profile->address_list, address_list,
+           address_count * sizeof(*profile->address_list));
+    memcpy(profile->lens, lens, address_count * sizeof(*profile->lens));
+    kh_value(&worker->addr_profile_hash, iter) = profile;
+
+    ucp_address_trace(unpack_flags,
+                      "worker %p: added profile 0x%" PRIx64 " with %u entries",
+                      worker, hash, address_count);
+    return UCS_OK;
+}
+
+/* Unpack an address in profile format, starting from the profile hash */
+static ucs_status_t
+ucp_address_unpack_profile(ucp_worker_h worker, const void *ptr,
+                           uint8_t addr_flags, unsigned unpack_flags,
+                           ucp_unpacked_address_t *unpacked_address)
+{
+    const ucp_address_profile_t *profile;
+    ucp_address_entry_t *address_list, *address;
+    const void *profile_ptr, *dev_addr;
+    uint16_t profile_length;
+    ucs_status_t status;
+    unsigned i;
+    uint64_t hash;
+    khiter_t iter;
+
+    hash = *ucs_serialize_next(&ptr, const uint64_t);
+    if (addr_flags & UCP_ADDRESS_HEADER_FLAG_PROFILE_BODY) {
+        profile_length = *ucs_serialize_next(&ptr, const uint16_t);
+        profile_ptr    = ucs_serialize_next_raw(&ptr, const void,
+                                                profile_length);
+    } else {
+        profile_ptr    = NULL;
+    }
+
+    iter = kh_get(ucp_worker_addr_profile_hash, &worker->addr_profile_hash,
+                  hash);
+    if (iter == kh_end(&worker->addr_profile_hash)) {
+        if (profile_ptr == NULL) {
+            ucp_address_error(unpack_flags,
+                              "failed to unpack address: unknown profile 0x%"
+                              PRIx64, hash);
+            return UCS_ERR_NO_ELEM;
+        }
+
+        address_list = ucs_calloc(UCP_MAX_RESOURCES, sizeof(*address_list),
+                                  "ucp_address_list");
+        if (address_list == NULL) {
+            ucs_error("failed to allocate address list");
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        status = ucp_address_profile_add(worker, hash, profile_ptr, ptr,
+                                         unpack_flags, address_list,
+                                         &unpacked_address->address_count);
+        if (status != UCS_OK) {
+            ucs_free(address_list);
+            return status;
+        }
+
+        unpacked_address->address_list = address_list;
+        return UCS_OK;
+    }
+
+    /* Known profile: copy its entries, and take only the device and iface
+     * addresses from the packed address */
+    profile      = kh_value(&worker->addr_profile_hash, iter);
+    address_list = ucs_malloc(profile->address_count * sizeof(*address_list),
+                              "ucp_address_list");
+    if (address_list == NULL) {
+        ucs_error("failed to allocate address list");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    memcpy(address_list, profile->address_list,
+           profile->address_count * sizeof(*address_list));
+
+    dev_addr = NULL;
+    for (i = 0; i < profile->address_count; ++i) {
+        address = &address_list[i];
+        if (profile->lens[i].new_dev) {
+            dev_addr = ptr;
+            ptr      = UCS_PTR_BYTE_OFFSET(ptr, address->dev_addr_len);
+        }
+
+        address->dev_addr   = (address->dev_addr_len > 0) ? dev_addr : NULL;
+        address->iface_addr = (profile->lens[i].iface_addr_len > 0) ? ptr :
+                              NULL;
+        ptr                 = UCS_PTR_BYTE_OFFSET(
+                                      ptr, profile->lens[i].iface_addr_len);
+    }
+
+    ucp_address_trace(unpack_flags, "unpacked profile 0x%" PRIx64
+                      " with %u entries from cache", hash,
+                      profile->address_count);
+
+    unpacked_address->address_count = profile->address_count;
+    unpacked_address->address_list  = address_list;
+    return UCS_OK;
+}
+
+ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
+                                unsigned unpack_flags,
+                                ucp_unpacked_address_t *unpacked_address)
+{
+    ucp_address_entry_t *address_list;
+    uint8_t addr_flags;
+    ucp_object_version_t addr_version;
+    unsigned dst_version;
+    unsigned address_count;
+    ucs_status_t status;
+    const void *ptr;
+
+    /* Initialize the unpacked address to empty */
+    unpacked_address->address_count = 0;
+    unpacked_address->address_list  = NULL;
+
+    ptr = ucp_address_unpack_header(buffer, &addr_version, &addr_flags,
+                                    &dst_version);
+
+    ucp_address_trace(unpack_flags,
+                      "unpacking address version %u dst version %u flags 0x%x",
+                      addr_version, dst_version, addr_flags);
+
+    if (((unpack_flags & UCP_ADDRESS_PACK_FLAG_WORKER_UUID) &&
+         (addr_version == UCP_OBJECT_VERSION_V1)) ||
+        (addr_flags & UCP_ADDRESS_HEADER_FLAG_WORKER_UUID)) {
+        /* NOTE:
+         * 1. addr_flags may not contain UCP_ADDRESS_HEADER_FLAG_WORKER_UUID
+         *    even though the worker uuid is packed, because this flags was
+         *    introduced in UCX v1.12.
+         * 2. Unpack worker uuid if addr_flags contains
+         *    UCP_ADDRESS_HEADER_FLAG_WORKER_UUID, even if there is no
+         *    UCP_ADDRESS_PACK_FLAG_WORKER_UUID bit in unpack_flags, to
+         *    correctly unpack the address.
+         */
+        unpacked_address->uuid = ucp_address_get_uuid(buffer);
+        ptr                    = UCS_PTR_TYPE_OFFSET(ptr,
+                                                     unpacked_address->uuid);
+    } else {
+        unpacked_address->uuid = 0ul;
+    }
+
+    if (addr_flags & UCP_ADDRESS_HEADER_FLAG_CLIENT_ID) {
+        ptr = UCS_PTR_TYPE_OFFSET(ptr, uint64_t);
+    }
+
+    if ((addr_flags & UCP_ADDRESS_HEADER_FLAG_DEBUG_INFO) &&
+        (unpack_flags & UCP_ADDRESS_PACK_FLAG_WORKER_NAME)) {
+        ptr = ucp_address_unpack_worker_address_name(ptr,
+                                                     unpacked_address->name);
+    } else {
+        ucs_strncpy_safe(unpacked_address->name, UCP_WIREUP_EMPTY_PEER_NAME,
+                         sizeof(unpacked_address->name));
+    }
+
+    unpacked_address->addr_version = addr_version;
+    unpacked_address->dst_version  = dst_version;
+
+    if ((addr_version != UCP_OBJECT_VERSION_V1) &&
+        (addr_flags & UCP_ADDRESS_HEADER_FLAG_PROFILE)) {
+        return ucp_address_unpack_profile(worker, ptr, addr_flags,
+                                          unpack_flags, unpacked_address);
+    }
+
+    /* Empty address list */
+    if (*(uint8_t*)ptr == UCP_NULL_RESOURCE) {
+        return UCS_OK;
+    }
+
+    /* Allocate address list */
+    address_list = ucs_calloc(UCP_MAX_RESOURCES, sizeof(*address_list),
+                              "ucp_address_list");
+    if (address_list == NULL) {
+        ucs_error("failed to allocate address list");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = ucp_address_unpack_devices(worker, ptr, NULL, unpack_flags,
+                                        addr_version, &dst_version,
+                                        address_list, &address_count, NULL);
+    if (status != UCS_OK) {
+        ucs_free(address_list);
+        return status;
+    }
+
     unpacked_address->dst_version   = dst_version;
-    unpacked_address->address_count = address - address_list;
+    unpacked_address->address_count = address_count;
     unpacked_address->address_list  = address_list;
 
     ucp_address_adjust_unpacked_md_index(unpacked_address);
     return UCS_OK;
-
-err_free:
-    ucs_free(address_list);
-    return UCS_ERR_INVALID_PARAM;
 }
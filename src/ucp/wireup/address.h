@@ -101,7 +101,16 @@ enum {
                                         UCP_ADDRESS_PACK_FLAG_EP_ADDR,
 
     /* Suppress debug tracing */
-    UCP_ADDRESS_PACK_FLAG_NO_TRACE    = UCS_BIT(16)
+    UCP_ADDRESS_PACK_FLAG_NO_TRACE    = UCS_BIT(16),
+
+    /* Pack device and iface attributes as a node profile, identified by its
+     * hash, followed by the device and iface addresses. Address version 2
+     * only, and cannot be used with UCP_ADDRESS_PACK_FLAG_EP_ADDR. */
+    UCP_ADDRESS_PACK_FLAG_PROFILE     = UCS_BIT(17),
+
+    /* Pack only the hash of the node profile, the peer must already know the
+     * profile. Used with UCP_ADDRESS_PACK_FLAG_PROFILE. */
+    UCP_ADDRESS_PACK_FLAG_PROFILE_REF = UCS_BIT(18)
 };
 
 
@@ -170,6 +179,33 @@ struct ucp_unpacked_address {
 };
 
 
+/**
+ * Location of the addresses of an address entry unpacked from a node profile.
+ */
+typedef struct {
+    uint8_t                     new_dev;        /* Whether the entry is the first
+                                                   of its device, so the device
+                                                   address precedes the iface
+                                                   address */
+    uint8_t                     iface_addr_len; /* Interface address length */
+} ucp_address_profile_lens_t;
+
+
+/**
+ * Node profile: device and iface attributes unpacked from an address in profile
+ * format, cached on the worker by the profile hash. The attributes are shared by
+ * all addresses of workers on the same type of node, and only the device and
+ * iface addresses have to be unpacked from each of them.
+ */
+struct ucp_address_profile {
+    uint64_t                    hash;           /* Hash of the packed profile */
+    unsigned                    address_count;  /* Number of address entries */
+    ucp_address_entry_t         *address_list;  /* Address entries, without the
+                                                   device and iface addresses */
+    ucp_address_profile_lens_t  *lens;          /* Address lengths of entries */
+};
+
+
 /* Iterate over entries in an unpacked address */
 #define ucp_unpacked_address_for_each(_elem, _unpacked_address) \
     for (_elem = (_unpacked_address)->address_list; \
@@ -257,6 +293,22 @@ ucs_status_t ucp_address_unpack(ucp_worker_h worker, const void *buffer,
                                 ucp_unpacked_address_t *unpacked_address);
 
 
+/**
+ * Initialize the cache of node profiles unpacked by the worker.
+ *
+ * @param [in] worker Worker object.
+ */
+void ucp_address_profile_cache_init(ucp_worker_h worker);
+
+
+/**
+ * Release the node profiles unpacked by the worker.
+ *
+ * @param [in] worker Worker object.
+ */
+void ucp_address_profile_cache_cleanup(ucp_worker_h worker);
+
+
 /**
  * Unpack worker unique id from the given address.
  *
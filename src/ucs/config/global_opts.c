@@ -311,7 +311,9 @@ static ucs_config_field_t ucs_global_opts_read_only_table[] = {
  {"PROFILE_MODE", "",
   "Profile collection modes. If none is specified, profiling is disabled.\n"
   " - log   - Record all timestamps.\n"
-  " - accum - Accumulate measurements per location.",
+  " - accum - Accumulate measurements per location.\n"
+  " - hist  - Keep a histogram of the elapsed time per location, which can be\n"
+  "           read at runtime from ucs/profile/histogram in the VFS.",
   ucs_offsetof(ucs_global_opts_t, profile_mode),
   UCS_CONFIG_TYPE_BITMAP(ucs_profile_mode_names)},
 
@@ -38,8 +38,10 @@ typedef struct ucs_callbackq_spill_elem {
  * One-shot element in the hash table
  */
 typedef struct ucs_callbackq_oneshot_elem {
-    ucs_callbackq_elem_t super;
-    ucs_hlist_link_t     hlist;
+    ucs_callbackq_elem_t              super;
+    ucs_callbackq_key_t               key;
+    struct ucs_callbackq_oneshot_elem *inbox_next; /* Next in the inbox list */
+    ucs_hlist_link_t                  hlist;
 } ucs_callbackq_oneshot_elem_t;
 
 #define ucs_callbackq_oneshot_key_hash(_key) \
@@ -312,6 +314,65 @@ static void ucs_callbackq_spill_elems_purge(ucs_callbackq_t *cbq)
     ucs_array_set_length(&priv->spill_elems, dst_idx);
 }
 
+/* Lock must be held */
+static void ucs_callbackq_oneshot_elem_insert(ucs_callbackq_t *cbq,
+                                              ucs_callbackq_oneshot_elem_t *elem)
+{
+    ucs_callbackq_priv_t *priv = cbq->priv;
+    ucs_hlist_head_t *hlist;
+    khiter_t khiter;
+    int khret;
+
+    khiter = kh_put(ucs_callbackq_oneshot_elems, &priv->oneshot_elems,
+                    elem->key, &khret);
+    if ((khret == UCS_KH_PUT_BUCKET_EMPTY) ||
+        (khret == UCS_KH_PUT_BUCKET_CLEAR)) {
+        hlist = &kh_value(&priv->oneshot_elems, khiter);
+        ucs_hlist_head_init(hlist);
+    } else if (khret == UCS_KH_PUT_KEY_PRESENT) {
+        hlist = &kh_value(&priv->oneshot_elems, khiter);
+    } else {
+        ucs_fatal("callbackq %p: failed to insert oneshot element (khret=%d)",
+                  cbq, khret);
+    }
+
+    ucs_hlist_add_tail(hlist, &elem->hlist);
+}
+
+/*
+ * Move the elements pushed to the inbox by ucs_callbackq_add_oneshot() to the
+ * oneshot hash. Lock must be held.
+ */
+static void ucs_callbackq_oneshot_inbox_flush(ucs_callbackq_t *cbq)
+{
+    ucs_callbackq_oneshot_elem_t *elem, *next, *head;
+
+    if (cbq->oneshot_inbox == 0) {
+        return;
+    }
+
+    /* Take the whole list at once. Since elements are never popped one by
+     * one, the producers' compare-and-swap is not exposed to ABA. */
+    elem = (ucs_callbackq_oneshot_elem_t*)(uintptr_t)ucs_atomic_swap64(
+            &cbq->oneshot_inbox, 0);
+
+    /* The inbox is in reverse order of insertion */
+    head = NULL;
+    while (elem != NULL) {
+        next             = elem->inbox_next;
+        elem->inbox_next = head;
+        head             = elem;
+        elem             = next;
+    }
+
+    ucs_trace_func("cbq=%p inbox=%p", cbq, head);
+
+    for (elem = head; elem != NULL; elem = next) {
+        next = elem->inbox_next;
+        ucs_callbackq_oneshot_elem_insert(cbq, elem);
+    }
+}
+
 static void ucs_callbackq_oneshot_elems_free(ucs_callbackq_t *cbq)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
@@ -473,6 +534,7 @@ static unsigned ucs_callbackq_proxy_callback(void *arg)
 
     ucs_callbackq_enter(cbq);
 
+    ucs_callbackq_oneshot_inbox_flush(cbq);
     count = ucs_callbackq_spill_elems_dispatch(cbq) +
             ucs_callbackq_oneshot_elems_dispatch(cbq);
 
@@ -490,6 +552,29 @@ static unsigned ucs_callbackq_proxy_callback(void *arg)
     return count;
 }
 
+unsigned ucs_callbackq_oneshot_inbox_dispatch(ucs_callbackq_t *cbq)
+{
+    unsigned count;
+
+    ucs_trace_poll("cbq=%p oneshot_inbox_dispatch", cbq);
+
+    ucs_callbackq_enter(cbq);
+
+    /* Dispatch only the oneshot elements, the spill elements are dispatched by
+     * the proxy callback */
+    ucs_callbackq_oneshot_inbox_flush(cbq);
+    count = ucs_callbackq_oneshot_elems_dispatch(cbq);
+
+    /* Oneshot elements added by the callbacks are left to the proxy */
+    if (ucs_callback_is_proxy_needed(cbq)) {
+        ucs_callbackq_proxy_enable(cbq);
+    }
+
+    ucs_callbackq_leave(cbq);
+
+    return count;
+}
+
 static void ucs_callbackq_proxy_enable(ucs_callbackq_t *cbq)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
@@ -601,6 +686,7 @@ ucs_status_t ucs_callbackq_init(ucs_callbackq_t *cbq)
     priv->fast_remove_mask = 0;
     priv->free_idx_id      = UCS_CALLBACKQ_ID_NULL;
     priv->proxy_cb_id      = UCS_CALLBACKQ_ID_NULL;
+    cbq->oneshot_inbox     = 0;
     cbq->priv              = priv;
 
     for (idx = 0; idx < UCS_CALLBACKQ_FAST_COUNT; ++idx) {
@@ -615,6 +701,7 @@ void ucs_callbackq_cleanup(ucs_callbackq_t *cbq)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
 
+    ucs_callbackq_oneshot_inbox_flush(cbq);
     ucs_callbackq_fast_elems_purge(cbq);
     ucs_callbackq_spill_elems_purge(cbq);
     ucs_callbackq_proxy_disable(cbq);
@@ -728,17 +815,12 @@ void *ucs_callbackq_remove_safe(ucs_callbackq_t *cbq, int id)
 void ucs_callbackq_add_oneshot(ucs_callbackq_t *cbq, ucs_callbackq_key_t key,
                                ucs_callback_t cb, void *arg)
 {
-    ucs_callbackq_priv_t *priv = cbq->priv;
     ucs_callbackq_oneshot_elem_t *elem;
-    ucs_hlist_head_t *hlist;
-    khiter_t khiter;
-    int khret;
+    uint64_t head;
 
     ucs_trace_func("cbq=%p key=%p cb=%s arg=%p", cbq, key,
                    ucs_debug_get_symbol_name(cb), arg);
 
-    ucs_callbackq_enter(cbq);
-
     elem = ucs_malloc(sizeof(*elem), "ucs_callbackq_oneshot_elem");
     if (elem == NULL) {
         ucs_fatal("callbackq %p: failed to allocate oneshot element", cbq);
@@ -746,24 +828,16 @@ void ucs_callbackq_add_oneshot(ucs_callbackq_t *cbq, ucs_callbackq_key_t key,
 
     elem->super.cb  = cb;
     elem->super.arg = arg;
-
-    khiter = kh_put(ucs_callbackq_oneshot_elems, &priv->oneshot_elems, key,
-                    &khret);
-    if ((khret == UCS_KH_PUT_BUCKET_EMPTY) ||
-        (khret == UCS_KH_PUT_BUCKET_CLEAR)) {
-        hlist = &kh_value(&priv->oneshot_elems, khiter);
-        ucs_hlist_head_init(hlist);
-    } else if (khret == UCS_KH_PUT_KEY_PRESENT) {
-        hlist = &kh_value(&priv->oneshot_elems, khiter);
-    } else {
-        ucs_fatal("callbackq %p: failed to insert oneshot element (khret=%d)",
-                  cbq, khret);
-    }
-
-    ucs_hlist_add_tail(hlist, &elem->hlist);
-    ucs_callbackq_proxy_enable(cbq);
-
-    ucs_callbackq_leave(cbq);
+    elem->key       = key;
+
+    /* Push to the inbox without taking the lock, so threads which schedule
+     * callbacks do not contend with the dispatching thread. The inbox is
+     * moved to the oneshot hash by the next dispatch. */
+    do {
+        head             = cbq->oneshot_inbox;
+        elem->inbox_next = (ucs_callbackq_oneshot_elem_t*)(uintptr_t)head;
+    } while (ucs_atomic_cswap64(&cbq->oneshot_inbox, head,
+                                (uintptr_t)elem) != head);
 }
 
 void ucs_callbackq_remove_oneshot(ucs_callbackq_t *cbq, ucs_callbackq_key_t key,
@@ -779,6 +853,12 @@ void ucs_callbackq_remove_oneshot(ucs_callbackq_t *cbq, ucs_callbackq_key_t key,
 
     ucs_callbackq_enter(cbq);
 
+    /* Elements which are still in the inbox can be removed as well */
+    ucs_callbackq_oneshot_inbox_flush(cbq);
+    if (kh_size(&priv->oneshot_elems) > 0) {
+        ucs_callbackq_proxy_enable(cbq);
+    }
+
     khiter = kh_get(ucs_callbackq_oneshot_elems, &priv->oneshot_elems, key);
     if (khiter == kh_end(&priv->oneshot_elems)) {
         goto out;
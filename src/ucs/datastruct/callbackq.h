@@ -81,6 +81,13 @@ struct ucs_callbackq {
      */
     ucs_callbackq_elem_t fast_elems[UCS_CALLBACKQ_FAST_COUNT + 1];
 
+    /**
+     * Lock-free list of oneshot elements which were added since the last
+     * dispatch, most recent first. Any thread can push to it, and the
+     * dispatching thread takes the whole list at once.
+     */
+    volatile uint64_t    oneshot_inbox;
+
     /**
      * Private data, which we don't want to expose in API to avoid pulling
      * more header files
@@ -167,7 +174,9 @@ void *ucs_callbackq_remove_safe(ucs_callbackq_t *cbq, int id);
 
 /**
  * Add a slowpath oneshot callback to the queue.
- * This can be used from any context and any thread.
+ * This can be used from any context and any thread, and does not take the
+ * queue lock: the callback is pushed to a lock-free inbox which is drained by
+ * the next @ref ucs_callbackq_dispatch.
  *
  * @note Callbacks with the same key will be called in the same order they were
  * added. On the other hand, callbacks with different keys can be called in any
@@ -196,6 +205,18 @@ void ucs_callbackq_remove_oneshot(ucs_callbackq_t *cbq, ucs_callbackq_key_t key,
                                   ucs_callbackq_predicate_t pred, void *arg);
 
 
+/**
+ * Move the oneshot callbacks added from any thread to the slow-path, and
+ * dispatch the oneshot callbacks. Other slow-path callbacks are dispatched
+ * only by the proxy callback. Called by @ref ucs_callbackq_dispatch.
+ *
+ * @param  [in] cbq      Callback queue to dispatch callbacks from.
+ *
+ * @return Sum of all return values from the dispatched callbacks.
+ */
+unsigned ucs_callbackq_oneshot_inbox_dispatch(ucs_callbackq_t *cbq);
+
+
 /**
  * Dispatch callbacks from the callback queue.
  * Must be called from single thread only.
@@ -214,6 +235,11 @@ static inline unsigned ucs_callbackq_dispatch(ucs_callbackq_t *cbq)
     for (elem = cbq->fast_elems; (cb = elem->cb) != NULL; ++elem) {
         count += cb(elem->arg);
     }
+
+    if (ucs_unlikely(cbq->oneshot_inbox != 0)) {
+        count += ucs_callbackq_oneshot_inbox_dispatch(cbq);
+    }
+
     return count;
 }
 
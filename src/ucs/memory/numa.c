@@ -13,18 +13,26 @@
 #include <ucs/datastruct/khash.h>
 #include <ucs/debug/assert.h>
 #include <ucs/debug/log.h>
+#include <ucs/sys/ptr_arith.h>
 #include <ucs/sys/string.h>
 #include <ucs/sys/sys.h>
 #include <ucs/type/spinlock.h>
 #include <stdint.h>
 #include <sched.h>
 #include <dirent.h>
+#ifdef __linux__
+#  include <linux/mempolicy.h>
+#endif
 
 #define UCS_NUMA_MIN_DISTANCE       10
 #define UCS_NUMA_NODE_MAX           INT16_MAX
 #define UCS_NUMA_CORE_DIR_PATH      UCS_SYS_FS_CPUS_PATH "/cpu%d"
 #define UCS_NUMA_NODES_DIR_PATH     UCS_SYS_FS_SYSTEM_PATH "/node"
 #define UCS_NUMA_NODE_DISTANCE_PATH UCS_NUMA_NODES_DIR_PATH "/node%d/distance"
+#define UCS_NUMA_BIND_MAX_NODES     1024
+#define UCS_NUMA_NODEMASK_BITS      (sizeof(unsigned long) * 8)
+#define UCS_NUMA_NODEMASK_LEN \
+    (UCS_NUMA_BIND_MAX_NODES / UCS_NUMA_NODEMASK_BITS)
 
 
 KHASH_MAP_INIT_INT(numa_distance, ucs_numa_distance_t);
@@ -42,6 +50,13 @@ typedef struct {
 
 static ucs_numa_global_ctx_t ucs_numa_global_ctx;
 
+const char *ucs_numa_policy_names[] = {
+    [UCS_NUMA_POLICY_DEFAULT]   = "default",
+    [UCS_NUMA_POLICY_BIND]      = "bind",
+    [UCS_NUMA_POLICY_PREFERRED] = "preferred",
+    [UCS_NUMA_POLICY_LAST]      = NULL
+};
+
 static inline uint32_t ucs_numa_distance_hash_key(const ucs_numa_node_t node1,
                                                   const ucs_numa_node_t node2)
 {
@@ -151,6 +166,86 @@ ucs_numa_node_t ucs_numa_node_of_cpu(int cpu)
     return cpu_numa_node[cpu] - 1;
 }
 
+ucs_numa_node_t ucs_numa_node_of_cpu_mask(const ucs_cpu_set_t *cpu_mask)
+{
+    ucs_numa_node_t node = UCS_NUMA_NODE_UNDEFINED;
+    ucs_numa_node_t cpu_node;
+    int num_cpus, cpu;
+
+    num_cpus = ucs_min(ucs_numa_num_configured_cpus(), UCS_CPU_SETSIZE);
+    for (cpu = 0; cpu < num_cpus; ++cpu) {
+        if (!ucs_cpu_is_set(cpu, cpu_mask)) {
+            continue;
+        }
+
+        cpu_node = ucs_numa_node_of_cpu(cpu);
+        if (node == UCS_NUMA_NODE_UNDEFINED) {
+            node = cpu_node;
+        } else if (cpu_node != node) {
+            return UCS_NUMA_NODE_UNDEFINED;
+        }
+    }
+
+    return node;
+}
+
+ucs_status_t ucs_numa_mem_bind(void *address, size_t length,
+                               ucs_numa_policy_t policy, ucs_numa_node_t node)
+{
+#if defined(__linux__) && defined(__NR_mbind)
+    unsigned long nodemask[UCS_NUMA_NODEMASK_LEN] = {0};
+    size_t page_size = ucs_get_page_size();
+    void *start, *end;
+    int mode, ret;
+
+    switch (policy) {
+    case UCS_NUMA_POLICY_DEFAULT:
+        return UCS_OK;
+    case UCS_NUMA_POLICY_BIND:
+        mode = MPOL_BIND;
+        break;
+    case UCS_NUMA_POLICY_PREFERRED:
+        mode = MPOL_PREFERRED;
+        break;
+    default:
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if ((node < 0) || (node >= UCS_NUMA_BIND_MAX_NODES)) {
+        ucs_debug("cannot bind memory to numa node %d", node);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    /* mbind() requires a page-aligned range, and we do not want to change the
+     * policy of the pages shared with neighboring allocations */
+    start = ucs_align_up_pow2_ptr(address, page_size);
+    end   = ucs_align_down_pow2_ptr(UCS_PTR_BYTE_OFFSET(address, length),
+                                    page_size);
+    if (end <= start) {
+        return UCS_OK;
+    }
+
+    nodemask[node / UCS_NUMA_NODEMASK_BITS] =
+            UCS_BIT(node % UCS_NUMA_NODEMASK_BITS);
+
+    /* The kernel considers only (maxnode - 1) bits of the mask */
+    ret = syscall(__NR_mbind, start, UCS_PTR_BYTE_DIFF(start, end), mode,
+                  nodemask, UCS_NUMA_BIND_MAX_NODES + 1, MPOL_MF_MOVE);
+    if (ret != 0) {
+        ucs_debug("mbind(%p, %zu, %s, node %d) failed: %m", start,
+                  UCS_PTR_BYTE_DIFF(start, end), ucs_numa_policy_names[policy],
+                  node);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    ucs_trace("bound memory %p..%p to numa node %d, policy %s", start, end,
+              node, ucs_numa_policy_names[policy]);
+    return UCS_OK;
+#else
+    return (policy == UCS_NUMA_POLICY_DEFAULT) ? UCS_OK : UCS_ERR_UNSUPPORTED;
+#endif
+}
+
 ucs_numa_node_t ucs_numa_node_of_device(const char *dev_path)
 {
     long parsed_node;
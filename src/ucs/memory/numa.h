@@ -8,6 +8,9 @@
 #define UCS_NUMA_H_
 
 #include <ucs/sys/compiler_def.h>
+#include <ucs/type/cpu_set.h>
+#include <ucs/type/status.h>
+#include <stddef.h>
 #include <stdint.h>
 
 BEGIN_C_DECLS
@@ -21,6 +24,17 @@ typedef int ucs_numa_distance_t;
 typedef int16_t ucs_numa_node_t;
 
 
+/**
+ * Memory placement policy with respect to a NUMA node.
+ */
+typedef enum {
+    UCS_NUMA_POLICY_DEFAULT,   /* Use the policy of the calling thread */
+    UCS_NUMA_POLICY_BIND,      /* Allocate only on the given node */
+    UCS_NUMA_POLICY_PREFERRED, /* Prefer the given node, fall back to others */
+    UCS_NUMA_POLICY_LAST
+} ucs_numa_policy_t;
+
+
 extern const char *ucs_numa_policy_names[];
 
 
@@ -58,6 +72,33 @@ ucs_numa_node_t ucs_numa_node_of_cpu(int cpu);
 ucs_numa_node_t ucs_numa_node_of_device(const char *dev_path);
 
 
+/**
+ * @param [in]  cpu_mask CPUs to query.
+ *
+ * @return The NUMA node that all CPUs in the mask belong to, or
+ *         UCS_NUMA_NODE_UNDEFINED if the mask is empty or spans several nodes.
+ */
+ucs_numa_node_t ucs_numa_node_of_cpu_mask(const ucs_cpu_set_t *cpu_mask);
+
+
+/**
+ * Set the NUMA policy of a memory range, so its pages are placed on the given
+ * node when first touched. Pages which are already present and owned only by
+ * this process are migrated to the node. Only the pages which are entirely
+ * inside the range are affected.
+ *
+ * @param [in]  address Start of the memory range.
+ * @param [in]  length  Length of the memory range.
+ * @param [in]  policy  NUMA policy to set. UCS_NUMA_POLICY_DEFAULT leaves the
+ *                      range unchanged.
+ * @param [in]  node    NUMA node to place the memory on.
+ *
+ * @return UCS_OK if the policy was set, or an error code otherwise.
+ */
+ucs_status_t ucs_numa_mem_bind(void *address, size_t length,
+                               ucs_numa_policy_t policy, ucs_numa_node_t node);
+
+
 /**
  * Reports the distance between two nodes according to the machine topology.
  * 
@@ -30,6 +30,13 @@
 #include "rcache.inl"
 
 
+/* Number of entries in the per-thread cache of lookup hits */
+#define UCS_RCACHE_THREAD_CACHE_SIZE       8
+
+/* Addresses in the same 4k block share a per-thread cache entry */
+#define UCS_RCACHE_THREAD_CACHE_ADDR_SHIFT 12
+
+
 #define ucs_rcache_region_pfn(_region) \
     ((_region)->priv)
 #define ucs_rcache_region_pfn_ptr(_region) \
@@ -146,6 +153,42 @@ static ucs_rcache_global_context_t ucs_rcache_global_context = {
     .pipe = UCS_ASYNC_PIPE_INITIALIZER
 };
 
+
+/* Per-thread cache of recent lookup hits */
+typedef struct {
+    ucs_rcache_t        *rcache;     /* Cache the region belongs to */
+    uint64_t            generation;  /* Cache generation when looked up */
+    ucs_rcache_region_t *region;     /* Region found by the lookup */
+} ucs_rcache_thread_cache_entry_t;
+
+
+/* Generations are unique across all caches, so a cached entry can not match a
+ * new cache which was created at the address of a destroyed one */
+static volatile uint64_t ucs_rcache_generation          = 0;
+
+/* Used to assign reader shards to threads in round-robin order */
+static volatile uint32_t ucs_rcache_reader_shard_next   = 0;
+
+static __thread unsigned ucs_rcache_reader_shard_index  = UINT_MAX;
+
+static __thread ucs_rcache_thread_cache_entry_t
+        ucs_rcache_thread_cache[UCS_RCACHE_THREAD_CACHE_SIZE];
+
+
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_rcache_thread_cache_index(ucs_rcache_t *rcache, ucs_pgt_addr_t address)
+{
+    return (((uintptr_t)rcache / UCS_SYS_CACHE_LINE_SIZE) ^
+            (address >> UCS_RCACHE_THREAD_CACHE_ADDR_SHIFT)) %
+           UCS_RCACHE_THREAD_CACHE_SIZE;
+}
+
+/* Lock must be held in write mode */
+static void ucs_rcache_generation_update(ucs_rcache_t *rcache)
+{
+    rcache->generation = ucs_atomic_fadd64(&ucs_rcache_generation, 1) + 1;
+}
+
 void ucs_rcache_region_log(const char *file, int line, const char *function,
                            ucs_log_level_t level, ucs_rcache_t *rcache,
                            ucs_rcache_region_t *region, const char *fmt, ...)
@@ -424,7 +467,7 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
         UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_DEREGS, 1);
 
         if (drop_lock) {
-            pthread_rwlock_unlock(&rcache->pgt_lock);
+            ucs_rcache_pgt_wrunlock(rcache);
         }
 
         UCS_PROFILE_NAMED_CALL_VOID_ALWAYS("mem_dereg",
@@ -433,7 +476,7 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
                                            region);
 
         if (drop_lock) {
-            pthread_rwlock_wrlock(&rcache->pgt_lock);
+            ucs_rcache_pgt_wrlock(rcache);
         }
     }
 
@@ -493,14 +536,14 @@ static inline void ucs_rcache_region_put_internal(ucs_rcache_t *rcache,
 
     /* Destroy region and de-register memory */
     if (flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK) {
-        pthread_rwlock_wrlock(&rcache->pgt_lock);
+        ucs_rcache_pgt_wrlock(rcache);
     }
 
     ucs_mem_region_destroy_internal(rcache, region,
                                     flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK);
 
     if (flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK) {
-        pthread_rwlock_unlock(&rcache->pgt_lock);
+        ucs_rcache_pgt_wrunlock(rcache);
     }
 }
 
@@ -523,6 +566,7 @@ static void ucs_rcache_region_invalidate_internal(ucs_rcache_t *rcache,
                                    ucs_status_string(status));
         }
         region->flags &= ~UCS_RCACHE_REGION_FLAG_PGTABLE;
+        ucs_rcache_generation_update(rcache);
         /* coverity[double_unlock] */
         /* coverity[double_lock] */
         ucs_rcache_region_put_internal(rcache, region, flags);
@@ -649,7 +693,7 @@ static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
      * no rcache operations are performed to clean it.
      */
     if (!(rcache->params.flags & UCS_RCACHE_FLAG_SYNC_EVENTS) &&
-        !pthread_rwlock_trywrlock(&rcache->pgt_lock)) {
+        !ucs_rcache_pgt_trywrlock(rcache)) {
         /* coverity[double_lock] */
         ucs_rcache_invalidate_range(rcache, start, end,
                                     UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
@@ -657,7 +701,7 @@ static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
         /* coverity[double_lock] */
         ucs_rcache_check_inv_queue(rcache, UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
         /* coverity[double_unlock] */
-        pthread_rwlock_unlock(&rcache->pgt_lock);
+        ucs_rcache_pgt_wrunlock(rcache);
         return;
     }
 
@@ -703,11 +747,11 @@ static void ucs_rcache_purge(ucs_rcache_t *rcache)
 /* Lock must be held in write mode */
 static void ucs_rcache_clean(ucs_rcache_t *rcache)
 {
-    pthread_rwlock_wrlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrlock(rcache);
     /* coverity[double_lock]*/
     ucs_rcache_check_inv_queue(rcache, 0);
     ucs_rcache_check_gc_list(rcache, 1);
-    pthread_rwlock_unlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrunlock(rcache);
 }
 
 /* Lock must be held in write mode */
@@ -940,7 +984,7 @@ ucs_status_t ucs_rcache_create_region(ucs_rcache_t *rcache, void *address,
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
-    pthread_rwlock_wrlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrlock(rcache);
 
 retry:
     /* Align to page size */
@@ -1061,7 +1105,7 @@ out_set_region:
     *region_p = region;
 out_unlock:
     /* coverity[double_unlock]*/
-    pthread_rwlock_unlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrunlock(rcache);
     return status;
 }
 
@@ -1071,37 +1115,113 @@ void ucs_rcache_region_hold(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
     ucs_rcache_region_trace(rcache, region, "hold");
 }
 
+static UCS_F_ALWAYS_INLINE ucs_rcache_reader_shard_t *
+ucs_rcache_reader_enter(ucs_rcache_t *rcache)
+{
+    ucs_rcache_reader_shard_t *shard;
+
+    if (ucs_unlikely(ucs_rcache_reader_shard_index == UINT_MAX)) {
+        ucs_rcache_reader_shard_index =
+                ucs_atomic_fadd32(&ucs_rcache_reader_shard_next, 1) %
+                UCS_RCACHE_READER_SHARDS;
+    }
+
+    /* The atomic increment is a full barrier, so either the writer waits for
+     * this reader, or the reader observes the writer and backs off */
+    shard = &rcache->readers[ucs_rcache_reader_shard_index];
+    ucs_atomic_add32(&shard->count, 1);
+    if (ucs_likely(!rcache->pgt_writer)) {
+        return shard;
+    }
+
+    ucs_atomic_sub32(&shard->count, 1);
+    return NULL;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucs_rcache_reader_exit(ucs_rcache_reader_shard_t *shard)
+{
+    ucs_atomic_sub32(&shard->count, 1);
+}
+
+/* Page table must be protected from writers */
+static UCS_F_ALWAYS_INLINE ucs_rcache_region_t *
+ucs_rcache_get_fast(ucs_rcache_t *rcache, void *address, size_t length,
+                    size_t alignment, int prot)
+{
+    ucs_pgt_addr_t start = (uintptr_t)address;
+    ucs_rcache_thread_cache_entry_t *entry;
+    ucs_pgt_region_t *pgt_region;
+    ucs_rcache_region_t *region;
+
+    if (!ucs_queue_is_empty(&rcache->inv_q)) {
+        return NULL;
+    }
+
+    /* The cached region is alive as long as no region was removed from the
+     * page table since it was cached */
+    entry = &ucs_rcache_thread_cache[ucs_rcache_thread_cache_index(rcache,
+                                                                   start)];
+    if ((entry->rcache == rcache) &&
+        (entry->generation == rcache->generation)) {
+        region = entry->region;
+        if ((start >= region->super.start) &&
+            ((start + length) <= region->super.end) &&
+            ucs_rcache_region_test(region, prot, alignment)) {
+            goto out_hit;
+        }
+    }
+
+    pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &rcache->pgtable, start);
+    if (ucs_unlikely(pgt_region == NULL)) {
+        return NULL;
+    }
+
+    region = ucs_derived_of(pgt_region, ucs_rcache_region_t);
+    if (((start + length) > region->super.end) ||
+        !ucs_rcache_region_test(region, prot, alignment)) {
+        return NULL;
+    }
+
+    entry->rcache     = rcache;
+    entry->generation = rcache->generation;
+    entry->region     = region;
+
+out_hit:
+    ucs_rcache_region_hold(rcache, region);
+    ucs_rcache_region_validate_pfn(rcache, region);
+    ucs_rcache_region_lru_get(rcache, region);
+    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
+    return region;
+}
+
 ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
                             size_t alignment, int prot, void *arg,
                             ucs_rcache_region_t **region_p)
 {
-    ucs_pgt_addr_t start = (uintptr_t)address;
-    ucs_pgt_region_t *pgt_region;
+    ucs_rcache_reader_shard_t *shard;
     ucs_rcache_region_t *region;
 
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
-    pthread_rwlock_rdlock(&rcache->pgt_lock);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
-    if (ucs_queue_is_empty(&rcache->inv_q)) {
-        pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &rcache->pgtable,
-                                      start);
-        if (ucs_likely(pgt_region != NULL)) {
-            region = ucs_derived_of(pgt_region, ucs_rcache_region_t);
-            if (((start + length) <= region->super.end) &&
-                ucs_rcache_region_test(region, prot, alignment)) {
-                ucs_rcache_region_hold(rcache, region);
-                ucs_rcache_region_validate_pfn(rcache, region);
-                ucs_rcache_region_lru_get(rcache, region);
-                *region_p = region;
-                UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
-                pthread_rwlock_unlock(&rcache->pgt_lock);
-                return UCS_OK;
-            }
-        }
+
+    shard = ucs_rcache_reader_enter(rcache);
+    if (ucs_likely(shard != NULL)) {
+        region = ucs_rcache_get_fast(rcache, address, length, alignment, prot);
+        ucs_rcache_reader_exit(shard);
+    } else {
+        /* A writer holds the page table, wait for it on the lock */
+        ucs_rcache_pgt_rdlock(rcache);
+        region = ucs_rcache_get_fast(rcache, address, length, alignment, prot);
+        ucs_rcache_pgt_rdunlock(rcache);
+    }
+
+    if (ucs_likely(region != NULL)) {
+        *region_p = region;
+        return UCS_OK;
     }
-    pthread_rwlock_unlock(&rcache->pgt_lock);
 
     /* Fall back to slow version (with rw lock) in following cases:
      * - invalidation list not empty
@@ -1132,7 +1252,7 @@ void ucs_rcache_region_invalidate(ucs_rcache_t *rcache,
     comp = ucs_mpool_get(&rcache->mp);
     ucs_spin_unlock(&rcache->lock);
 
-    pthread_rwlock_wrlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrlock(rcache);
     if (comp != NULL) {
         comp->func = cb;
         comp->arg  = arg;
@@ -1145,7 +1265,7 @@ void ucs_rcache_region_invalidate(ucs_rcache_t *rcache,
     /* coverity[double_lock] */
     ucs_rcache_region_invalidate_internal(rcache, region, 0);
     /* coverity[double_unlock] */
-    pthread_rwlock_unlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrunlock(rcache);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_PUTS, 1);
 }
 
@@ -1170,10 +1290,10 @@ static void ucs_rcache_before_fork(void)
              *   again on-demand.
              * - Other use cases shouldn't be affected
              */
-            pthread_rwlock_wrlock(&rcache->pgt_lock);
+            ucs_rcache_pgt_wrlock(rcache);
             /* coverity[double_lock] */
             ucs_rcache_invalidate_range(rcache, 0, UCS_PGT_ADDR_MAX, 0);
-            pthread_rwlock_unlock(&rcache->pgt_lock);
+            ucs_rcache_pgt_wrunlock(rcache);
         }
     }
     pthread_mutex_unlock(&ucs_rcache_global_context.lock);
@@ -1301,6 +1421,10 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
         goto err_destroy_stats;
     }
 
+    self->pgt_writer = 0;
+    memset(self->readers, 0, sizeof(self->readers));
+    ucs_rcache_generation_update(self);
+
     status = ucs_spinlock_init(&self->lock, 0);
     if (status != UCS_OK) {
         goto err_destroy_rwlock;
@@ -9,10 +9,14 @@
 
 #include "rcache.h"
 
+#include <ucs/arch/atomic.h>
+#include <ucs/arch/cpu.h>
 #include <ucs/datastruct/list.h>
 #include <ucs/stats/stats.h>
 #include <ucs/sys/ptr_arith.h>
 #include <ucs/type/spinlock.h>
+#include <errno.h>
+#include <sched.h>
 
 
 #define ucs_rcache_region_log_lvl(_level, _message, ...) \
@@ -38,6 +42,10 @@
     ucs_roundup_pow2(ucs_global_opts.rcache_stat_min)
 
 
+/* Number of reader shards of the page table lock fast path */
+#define UCS_RCACHE_READER_SHARDS 16
+
+
 /* Names of rcache stats counters */
 enum {
     UCS_RCACHE_GETS,                /* number of get operations */
@@ -55,6 +63,16 @@ enum {
 };
 
 
+/* Count of readers which look up the page table without taking 'pgt_lock'.
+   Every shard occupies its own cache line, so that readers running on
+   different threads do not bounce a shared cache line.
+ */
+typedef struct ucs_rcache_reader_shard {
+    volatile uint32_t count;
+    char              pad[UCS_SYS_CACHE_LINE_SIZE - sizeof(uint32_t)];
+} ucs_rcache_reader_shard_t;
+
+
 /* The structure represents a group in registration cache regions distribution.
    Regions are distributed by their size.
  */
@@ -68,6 +86,16 @@ struct ucs_rcache {
 
     pthread_rwlock_t    pgt_lock;        /**< Protects the page table and all
                                               regions whose refcount is 0 */
+    volatile uint32_t   pgt_writer;      /**< Set while 'pgt_lock' is held in
+                                              write mode, forces the readers to
+                                              take 'pgt_lock' */
+    ucs_rcache_reader_shard_t readers[UCS_RCACHE_READER_SHARDS];
+                                         /**< Readers looking up the page table
+                                              without taking 'pgt_lock' */
+    volatile uint64_t   generation;      /**< Changed whenever a region is
+                                              removed from the page table, to
+                                              validate per-thread cached
+                                              lookups */
     ucs_pgtable_t       pgtable;         /**< page table to hold the regions */
 
 
@@ -110,6 +138,71 @@ struct ucs_rcache {
 };
 
 
+static inline int ucs_rcache_pgt_readers_idle(ucs_rcache_t *rcache)
+{
+    unsigned i;
+
+    for (i = 0; i < UCS_RCACHE_READER_SHARDS; ++i) {
+        if (rcache->readers[i].count != 0) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+/* Lock the page table in write mode, excluding lock-free readers as well */
+static inline void ucs_rcache_pgt_wrlock(ucs_rcache_t *rcache)
+{
+    pthread_rwlock_wrlock(&rcache->pgt_lock);
+    ucs_atomic_swap32(&rcache->pgt_writer, 1);
+    while (!ucs_rcache_pgt_readers_idle(rcache)) {
+        sched_yield();
+    }
+}
+
+
+/* Try to lock the page table in write mode, return 0 on success */
+static inline int ucs_rcache_pgt_trywrlock(ucs_rcache_t *rcache)
+{
+    int ret;
+
+    ret = pthread_rwlock_trywrlock(&rcache->pgt_lock);
+    if (ret != 0) {
+        return ret;
+    }
+
+    ucs_atomic_swap32(&rcache->pgt_writer, 1);
+    if (!ucs_rcache_pgt_readers_idle(rcache)) {
+        ucs_atomic_swap32(&rcache->pgt_writer, 0);
+        pthread_rwlock_unlock(&rcache->pgt_lock);
+        return EBUSY;
+    }
+
+    return 0;
+}
+
+
+static inline void ucs_rcache_pgt_wrunlock(ucs_rcache_t *rcache)
+{
+    ucs_atomic_swap32(&rcache->pgt_writer, 0);
+    pthread_rwlock_unlock(&rcache->pgt_lock);
+}
+
+
+static inline void ucs_rcache_pgt_rdlock(ucs_rcache_t *rcache)
+{
+    pthread_rwlock_rdlock(&rcache->pgt_lock);
+}
+
+
+static inline void ucs_rcache_pgt_rdunlock(ucs_rcache_t *rcache)
+{
+    pthread_rwlock_unlock(&rcache->pgt_lock);
+}
+
+
 /**
  * @brief Create objects in VFS to represent registration cache and its
  *        features.
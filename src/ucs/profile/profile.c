@@ -17,6 +17,7 @@
 #include <ucs/sys/string.h>
 #include <ucs/sys/sys.h>
 #include <ucs/time/time.h>
+#include <ucs/vfs/base/vfs_obj.h>
 #include <pthread.h>
 
 
@@ -42,9 +43,11 @@ typedef struct ucs_profile_thread_context {
         int                           wraparound;    /**< Whether log was rotated */
     } log;
 
+    /* Used by both accumulate and histogram modes */
     struct {
         unsigned                      num_locations; /**< Number of valid locations */
         ucs_profile_thread_location_t *locations;    /**< Statistics per location */
+        ucs_profile_hist_t            *hists;        /**< Histogram per location */
         int                           stack_top;     /**< Index of stack top */
         ucs_time_t                    stack[UCS_PROFILE_STACK_MAX]; /**< Timestamps for each nested scope */
     } accum;
@@ -77,6 +80,7 @@ struct ucs_profile_context  {
 const char *ucs_profile_mode_names[] = {
     [UCS_PROFILE_MODE_ACCUM] = "accum",
     [UCS_PROFILE_MODE_LOG]   = "log",
+    [UCS_PROFILE_MODE_HIST]  = "hist",
     [UCS_PROFILE_MODE_LAST]  = NULL
 };
 
@@ -135,6 +139,40 @@ ucs_profile_write_profiling_records(ucs_profile_context_t *ctx, int fd,
                                           thread_ctx->log.current);
 }
 
+static ucs_status_t
+ucs_profile_write_histograms(ucs_profile_context_t *ctx, int fd,
+                             ucs_profile_thread_context_t *thread_ctx)
+{
+    static const ucs_profile_hist_t empty_hist = {};
+    unsigned i, num_locations;
+    ucs_status_t status;
+
+    if (!(ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_HIST))) {
+        return UCS_OK;
+    }
+
+    /* Like accumulated locations, pad with empty histograms up to the number
+     * of global locations */
+    num_locations = thread_ctx->accum.num_locations;
+    ucs_assert_always(num_locations <= ctx->num_locations);
+    status = ucs_profile_file_write_data(fd, thread_ctx->accum.hists,
+                                         num_locations *
+                                         sizeof(*thread_ctx->accum.hists));
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    for (i = num_locations; i < ctx->num_locations; ++i) {
+        status = ucs_profile_file_write_data(fd, &empty_hist,
+                                             sizeof(empty_hist));
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
+    return UCS_OK;
+}
+
 size_t ucs_profile_calc_num_records(ucs_profile_context_t *ctx,
                                     ucs_profile_thread_context_t *thread_ctx)
 {
@@ -208,6 +246,11 @@ ucs_profile_file_write_thread(ucs_profile_context_t *ctx, int fd,
         }
     }
 
+    status = ucs_profile_write_histograms(ctx, fd, thread_ctx);
+    if (status != UCS_OK) {
+        return status;
+    }
+
     status = ucs_profile_write_profiling_records(ctx, fd, thread_ctx);
 
     if (status != UCS_OK) {
@@ -267,6 +310,10 @@ static void ucs_profile_calc_blocks(ucs_profile_header_t *header,
 
     threads_locations_size = ctx->num_locations *
                              sizeof(ucs_profile_thread_location_t);
+    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_HIST)) {
+        threads_locations_size += ctx->num_locations *
+                                  sizeof(ucs_profile_hist_t);
+    }
     thread_header_size     = sizeof(ucs_profile_thread_header_t);
     header->threads.offset = header->locations.offset + header->locations.size;
     header->threads.size   = (thread_header_size + threads_locations_size) *
@@ -393,10 +440,12 @@ ucs_profile_thread_init(ucs_profile_context_t *ctx)
         thread_ctx->log.wraparound = 0;
     }
 
-    /* Initialize accumulate mode */
-    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_ACCUM)) {
+    /* Initialize accumulate and histogram modes */
+    if (ctx->profile_mode & (UCS_BIT(UCS_PROFILE_MODE_ACCUM) |
+                             UCS_BIT(UCS_PROFILE_MODE_HIST))) {
         thread_ctx->accum.num_locations = 0;
         thread_ctx->accum.locations     = NULL;
+        thread_ctx->accum.hists         = NULL;
         thread_ctx->accum.stack_top     = -1;
     }
 
@@ -418,8 +467,10 @@ static void ucs_profile_thread_cleanup(unsigned profile_mode,
         ucs_free(ctx->log.start);
     }
 
-    if (profile_mode & UCS_BIT(UCS_PROFILE_MODE_ACCUM)) {
+    if (profile_mode & (UCS_BIT(UCS_PROFILE_MODE_ACCUM) |
+                        UCS_BIT(UCS_PROFILE_MODE_HIST))) {
         ucs_free(ctx->accum.locations);
+        ucs_free(ctx->accum.hists);
     }
 
     ucs_list_del(&ctx->list);
@@ -548,20 +599,42 @@ static void ucs_profile_thread_expand_locations(ucs_profile_context_t *ctx,
     ucs_assert(thread_ctx != NULL);
 
     new_num_locations = ucs_max(loc_id, thread_ctx->accum.num_locations);
-    thread_ctx->accum.locations = ucs_realloc(thread_ctx->accum.locations,
-                                       sizeof(*thread_ctx->accum.locations) *
-                                       new_num_locations,
-                                       "profile_thread_locations");
-    if (thread_ctx->accum.locations == NULL) {
-        ucs_fatal("failed to allocate profiling per-thread locations");
+
+    /* The histograms can be read by another thread through VFS */
+    pthread_mutex_lock(&ctx->mutex);
+
+    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_ACCUM)) {
+        thread_ctx->accum.locations = ucs_realloc(thread_ctx->accum.locations,
+                                           sizeof(*thread_ctx->accum.locations) *
+                                           new_num_locations,
+                                           "profile_thread_locations");
+        if (thread_ctx->accum.locations == NULL) {
+            ucs_fatal("failed to allocate profiling per-thread locations");
+        }
+
+        for (i = thread_ctx->accum.num_locations; i < new_num_locations; ++i) {
+            thread_ctx->accum.locations[i].count      = 0;
+            thread_ctx->accum.locations[i].total_time = 0;
+        }
     }
 
-    for (i = thread_ctx->accum.num_locations; i < new_num_locations; ++i) {
-        thread_ctx->accum.locations[i].count      = 0;
-        thread_ctx->accum.locations[i].total_time = 0;
+    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_HIST)) {
+        thread_ctx->accum.hists = ucs_realloc(thread_ctx->accum.hists,
+                                              sizeof(*thread_ctx->accum.hists) *
+                                              new_num_locations,
+                                              "profile_thread_hists");
+        if (thread_ctx->accum.hists == NULL) {
+            ucs_fatal("failed to allocate profiling per-thread histograms");
+        }
+
+        memset(&thread_ctx->accum.hists[thread_ctx->accum.num_locations], 0,
+               sizeof(*thread_ctx->accum.hists) *
+               (new_num_locations - thread_ctx->accum.num_locations));
     }
 
     thread_ctx->accum.num_locations = new_num_locations;
+
+    pthread_mutex_unlock(&ctx->mutex);
 }
 
 void ucs_profile_record(ucs_profile_context_t *ctx, ucs_profile_type_t type,
@@ -569,11 +642,10 @@ void ucs_profile_record(ucs_profile_context_t *ctx, ucs_profile_type_t type,
                         const char *file, int line, const char *function,
                         volatile ucs_profile_loc_id_t *loc_id_p)
 {
-    ucs_profile_thread_location_t *loc;
     ucs_profile_thread_context_t *thread_ctx;
     ucs_profile_loc_id_t loc_id;
     ucs_profile_record_t *rec;
-    ucs_time_t current_time;
+    ucs_time_t current_time, elapsed;
 
     /* If the location id is -1 or 0, need to re-read it with lock held */
     loc_id = *loc_id_p;
@@ -597,27 +669,37 @@ void ucs_profile_record(ucs_profile_context_t *ctx, ucs_profile_type_t type,
     }
 
     current_time = ucs_get_time();
-    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_ACCUM)) {
+    if (ctx->profile_mode & (UCS_BIT(UCS_PROFILE_MODE_ACCUM) |
+                             UCS_BIT(UCS_PROFILE_MODE_HIST))) {
         if (ucs_unlikely(loc_id > thread_ctx->accum.num_locations)) {
             /* expand the locations array of the current thread */
             ucs_profile_thread_expand_locations(ctx, loc_id);
         }
         ucs_assert(loc_id - 1 < thread_ctx->accum.num_locations);
 
-        loc = &thread_ctx->accum.locations[loc_id - 1];
         switch (type) {
         case UCS_PROFILE_TYPE_SCOPE_BEGIN:
             thread_ctx->accum.stack[++thread_ctx->accum.stack_top] = current_time;
             break;
         case UCS_PROFILE_TYPE_SCOPE_END:
-            loc->total_time += current_time -
-                               thread_ctx->accum.stack[thread_ctx->accum.stack_top];
+            elapsed = current_time -
+                      thread_ctx->accum.stack[thread_ctx->accum.stack_top];
             --thread_ctx->accum.stack_top;
+            if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_ACCUM)) {
+                thread_ctx->accum.locations[loc_id - 1].total_time += elapsed;
+            }
+            if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_HIST)) {
+                ++thread_ctx->accum.hists[loc_id - 1]
+                          .counts[ucs_profile_hist_bucket(elapsed)];
+            }
             break;
         default:
             break;
         }
-        ++loc->count;
+
+        if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_ACCUM)) {
+            ++thread_ctx->accum.locations[loc_id - 1].count;
+        }
     }
 
     if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_LOG)) {
@@ -711,10 +793,113 @@ unsigned ucs_profile_calc_num_threads(size_t total_num_records,
     size_t records_size           = sizeof(ucs_profile_record_t) * 
                                     total_num_records;
 
+    if (header->mode & UCS_BIT(UCS_PROFILE_MODE_HIST)) {
+        threads_locations_size += num_locations * sizeof(ucs_profile_hist_t);
+    }
+
     return (header->threads.size - records_size) /
            (thread_header_size + threads_locations_size);
 }
 
+uint64_t ucs_profile_hist_percentile(const ucs_profile_hist_t *hist,
+                                     double percentile)
+{
+    uint64_t total, target, sum;
+    double exact_target;
+    unsigned bucket;
+
+    total = 0;
+    for (bucket = 0; bucket < UCS_PROFILE_HIST_NUM_BUCKETS; ++bucket) {
+        total += hist->counts[bucket];
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    /* Number of samples which are less than or equal to the percentile */
+    exact_target = total * percentile / 100.0;
+    target       = exact_target;
+    if (target < exact_target) {
+        ++target;
+    }
+    target = ucs_max(target, 1);
+
+    sum = 0;
+    for (bucket = 0; bucket < (UCS_PROFILE_HIST_NUM_BUCKETS - 1); ++bucket) {
+        sum += hist->counts[bucket];
+        if (sum >= target) {
+            return ucs_profile_hist_bucket_start(bucket + 1) - 1;
+        }
+    }
+
+    return UINT64_MAX;
+}
+
+static void ucs_profile_vfs_read_hist(void *obj, ucs_string_buffer_t *strb,
+                                      void *arg_ptr, uint64_t arg_u64)
+{
+    static const double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+    ucs_profile_context_t *ctx        = obj;
+    ucs_profile_thread_context_t *thread_ctx;
+    ucs_profile_global_location_t *loc;
+    ucs_profile_hist_t *hist;
+    uint64_t count;
+    unsigned i, loc_idx, bucket;
+
+    hist = ucs_malloc(sizeof(*hist), "profile_vfs_hist");
+    if (hist == NULL) {
+        ucs_string_buffer_appendf(strb, "<failed to allocate histogram>\n");
+        return;
+    }
+
+    /* Histograms are summed while the threads keep updating them, so the
+     * result is a snapshot which may be slightly inconsistent */
+    pthread_mutex_lock(&ctx->mutex);
+
+    ucs_profile_ctx_for_each_location(ctx, loc) {
+        if (loc->super.type != UCS_PROFILE_TYPE_SCOPE_END) {
+            continue;
+        }
+
+        loc_idx = loc - ctx->locations;
+        memset(hist, 0, sizeof(*hist));
+        ucs_list_for_each(thread_ctx, &ctx->thread_list, list) {
+            if (loc_idx >= thread_ctx->accum.num_locations) {
+                continue;
+            }
+
+            for (bucket = 0; bucket < UCS_PROFILE_HIST_NUM_BUCKETS; ++bucket) {
+                hist->counts[bucket] +=
+                        thread_ctx->accum.hists[loc_idx].counts[bucket];
+            }
+        }
+
+        count = 0;
+        for (bucket = 0; bucket < UCS_PROFILE_HIST_NUM_BUCKETS; ++bucket) {
+            count += hist->counts[bucket];
+        }
+
+        if (count == 0) {
+            continue;
+        }
+
+        ucs_string_buffer_appendf(strb, "%s (%s:%d %s): count %" PRIu64,
+                                  loc->super.name, loc->super.file,
+                                  loc->super.line, loc->super.function, count);
+        for (i = 0; i < ucs_static_array_size(percentiles); ++i) {
+            ucs_string_buffer_appendf(
+                    strb, " p%g %.3f", percentiles[i],
+                    ucs_time_to_usec(ucs_profile_hist_percentile(
+                            hist, percentiles[i])));
+        }
+        ucs_string_buffer_appendf(strb, " usec\n");
+    }
+
+    pthread_mutex_unlock(&ctx->mutex);
+    ucs_free(hist);
+}
+
 ucs_status_t ucs_profile_init(unsigned profile_mode, const char *file_name,
                               size_t max_file_size, ucs_profile_context_t **ctx_p)
 {
@@ -750,6 +935,13 @@ ucs_status_t ucs_profile_init(unsigned profile_mode, const char *file_name,
     }
 
     pthread_key_create(&(ctx->tls_key), ucs_profile_thread_key_destr);
+
+    if (profile_mode & UCS_BIT(UCS_PROFILE_MODE_HIST)) {
+        ucs_vfs_obj_add_dir(NULL, ctx, "ucs/profile");
+        ucs_vfs_obj_add_ro_file(ctx, ucs_profile_vfs_read_hist, NULL, 0,
+                                "histogram");
+    }
+
     *ctx_p = ctx;
 
     return UCS_OK;
@@ -761,6 +953,7 @@ free_ctx:
 
 void ucs_profile_cleanup(ucs_profile_context_t *ctx)
 {
+    ucs_vfs_obj_remove(ctx);
     ucs_profile_dump(ctx);
     ucs_profile_check_active_threads(ctx);
     ucs_profile_reset_locations(ctx);
@@ -7,6 +7,7 @@
 #ifndef UCS_PROFILE_DEFS_H_
 #define UCS_PROFILE_DEFS_H_
 
+#include <ucs/arch/bitops.h>
 #include <ucs/config/global_opts.h>
 #include <ucs/sys/compiler_def.h>
 #include <ucs/time/time_def.h>
@@ -16,13 +17,20 @@
 BEGIN_C_DECLS
 
 #define UCS_PROFILE_STACK_MAX       64
-#define UCS_PROFILE_FILE_VERSION    3u
+#define UCS_PROFILE_FILE_VERSION    4u
 #define UCS_PROFILE_LOC_ID_UNKNOWN  -1
 #define UCS_PROFILE_LOC_ID_DISABLED 0
 
 /* Minimum backwards compatible version */
 #define UCS_PROFILE_FILE_MIN_VERSION 3u
 
+/* Number of linear sub-buckets of each power-of-2 range in a histogram, as a
+ * power of 2. Every bucket is at most 1/8 (12.5%) wide relative to its start.
+ */
+#define UCS_PROFILE_HIST_SUB_BITS    3
+#define UCS_PROFILE_HIST_NUM_BUCKETS \
+    ((64 - UCS_PROFILE_HIST_SUB_BITS + 1) << UCS_PROFILE_HIST_SUB_BITS)
+
 
 /**
  * Profiling modes
@@ -30,6 +38,7 @@ BEGIN_C_DECLS
 enum {
     UCS_PROFILE_MODE_ACCUM, /**< Accumulate elapsed time per location */
     UCS_PROFILE_MODE_LOG,   /**< Record all events */
+    UCS_PROFILE_MODE_HIST,  /**< Histogram of elapsed time per location */
     UCS_PROFILE_MODE_LAST
 };
 
@@ -56,6 +65,8 @@ typedef enum {
  * [
  *    < ucs_profile_thread_header_t >
  *    < ucs_profile_thread_location_t > * ucs_profile_header_t::num_locations
+ *    [ < ucs_profile_hist_t > * ucs_profile_header_t::num_locations ]
+ *        (only if UCS_PROFILE_MODE_HIST is set in ucs_profile_header_t::mode)
  *    < ucs_profile_record_t > * ucs_profile_thread_header_t::num_records
  *
  * ] * ucs_profile_thread_header_t::num_threads
@@ -122,6 +133,17 @@ typedef struct ucs_profile_thread_location {
 } UCS_S_PACKED ucs_profile_thread_location_t;
 
 
+/**
+ * Log-linear histogram of the elapsed time of a scope location, in ucs_time_t
+ * units. Values below 2^UCS_PROFILE_HIST_SUB_BITS have a bucket each; larger
+ * values are divided to power-of-2 ranges, each split to
+ * 2^UCS_PROFILE_HIST_SUB_BITS equal buckets.
+ */
+typedef struct ucs_profile_hist {
+    uint64_t                 counts[UCS_PROFILE_HIST_NUM_BUCKETS];
+} UCS_S_PACKED ucs_profile_hist_t;
+
+
 /**
  * Profile output file sample record
  */
@@ -202,6 +224,53 @@ void ucs_profile_record(ucs_profile_context_t *ctx, ucs_profile_type_t type,
 unsigned ucs_profile_calc_num_threads(size_t total_num_records,
                                       const ucs_profile_header_t *header);
 
+/**
+ * @return Index of the histogram bucket which contains @a value.
+ */
+static UCS_F_ALWAYS_INLINE unsigned ucs_profile_hist_bucket(uint64_t value)
+{
+    unsigned shift;
+
+    if (value < UCS_BIT(UCS_PROFILE_HIST_SUB_BITS)) {
+        return value;
+    }
+
+    shift = ucs_ilog2(value) - UCS_PROFILE_HIST_SUB_BITS;
+    return ((shift + 1) << UCS_PROFILE_HIST_SUB_BITS) + (value >> shift) -
+           UCS_BIT(UCS_PROFILE_HIST_SUB_BITS);
+}
+
+
+/**
+ * @return Smallest value which belongs to histogram bucket @a bucket.
+ */
+static UCS_F_ALWAYS_INLINE uint64_t ucs_profile_hist_bucket_start(unsigned bucket)
+{
+    unsigned shift;
+
+    if (bucket < UCS_BIT(UCS_PROFILE_HIST_SUB_BITS)) {
+        return bucket;
+    }
+
+    shift = (bucket >> UCS_PROFILE_HIST_SUB_BITS) - 1;
+    return (uint64_t)(UCS_BIT(UCS_PROFILE_HIST_SUB_BITS) +
+                      (bucket & UCS_MASK(UCS_PROFILE_HIST_SUB_BITS))) << shift;
+}
+
+
+/**
+ * Calculate a percentile of a histogram.
+ *
+ * @param [in]  hist        Histogram.
+ * @param [in]  percentile  Percentile to calculate, in the range [0..100].
+ *
+ * @return Upper bound of the bucket which contains the percentile, or 0 if the
+ *         histogram is empty.
+ */
+uint64_t ucs_profile_hist_percentile(const ucs_profile_hist_t *hist,
+                                     double percentile);
+
+
 /**
  * Record a profiling event.
  *
@@ -17,9 +17,12 @@
 #include <ucs/sys/sys.h>
 #include <ucs/sys/iovec.h>
 #include <ucs/sys/iovec.inl>
+#include <ucs/time/time.h>
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
 #include <ifaddrs.h>
 #include <unistd.h>
 #include <errno.h>
@@ -654,6 +657,18 @@ ucs_status_t ucs_socket_recv_nb(int fd, void *data, int flags, size_t *length_p)
                                "recv", flags);
 }
 
+ucs_status_t ucs_socket_io_result(int fd, const char *name, ssize_t io_retval,
+                                  int io_errno, size_t *length_p)
+{
+    if (ucs_likely(io_retval > 0)) {
+        *length_p = io_retval;
+        return UCS_OK;
+    }
+
+    *length_p = 0;
+    return ucs_socket_handle_io_error(fd, name, io_retval, io_errno);
+}
+
 ucs_status_t ucs_socket_send(int fd, const void *data, size_t length)
 {
     return ucs_socket_do_io_b(fd, (void*)data, length,
@@ -671,6 +686,106 @@ ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p)
     return ucs_socket_do_iov_nb(fd, iov, iov_cnt, length_p, sendmsg, "sendv");
 }
 
+ucs_status_t ucs_socket_sendmsg_nb(int fd, struct iovec *iov, size_t iov_cnt,
+                                   int flags, size_t *length_p)
+{
+    struct msghdr msg = {
+        .msg_iov    = iov,
+        .msg_iovlen = iov_cnt
+    };
+    ssize_t ret;
+
+    ret = sendmsg(fd, &msg, MSG_NOSIGNAL | flags);
+    if ((ret < 0) && (errno == ENOBUFS) && (flags & UCS_SOCKET_MSG_ZEROCOPY)) {
+        /* the socket option memory is exhausted by the outstanding zero-copy
+         * sends, try again after some of them are completed */
+        *length_p = 0;
+        return UCS_ERR_NO_PROGRESS;
+    }
+
+    return ucs_socket_handle_io(fd, iov, iov_cnt, length_p, 1, ret, errno,
+                                "sendmsg");
+}
+
+ucs_status_t ucs_socket_enable_zcopy(int fd)
+{
+#if defined(SO_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+    int optval = 1;
+
+    if ((UCS_SOCKET_MSG_ZEROCOPY != 0) &&
+        (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &optval, sizeof(optval)) == 0)) {
+        return UCS_OK;
+    }
+
+    ucs_debug("failed to enable SO_ZEROCOPY on fd %d: %m", fd);
+#endif
+    return UCS_ERR_UNSUPPORTED;
+}
+
+ucs_status_t ucs_socket_set_busy_poll(int fd, ucs_time_t timeout)
+{
+#ifdef SO_BUSY_POLL
+    int optval = ucs_min(ucs_time_to_usec(timeout), INT_MAX);
+
+    if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &optval, sizeof(optval)) == 0) {
+        return UCS_OK;
+    }
+
+    ucs_debug("failed to set SO_BUSY_POLL=%d on fd %d: %m", optval, fd);
+#endif
+    return UCS_ERR_UNSUPPORTED;
+}
+
+ucs_status_t ucs_socket_zcopy_completions(int fd, uint32_t *count_p)
+{
+#ifdef SO_EE_ORIGIN_ZEROCOPY
+    char control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+    struct sock_extended_err *serr;
+    struct cmsghdr *cmsg;
+    struct msghdr msg;
+    ssize_t ret;
+
+    *count_p = 0;
+
+    /* every message in the error queue carries a range of completed sends */
+    for (;;) {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        ret = recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+        if (ret < 0) {
+            break;
+        }
+
+        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+             cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (!(((cmsg->cmsg_level == SOL_IP) &&
+                   (cmsg->cmsg_type == IP_RECVERR)) ||
+                  ((cmsg->cmsg_level == SOL_IPV6) &&
+                   (cmsg->cmsg_type == IPV6_RECVERR)))) {
+                continue;
+            }
+
+            serr = (struct sock_extended_err*)CMSG_DATA(cmsg);
+            if ((serr->ee_errno == 0) &&
+                (serr->ee_origin == SO_EE_ORIGIN_ZEROCOPY)) {
+                *count_p += serr->ee_data - serr->ee_info + 1;
+            }
+        }
+    }
+
+    if (*count_p > 0) {
+        return UCS_OK;
+    }
+
+    return ucs_socket_check_errno(errno);
+#else
+    *count_p = 0;
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
 ucs_status_t ucs_sockaddr_sizeof(const struct sockaddr *addr, size_t *size_p)
 {
     switch (addr->sa_family) {
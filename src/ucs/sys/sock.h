@@ -10,6 +10,7 @@
 
 #include <ucs/type/status.h>
 #include <ucs/config/parser.h>
+#include <ucs/time/time_def.h>
 
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -35,6 +36,14 @@ BEGIN_C_DECLS
 #define UCS_SOCKET_INET6_ADDR(_addr) (((struct sockaddr_in6*)(_addr))->sin6_addr)
 #define UCS_SOCKET_INET6_PORT(_addr) (((struct sockaddr_in6*)(_addr))->sin6_port)
 
+/* Send flag which requests to transmit the data without copying it, 0 if it
+ * is not supported by the system */
+#ifdef MSG_ZEROCOPY
+#  define UCS_SOCKET_MSG_ZEROCOPY    MSG_ZEROCOPY
+#else
+#  define UCS_SOCKET_MSG_ZEROCOPY    0
+#endif
+
 
 /**
  * Close the given file descriptor.
@@ -290,6 +299,23 @@ ucs_status_t ucs_socket_send_nb(int fd, const void *data, size_t *length_p);
 ucs_status_t ucs_socket_recv_nb(int fd, void *data, int flags, size_t *length_p);
 
 
+/**
+ * Convert the result of a non-blocking IO operation which was not issued by
+ * the socket functions above (e.g submitted asynchronously) to a status code,
+ * in the same way @ref ucs_socket_recv_nb and @ref ucs_socket_send_nb do.
+ *
+ * @param [in]  fd              Socket fd.
+ * @param [in]  name            Name of the IO operation ("send" or "recv").
+ * @param [in]  io_retval       Result of the IO operation.
+ * @param [in]  io_errno        Error code of the IO operation.
+ * @param [out] length_p        The amount of data transmitted.
+ *
+ * @return UCS_OK on success or an error code on failure.
+ */
+ucs_status_t ucs_socket_io_result(int fd, const char *name, ssize_t io_retval,
+                                  int io_errno, size_t *length_p);
+
+
 /**
  * Blocking send operation sends data on the connected (or bound connectionless)
  * socket referred to by the file descriptor `fd`.
@@ -322,6 +348,66 @@ ucs_status_t ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt,
                                  size_t *length_p);
 
 
+/**
+ * Non-blocking send operation sends I/O vector on the connected socket referred
+ * to by the file descriptor `fd` using the given send flags. If the flags
+ * contain @ref UCS_SOCKET_MSG_ZEROCOPY, the data buffers must not be modified
+ * until the completion is reported by @ref ucs_socket_zcopy_completions.
+ *
+ * @param [in]      fd              Socket fd.
+ * @param [in]      iov             A pointer to an array of iovec buffers.
+ * @param [in]      iov_cnt         The number of buffers pointed to by
+ *                                  the iov parameter.
+ * @param [in]      flags           sendmsg flags.
+ * @param [out]     length_p        The amount of data transmitted is written to
+ *                                  this argument.
+ *
+ * @return UCS_OK on success or an error code on failure.
+ */
+ucs_status_t ucs_socket_sendmsg_nb(int fd, struct iovec *iov, size_t iov_cnt,
+                                   int flags, size_t *length_p);
+
+
+/**
+ * Enable sending with @ref UCS_SOCKET_MSG_ZEROCOPY flag on the socket referred
+ * to by the file descriptor `fd`.
+ *
+ * @param [in]  fd              Socket fd.
+ *
+ * @return UCS_OK on success, UCS_ERR_UNSUPPORTED if zero-copy send is not
+ *         supported by the system.
+ */
+ucs_status_t ucs_socket_enable_zcopy(int fd);
+
+
+/**
+ * Set the approximate time to busy poll on the device queue when receiving
+ * from the socket referred to by the file descriptor `fd` and no data is
+ * available (SO_BUSY_POLL socket option).
+ *
+ * @param [in]  fd              Socket fd.
+ * @param [in]  timeout         Time to busy poll.
+ *
+ * @return UCS_OK on success, UCS_ERR_UNSUPPORTED if busy polling is not
+ *         supported by the system or not permitted for the process.
+ */
+ucs_status_t ucs_socket_set_busy_poll(int fd, ucs_time_t timeout);
+
+
+/**
+ * Receive the completion notifications of @ref UCS_SOCKET_MSG_ZEROCOPY sends
+ * from the error queue of the socket referred to by the file descriptor `fd`.
+ * Every successful zero-copy send is completed by exactly one notification.
+ *
+ * @param [in]  fd              Socket fd.
+ * @param [out] count_p         Number of completed zero-copy sends.
+ *
+ * @return UCS_OK if some sends were completed, UCS_ERR_NO_PROGRESS if there
+ *         are no new notifications, or an error code on failure.
+ */
+ucs_status_t ucs_socket_zcopy_completions(int fd, uint32_t *count_p);
+
+
 /**
  * Blocking receive operation receives data from the connected (or bound
  * connectionless) socket referred to by the file descriptor `fd`.
@@ -16,6 +16,37 @@
 #include <ucs/sys/ptr_arith.h>
 
 
+/* Maximal number of ticks from now a timer can expire at */
+#define UCS_TWHEEL_MAX_TICKS \
+    (UCS_BIT(UCS_TWHEEL_LEVEL_BITS * UCS_TWHEEL_NUM_LEVELS) - 1)
+
+
+static UCS_F_ALWAYS_INLINE ucs_list_link_t *
+ucs_twheel_slot(ucs_twheel_t *t, unsigned level, uint64_t tick)
+{
+    uint64_t index = (tick >> (level * UCS_TWHEEL_LEVEL_BITS)) &
+                     (t->num_slots - 1);
+
+    return &t->wheel[(level * t->num_slots) + index];
+}
+
+/* Put a timer on the lowest level which covers its expiration */
+static void ucs_twheel_insert(ucs_twheel_t *t, ucs_wtimer_t *timer)
+{
+    uint64_t ticks = timer->expiration - t->current;
+    unsigned level;
+
+    ucs_assert(timer->expiration >= t->current);
+    for (level = 0; level < (UCS_TWHEEL_NUM_LEVELS - 1); ++level) {
+        if (ticks < UCS_BIT((level + 1) * UCS_TWHEEL_LEVEL_BITS)) {
+            break;
+        }
+    }
+
+    ucs_list_add_tail(ucs_twheel_slot(t, level, timer->expiration),
+                      &timer->list);
+}
+
 ucs_status_t ucs_twheel_init(ucs_twheel_t *twheel, ucs_time_t resolution,
                              ucs_time_t current_time)
 {
@@ -23,17 +54,18 @@ ucs_status_t ucs_twheel_init(ucs_twheel_t *twheel, ucs_time_t resolution,
 
     twheel->res         = ucs_roundup_pow2(resolution);
     twheel->res_order   = (unsigned) ucs_log2(twheel->res);
-    twheel->num_slots   = 1024;
-    twheel->current     = 0;
+    twheel->num_slots   = UCS_TWHEEL_NUM_SLOTS;
+    twheel->current     = current_time >> twheel->res_order;
     twheel->now         = current_time;
-    twheel->wheel       = ucs_malloc(sizeof(*twheel->wheel) * twheel->num_slots,
+    twheel->wheel       = ucs_malloc(sizeof(*twheel->wheel) *
+                                     twheel->num_slots * UCS_TWHEEL_NUM_LEVELS,
                                      "twheel");
     twheel->count       = 0;
     if (twheel->wheel == NULL) {
         return UCS_ERR_NO_MEMORY;
     }
 
-    for (i = 0; i < twheel->num_slots; i++) {
+    for (i = 0; i < (twheel->num_slots * UCS_TWHEEL_NUM_LEVELS); i++) {
         ucs_list_head_init(&twheel->wheel[i]);
     }
 
@@ -56,50 +88,81 @@ ucs_status_t ucs_wtimer_init(ucs_wtimer_t *t, ucs_twheel_callback_t cb)
 
 void __ucs_wtimer_add(ucs_twheel_t *t, ucs_wtimer_t *timer, ucs_time_t delta)
 {
-    uint64_t slot;
+    uint64_t ticks;
 
     timer->is_active = 1;
-    slot = delta>>t->res_order;
-    if (ucs_unlikely(slot == 0)) {
+    ticks = delta >> t->res_order;
+    if (ucs_unlikely(ticks == 0)) {
         /* nothing really wrong with adding timer to the current slot. However
          * we want to guard against the case we spend to much time in hi res
          * timer processing */
         ucs_fatal("Timer resolution is too low. Min resolution %lf usec, wanted %lf usec",
                 ucs_time_to_usec(t->res), ucs_time_to_usec(delta));
     }
-    ucs_assert(slot > 0);
+    ucs_assert(ticks > 0);
 
-    if (ucs_unlikely(slot >= t->num_slots)) {
-        slot = t->num_slots - 1;
-    }
+    timer->expiration = t->current + ucs_min(ticks, UCS_TWHEEL_MAX_TICKS);
+    ucs_twheel_insert(t, timer);
+    t->count++;
+}
 
-    slot = (t->current + slot) % t->num_slots;
-    ucs_assert(slot != t->current);
+/* Move the timers of an upper level slot to the levels below it */
+static void ucs_twheel_cascade(ucs_twheel_t *t, unsigned level)
+{
+    ucs_wtimer_t *timer;
+    UCS_LIST_HEAD(timers);
 
-    ucs_list_add_tail(&t->wheel[slot], &timer->list);
-    t->count++;
+    ucs_list_splice_tail(&timers, ucs_twheel_slot(t, level, t->current));
+    ucs_list_head_init(ucs_twheel_slot(t, level, t->current));
+
+    while (!ucs_list_is_empty(&timers)) {
+        timer = ucs_list_extract_head(&timers, ucs_wtimer_t, list);
+        ucs_twheel_insert(t, timer);
+    }
 }
 
 void __ucs_twheel_sweep(ucs_twheel_t *t, ucs_time_t current_time)
 {
+    uint64_t tick = current_time >> t->res_order;
+    ucs_list_link_t *slot;
     ucs_wtimer_t *timer;
-    uint64_t slot;
+    unsigned level;
+    UCS_LIST_HEAD(expired);
 
-    slot   = (current_time - t->now) >> t->res_order;
     t->now = current_time;
 
-    if (ucs_unlikely(slot >= t->num_slots)) {
-        slot = t->num_slots - 1;
-    }
+    while (t->current < tick) {
+        if (t->count == 0) {
+            t->current = tick;
+            break;
+        }
 
-    slot = (t->current + slot) % t->num_slots;
+        ++t->current;
 
-    for (; t->current != slot; t->current = (t->current+1) % t->num_slots) {
-        while (!ucs_list_is_empty(&t->wheel[t->current])) {
-            timer = ucs_list_extract_head(&t->wheel[t->current], ucs_wtimer_t, list);
+        /* When a level completes a turn, move down the timers of the next slot
+         * of the level above it */
+        for (level = 1; level < UCS_TWHEEL_NUM_LEVELS; ++level) {
+            if (t->current & (UCS_BIT(level * UCS_TWHEEL_LEVEL_BITS) - 1)) {
+                break;
+            }
+
+            ucs_twheel_cascade(t, level);
+        }
+
+        slot = ucs_twheel_slot(t, 0, t->current);
+        if (ucs_list_is_empty(slot)) {
+            continue;
+        }
+
+        /* Detach all timers of the slot, since callbacks may add timers */
+        ucs_list_splice_tail(&expired, slot);
+        ucs_list_head_init(slot);
+        while (!ucs_list_is_empty(&expired)) {
+            timer = ucs_list_extract_head(&expired, ucs_wtimer_t, list);
+            ucs_assert(timer->expiration == t->current);
             timer->is_active = 0;
-            timer->cb(timer);
             t->count--;
+            timer->cb(timer);
         }
     }
 }
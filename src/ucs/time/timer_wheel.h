@@ -12,6 +12,15 @@
 #include <ucs/debug/log.h>
 
 
+/* Number of slots in every level of the timer wheel, as a power of 2 */
+#define UCS_TWHEEL_LEVEL_BITS  6
+#define UCS_TWHEEL_NUM_SLOTS   UCS_BIT(UCS_TWHEEL_LEVEL_BITS)
+
+/* Number of levels. Every slot of a level covers a full turn of the level below
+ * it, so the wheel range is UCS_TWHEEL_NUM_SLOTS^UCS_TWHEEL_NUM_LEVELS ticks */
+#define UCS_TWHEEL_NUM_LEVELS  4
+
+
 /* Forward declarations */
 typedef struct ucs_wtimer       ucs_wtimer_t;
 typedef struct ucs_timer_wheel  ucs_twheel_t;
@@ -29,17 +38,25 @@ typedef void (*ucs_twheel_callback_t)(ucs_wtimer_t *self);
 struct ucs_wtimer {
     ucs_twheel_callback_t  cb;         /* User callback */
     ucs_list_link_t        list;       /* Link in the list of timers */
+    uint64_t               expiration; /* Expiration tick */
     int                    is_active;
 };
 
 
+/**
+ * Hierarchical timer wheel. Level 0 has a slot for every tick, and each slot of
+ * level N holds the timers expiring during a full turn of level N-1. When the
+ * lower level completes a turn, the timers of the next slot of the upper level
+ * are moved down. Adding and removing a timer take constant time, and the
+ * timers of a slot are dispatched together.
+ */
 struct ucs_timer_wheel {
     ucs_time_t             res;
     ucs_time_t             now;        /* when wheel was last updated */
-    uint64_t               current;
-    ucs_list_link_t        *wheel;
+    uint64_t               current;    /* Current tick */
+    ucs_list_link_t        *wheel;     /* Slots of all levels */
     unsigned               res_order;
-    unsigned               num_slots;
+    unsigned               num_slots;  /* Number of slots in a level */
     unsigned               count;
 };
 
@@ -48,7 +65,8 @@ struct ucs_timer_wheel {
  * Initialize the timer queue.
  *
  * @param twheel        Timer queue to initialize.
- * @param resolution    Timer resolution. Timer wheel range is from now to now + UCS_TWHEEL_NSLOTS * res
+ * @param resolution    Timer resolution. Timer wheel range is from now to
+ *                      now + UCS_TWHEEL_NUM_SLOTS^UCS_TWHEEL_NUM_LEVELS * res
  * @param current_time  Current time to initialize the timer with.
  */
 ucs_status_t ucs_twheel_init(ucs_twheel_t *twheel, ucs_time_t resolution,
@@ -24,7 +24,9 @@ ucs_status_t ucs_timerq_init(ucs_timer_queue_t *timerq)
     timerq->timers       = NULL;
     timerq->num_timers   = 0;
     /* coverity[missing_lock] */
-    timerq->min_interval = UCS_TIME_INFINITY;
+    timerq->min_interval    = UCS_TIME_INFINITY;
+    /* coverity[missing_lock] */
+    timerq->next_expiration = UCS_TIME_INFINITY;
     return UCS_OK;
 }
 
@@ -75,6 +77,7 @@ ucs_status_t ucs_timerq_add(ucs_timer_queue_t *timerq, int timer_id,
     ptr->expiration = 0; /* will fire the next time sweep is called */
     ptr->interval   = interval;
     ptr->id         = timer_id;
+    timerq->next_expiration = 0;
 
     status = UCS_OK;
 
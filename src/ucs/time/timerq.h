@@ -23,7 +23,9 @@ typedef struct ucs_timer {
 
 typedef struct ucs_timer_queue {
     ucs_recursive_spinlock_t   lock;
-    ucs_time_t                 min_interval; /* Expiration of next timer */
+    ucs_time_t                 min_interval; /* Minimal timer interval */
+    ucs_time_t                 next_expiration; /* Earliest expiration time
+                                                   of all timers */
     ucs_timer_t                *timers;      /* Array of timers */
     unsigned                   num_timers;   /* Number of timers */
 } ucs_timer_queue_t;
@@ -98,20 +100,39 @@ static inline int ucs_timerq_is_empty(ucs_timer_queue_t *timerq) {
  *
  * @note Timers which expired between calls to this function will also be dispatched.
  * @note There is no guarantee on the order of dispatching.
+ * @note The timers are scanned only if the earliest of them has expired.
  */
 #define ucs_timerq_for_each_expired(_timer, _timerq, _current_time, _code) \
     { \
         ucs_time_t __current_time = _current_time; \
+        ucs_time_t __next_expiration; \
         ucs_recursive_spin_lock(&(_timerq)->lock); /* Grab lock */ \
-        for (_timer = (_timerq)->timers; \
-             _timer != (_timerq)->timers + (_timerq)->num_timers; \
-             ++_timer) \
-        { \
-            if (__current_time >= (_timer)->expiration) { \
-                /* Update expiration time */ \
-                (_timer)->expiration = __current_time + (_timer)->interval; \
-                _code; \
+        if (__current_time >= (_timerq)->next_expiration) { \
+            /* A timer added by _code resets next_expiration */ \
+            (_timerq)->next_expiration = UCS_TIME_INFINITY; \
+            __next_expiration          = UCS_TIME_INFINITY; \
+            for (_timer = (_timerq)->timers; \
+                 _timer != (_timerq)->timers + (_timerq)->num_timers; \
+                 ++_timer) \
+            { \
+                if (__current_time >= (_timer)->expiration) { \
+                    /* Update expiration time */ \
+                    (_timer)->expiration = __current_time + \
+                                           (_timer)->interval; \
+                    __next_expiration    = ucs_min(__next_expiration, \
+                                                   (_timer)->expiration); \
+                    _code; \
+                } else { \
+                    __next_expiration    = ucs_min(__next_expiration, \
+                                                   (_timer)->expiration); \
+                } \
             } \
+            if (_timer != (_timerq)->timers + (_timerq)->num_timers) { \
+                /* Stopped early, the rest of the timers were not checked */ \
+                __next_expiration = 0; \
+            } \
+            (_timerq)->next_expiration = ucs_min((_timerq)->next_expiration, \
+                                                 __next_expiration); \
         } \
         ucs_recursive_spin_unlock(&(_timerq)->lock); /* Release lock  */ \
     }
@@ -1181,6 +1181,11 @@ struct uct_iface_attr {
                                                 achieve higher total bandwidth
                                                 compared to using only a single
                                                 endpoint. */
+    ucs_numa_node_t          numa_node;    /**< NUMA node which the memory
+                                                allocated by the interface, such
+                                                as receive buffers, is placed on,
+                                                or UCS_NUMA_NODE_UNDEFINED if its
+                                                placement is not controlled. */
 };
 
 
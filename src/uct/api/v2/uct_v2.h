@@ -1151,6 +1151,50 @@ ucs_status_t uct_ep_connect_to_ep_v2(uct_ep_h ep,
 int uct_ep_is_connected(uct_ep_h ep,
                         const uct_ep_is_connected_params_t *params);
 
+/**
+ * @ingroup UCT_AM
+ * @brief Short active message descriptor for @ref uct_ep_am_short_batch.
+ */
+typedef struct uct_am_short_batch_elem {
+    uint8_t    id;      /**< Active message id. Must be in range
+                             0..UCT_AM_ID_MAX-1. */
+    unsigned   length;  /**< Length of @a payload, the total message size
+                             including @a header is limited by
+                             @ref uct_iface_attr_cap_am_max_short
+                             "uct_iface_attr::cap::am::max_short". */
+    uint64_t   header;  /**< Message header. */
+    const void *payload; /**< Message payload. */
+} uct_am_short_batch_elem_t;
+
+
+/**
+ * @ingroup UCT_AM
+ * @brief Send a batch of short active messages.
+ *
+ * This routine sends the messages described by @a elems, in order, using the
+ * @ref uct_short_protocol_desc "short" protocol. Transports which support it
+ * reserve send resources for the whole batch at once, which avoids paying the
+ * per-message resource acquisition cost of @ref uct_ep_am_short. Other
+ * transports fall back to posting the messages one by one.
+ *
+ * The operation may send only a prefix of the batch if there are not enough
+ * send resources for all messages; the caller is expected to retry the
+ * remaining messages later.
+ *
+ * @param [in] ep     Destination endpoint handle.
+ * @param [in] elems  Array of messages to send.
+ * @param [in] count  Number of elements in @a elems.
+ * @param [in] flags  Active message flags, see @ref uct_msg_flags.
+ *
+ * @return Number of messages from the beginning of @a elems which were sent,
+ *         UCS_ERR_NO_RESOURCE if no message could be sent due to lack of send
+ *         resources, or other negative error code.
+ */
+ssize_t uct_ep_am_short_batch(uct_ep_h ep,
+                              const uct_am_short_batch_elem_t *elems,
+                              size_t count, unsigned flags);
+
+
 /**
  * @ingroup UCT_MD
  *
@@ -373,6 +373,19 @@ int uct_ep_is_connected(uct_ep_h ep, const uct_ep_is_connected_params_t *params)
     return iface->internal_ops->ep_is_connected(ep, params);
 }
 
+ssize_t uct_ep_am_short_batch(uct_ep_h ep,
+                              const uct_am_short_batch_elem_t *elems,
+                              size_t count, unsigned flags)
+{
+    const uct_base_iface_t *iface = ucs_derived_of(ep->iface, uct_base_iface_t);
+
+    if (iface->internal_ops->ep_am_short_batch == NULL) {
+        return uct_base_ep_am_short_batch(ep, elems, count, flags);
+    }
+
+    return iface->internal_ops->ep_am_short_batch(ep, elems, count, flags);
+}
+
 ucs_status_t uct_ep_check(const uct_ep_h ep, unsigned flags,
                           uct_completion_t *comp)
 {
@@ -504,6 +517,7 @@ void uct_base_iface_query(uct_base_iface_t *iface, uct_iface_attr_t *iface_attr)
 
     iface_attr->max_num_eps   = iface->config.max_num_eps;
     iface_attr->dev_num_paths = 1;
+    iface_attr->numa_node     = iface->config.numa_node;
 }
 
 ucs_status_t
@@ -636,6 +650,45 @@ UCS_CLASS_CLEANUP_FUNC(uct_iface_t)
 UCS_CLASS_DEFINE(uct_iface_t, void);
 
 
+static ucs_numa_node_t
+uct_base_iface_numa_node(const uct_iface_params_t *params,
+                         const uct_iface_config_t *config)
+{
+    ucs_sys_cpuset_t thread_cpuset;
+    ucs_cpu_set_t cpu_mask;
+    ucs_numa_node_t node;
+
+    if (config->numa_policy == UCS_NUMA_POLICY_DEFAULT) {
+        return UCS_NUMA_NODE_UNDEFINED;
+    }
+
+    if (config->numa_node != UCS_ULUNITS_AUTO) {
+        if (config->numa_node >= ucs_numa_num_configured_nodes()) {
+            ucs_warn("NUMA node %lu does not exist, memory placement is not "
+                     "changed", config->numa_node);
+            return UCS_NUMA_NODE_UNDEFINED;
+        }
+
+        return config->numa_node;
+    }
+
+    /* The interface is progressed on the CPUs the worker is bound to, or else
+     * by the thread which opens it */
+    if (params->field_mask & UCT_IFACE_PARAM_FIELD_CPU_MASK) {
+        node = ucs_numa_node_of_cpu_mask(&params->cpu_mask);
+        if (node != UCS_NUMA_NODE_UNDEFINED) {
+            return node;
+        }
+    }
+
+    if (ucs_sys_getaffinity(&thread_cpuset) != 0) {
+        return UCS_NUMA_NODE_UNDEFINED;
+    }
+
+    ucs_sys_cpuset_copy(&cpu_mask, &thread_cpuset);
+    return ucs_numa_node_of_cpu_mask(&cpu_mask);
+}
+
 UCS_CLASS_INIT_FUNC(uct_base_iface_t, uct_iface_ops_t *ops,
                     uct_iface_internal_ops_t *internal_ops, uct_md_h md,
                     uct_worker_h worker, const uct_iface_params_t *params,
@@ -695,6 +748,8 @@ UCS_CLASS_INIT_FUNC(uct_base_iface_t, uct_iface_ops_t *ops,
 
     self->config.failure_level = (ucs_log_level_t)config->failure;
     self->config.max_num_eps   = config->max_num_eps;
+    self->config.numa_policy   = config->numa_policy;
+    self->config.numa_node     = uct_base_iface_numa_node(params, config);
 
     return UCS_STATS_NODE_ALLOC(&self->stats, &uct_iface_stats_class,
                                 stats_parent, "-%s-%p", iface_name, self);
@@ -887,6 +942,22 @@ ucs_config_field_t uct_iface_config_table[] = {
    "Maximum number of endpoints that the transport interface is able to create",
    ucs_offsetof(uct_iface_config_t, max_num_eps), UCS_CONFIG_TYPE_ULUNITS},
 
+  {"NUMA_POLICY", "preferred",
+   "Placement of the memory allocated by the interface, such as receive FIFOs\n"
+   "and buffers, with respect to the NUMA node set by UCX_NUMA_NODE:\n"
+   " default   - use the memory policy of the process.\n"
+   " bind      - allocate the memory only on that node.\n"
+   " preferred - allocate the memory on that node, if possible.",
+   ucs_offsetof(uct_iface_config_t, numa_policy),
+   UCS_CONFIG_TYPE_ENUM(ucs_numa_policy_names)},
+
+  {"NUMA_NODE", "auto",
+   "NUMA node to place the memory allocated by the interface on. \"auto\" means\n"
+   "the node of the CPUs the interface is progressed on, according to the CPU\n"
+   "mask of the worker or the affinity of the thread which opens the interface.\n"
+   "If these CPUs span several nodes, the memory placement is not changed.",
+   ucs_offsetof(uct_iface_config_t, numa_node), UCS_CONFIG_TYPE_ULUNITS},
+
   {NULL}
 };
 
@@ -952,6 +1023,28 @@ ucs_status_t uct_base_ep_am_short_iov(uct_ep_h ep, uint8_t id, const uct_iov_t *
     return status;
 }
 
+ssize_t uct_base_ep_am_short_batch(uct_ep_h ep,
+                                   const uct_am_short_batch_elem_t *elems,
+                                   size_t count, unsigned flags)
+{
+    ucs_status_t status;
+    size_t i;
+
+    /* uct_ep_am_short() has no flags, so the peer is checked only by
+     * transports which implement the batch operation */
+    for (i = 0; i < count; ++i) {
+        status = uct_ep_am_short(ep, elems[i].id, elems[i].header,
+                                 elems[i].payload, elems[i].length);
+        if (status != UCS_OK) {
+            /* Report the partial batch, the error (if persistent) would be
+             * returned by the next call */
+            return (i > 0) ? i : status;
+        }
+    }
+
+    return count;
+}
+
 static void uct_iface_schedule_ep_err(uct_ep_h ep)
 {
     uct_base_iface_t *iface = ucs_derived_of(ep->iface, uct_base_iface_t);
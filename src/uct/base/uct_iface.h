@@ -19,6 +19,7 @@
 #include <ucs/datastruct/queue.h>
 #include <ucs/debug/log.h>
 #include <ucs/debug/debug_int.h>
+#include <ucs/memory/numa.h>
 #include <ucs/stats/stats.h>
 #include <ucs/sys/compiler.h>
 #include <ucs/sys/uid.h>
@@ -301,6 +302,12 @@ typedef int (*uct_ep_is_connected_func_t)(
         uct_ep_h ep, const uct_ep_is_connected_params_t *params);
 
 
+/* Send a batch of short active messages */
+typedef ssize_t (*uct_ep_am_short_batch_func_t)(
+        uct_ep_h ep, const uct_am_short_batch_elem_t *elems, size_t count,
+        unsigned flags);
+
+
 /* Internal operations, not exposed by the external API */
 typedef struct uct_iface_internal_ops {
     uct_iface_estimate_perf_func_t   iface_estimate_perf;
@@ -310,6 +317,8 @@ typedef struct uct_iface_internal_ops {
     uct_ep_connect_to_ep_v2_func_t   ep_connect_to_ep_v2;
     uct_iface_is_reachable_v2_func_t iface_is_reachable_v2;
     uct_ep_is_connected_func_t       ep_is_connected;
+    uct_ep_am_short_batch_func_t     ep_am_short_batch; /* Optional, NULL to
+                                                           post one by one */
 } uct_iface_internal_ops_t;
 
 
@@ -337,6 +346,9 @@ typedef struct uct_base_iface {
         uct_alloc_method_t   alloc_methods[UCT_ALLOC_METHOD_LAST];
         ucs_log_level_t      failure_level;
         size_t               max_num_eps;
+        ucs_numa_policy_t    numa_policy;   /* Placement of allocated memory */
+        ucs_numa_node_t      numa_node;     /* Node to place allocated memory on,
+                                               or UCS_NUMA_NODE_UNDEFINED */
     } config;
 
     UCS_STATS_NODE_DECLARE(stats)            /* Statistics */
@@ -543,6 +555,8 @@ struct uct_iface_config {
 
     int               failure;   /* Level of failure reports */
     size_t            max_num_eps;
+    ucs_numa_policy_t numa_policy; /* Placement of allocated memory */
+    unsigned long     numa_node;   /* NUMA node to place allocated memory on */
 };
 
 
@@ -1020,6 +1034,10 @@ ucs_log_level_t uct_base_iface_failure_log_level(uct_base_iface_t *iface,
 ucs_status_t uct_base_ep_am_short_iov(uct_ep_h ep, uint8_t id, const uct_iov_t *iov,
                                       size_t iovcnt);
 
+ssize_t uct_base_ep_am_short_batch(uct_ep_h ep,
+                                   const uct_am_short_batch_elem_t *elems,
+                                   size_t count, unsigned flags);
+
 int uct_ep_get_process_proc_dir(char *buffer, size_t max_len, pid_t pid);
 
 ucs_status_t uct_ep_keepalive_init(uct_keepalive_info_t *ka, pid_t pid);
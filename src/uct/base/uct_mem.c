@@ -419,6 +419,14 @@ ucs_status_t uct_iface_mem_alloc(uct_iface_h tl_iface, size_t length, unsigned f
         goto err;
     }
 
+    /* Place the memory near the thread which progresses the interface, before
+     * it is touched by the registration */
+    if (iface->config.numa_node != UCS_NUMA_NODE_UNDEFINED) {
+        (void)ucs_numa_mem_bind(mem->address, mem->length,
+                                iface->config.numa_policy,
+                                iface->config.numa_node);
+    }
+
     /* If the memory was not allocated using MD, register it if needed */
     if (mem->method != UCT_ALLOC_METHOD_MD) {
         if (need_mem_reg && support_mem_reg) {
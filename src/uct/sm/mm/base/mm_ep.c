@@ -21,7 +21,8 @@
 typedef enum {
     UCT_MM_SEND_AM_BCOPY,
     UCT_MM_SEND_AM_SHORT,
-    UCT_MM_SEND_AM_SHORT_IOV
+    UCT_MM_SEND_AM_SHORT_IOV,
+    UCT_MM_SEND_AM_ZCOPY
 } uct_mm_send_op_t;
 
 
@@ -159,6 +160,10 @@ void uct_mm_ep_cleanup_remote_segs(uct_mm_ep_t *ep)
     kh_destroy_inplace(uct_mm_remote_seg, &ep->remote_segs);
 }
 
+/* Offset of the FIFO lane of the next endpoint created by this process */
+static volatile uint32_t uct_mm_ep_lane_counter = 0;
+
+
 static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
 {
     uct_mm_iface_t            *iface = ucs_derived_of(params->iface, uct_mm_iface_t);
@@ -170,6 +175,14 @@ static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
     UCT_EP_PARAMS_CHECK_DEV_IFACE_ADDRS(params);
     UCS_CLASS_CALL_SUPER_INIT(uct_base_ep_t, &iface->super.super);
 
+    /* The layout of the remote FIFO depends on its number of lanes */
+    if (addr->fifo_lanes != iface->config.fifo_lanes) {
+        ucs_error("mm ep cannot connect to remote FIFO id 0x%"PRIx64" with %u "
+                  "lanes, local FIFO has %u lanes", addr->fifo_seg_id,
+                  addr->fifo_lanes, iface->config.fifo_lanes);
+        return UCS_ERR_UNREACHABLE;
+    }
+
     kh_init_inplace(uct_mm_remote_seg, &self->remote_segs);
     ucs_arbiter_group_init(&self->arb_group);
 
@@ -195,10 +208,18 @@ static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
         goto err_free_md_addr;
     }
 
-    /* Initialize remote FIFO control structure */
-    uct_mm_iface_set_fifo_ptrs(fifo_ptr, &self->fifo_ctl, &self->fifo_elems);
+    /* Initialize remote FIFO control structure. Senders are spread across the
+     * remote FIFO lanes according to their process id, and the endpoints of
+     * the same process take the next lanes */
+    uct_mm_iface_set_fifo_ptrs(iface, fifo_ptr,
+                               (getpid() +
+                                ucs_atomic_fadd32(&uct_mm_ep_lane_counter, 1)) %
+                               addr->fifo_lanes,
+                               &self->fifo_ctl, &self->fifo_elems);
     self->cached_tail = self->fifo_ctl->tail;
     ucs_arbiter_elem_init(&self->arb_elem);
+    ucs_queue_head_init(&self->zcopy_ops);
+    self->zcopy_last_sn     = 0;
 
     status = uct_ep_keepalive_init(&self->keepalive, self->fifo_ctl->pid);
     if (status != UCS_OK) {
@@ -220,6 +241,10 @@ err:
 
 static UCS_CLASS_CLEANUP_FUNC(uct_mm_ep_t)
 {
+    uct_mm_iface_t *iface = ucs_derived_of(self->super.super.iface,
+                                           uct_mm_iface_t);
+
+    uct_mm_iface_zcopy_ops_purge(iface, self, UCS_ERR_CANCELED);
     uct_mm_ep_pending_purge(&self->super.super, NULL, NULL);
     uct_mm_ep_cleanup_remote_segs(self);
     ucs_free(self->remote_iface_addr);
@@ -366,6 +391,24 @@ retry:
                               head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED);
         UCT_TL_EP_STAT_OP(&ep->super, AM, SHORT, elem->length);
         break;
+    case UCT_MM_SEND_AM_ZCOPY:
+        /* write the sender buffer descriptor and the local mapper address,
+         * the receiver reads the data directly from the sender memory */
+        memcpy(elem + 1, payload, sizeof(uct_mm_zcopy_desc_t));
+        memcpy(UCS_PTR_BYTE_OFFSET(elem + 1, sizeof(uct_mm_zcopy_desc_t)),
+               iface->local_iface_addr,
+               ucs_derived_of(iface->super.super.md, uct_mm_md_t)->iface_addr_len);
+
+        elem_flags   = UCT_MM_FIFO_ELEM_FLAG_ZCOPY;
+        elem->length = length;
+
+        uct_mm_iface_trace_am(iface, UCT_AM_TRACE_TYPE_SEND, elem_flags, am_id,
+                              (void*)(uintptr_t)header, length,
+                              head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED);
+        UCT_TL_EP_STAT_OP(&ep->super, AM, ZCOPY, length);
+
+        ep->zcopy_last_sn = head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
+        break;
     }
 
     elem->am_id = am_id;
@@ -390,6 +433,7 @@ retry:
     switch (send_op) {
     case UCT_MM_SEND_AM_SHORT:
     case UCT_MM_SEND_AM_SHORT_IOV:
+    case UCT_MM_SEND_AM_ZCOPY:
         return UCS_OK;
     case UCT_MM_SEND_AM_BCOPY:
         return length;
@@ -440,6 +484,179 @@ ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_
                                     NULL, pack_cb, arg, NULL, 0, flags);
 }
 
+/* Complete the operation when the receiver consumes the last zcopy send */
+static UCS_F_ALWAYS_INLINE void
+uct_mm_ep_zcopy_op_push(uct_mm_ep_t *ep, uct_mm_iface_t *iface,
+                        uct_mm_zcopy_op_t *op)
+{
+    op->ep = ep;
+    op->sn = ep->zcopy_last_sn;
+    if (ucs_queue_is_empty(&ep->zcopy_ops)) {
+        ucs_list_add_tail(&iface->zcopy_eps, &ep->zcopy_list);
+    }
+    ucs_queue_push(&ep->zcopy_ops, &op->queue);
+}
+
+ucs_status_t uct_mm_ep_am_zcopy(uct_ep_h tl_ep, uint8_t id, const void *header,
+                                unsigned header_length, const uct_iov_t *iov,
+                                size_t iovcnt, unsigned flags,
+                                uct_completion_t *comp)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_mm_iface_t);
+    uct_mm_ep_t *ep       = ucs_derived_of(tl_ep, uct_mm_ep_t);
+    uct_mm_seg_t *seg     = iov->memh;
+    uct_mm_zcopy_desc_t zdesc;
+    uct_mm_zcopy_op_t *op;
+    ucs_status_t status;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, 1ul, "uct_mm_ep_am_zcopy");
+    UCT_CHECK_LENGTH(header_length, 0, 0, "am_zcopy header");
+
+    if ((seg == UCT_MEM_HANDLE_NULL) || (iov->count != 1) ||
+        (iov->buffer < seg->address) ||
+        (UCS_PTR_BYTE_OFFSET(iov->buffer, iov->length) >
+         UCS_PTR_BYTE_OFFSET(seg->address, seg->length))) {
+        ucs_debug("mm_ep %p: zcopy buffer %p must be allocated by the mm md",
+                  ep, iov->buffer);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    op = ucs_mpool_get_inline(&iface->zcopy_op_mp);
+    if (ucs_unlikely(op == NULL)) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    zdesc.seg_id   = seg->seg_id;
+    zdesc.seg_size = seg->length;
+    zdesc.offset   = UCS_PTR_BYTE_DIFF(seg->address, iov->buffer);
+    zdesc.length   = iov->length;
+
+    status = (ucs_status_t)uct_mm_ep_am_common_send(UCT_MM_SEND_AM_ZCOPY, ep,
+                                                    iface, id, iov->length,
+                                                    (uintptr_t)iov->buffer,
+                                                    &zdesc, NULL, NULL, NULL,
+                                                    0, flags);
+    if (status != UCS_OK) {
+        ucs_mpool_put_inline(op);
+        return status;
+    }
+
+    op->comp = comp;
+    uct_mm_ep_zcopy_op_push(ep, iface, op);
+    return UCS_INPROGRESS;
+}
+
+/* Number of FIFO elements which can be written starting from 'head',
+ * according to the cached tail */
+static UCS_F_ALWAYS_INLINE unsigned
+uct_mm_ep_fifo_num_free(uct_mm_ep_t *ep, uct_mm_iface_t *iface, uint64_t head)
+{
+    uint64_t num_used = (head - ep->cached_tail) &
+                        ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
+
+    if (ucs_unlikely(num_used >= iface->config.fifo_size)) {
+        return 0;
+    }
+
+    return iface->config.fifo_size - num_used;
+}
+
+ssize_t uct_mm_ep_am_short_batch(uct_ep_h tl_ep,
+                                 const uct_am_short_batch_elem_t *elems,
+                                 size_t count, unsigned flags)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_mm_iface_t);
+    uct_mm_ep_t *ep       = ucs_derived_of(tl_ep, uct_mm_ep_t);
+    uct_mm_fifo_element_t *elem;
+    uint64_t head, head_sn, prev_head, elem_sn;
+    unsigned num_free;
+    size_t i, num_elems;
+    uint8_t elem_flags;
+
+    for (i = 0; i < count; ++i) {
+        UCT_CHECK_AM_ID(elems[i].id);
+        UCT_CHECK_LENGTH(elems[i].length + sizeof(elems[i].header), 0,
+                         iface->config.fifo_elem_size -
+                                 sizeof(uct_mm_fifo_element_t),
+                         "am_short_batch");
+    }
+
+    if (ucs_unlikely(count == 0)) {
+        return 0;
+    }
+
+retry:
+    head     = ep->fifo_ctl->head;
+    num_free = uct_mm_ep_fifo_num_free(ep, iface, head);
+    if (num_free < count) {
+        if (ucs_arbiter_group_is_empty(&ep->arb_group)) {
+            /* pending is empty, refresh the local copy of the remote tail */
+            uct_mm_ep_update_cached_tail(ep);
+            num_free = uct_mm_ep_fifo_num_free(ep, iface, head);
+            if (num_free == 0) {
+                ucs_arbiter_group_push_head_elem_always(&ep->arb_group,
+                                                        &ep->arb_elem);
+                ucs_arbiter_group_schedule_nonempty(&iface->arbiter,
+                                                    &ep->arb_group);
+                return uct_mm_ep_no_resources_handle(ep, flags);
+            }
+        } else if (num_free == 0) {
+            /* pending isn't empty. don't send now to prevent out-of-order
+             * sending */
+            return uct_mm_ep_no_resources_handle(ep, flags);
+        }
+    }
+
+    /* reserve all the elements we are going to write with a single update of
+     * the remote head */
+    num_elems = ucs_min(count, num_free);
+    head_sn   = head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
+    prev_head = ucs_atomic_cswap64(ucs_unaligned_ptr(&ep->fifo_ctl->head), head,
+                                   head_sn + num_elems);
+    if (prev_head != head) {
+        ucs_trace_poll("couldn't reserve %zu FIFO elements. retrying",
+                       num_elems);
+        goto retry;
+    }
+
+    for (i = 0, elem_sn = head_sn; i < num_elems; ++i, ++elem_sn) {
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo_elems,
+                                          elem_sn & iface->fifo_mask);
+        uct_am_short_fill_data(elem + 1, elems[i].header, elems[i].payload,
+                               elems[i].length, UCS_ARCH_MEMCPY_NT_DEST);
+        elem->length = elems[i].length + sizeof(elems[i].header);
+        elem->am_id  = elems[i].id;
+
+        uct_mm_iface_trace_am(iface, UCT_AM_TRACE_TYPE_SEND,
+                              UCT_MM_FIFO_ELEM_FLAG_INLINE, elems[i].id,
+                              elem + 1, elem->length, elem_sn);
+        UCT_TL_EP_STAT_OP(&ep->super, AM, SHORT, elem->length);
+    }
+
+    /* a single memory barrier for the whole batch - make sure all elements are
+     * written before any of them is marked as complete */
+    ucs_memory_cpu_store_fence();
+
+    /* publish the elements in FIFO order, since the reader stops at the first
+     * element which does not have the expected owner bit */
+    for (i = 0, elem_sn = head_sn; i < num_elems; ++i, ++elem_sn) {
+        elem       = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo_elems,
+                                                elem_sn & iface->fifo_mask);
+        elem_flags = UCT_MM_FIFO_ELEM_FLAG_INLINE;
+        if (elem_sn & iface->config.fifo_size) {
+            elem_flags |= UCT_MM_FIFO_ELEM_FLAG_OWNER;
+        }
+        elem->flags = elem_flags;
+    }
+
+    if (ucs_unlikely(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) {
+        uct_mm_ep_signal_remote(ep);
+    }
+
+    uct_mm_ep_peer_check(ep, flags);
+    return num_elems;
+}
+
 static inline int uct_mm_ep_has_tx_resources(uct_mm_ep_t *ep)
 {
     uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface, uct_mm_iface_t);
@@ -552,7 +769,9 @@ void uct_mm_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
 ucs_status_t uct_mm_ep_flush(uct_ep_h tl_ep, unsigned flags,
                              uct_completion_t *comp)
 {
-    uct_mm_ep_t *ep = ucs_derived_of(tl_ep, uct_mm_ep_t);
+    uct_mm_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_mm_iface_t);
+    uct_mm_ep_t *ep       = ucs_derived_of(tl_ep, uct_mm_ep_t);
+    uct_mm_zcopy_op_t *op;
 
     if (!uct_mm_ep_has_tx_resources(ep)) {
         if (!ucs_arbiter_group_is_empty(&ep->arb_group)) {
@@ -566,6 +785,23 @@ ucs_status_t uct_mm_ep_flush(uct_ep_h tl_ep, unsigned flags,
     }
 
     ucs_memory_cpu_store_fence();
+
+    if (!ucs_queue_is_empty(&ep->zcopy_ops)) {
+        /* zero-copy sends are complete only after the receiver reads them */
+        if (comp != NULL) {
+            op = ucs_mpool_get_inline(&iface->zcopy_op_mp);
+            if (op == NULL) {
+                return UCS_ERR_NO_MEMORY;
+            }
+
+            op->comp = comp;
+            uct_mm_ep_zcopy_op_push(ep, iface, op);
+        }
+
+        UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
+        return UCS_INPROGRESS;
+    }
+
     UCT_TL_EP_STAT_FLUSH(&ep->super);
     return UCS_OK;
 }
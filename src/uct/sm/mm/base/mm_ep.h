@@ -14,10 +14,6 @@
 #include <uct/sm/base/sm_ep.h>
 
 
-KHASH_INIT(uct_mm_remote_seg, uintptr_t, uct_mm_remote_seg_t, 1,
-           kh_int64_hash_func, kh_int64_hash_equal)
-
-
 /**
  * MM transport endpoint
  */
@@ -49,6 +45,14 @@ typedef struct uct_mm_ep {
     ucs_arbiter_elem_t         arb_elem;
 
     uct_keepalive_info_t       keepalive; /* keepalive info */
+
+    /* zero-copy sends which were not consumed by the receiver yet, in send
+     * order, and the FIFO sequence number of the last one */
+    ucs_queue_head_t           zcopy_ops;
+    uint64_t                   zcopy_last_sn;
+
+    /* entry in iface->zcopy_eps, if zcopy_ops is not empty */
+    ucs_list_link_t            zcopy_list;
 } uct_mm_ep_t;
 
 
@@ -64,6 +68,15 @@ ucs_status_t uct_mm_ep_am_short_iov(uct_ep_h tl_ep, uint8_t id,
 ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_cb,
                            void *arg, unsigned flags);
 
+ucs_status_t uct_mm_ep_am_zcopy(uct_ep_h tl_ep, uint8_t id, const void *header,
+                                unsigned header_length, const uct_iov_t *iov,
+                                size_t iovcnt, unsigned flags,
+                                uct_completion_t *comp);
+
+ssize_t uct_mm_ep_am_short_batch(uct_ep_h tl_ep,
+                                 const uct_am_short_batch_elem_t *elems,
+                                 size_t count, unsigned flags);
+
 ucs_status_t uct_mm_ep_flush(uct_ep_h tl_ep, unsigned flags,
                              uct_completion_t *comp);
 
@@ -18,6 +18,8 @@
 #include <ucs/arch/bitops.h>
 #include <ucs/async/async.h>
 #include <ucs/sys/string.h>
+#include <ucs/vfs/base/vfs_cb.h>
+#include <ucs/vfs/base/vfs_obj.h>
 #include <sys/poll.h>
 
 
@@ -60,6 +62,23 @@ ucs_config_field_t uct_mm_iface_config_table[] = {
      "Size of the FIFO element size (data + header) in the MM UCTs.",
      ucs_offsetof(uct_mm_iface_config_t, fifo_elem_size), UCS_CONFIG_TYPE_UINT},
 
+    {"FIFO_LANES", "1",
+     "Number of receive FIFO lanes in the memory-map UCTs. Senders are spread\n"
+     "across the lanes according to their process id, and the receiver polls\n"
+     "the lanes in a round-robin order with a separate polling window per lane,\n"
+     "so a few heavy senders cannot starve the others. Processes which use a\n"
+     "different number of lanes cannot reach each other over this transport.",
+     ucs_offsetof(uct_mm_iface_config_t, fifo_lanes), UCS_CONFIG_TYPE_UINT},
+
+    {"AM_ZCOPY", "n",
+     "Enable zero-copy active messages. The sender passes a descriptor of a\n"
+     "buffer allocated by the memory domain, and the receiver attaches to it\n"
+     "and reads the payload in place. The send completes after the receiver\n"
+     "has consumed the message. The sender segments stay attached to the\n"
+     "receiver, so it pays off for buffers which are reused. When enabled,\n"
+     "active messages are limited to a single iov, including short ones.",
+     ucs_offsetof(uct_mm_iface_config_t, am_zcopy), UCS_CONFIG_TYPE_BOOL},
+
     {"FIFO_MAX_POLL", UCS_PP_MAKE_STRING(UCT_MM_IFACE_FIFO_MAX_POLL),
      "Maximal number of receive completions to pick during RX poll",
      ucs_offsetof(uct_mm_iface_config_t, fifo_max_poll), UCS_CONFIG_TYPE_ULUNITS},
@@ -100,6 +119,7 @@ static ucs_status_t uct_mm_iface_get_address(uct_iface_t *tl_iface,
     uct_mm_seg_t        *seg        = iface->recv_fifo_mem.memh;
 
     iface_addr->fifo_seg_id = seg->seg_id;
+    iface_addr->fifo_lanes  = iface->config.fifo_lanes;
     return uct_mm_md_mapper_ops(md)->iface_addr_pack(md, iface_addr + 1);
 }
 
@@ -143,6 +163,14 @@ uct_mm_iface_is_reachable_v2(const uct_iface_h tl_iface,
         return 0;
     }
 
+    if (iface_addr->fifo_lanes != iface->config.fifo_lanes) {
+        uct_iface_fill_info_str_buf(params,
+                                    "remote FIFO lanes %u, local FIFO lanes %u",
+                                    iface_addr->fifo_lanes,
+                                    iface->config.fifo_lanes);
+        return 0;
+    }
+
     return uct_sm_iface_is_reachable(tl_iface, params) &&
            uct_mm_md_mapper_ops(md)->is_reachable(md, iface_addr->fifo_seg_id,
                                                   iface_addr + 1) &&
@@ -157,14 +185,123 @@ void uct_mm_iface_release_desc(uct_recv_desc_t *self, void *desc)
     ucs_mpool_put(mm_desc);
 }
 
+static ucs_mpool_ops_t uct_mm_zcopy_op_mpool_ops = {
+    .chunk_alloc   = ucs_mpool_chunk_malloc,
+    .chunk_release = ucs_mpool_chunk_free,
+    .obj_init      = NULL,
+    .obj_cleanup   = NULL,
+    .obj_str       = NULL
+};
+
+static UCS_F_ALWAYS_INLINE void
+uct_mm_iface_zcopy_op_complete(uct_mm_zcopy_op_t *op, ucs_status_t status)
+{
+    uct_invoke_completion(op->comp, status);
+    ucs_mpool_put_inline(op);
+}
+
+/* Status of a zcopy send whose FIFO element was consumed by the receiver */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_mm_iface_zcopy_op_status(uct_mm_zcopy_op_t *op)
+{
+    uct_mm_fifo_ctl_t *fifo_ctl = op->ep->fifo_ctl;
+
+    if (ucs_likely(fifo_ctl->zcopy_error_sn != (op->sn + 1))) {
+        return UCS_OK;
+    }
+
+    /* let the receiver report the next failure on this lane */
+    fifo_ctl->zcopy_error_sn = 0;
+    ucs_debug("mm_ep %p: zcopy send sn %" PRIu64 " was not delivered", op->ep,
+              op->sn);
+    return UCS_ERR_IO_ERROR;
+}
+
+static unsigned uct_mm_ep_progress_zcopy(uct_mm_ep_t *ep)
+{
+    uint64_t tail  = ep->fifo_ctl->tail;
+    unsigned count = 0;
+    uct_mm_zcopy_op_t *op;
+
+    /* the error slot is written by the receiver before it releases the tail */
+    ucs_memory_cpu_load_fence();
+
+    /* the remote tail passes the FIFO element after the receiver is done with
+     * the sender buffer. complete in send order, so flush completions which
+     * follow zcopy sends are not reported before them */
+    ucs_queue_for_each_extract(op, &ep->zcopy_ops, queue, tail > op->sn) {
+        uct_mm_iface_zcopy_op_complete(op, uct_mm_iface_zcopy_op_status(op));
+        ++count;
+    }
+
+    return count;
+}
+
+static unsigned uct_mm_iface_progress_zcopy(uct_mm_iface_t *iface)
+{
+    unsigned count = 0;
+    uct_mm_ep_t *ep, *tmp;
+
+    /* every endpoint completes its own sends, so a peer which is slow to
+     * consume its FIFO does not delay the completions of other peers */
+    ucs_list_for_each_safe(ep, tmp, &iface->zcopy_eps, zcopy_list) {
+        count += uct_mm_ep_progress_zcopy(ep);
+        if (ucs_queue_is_empty(&ep->zcopy_ops)) {
+            ucs_list_del(&ep->zcopy_list);
+        }
+    }
+
+    return count;
+}
+
+void uct_mm_iface_zcopy_ops_purge(uct_mm_iface_t *iface, uct_mm_ep_t *ep,
+                                  ucs_status_t status)
+{
+    uct_mm_zcopy_op_t *op;
+
+    if (ucs_queue_is_empty(&ep->zcopy_ops)) {
+        return;
+    }
+
+    ucs_queue_for_each_extract(op, &ep->zcopy_ops, queue, 1) {
+        /* do not block the error slot of the lane */
+        if (ep->fifo_ctl->zcopy_error_sn == (op->sn + 1)) {
+            ep->fifo_ctl->zcopy_error_sn = 0;
+        }
+        uct_mm_iface_zcopy_op_complete(op, status);
+    }
+
+    ucs_list_del(&ep->zcopy_list);
+}
+
+static void uct_mm_iface_zcopy_segs_detach(uct_mm_iface_t *iface)
+{
+    uct_mm_remote_seg_t remote_seg;
+
+    kh_foreach_value(&iface->zcopy_segs, remote_seg, {
+        uct_mm_iface_mapper_call(iface, mem_detach, &remote_seg);
+    })
+
+    kh_clear(uct_mm_remote_seg, &iface->zcopy_segs);
+}
+
 ucs_status_t uct_mm_iface_flush(uct_iface_h tl_iface, unsigned flags,
                                 uct_completion_t *comp)
 {
+    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
+
     if (comp != NULL) {
         return UCS_ERR_UNSUPPORTED;
     }
 
     ucs_memory_cpu_store_fence();
+
+    if (!ucs_list_is_empty(&iface->zcopy_eps)) {
+        UCT_TL_IFACE_STAT_FLUSH_WAIT(ucs_derived_of(tl_iface,
+                                                    uct_base_iface_t));
+        return UCS_INPROGRESS;
+    }
+
     UCT_TL_IFACE_STAT_FLUSH(ucs_derived_of(tl_iface, uct_base_iface_t));
     return UCS_OK;
 }
@@ -204,6 +341,15 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
     iface_attr->cap.am.align_mtu        = iface_attr->cap.am.opt_zcopy_align;
     iface_attr->cap.am.max_iov          = SIZE_MAX;
 
+    if (iface->config.extra_cap_flags & UCT_IFACE_FLAG_AM_ZCOPY) {
+        /* the payload is read from a single sender buffer in place, without
+         * a header. max_iov is shared with am_short_iov, which is limited to
+         * one iov as well in this mode */
+        iface_attr->cap.am.max_zcopy    = SIZE_MAX;
+        iface_attr->cap.am.max_hdr      = 0;
+        iface_attr->cap.am.max_iov      = 1;
+    }
+
     iface_attr->iface_addr_len          = sizeof(uct_mm_iface_addr_t) +
                                           md->iface_addr_len;
     iface_attr->device_addr_len         = uct_sm_iface_get_device_addr_len();
@@ -262,10 +408,12 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
 }
 
 static UCS_F_ALWAYS_INLINE void
-uct_mm_progress_fifo_tail(uct_mm_iface_t *iface)
+uct_mm_progress_fifo_tail(uct_mm_iface_t *iface, uct_mm_fifo_lane_t *lane,
+                          int force)
 {
-    /* don't progress the tail every time - release in batches. improves performance */
-    if (iface->read_index & iface->fifo_release_factor_mask) {
+    /* don't progress the tail every time - release in batches. improves
+     * performance. zero-copy senders wait for the tail, so release it now */
+    if (!force && (lane->read_index & iface->fifo_release_factor_mask)) {
         return;
     }
 
@@ -273,7 +421,7 @@ uct_mm_progress_fifo_tail(uct_mm_iface_t *iface)
      * FIFO tail */
     ucs_memory_cpu_store_fence();
 
-    iface->recv_fifo_ctl->tail = iface->read_index;
+    lane->fifo_ctl->tail = lane->read_index;
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
@@ -295,9 +443,86 @@ uct_mm_assign_desc_to_fifo_elem(uct_mm_iface_t *iface,
     return UCS_OK;
 }
 
-static UCS_F_ALWAYS_INLINE void uct_mm_iface_process_recv(uct_mm_iface_t *iface)
+/* Get the local address of an attached sender segment, attach it if needed */
+static ucs_status_t
+uct_mm_iface_zcopy_seg_get(uct_mm_iface_t *iface,
+                           const uct_mm_zcopy_desc_t *zdesc, void **address_p)
 {
-    uct_mm_fifo_element_t *elem = iface->read_index_elem;
+    uct_mm_remote_seg_t *remote_seg;
+    ucs_status_t status;
+    khiter_t khiter;
+    int khret;
+
+    khiter = kh_get(uct_mm_remote_seg, &iface->zcopy_segs, zdesc->seg_id);
+    if (ucs_likely(khiter != kh_end(&iface->zcopy_segs))) {
+        *address_p = kh_val(&iface->zcopy_segs, khiter).address;
+        return UCS_OK;
+    }
+
+    /* sender segments which were released are not detached until the cache
+     * is full, so keep it bounded */
+    if (kh_size(&iface->zcopy_segs) >= UCT_MM_IFACE_ZCOPY_MAX_SEGS) {
+        uct_mm_iface_zcopy_segs_detach(iface);
+    }
+
+    khiter = kh_put(uct_mm_remote_seg, &iface->zcopy_segs, zdesc->seg_id,
+                    &khret);
+    if (khret == UCS_KH_PUT_FAILED) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    remote_seg = &kh_val(&iface->zcopy_segs, khiter);
+    status     = uct_mm_iface_mapper_call(iface, mem_attach, zdesc->seg_id,
+                                          zdesc->seg_size, zdesc + 1,
+                                          remote_seg);
+    if (status != UCS_OK) {
+        kh_del(uct_mm_remote_seg, &iface->zcopy_segs, khiter);
+        return status;
+    }
+
+    *address_p = remote_seg->address;
+    return UCS_OK;
+}
+
+static UCS_F_NOINLINE ucs_status_t
+uct_mm_iface_process_recv_zcopy(uct_mm_iface_t *iface,
+                                uct_mm_fifo_lane_t *lane)
+{
+    uct_mm_fifo_element_t *elem = lane->read_index_elem;
+    uct_mm_zcopy_desc_t *zdesc  = (uct_mm_zcopy_desc_t*)(elem + 1);
+    ucs_status_t status;
+    void *address, *data;
+
+    status = uct_mm_iface_zcopy_seg_get(iface, zdesc, &address);
+    if (ucs_unlikely(status != UCS_OK)) {
+        if (lane->fifo_ctl->zcopy_error_sn != 0) {
+            /* the sender of the previous failed element did not see the
+             * error yet, retry the element later */
+            return UCS_ERR_NO_RESOURCE;
+        }
+
+        ucs_diag("mm_iface %p: failed to attach zcopy segment id 0x%" PRIx64
+                 ": %s", iface, zdesc->seg_id, ucs_status_string(status));
+        /* reported to the sender when the tail passes the element */
+        lane->fifo_ctl->zcopy_error_sn = lane->read_index + 1;
+        return UCS_OK;
+    }
+
+    data = UCS_PTR_BYTE_OFFSET(address, zdesc->offset);
+    uct_mm_iface_trace_am(iface, UCT_AM_TRACE_TYPE_RECV, elem->flags,
+                          elem->am_id, data, zdesc->length, lane->read_index);
+
+    /* the sender buffer is released when the callback returns */
+    status = uct_iface_invoke_am(&iface->super.super, elem->am_id, data,
+                                 zdesc->length, 0);
+    ucs_assert(status == UCS_OK);
+    return UCS_OK;
+}
+
+static UCS_F_ALWAYS_INLINE void
+uct_mm_iface_process_recv(uct_mm_iface_t *iface, uct_mm_fifo_lane_t *lane)
+{
+    uct_mm_fifo_element_t *elem = lane->read_index_elem;
     ucs_status_t status;
     void *data;
 
@@ -305,7 +530,7 @@ static UCS_F_ALWAYS_INLINE void uct_mm_iface_process_recv(uct_mm_iface_t *iface)
         /* read short (inline) messages from the FIFO elements */
         uct_mm_iface_trace_am(iface, UCT_AM_TRACE_TYPE_RECV, elem->flags,
                               elem->am_id, elem + 1, elem->length,
-                              iface->read_index);
+                              lane->read_index);
         uct_mm_iface_invoke_am(iface, elem->am_id, elem + 1, elem->length, 0);
         return;
     }
@@ -320,7 +545,7 @@ static UCS_F_ALWAYS_INLINE void uct_mm_iface_process_recv(uct_mm_iface_t *iface)
     data = elem->desc_data;
     VALGRIND_MAKE_MEM_DEFINED(data, elem->length);
     uct_mm_iface_trace_am(iface, UCT_AM_TRACE_TYPE_RECV, elem->flags,
-                          elem->am_id, data, elem->length, iface->read_index);
+                          elem->am_id, data, elem->length, lane->read_index);
 
     status = uct_mm_iface_invoke_am(iface, elem->am_id, data, elem->length,
                                     UCT_CB_PARAM_FLAG_DESC);
@@ -334,86 +559,121 @@ static UCS_F_ALWAYS_INLINE void uct_mm_iface_process_recv(uct_mm_iface_t *iface)
 }
 
 static UCS_F_ALWAYS_INLINE int
-uct_mm_iface_fifo_has_new_data(uct_mm_iface_t *iface)
+uct_mm_iface_fifo_has_new_data(uct_mm_iface_t *iface, uct_mm_fifo_lane_t *lane)
 {
     /* check the read_index to see if there is a new item to read
      * (checking the owner bit) */
-    return (((iface->read_index >> iface->fifo_shift) & 1) ==
-            (iface->read_index_elem->flags & 1));
+    return (((lane->read_index >> iface->fifo_shift) & 1) ==
+            (lane->read_index_elem->flags & 1));
 }
 
 static UCS_F_ALWAYS_INLINE unsigned
-uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
+uct_mm_iface_poll_fifo(uct_mm_iface_t *iface, uct_mm_fifo_lane_t *lane)
 {
-    if (!uct_mm_iface_fifo_has_new_data(iface)) {
+    int is_zcopy;
+
+    if (!uct_mm_iface_fifo_has_new_data(iface, lane)) {
         return 0;
     }
 
     /* read from read_index_elem */
     ucs_memory_cpu_load_fence();
-    ucs_assert(iface->read_index <=
-               (iface->recv_fifo_ctl->head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
+    ucs_assert(lane->read_index <=
+               (lane->fifo_ctl->head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
 
-    uct_mm_iface_process_recv(iface);
+    is_zcopy = lane->read_index_elem->flags & UCT_MM_FIFO_ELEM_FLAG_ZCOPY;
+    if (ucs_unlikely(is_zcopy)) {
+        if (uct_mm_iface_process_recv_zcopy(iface, lane) != UCS_OK) {
+            return 0;
+        }
+    } else {
+        uct_mm_iface_process_recv(iface, lane);
+    }
 
     /* raise the read_index */
-    iface->read_index++;
+    lane->read_index++;
 
     /* the next fifo_element which the read_index points to */
-    iface->read_index_elem =
-        UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elems,
-                                   (iface->read_index & iface->fifo_mask));
+    lane->read_index_elem =
+        UCT_MM_IFACE_GET_FIFO_ELEM(iface, lane->fifo_elems,
+                                   (lane->read_index & iface->fifo_mask));
 
-    uct_mm_progress_fifo_tail(iface);
+    uct_mm_progress_fifo_tail(iface, lane, is_zcopy);
 
     return 1;
 }
 
 static UCS_F_ALWAYS_INLINE void
-uct_mm_iface_fifo_window_adjust(uct_mm_iface_t *iface,
+uct_mm_iface_fifo_window_adjust(uct_mm_iface_t *iface, uct_mm_fifo_lane_t *lane,
                                 unsigned fifo_poll_count)
 {
-    if (fifo_poll_count < iface->fifo_poll_count) {
-        iface->fifo_poll_count = ucs_max(iface->fifo_poll_count /
-                                         UCT_MM_IFACE_FIFO_MD_FACTOR,
-                                         UCT_MM_IFACE_FIFO_MIN_POLL);
-        iface->fifo_prev_wnd_cons = 0;
+    if (fifo_poll_count < lane->poll_count) {
+        lane->poll_count    = ucs_max(lane->poll_count /
+                                      UCT_MM_IFACE_FIFO_MD_FACTOR,
+                                      UCT_MM_IFACE_FIFO_MIN_POLL);
+        lane->prev_wnd_cons = 0;
         return;
     }
 
-    ucs_assert(fifo_poll_count == iface->fifo_poll_count);
+    ucs_assert(fifo_poll_count == lane->poll_count);
 
-    if (iface->fifo_prev_wnd_cons) {
+    if (lane->prev_wnd_cons) {
         /* Increase FIFO window size if it was fully consumed
          * during the previous iface progress call in order
          * to prevent the situation when the window will be
          * adjusted to [MIN, MIN + 1, MIN, MIN + 1, ...] that
          * is harmful to latency */
-        iface->fifo_poll_count = ucs_min(iface->fifo_poll_count +
-                                         UCT_MM_IFACE_FIFO_AI_VALUE,
-                                         iface->config.fifo_max_poll);
+        lane->poll_count = ucs_min(lane->poll_count +
+                                   UCT_MM_IFACE_FIFO_AI_VALUE,
+                                   iface->config.fifo_max_poll);
     } else {
-        iface->fifo_prev_wnd_cons = 1;
+        lane->prev_wnd_cons = 1;
     }
 }
 
-static unsigned uct_mm_iface_progress(uct_iface_h tl_iface)
+static UCS_F_ALWAYS_INLINE unsigned
+uct_mm_iface_poll_lane(uct_mm_iface_t *iface, uct_mm_fifo_lane_t *lane)
 {
-    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
-    unsigned total_count  = 0;
+    unsigned total_count = 0;
     unsigned count;
 
-    ucs_assert(iface->fifo_poll_count >= UCT_MM_IFACE_FIFO_MIN_POLL);
+    ucs_assert(lane->poll_count >= UCT_MM_IFACE_FIFO_MIN_POLL);
 
-    /* progress receive */
     do {
-        count = uct_mm_iface_poll_fifo(iface);
+        count = uct_mm_iface_poll_fifo(iface, lane);
         ucs_assert(count < 2);
         total_count += count;
         ucs_assert(total_count < UINT_MAX);
-    } while ((count != 0) && (total_count < iface->fifo_poll_count));
+    } while ((count != 0) && (total_count < lane->poll_count));
+
+    uct_mm_iface_fifo_window_adjust(iface, lane, total_count);
+    return total_count;
+}
 
-    uct_mm_iface_fifo_window_adjust(iface, total_count);
+static unsigned uct_mm_iface_progress(uct_iface_h tl_iface)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
+    unsigned total_count  = 0;
+    unsigned lane_index, i;
+
+    /* progress receive, starting from a different lane every time so none of
+     * the lanes gets precedence over the others */
+    lane_index = iface->next_lane;
+    for (i = 0; i < iface->config.fifo_lanes; ++i) {
+        total_count += uct_mm_iface_poll_lane(iface,
+                                              &iface->recv_lanes[lane_index]);
+        if (++lane_index == iface->config.fifo_lanes) {
+            lane_index = 0;
+        }
+    }
+
+    if (++iface->next_lane == iface->config.fifo_lanes) {
+        iface->next_lane = 0;
+    }
+
+    if (ucs_unlikely(!ucs_list_is_empty(&iface->zcopy_eps))) {
+        total_count += uct_mm_iface_progress_zcopy(iface);
+    }
 
     /* progress the pending sends (if there are any) */
     ucs_arbiter_dispatch(&iface->arbiter, 1, uct_mm_ep_process_pending,
@@ -430,40 +690,26 @@ static ucs_status_t uct_mm_iface_event_fd_get(uct_iface_h tl_iface, int *fd_p)
 
 
 static ucs_status_t
-uct_mm_iface_event_fd_arm(uct_iface_h tl_iface, unsigned events)
+uct_mm_iface_fifo_lane_arm(uct_mm_iface_t *iface, uct_mm_fifo_lane_t *lane)
 {
-    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
-    char dummy[UCT_MM_IFACE_MAX_SIG_EVENTS]; /* pop multiple signals at once */
     uint64_t head, prev_head;
-    int ret;
-
-    if ((events & UCT_EVENT_SEND_COMP) &&
-        !ucs_arbiter_is_empty(&iface->arbiter)) {
-        /* if we have outstanding send operations, can't go to sleep */
-        return UCS_ERR_BUSY;
-    }
-
-    if (!(events & UCT_EVENT_RECV)) {
-        /* Nothing to do anymore */
-        return UCS_OK;
-    }
 
     /* Make the next sender which writes to the FIFO signal the receiver */
-    head = iface->recv_fifo_ctl->head;
-    if ((head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) > iface->read_index) {
+    head = lane->fifo_ctl->head;
+    if ((head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) > lane->read_index) {
         /* head element was not read yet */
         ucs_trace("iface %p: cannot arm, head %" PRIu64 " read_index %" PRIu64,
                   iface, head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED,
-                  iface->read_index);
+                  lane->read_index);
         return UCS_ERR_BUSY;
     }
 
     if (!(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) {
         /* Try to mark the head index as armed in an atomic way; fail if any
            sender managed to update the head at the same time */
-        prev_head = ucs_atomic_cswap64(
-                ucs_unaligned_ptr(&iface->recv_fifo_ctl->head), head,
-                head | UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED);
+        prev_head = ucs_atomic_cswap64(ucs_unaligned_ptr(&lane->fifo_ctl->head),
+                                       head,
+                                       head | UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED);
         if (prev_head != head) {
             /* race with sender; need to retry */
             ucs_assert(!(prev_head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
@@ -474,6 +720,40 @@ uct_mm_iface_event_fd_arm(uct_iface_h tl_iface, unsigned events)
         }
     }
 
+    ucs_trace("iface %p: armed lane %ld head %" PRIu64 " read_index %" PRIu64,
+              iface, lane - iface->recv_lanes,
+              head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED, lane->read_index);
+    return UCS_OK;
+}
+
+static ucs_status_t
+uct_mm_iface_event_fd_arm(uct_iface_h tl_iface, unsigned events)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
+    char dummy[UCT_MM_IFACE_MAX_SIG_EVENTS]; /* pop multiple signals at once */
+    ucs_status_t status;
+    unsigned lane;
+    int ret;
+
+    if ((events & UCT_EVENT_SEND_COMP) &&
+        (!ucs_arbiter_is_empty(&iface->arbiter) ||
+         !ucs_list_is_empty(&iface->zcopy_eps))) {
+        /* if we have outstanding send operations, can't go to sleep */
+        return UCS_ERR_BUSY;
+    }
+
+    if (!(events & UCT_EVENT_RECV)) {
+        /* Nothing to do anymore */
+        return UCS_OK;
+    }
+
+    for (lane = 0; lane < iface->config.fifo_lanes; ++lane) {
+        status = uct_mm_iface_fifo_lane_arm(iface, &iface->recv_lanes[lane]);
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
     /* check for pending events */
     ret = recvfrom(iface->signal_fd, &dummy, sizeof(dummy), 0, NULL, 0);
     if (ret > 0) {
@@ -481,9 +761,7 @@ uct_mm_iface_event_fd_arm(uct_iface_h tl_iface, unsigned events)
         return UCS_ERR_BUSY;
     } else if (ret == -1) {
         if (errno == EAGAIN) {
-            ucs_trace("iface %p: armed head %" PRIu64 " read_index %" PRIu64,
-                      iface, head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED,
-                      iface->read_index);
+            ucs_trace("iface %p: armed", iface);
             return UCS_OK;
         } else if (errno == EINTR) {
             return UCS_ERR_BUSY;
@@ -508,6 +786,7 @@ static uct_iface_ops_t uct_mm_iface_ops = {
     .ep_am_short              = uct_mm_ep_am_short,
     .ep_am_short_iov          = uct_mm_ep_am_short_iov,
     .ep_am_bcopy              = uct_mm_ep_am_bcopy,
+    .ep_am_zcopy              = uct_mm_ep_am_zcopy,
     .ep_atomic_cswap64        = uct_sm_ep_atomic_cswap64,
     .ep_atomic64_post         = uct_sm_ep_atomic64_post,
     .ep_atomic64_fetch        = uct_sm_ep_atomic64_fetch,
@@ -601,14 +880,42 @@ uct_mm_estimate_perf(uct_iface_h tl_iface, uct_perf_attr_t *perf_attr)
     return UCS_OK;
 }
 
+static void uct_mm_iface_vfs_show_lane_occupancy(void *obj,
+                                                 ucs_string_buffer_t *strb,
+                                                 void *arg_ptr, uint64_t arg_u64)
+{
+    uct_mm_fifo_lane_t *lane = arg_ptr;
+    uint64_t head;
+
+    head = lane->fifo_ctl->head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
+    ucs_string_buffer_appendf(strb, "%" PRIu64 "\n", head - lane->read_index);
+}
+
+static void uct_mm_iface_vfs_refresh(uct_iface_h tl_iface)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
+    uct_mm_fifo_lane_t *lane;
+    unsigned lane_index;
+
+    for (lane_index = 0; lane_index < iface->config.fifo_lanes; ++lane_index) {
+        lane = &iface->recv_lanes[lane_index];
+        ucs_vfs_obj_add_ro_file(iface, uct_mm_iface_vfs_show_lane_occupancy,
+                                lane, 0, "fifo/lane%u/occupancy", lane_index);
+        ucs_vfs_obj_add_ro_file(iface, ucs_vfs_show_primitive,
+                                &lane->poll_count, UCS_VFS_TYPE_U32,
+                                "fifo/lane%u/poll_window", lane_index);
+    }
+}
+
 static uct_iface_internal_ops_t uct_mm_iface_internal_ops = {
     .iface_estimate_perf   = uct_mm_estimate_perf,
-    .iface_vfs_refresh     = (uct_iface_vfs_refresh_func_t)ucs_empty_function,
+    .iface_vfs_refresh     = uct_mm_iface_vfs_refresh,
     .ep_query              = (uct_ep_query_func_t)ucs_empty_function,
     .ep_invalidate         = (uct_ep_invalidate_func_t)ucs_empty_function_return_unsupported,
     .ep_connect_to_ep_v2   = (uct_ep_connect_to_ep_v2_func_t)ucs_empty_function_return_unsupported,
     .iface_is_reachable_v2 = uct_mm_iface_is_reachable_v2,
-    .ep_is_connected       = uct_mm_ep_is_connected
+    .ep_is_connected       = uct_mm_ep_is_connected,
+    .ep_am_short_batch     = uct_mm_ep_am_short_batch
 };
 
 static void uct_mm_iface_recv_desc_init(uct_iface_h tl_iface, void *obj,
@@ -641,22 +948,30 @@ static void uct_mm_iface_free_rx_descs(uct_mm_iface_t *iface, unsigned num_elems
     uct_mm_recv_desc_t *desc;
     unsigned i;
 
+    /* elements are assigned descriptors lane by lane */
     for (i = 0; i < num_elems; i++) {
-        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elems, i);
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(
+                iface, iface->recv_lanes[i / iface->config.fifo_size].fifo_elems,
+                i % iface->config.fifo_size);
         desc = (uct_mm_recv_desc_t*)UCS_PTR_BYTE_OFFSET(elem->desc_data,
                                                         -iface->rx_headroom) - 1;
         ucs_mpool_put(desc);
     }
 }
 
-void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
+void uct_mm_iface_set_fifo_ptrs(uct_mm_iface_t *iface, void *fifo_mem,
+                                unsigned lane, uct_mm_fifo_ctl_t **fifo_ctl_p,
                                 void **fifo_elems_p)
 {
     uct_mm_fifo_ctl_t *fifo_ctl;
 
+    ucs_assert(lane < iface->config.fifo_lanes);
+
     /* initiate the the uct_mm_fifo_ctl struct, holding the head and the tail */
     fifo_ctl = (uct_mm_fifo_ctl_t*)ucs_align_up_pow2
                     ((uintptr_t)fifo_mem, UCS_SYS_CACHE_LINE_SIZE);
+    fifo_ctl = UCS_PTR_BYTE_OFFSET(fifo_ctl,
+                                   lane * UCT_MM_GET_FIFO_LANE_STRIDE(iface));
 
     /* Make sure head and tail are cache-aligned, and not on same cacheline, to
      * avoid false-sharing.
@@ -675,9 +990,11 @@ void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
 
 static ucs_status_t uct_mm_iface_create_signal_fd(uct_mm_iface_t *iface)
 {
+    uct_mm_fifo_ctl_t *fifo_ctl;
     ucs_status_t status;
     socklen_t addrlen;
     struct sockaddr_un bind_addr;
+    unsigned lane;
     int ret;
 
     /* Create a UNIX domain socket to send and receive wakeup signal from remote processes */
@@ -707,10 +1024,11 @@ static ucs_status_t uct_mm_iface_create_signal_fd(uct_mm_iface_t *iface)
     /* Share the socket address on the FIFO control area, so we would not have
      * to enlarge the interface address size.
      */
-    addrlen = sizeof(struct sockaddr_un);
-    memset(&iface->recv_fifo_ctl->signal_sockaddr, 0, addrlen);
+    fifo_ctl = iface->recv_lanes[0].fifo_ctl;
+    addrlen  = sizeof(struct sockaddr_un);
+    memset(&fifo_ctl->signal_sockaddr, 0, addrlen);
     ret = getsockname(iface->signal_fd,
-                      (struct sockaddr *)ucs_unaligned_ptr(&iface->recv_fifo_ctl->signal_sockaddr),
+                      (struct sockaddr *)ucs_unaligned_ptr(&fifo_ctl->signal_sockaddr),
                       &addrlen);
     if (ret < 0) {
         ucs_error("Failed to retrieve unix domain socket address: %m");
@@ -718,7 +1036,16 @@ static ucs_status_t uct_mm_iface_create_signal_fd(uct_mm_iface_t *iface)
         goto err_close;
     }
 
-    iface->recv_fifo_ctl->signal_addrlen = addrlen;
+    fifo_ctl->signal_addrlen = addrlen;
+
+    /* Senders read the socket address from the lane they are writing to */
+    for (lane = 1; lane < iface->config.fifo_lanes; ++lane) {
+        iface->recv_lanes[lane].fifo_ctl->signal_addrlen = addrlen;
+        memcpy(ucs_unaligned_ptr(&iface->recv_lanes[lane].fifo_ctl->signal_sockaddr),
+               ucs_unaligned_ptr(&fifo_ctl->signal_sockaddr),
+               sizeof(fifo_ctl->signal_sockaddr));
+    }
+
     return UCS_OK;
 
 err_close:
@@ -732,9 +1059,10 @@ static void uct_mm_iface_log_created(uct_mm_iface_t *iface)
     uct_mm_seg_t *seg = iface->recv_fifo_mem.memh;
 
     ucs_debug("created mm iface %p FIFO id 0x%"PRIx64
-              " va %p size %zu (%u x %u elems)",
+              " va %p size %zu (%u x %u x %u elems)",
               iface, seg->seg_id, seg->address, seg->length,
-              iface->config.fifo_elem_size, iface->config.fifo_size);
+              iface->config.fifo_lanes, iface->config.fifo_elem_size,
+              iface->config.fifo_size);
 }
 
 static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
@@ -743,8 +1071,12 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
 {
     uct_mm_iface_config_t *mm_config =
                     ucs_derived_of(tl_config, uct_mm_iface_config_t);
+    uct_mm_md_t *mm_md             = ucs_derived_of(md, uct_mm_md_t);
     uct_mm_fifo_element_t* fifo_elem_p;
     size_t alignment, align_offset, payload_offset;
+    ucs_mpool_params_t mp_params;
+    uct_md_attr_t md_attr;
+    uct_mm_fifo_lane_t *lane;
     ucs_status_t status;
     unsigned i;
 
@@ -780,9 +1112,17 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         goto err;
     }
 
+    if ((mm_config->fifo_lanes == 0) || (mm_config->fifo_lanes > UINT8_MAX)) {
+        ucs_error("The UCX_MM_FIFO_LANES parameter must be in the range "
+                  "1..%u.", UINT8_MAX);
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
     self->config.overhead          = mm_config->overhead;
     self->config.fifo_size         = mm_config->fifo_size;
     self->config.fifo_elem_size    = mm_config->fifo_elem_size;
+    self->config.fifo_lanes        = mm_config->fifo_lanes;
     self->config.seg_size          = mm_config->seg_size;
     self->config.fifo_max_poll     = ((mm_config->fifo_max_poll == UCS_ULUNITS_AUTO) ?
                                       UCT_MM_IFACE_FIFO_MAX_POLL :
@@ -792,8 +1132,8 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
     self->config.extra_cap_flags   = (mm_config->error_handling == UCS_YES) ?
                                      UCT_IFACE_FLAG_ERRHANDLE_PEER_FAILURE :
                                      0ul;
-    self->fifo_prev_wnd_cons       = 0;
-    self->fifo_poll_count          = self->config.fifo_max_poll;
+    self->next_lane                = 0;
+    self->local_iface_addr         = NULL;
     /* cppcheck-suppress internalAstError */
     self->fifo_release_factor_mask = UCS_MASK(ucs_ilog2(ucs_max((int)
                                      (mm_config->fifo_size * mm_config->release_fifo_factor),
@@ -805,6 +1145,61 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
                                      params->rx_headroom : 0;
     self->release_desc.cb          = uct_mm_iface_release_desc;
 
+    ucs_list_head_init(&self->zcopy_eps);
+    kh_init_inplace(uct_mm_remote_seg, &self->zcopy_segs);
+
+    if (mm_config->am_zcopy) {
+        status = uct_md_query(md, &md_attr);
+        if (status != UCS_OK) {
+            goto err;
+        }
+
+        /* zcopy buffers are described by the mm segment of their memory
+         * handle, and the descriptor must fit in a FIFO element */
+        if (!(md_attr.cap.flags & UCT_MD_FLAG_ALLOC) ||
+            (md_attr.cap.flags & UCT_MD_FLAG_REG) ||
+            ((sizeof(uct_mm_zcopy_desc_t) + mm_md->iface_addr_len) >
+             (self->config.fifo_elem_size - sizeof(uct_mm_fifo_element_t)))) {
+            ucs_debug("mm_iface %p: zero-copy active messages are not "
+                      "supported on md %s", self,
+                      md->component->name);
+        } else {
+            self->local_iface_addr = ucs_malloc(
+                    ucs_max(mm_md->iface_addr_len, 1), "mm_local_iface_addr");
+            if (self->local_iface_addr == NULL) {
+                status = UCS_ERR_NO_MEMORY;
+                goto err;
+            }
+
+            status = uct_mm_md_mapper_ops(mm_md)->iface_addr_pack(
+                    mm_md, self->local_iface_addr);
+            if (status != UCS_OK) {
+                goto err_free_local_addr;
+            }
+
+            self->config.extra_cap_flags |= UCT_IFACE_FLAG_AM_ZCOPY;
+        }
+    }
+
+    ucs_mpool_params_reset(&mp_params);
+    mp_params.elem_size       = sizeof(uct_mm_zcopy_op_t);
+    mp_params.elems_per_chunk = 128;
+    mp_params.ops             = &uct_mm_zcopy_op_mpool_ops;
+    mp_params.name            = "mm_zcopy_ops";
+    status = ucs_mpool_init(&mp_params, &self->zcopy_op_mp);
+    if (status != UCS_OK) {
+        goto err_free_local_addr;
+    }
+
+    self->recv_lanes = ucs_calloc(self->config.fifo_lanes,
+                                  sizeof(*self->recv_lanes), "mm_recv_lanes");
+    if (self->recv_lanes == NULL) {
+        ucs_error("mm_iface failed to allocate %u receive FIFO lanes",
+                  self->config.fifo_lanes);
+        status = UCS_ERR_NO_MEMORY;
+        goto err_cleanup_zcopy_mp;
+    }
+
     /* Allocate the receive FIFO */
     status = uct_iface_mem_alloc(&self->super.super.super,
                                  UCT_MM_GET_FIFO_SIZE(self),
@@ -812,19 +1207,25 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
                                  &self->recv_fifo_mem);
     if (status != UCS_OK) {
         ucs_error("mm_iface failed to allocate receive FIFO");
-        return status;
+        goto err_free_lanes;
+    }
+
+    for (i = 0; i < self->config.fifo_lanes; ++i) {
+        lane = &self->recv_lanes[i];
+        uct_mm_iface_set_fifo_ptrs(self, self->recv_fifo_mem.address, i,
+                                   &lane->fifo_ctl, &lane->fifo_elems);
+        lane->fifo_ctl->head  = 0;
+        lane->fifo_ctl->tail  = 0;
+        lane->fifo_ctl->pid   = getpid();
+        lane->read_index      = 0;
+        lane->read_index_elem = UCT_MM_IFACE_GET_FIFO_ELEM(self,
+                                                           lane->fifo_elems,
+                                                           lane->read_index);
+        lane->poll_count      = self->config.fifo_max_poll;
+        lane->prev_wnd_cons   = 0;
     }
 
-    uct_mm_iface_set_fifo_ptrs(self->recv_fifo_mem.address,
-                               &self->recv_fifo_ctl, &self->recv_fifo_elems);
-    self->recv_fifo_ctl->head = 0;
-    self->recv_fifo_ctl->tail = 0;
-    self->recv_fifo_ctl->pid  = getpid();
-    self->read_index          = 0;
-    self->read_index_elem     = UCT_MM_IFACE_GET_FIFO_ELEM(self,
-                                                           self->recv_fifo_elems,
-                                                           self->read_index);
-    payload_offset            = sizeof(uct_mm_recv_desc_t) + self->rx_headroom;
+    payload_offset = sizeof(uct_mm_recv_desc_t) + self->rx_headroom;
 
     /* create a unix file descriptor to receive event notifications */
     status = uct_mm_iface_create_signal_fd(self);
@@ -861,8 +1262,10 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
 
     /* initiate the owner bit in all the FIFO elements and assign a receive descriptor
      * per every FIFO element */
-    for (i = 0; i < mm_config->fifo_size; i++) {
-        fifo_elem_p = UCT_MM_IFACE_GET_FIFO_ELEM(self, self->recv_fifo_elems, i);
+    for (i = 0; i < (self->config.fifo_size * self->config.fifo_lanes); i++) {
+        fifo_elem_p = UCT_MM_IFACE_GET_FIFO_ELEM(
+                self, self->recv_lanes[i / self->config.fifo_size].fifo_elems,
+                i % self->config.fifo_size);
         fifo_elem_p->flags = UCT_MM_FIFO_ELEM_FLAG_OWNER;
 
         status = uct_mm_assign_desc_to_fifo_elem(self, fifo_elem_p, 1);
@@ -886,6 +1289,12 @@ err_close_signal_fd:
     close(self->signal_fd);
 err_free_fifo:
     uct_iface_mem_free(&self->recv_fifo_mem);
+err_free_lanes:
+    ucs_free(self->recv_lanes);
+err_cleanup_zcopy_mp:
+    ucs_mpool_cleanup(&self->zcopy_op_mp, 1);
+err_free_local_addr:
+    ucs_free(self->local_iface_addr);
 err:
     return status;
 }
@@ -897,13 +1306,19 @@ static UCS_CLASS_CLEANUP_FUNC(uct_mm_iface_t)
 
     /* return all the descriptors that are now 'assigned' to the FIFO,
      * to their mpool */
-    uct_mm_iface_free_rx_descs(self, self->config.fifo_size);
+    uct_mm_iface_free_rx_descs(self, self->config.fifo_size *
+                                     self->config.fifo_lanes);
 
     ucs_mpool_put(self->last_recv_desc);
     ucs_mpool_cleanup(&self->recv_desc_mp, 1);
     close(self->signal_fd);
     uct_iface_mem_free(&self->recv_fifo_mem);
+    ucs_free(self->recv_lanes);
     ucs_arbiter_cleanup(&self->arbiter);
+    ucs_mpool_cleanup(&self->zcopy_op_mp, 1);
+    uct_mm_iface_zcopy_segs_detach(self);
+    kh_destroy_inplace(uct_mm_remote_seg, &self->zcopy_segs);
+    ucs_free(self->local_iface_addr);
 }
 
 UCS_CLASS_DEFINE(uct_mm_iface_t, uct_base_iface_t);
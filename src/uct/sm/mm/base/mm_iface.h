@@ -15,6 +15,8 @@
 #include <ucs/arch/cpu.h>
 #include <ucs/debug/memtrack_int.h>
 #include <ucs/datastruct/arbiter.h>
+#include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/queue.h>
 #include <ucs/sys/compiler.h>
 #include <ucs/sys/ptr_arith.h>
 #include <ucs/sys/sys.h>
@@ -29,6 +31,10 @@ enum {
 
     /* Whether the element data is inline or in receive descriptor */
     UCT_MM_FIFO_ELEM_FLAG_INLINE = UCS_BIT(1),
+
+    /* The element holds a descriptor of the sender's buffer, which the
+       receiver attaches to and reads in place */
+    UCT_MM_FIFO_ELEM_FLAG_ZCOPY  = UCS_BIT(2),
 };
 
 
@@ -36,8 +42,16 @@ enum {
     ucs_align_up(sizeof(uct_mm_fifo_ctl_t), UCS_SYS_CACHE_LINE_SIZE)
 
 
+/* Offset between the control structures of two consecutive FIFO lanes */
+#define UCT_MM_GET_FIFO_LANE_STRIDE(_iface) \
+    ucs_align_up(UCT_MM_FIFO_CTL_SIZE + \
+                 ((_iface)->config.fifo_size * (_iface)->config.fifo_elem_size), \
+                 UCS_SYS_CACHE_LINE_SIZE)
+
+
 #define UCT_MM_GET_FIFO_SIZE(_iface) \
-    (UCT_MM_FIFO_CTL_SIZE + \
+    ((((_iface)->config.fifo_lanes - 1) * UCT_MM_GET_FIFO_LANE_STRIDE(_iface)) + \
+     UCT_MM_FIFO_CTL_SIZE + \
      ((_iface)->config.fifo_size * (_iface)->config.fifo_elem_size) + \
       (UCS_SYS_CACHE_LINE_SIZE - 1))
 
@@ -63,7 +77,9 @@ enum {
                                                              '?', \
                        (_elem_sn), \
                        ((_flags) & UCT_MM_FIFO_ELEM_FLAG_OWNER) ? 'o' : '-', \
-                       ((_flags) & UCT_MM_FIFO_ELEM_FLAG_INLINE) ? 'i' : '-')
+                       ((_flags) & UCT_MM_FIFO_ELEM_FLAG_INLINE) ? 'i' : \
+                       ((_flags) & UCT_MM_FIFO_ELEM_FLAG_ZCOPY)  ? 'z' : \
+                                                                   '-')
 
 
 /* AIMD (additive increase/multiplicative decrease) algorithm adopted for FIFO
@@ -84,6 +100,10 @@ enum {
 #define UCT_MM_IFACE_FIFO_AI_VALUE              1 /* FIFO window += AI value */
 #define UCT_MM_IFACE_FIFO_MD_FACTOR             2 /* FIFO window /= MD factor */
 
+#define UCT_MM_IFACE_ZCOPY_MAX_SEGS           256 /* Maximal number of sender
+                                                   * segments kept attached for
+                                                   * zero-copy receive */
+
 /* If this bit is set in fifo_ctl.head, trigger async event on the receiver  */
 #define UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED      UCS_BIT(63)
 
@@ -114,6 +134,9 @@ typedef struct uct_mm_iface_config {
     ucs_ternary_auto_value_t hugetlb_mode;        /* Enable using huge pages for
                                                    * shared memory buffers */
     unsigned                 fifo_elem_size;      /* Size of the FIFO element size */
+    unsigned                 fifo_lanes;          /* Number of receive FIFO lanes */
+    int                      am_zcopy;            /* Enable zero-copy active
+                                                   * messages */
     int                      error_handling; /* Exposing of error handling cap */
     uct_iface_mpool_config_t mp;
     uct_mm_iface_overhead_t  overhead;
@@ -125,6 +148,8 @@ typedef struct uct_mm_iface_config {
  */
 typedef struct uct_mm_iface_addr {
     uct_mm_seg_id_t          fifo_seg_id;     /* Shared memory identifier of FIFO */
+    uint8_t                  fifo_lanes;      /* Number of receive FIFO lanes,
+                                                 defines the FIFO layout */
     /* mapper-specific iface address follows */
 } UCS_S_PACKED uct_mm_iface_addr_t;
 
@@ -143,10 +168,19 @@ typedef struct uct_mm_fifo_ctl {
 
     /* 2nd cacheline */
     volatile uint64_t         tail;           /* How much was consumed */
+    volatile uint64_t         zcopy_error_sn; /* Sequence number + 1 of a
+                                                 zero-copy element which was
+                                                 not delivered, 0 if none.
+                                                 Set by the receiver, cleared
+                                                 by the sender of the element */
     pid_t                     pid;            /* Process owner pid */
 } UCS_S_PACKED UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) uct_mm_fifo_ctl_t;
 
 
+KHASH_INIT(uct_mm_remote_seg, uintptr_t, uct_mm_remote_seg_t, 1,
+           kh_int64_hash_func, kh_int64_hash_equal)
+
+
 /**
  * MM receive descriptor info in the shared FIFO
  */
@@ -158,6 +192,30 @@ typedef struct uct_mm_desc_info {
 } UCS_S_PACKED uct_mm_desc_info_t;
 
 
+/**
+ * Sender buffer descriptor of a zero-copy active message, written inline to
+ * the FIFO element and followed by the sender's mapper-specific iface address
+ */
+typedef struct uct_mm_zcopy_desc {
+    uct_mm_seg_id_t         seg_id;           /* sender shared memory segment */
+    uint64_t                seg_size;         /* size of the sender segment */
+    uint64_t                offset;           /* data offset inside the segment */
+    uint64_t                length;           /* data length */
+} UCS_S_PACKED uct_mm_zcopy_desc_t;
+
+
+/**
+ * Outstanding zero-copy send, completed once the receiver has consumed the
+ * FIFO element it was sent with
+ */
+typedef struct uct_mm_zcopy_op {
+    ucs_queue_elem_t          queue;          /* entry in ep zcopy_ops */
+    struct uct_mm_ep          *ep;            /* endpoint the op was sent on */
+    uint64_t                  sn;             /* FIFO element sequence number */
+    uct_completion_t          *comp;          /* user completion, can be NULL */
+} uct_mm_zcopy_op_t;
+
+
 /**
  * MM FIFO element
  */
@@ -175,6 +233,27 @@ typedef struct uct_mm_fifo_element {
 } UCS_S_PACKED uct_mm_fifo_element_t;
 
 
+/**
+ * MM receive FIFO lane. Every lane is a separate FIFO in the shared receive
+ * segment, with its own control structure and polling window.
+ */
+typedef struct uct_mm_fifo_lane {
+    uct_mm_fifo_ctl_t         *fifo_ctl;      /* pointer to the struct at the
+                                                 beginning of the lane which
+                                                 holds the head and the tail */
+    void                      *fifo_elems;    /* pointer to the first fifo element
+                                                 in the lane */
+    uct_mm_fifo_element_t     *read_index_elem;
+    uint64_t                  read_index;     /* actual reading location */
+    unsigned                  poll_count;     /* How much RX operations can be
+                                               * polled from this lane during
+                                               * an iface progress call */
+    int                       prev_wnd_cons;  /* Was the lane window fully
+                                               * consumed by the previous call
+                                               * to iface progress */
+} uct_mm_fifo_lane_t;
+
+
 /*
  * MM receive descriptor:
  *
@@ -199,26 +278,18 @@ typedef struct uct_mm_iface {
     /* Receive FIFO */
     uct_allocated_memory_t  recv_fifo_mem;
 
-    uct_mm_fifo_ctl_t       *recv_fifo_ctl;   /* pointer to the struct at the */
-                                              /* beginning of the receive fifo */
-                                              /* which holds the head and the tail. */
-                                              /* this struct is cache line aligned and */
-                                              /* doesn't necessarily start where */
-                                              /* shared_mem starts */
-    void                    *recv_fifo_elems; /* pointer to the first fifo element
-                                                 in the receive fifo */
-    uct_mm_fifo_element_t   *read_index_elem;
-    uint64_t                read_index;       /* actual reading location */
+    uct_mm_fifo_lane_t      *recv_lanes;      /* receive FIFO lanes, the first
+                                                 lane control struct is cache
+                                                 line aligned and doesn't
+                                                 necessarily start where
+                                                 shared_mem starts */
+    unsigned                next_lane;        /* lane to start polling from in
+                                                 the next progress call */
 
     uint8_t                 fifo_shift;       /* = log2(fifo_size) */
     unsigned                fifo_mask;        /* = 2^fifo_shift - 1 */
     uint64_t                fifo_release_factor_mask;
 
-    unsigned                fifo_poll_count;     /* How much RX operations can be polled
-                                                  * during an iface progress call */
-    int                     fifo_prev_wnd_cons;  /* Was FIFO window size fully consumed by
-                                                  * the previous call to iface progress */
-
     ucs_mpool_t             recv_desc_mp;
     uct_mm_recv_desc_t      *last_recv_desc;  /* next receive descriptor to use */
 
@@ -228,9 +299,18 @@ typedef struct uct_mm_iface {
     ucs_arbiter_t           arbiter;
     uct_recv_desc_t         release_desc;
 
+    ucs_mpool_t             zcopy_op_mp;      /* outstanding zcopy sends */
+    ucs_list_link_t         zcopy_eps;        /* endpoints with outstanding
+                                                 zcopy sends */
+    khash_t(uct_mm_remote_seg) zcopy_segs;    /* attached sender segments of
+                                                 received zcopy messages */
+    void                    *local_iface_addr;/* own mapper-specific address,
+                                                 sent with zcopy messages */
+
     struct {
         unsigned                fifo_size;
         unsigned                fifo_elem_size;
+        unsigned                fifo_lanes;
         /* size of the receive descriptor (for payload) */
         unsigned                seg_size;
         unsigned                fifo_max_poll;
@@ -289,13 +369,16 @@ uct_mm_iface_invoke_am(uct_mm_iface_t *iface, uint8_t am_id, void *data,
 
 
 /**
- * Set aligned pointers of the FIFO according to the beginning of the allocated
- * memory.
+ * Set aligned pointers of a FIFO lane according to the beginning of the
+ * allocated memory.
+ * @param [in] iface         Interface whose configuration defines the layout.
  * @param [in] fifo_mem      Pointer to the beginning of the allocated memory.
- * @param [out] fifo_ctl_p   Pointer to the FIFO control structure.
- * @param [out] fifo_elems   Pointer to the array of FIFO elements.
+ * @param [in] lane          Index of the FIFO lane.
+ * @param [out] fifo_ctl_p   Pointer to the lane FIFO control structure.
+ * @param [out] fifo_elems   Pointer to the array of lane FIFO elements.
  */
-void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
+void uct_mm_iface_set_fifo_ptrs(uct_mm_iface_t *iface, void *fifo_mem,
+                                unsigned lane, uct_mm_fifo_ctl_t **fifo_ctl_p,
                                 void **fifo_elems_p);
 
 
@@ -306,6 +389,10 @@ UCS_CLASS_DECLARE_NEW_FUNC(uct_mm_iface_t, uct_iface_t, uct_md_h, uct_worker_h,
 void uct_mm_iface_release_desc(uct_recv_desc_t *self, void *desc);
 
 
+void uct_mm_iface_zcopy_ops_purge(uct_mm_iface_t *iface, struct uct_mm_ep *ep,
+                                  ucs_status_t status);
+
+
 ucs_status_t uct_mm_flush();
 
 
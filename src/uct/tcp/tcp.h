@@ -47,6 +47,14 @@
  * operation */
 #define UCT_TCP_EP_PUT_ZCOPY_MAX              SIZE_MAX
 
+/* Maximum size of a data that can be read by GET Zcopy
+ * operation */
+#define UCT_TCP_EP_GET_ZCOPY_MAX              SIZE_MAX
+
+/* Maximum number of MSG_ZEROCOPY sends which are waiting for the completion
+ * notifications from the kernel on a single EP */
+#define UCT_TCP_EP_MSG_ZCOPY_MAX_INFLIGHT     64
+
 /* Length of a data that is used by PUT protocol */
 #define UCT_TCP_EP_PUT_SERVICE_LENGTH        (sizeof(uct_tcp_am_hdr_t) + \
                                               sizeof(uct_tcp_ep_put_req_hdr_t))
@@ -114,7 +122,15 @@ enum {
     /* EP is on EP PTR map. */
     UCT_TCP_EP_FLAG_ON_PTR_MAP         = UCS_BIT(9),
     /* EP has some operations done without flush */
-    UCT_TCP_EP_FLAG_NEED_FLUSH         = UCS_BIT(10)
+    UCT_TCP_EP_FLAG_NEED_FLUSH         = UCS_BIT(10),
+    /* EP has Zcopy TX operation which payload is sent with MSG_ZEROCOPY */
+    UCT_TCP_EP_FLAG_MSG_ZCOPY_TX       = UCS_BIT(11),
+    /* GET RX operation is in progress on a given EP. */
+    UCT_TCP_EP_FLAG_GET_RX             = UCS_BIT(12),
+    /* EP has a receive operation posted to the iface io_uring */
+    UCT_TCP_EP_FLAG_URING_RX           = UCS_BIT(13),
+    /* SO_ZEROCOPY is enabled on the EP socket */
+    UCT_TCP_EP_FLAG_MSG_ZCOPY_SOCK     = UCS_BIT(14)
 };
 
 
@@ -149,6 +165,35 @@ typedef enum uct_tcp_ep_conn_state {
 /* Forward declaration */
 typedef struct uct_tcp_ep uct_tcp_ep_t;
 
+/* io_uring instance used by the TCP IO engine, see tcp_uring.c */
+typedef struct uct_tcp_uring uct_tcp_uring_t;
+
+
+/**
+ * Completion callback of an io_uring operation.
+ *
+ * @param [in] user_data  User data passed when the operation was prepared.
+ * @param [in] result     Operation result, number of bytes or -errno.
+ * @param [in] arg        User argument passed to @ref uct_tcp_uring_submit.
+ *
+ * @return Number of progressed operations.
+ */
+typedef unsigned (*uct_tcp_uring_complete_cb_t)(void *user_data, int result,
+                                                void *arg);
+
+
+/**
+ * TCP socket IO engine
+ */
+typedef enum uct_tcp_io_engine {
+    /* Every socket operation is a separate system call, driven by epoll */
+    UCT_TCP_IO_ENGINE_EPOLL,
+    /* Receive operations of all sockets which are reported as readable by
+     * epoll are submitted to an io_uring with a single system call */
+    UCT_TCP_IO_ENGINE_URING,
+    UCT_TCP_IO_ENGINE_LAST
+} uct_tcp_io_engine_t;
+
 typedef ucs_callback_t uct_tcp_ep_progress_t;
 
 
@@ -225,7 +270,11 @@ typedef enum uct_tcp_ep_am_id {
     /* AM ID reserved for TCP internal PUT ACK message */
     UCT_TCP_EP_PUT_ACK_AM_ID   = UCT_AM_ID_MAX + 2,
     /* AM ID reserved for TCP internal keepalive message */
-    UCT_TCP_EP_KEEPALIVE_AM_ID = UCT_AM_ID_MAX + 3
+    UCT_TCP_EP_KEEPALIVE_AM_ID = UCT_AM_ID_MAX + 3,
+    /* AM ID reserved for TCP internal GET REQ message */
+    UCT_TCP_EP_GET_REQ_AM_ID   = UCT_AM_ID_MAX + 4,
+    /* AM ID reserved for TCP internal GET RSP message */
+    UCT_TCP_EP_GET_RSP_AM_ID   = UCT_AM_ID_MAX + 5
 } uct_tcp_ep_am_id_t;
 
 
@@ -248,14 +297,58 @@ typedef struct uct_tcp_ep_put_ack_hdr {
 
 
 /**
- * TCP PUT completion
+ * TCP GET request header
+ */
+typedef struct uct_tcp_ep_get_req_hdr {
+    uint64_t                      addr;        /* Address of a remote memory buffer */
+    size_t                        length;      /* Length of a remote memory buffer */
+} UCS_S_PACKED uct_tcp_ep_get_req_hdr_t;
+
+
+/**
+ * TCP GET response header
+ */
+typedef struct uct_tcp_ep_get_rsp_hdr {
+    size_t                        length;      /* Length of the data which follows
+                                                * the header */
+    int8_t                        status;      /* Status of the GET operation, no
+                                                * data follows if it failed */
+} UCS_S_PACKED uct_tcp_ep_get_rsp_hdr_t;
+
+
+/**
+ * TCP GET operation, used by the initiator to receive the response data and
+ * by the target to keep the requests waiting for TX resources
+ */
+typedef struct uct_tcp_ep_get_op {
+    uct_completion_t              *comp;       /* User's completion passed to
+                                                * uct_ep_get_zcopy */
+    uint64_t                      addr;        /* Address of the local buffer to
+                                                * receive to (initiator) or of the
+                                                * buffer to send from (target) */
+    size_t                        length;      /* Remaining length of the buffer */
+    uint32_t                      num_failed;  /* Number of requests received
+                                                * after this one, which are
+                                                * answered with an error (target) */
+    ucs_queue_elem_t              elem;        /* Element to insert the operation
+                                                * into TCP EP GET queues */
+} uct_tcp_ep_get_op_t;
+
+
+/**
+ * TCP PUT completion, also used to wait for MSG_ZEROCOPY notifications and
+ * GET operations
  */
 typedef struct uct_tcp_ep_put_completion {
     uct_completion_t              *comp;           /* User's completion passed to
                                                     * uct_ep_flush */
     uint32_t                      wait_put_sn;     /* Sequence number of the last unacked
                                                     * PUT operations that was in-progress
-                                                    * when uct_ep_flush was called */
+                                                    * when uct_ep_flush was called, or
+                                                    * number of MSG_ZEROCOPY sends which
+                                                    * have to be completed */
+    uint32_t                      wait_get_sn;     /* Number of GET operations which
+                                                    * have to be completed */
     ucs_queue_elem_t              elem;            /* Element to insert completion into
                                                     * TCP EP PUT operation pending queue */
 } uct_tcp_ep_put_completion_t;
@@ -283,6 +376,8 @@ typedef struct uct_tcp_ep_zcopy_tx {
     uct_completion_t              *comp;     /* Local UCT completion object */
     size_t                        iov_index; /* Current IOV index */
     size_t                        iov_cnt;   /* Number of IOVs that should be sent */
+    size_t                        hdr_iov_cnt; /* Number of IOVs with TCP and
+                                                * user's headers */
     struct iovec                  iov[0];    /* IOVs that should be sent */
 } uct_tcp_ep_zcopy_tx_t;
 
@@ -349,6 +444,26 @@ struct uct_tcp_ep {
     ucs_queue_head_t              pending_q;    /* Pending operations */
     ucs_queue_head_t              put_comp_q;   /* Flush completions waiting for
                                                  * outstanding PUTs acknowledgment */
+    struct {
+        uint32_t                  sent_sn;      /* Number of MSG_ZEROCOPY sends */
+        uint32_t                  comp_sn;      /* Number of completed MSG_ZEROCOPY
+                                                 * sends */
+        ucs_queue_head_t          comp_q;       /* Completions waiting for
+                                                 * MSG_ZEROCOPY notifications */
+    } msg_zcopy;
+    struct {
+        uint32_t                  sn;           /* Number of started GET operations */
+        uint32_t                  comp_sn;      /* Number of completed GET operations */
+        ucs_queue_head_t          op_q;         /* GET operations waiting for
+                                                 * the response data */
+        ucs_queue_head_t          rsp_q;        /* Received GET requests waiting
+                                                 * for TX resources to respond */
+        uint32_t                  rsp_num_failed; /* Number of requests to answer
+                                                   * with an error before the
+                                                   * head of rsp_q */
+        ucs_queue_head_t          comp_q;       /* Completions waiting for
+                                                 * outstanding GET operations */
+    } get;
     union {
         ucs_list_link_t           list;         /* List element to insert into TCP EP list */
         ucs_conn_match_elem_t     elem;         /* Connection matching element, used by EPs
@@ -375,6 +490,9 @@ typedef struct uct_tcp_iface {
     ucs_list_link_t               ep_list;           /* List of endpoints */
     char                          if_name[IFNAMSIZ]; /* Network interface name */
     ucs_sys_event_set_t           *event_set;        /* Event set identifier */
+    uct_tcp_uring_t               *uring;            /* io_uring for batched
+                                                      * receives, NULL if the
+                                                      * epoll engine is used */
     ucs_mpool_t                   tx_mpool;          /* TX memory pool */
     ucs_mpool_t                   rx_mpool;          /* RX memory pool */
     size_t                        outstanding;       /* How much data in the EP send buffers
@@ -396,13 +514,17 @@ typedef struct uct_tcp_iface {
             size_t                max_hdr;           /* Maximum supported AM Zcopy header */
             size_t                hdr_offset;        /* Offset in TX buffer to empty space that
                                                       * can be used for AM Zcopy header */
+            size_t                msg_zcopy_thresh;  /* Minimum Zcopy payload to send with
+                                                      * MSG_ZEROCOPY */
         } zcopy;
         struct sockaddr_storage   ifaddr;            /* Network address */
         struct sockaddr_storage   netmask;           /* Network address mask */
         size_t                    sockaddr_len;      /* Network address length */
         ucs_ternary_auto_value_t  ep_bind_src_addr;  /* Bind EP's FD to ifaddr */
+        uct_tcp_io_engine_t       io_engine;         /* Socket IO engine */
         int                       prefer_default;    /* Prefer default gateway */
         int                       put_enable;        /* Enable PUT Zcopy operation support */
+        int                       get_enable;        /* Enable GET Zcopy operation support */
         int                       conn_nb;           /* Use non-blocking connect() */
         unsigned                  max_poll;          /* Number of events to poll per socket*/
         uint8_t                   max_conn_retries;  /* How many connection establishment attempts
@@ -428,6 +550,7 @@ typedef struct uct_tcp_iface {
         int                       nodelay;           /* TCP_NODELAY */
         size_t                    sndbuf;            /* SO_SNDBUF */
         size_t                    rcvbuf;            /* SO_RCVBUF */
+        ucs_time_t                busy_poll;         /* SO_BUSY_POLL */
     } sockopt;
 } uct_tcp_iface_t;
 
@@ -441,12 +564,15 @@ typedef struct uct_tcp_iface_config {
     size_t                         rx_seg_size;
     size_t                         max_iov;
     size_t                         sendv_thresh;
+    size_t                         msg_zcopy_thresh;
     int                            prefer_default;
     int                            put_enable;
+    int                            get_enable;
     int                            conn_nb;
     unsigned                       max_poll;
     unsigned                       max_conn_retries;
     int                            sockopt_nodelay;
+    ucs_time_t                     sockopt_busy_poll;
     uct_tcp_send_recv_buf_config_t sockopt;
     unsigned                       syn_cnt;
     uct_iface_mpool_config_t       tx_mpool;
@@ -459,6 +585,7 @@ typedef struct uct_tcp_iface_config {
         ucs_time_t                 intvl;
     } keepalive;
     ucs_ternary_auto_value_t       ep_bind_src_addr;
+    uct_tcp_io_engine_t            io_engine;
 } uct_tcp_iface_config_t;
 
 
@@ -506,6 +633,7 @@ extern const char *uct_tcp_address_type_names[];
 extern const uct_tcp_cm_state_t uct_tcp_ep_cm_state[];
 extern const ucs_conn_match_ops_t uct_tcp_cm_conn_match_ops;
 extern const uct_tcp_ep_progress_t uct_tcp_ep_progress_rx_cb[];
+extern const char *uct_tcp_io_engine_names[];
 
 ucs_status_t uct_tcp_netif_caps(const char *if_name, double *latency_p,
                                 double *bandwidth_p);
@@ -516,7 +644,7 @@ int uct_tcp_sockaddr_cmp(const struct sockaddr *sa1,
                          const struct sockaddr *sa2);
 
 ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
-                                       int set_nb);
+                                       int set_nb, int *msg_zcopy_p);
 
 size_t uct_tcp_iface_get_max_iov(const uct_tcp_iface_t *iface);
 
@@ -588,6 +716,8 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, ucs_event_set_types_t add,
 
 void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep);
 
+unsigned uct_tcp_ep_msg_zcopy_progress(uct_tcp_ep_t *ep);
+
 ucs_status_t uct_tcp_ep_am_short(uct_ep_h uct_ep, uint8_t am_id, uint64_t header,
                                  const void *payload, unsigned length);
 
@@ -607,6 +737,10 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
                                   size_t iovcnt, uint64_t remote_addr,
                                   uct_rkey_t rkey, uct_completion_t *comp);
 
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp);
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags);
 
@@ -654,6 +788,23 @@ ucs_status_t uct_tcp_cm_conn_start(uct_tcp_ep_t *ep);
 
 int uct_tcp_keepalive_is_enabled(uct_tcp_iface_t *iface);
 
+int uct_tcp_ep_uring_prep_rx(uct_tcp_ep_t *ep);
+
+unsigned uct_tcp_ep_uring_complete_rx(void *user_data, int result, void *arg);
+
+ucs_status_t uct_tcp_uring_create(unsigned entries, uct_tcp_uring_t **uring_p);
+
+void uct_tcp_uring_destroy(uct_tcp_uring_t *uring);
+
+ucs_status_t uct_tcp_uring_prep_recv(uct_tcp_uring_t *uring, int fd,
+                                     void *buffer, size_t length,
+                                     void *user_data);
+
+unsigned uct_tcp_uring_submit(uct_tcp_uring_t *uring,
+                              uct_tcp_uring_complete_cb_t cb, void *arg);
+
+void uct_tcp_uring_cancel(uct_tcp_uring_t *uring, void *user_data);
+
 static UCS_F_ALWAYS_INLINE int uct_tcp_ep_ctx_buf_empty(uct_tcp_ep_ctx_t *ctx)
 {
     ucs_assert((ctx->length == 0) || (ctx->buf != NULL));
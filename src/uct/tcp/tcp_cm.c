@@ -473,7 +473,9 @@ uct_tcp_cm_simult_conn_accept_remote_conn(uct_tcp_ep_t *accept_ep,
                 "Requested epoll events must be 0-ed for ep=%p", connect_ep);
 
     ucs_close_fd(&connect_ep->fd);
-    connect_ep->fd = accept_ep->fd;
+    connect_ep->fd     = accept_ep->fd;
+    connect_ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_SOCK;
+    connect_ep->flags |= accept_ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_SOCK;
 
     /* 2. Migrate RX from the EP allocated during accepting connection to
      *    the found EP */
@@ -814,6 +816,7 @@ ucs_status_t uct_tcp_cm_handle_incoming_conn(uct_tcp_iface_t *iface,
     char str_remote_addr[UCS_SOCKADDR_STRING_LEN];
     ucs_status_t status;
     uct_tcp_ep_t *ep;
+    int msg_zcopy;
 
     if (!ucs_socket_is_connected(fd)) {
         ucs_warn("tcp_iface %p: connection establishment for socket fd %d "
@@ -827,7 +830,7 @@ ucs_status_t uct_tcp_cm_handle_incoming_conn(uct_tcp_iface_t *iface,
 
     /* set non-blocking flag, since this is a fd from accept(), i.e.
      * connection was already established */
-    status = uct_tcp_iface_set_sockopt(iface, fd, 1);
+    status = uct_tcp_iface_set_sockopt(iface, fd, 1, &msg_zcopy);
     if (status != UCS_OK) {
         return status;
     }
@@ -837,6 +840,10 @@ ucs_status_t uct_tcp_cm_handle_incoming_conn(uct_tcp_iface_t *iface,
         return status;
     }
 
+    if (msg_zcopy) {
+        ep->flags |= UCT_TCP_EP_FLAG_MSG_ZCOPY_SOCK;
+    }
+
     uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_RECV_MAGIC_NUMBER);
     uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVREAD, 0);
 
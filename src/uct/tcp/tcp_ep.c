@@ -19,6 +19,7 @@ static unsigned uct_tcp_ep_progress_data_tx(void *arg);
 static unsigned uct_tcp_ep_progress_data_rx(void *arg);
 static unsigned uct_tcp_ep_progress_magic_number_rx(void *arg);
 static unsigned uct_tcp_ep_destroy_progress(void *arg);
+static void uct_tcp_ep_post_get_rsp(uct_tcp_ep_t *ep);
 
 const uct_tcp_cm_state_t uct_tcp_ep_cm_state[] = {
     [UCT_TCP_EP_CONN_STATE_CLOSED] = {
@@ -61,10 +62,34 @@ static inline int uct_tcp_ep_ctx_buf_need_progress(uct_tcp_ep_ctx_t *ctx)
     return ctx->offset < ctx->length;
 }
 
+static UCS_F_ALWAYS_INLINE uint32_t
+uct_tcp_ep_msg_zcopy_inflight(const uct_tcp_ep_t *ep)
+{
+    return ep->msg_zcopy.sent_sn - ep->msg_zcopy.comp_sn;
+}
+
+static UCS_F_ALWAYS_INLINE int uct_tcp_ep_get_inflight(const uct_tcp_ep_t *ep)
+{
+    return ep->get.sn != ep->get.comp_sn;
+}
+
+static UCS_F_ALWAYS_INLINE int
+uct_tcp_ep_get_rsp_pending(const uct_tcp_ep_t *ep)
+{
+    return !ucs_queue_is_empty(&ep->get.rsp_q) || (ep->get.rsp_num_failed > 0);
+}
+
+static UCS_F_ALWAYS_INLINE int uct_tcp_ep_tx_ready(uct_tcp_ep_t *ep)
+{
+    return uct_tcp_ep_ctx_buf_empty(&ep->tx) &&
+           (uct_tcp_ep_msg_zcopy_inflight(ep) <
+            UCT_TCP_EP_MSG_ZCOPY_MAX_INFLIGHT);
+}
+
 static inline ucs_status_t uct_tcp_ep_check_tx_res(uct_tcp_ep_t *ep)
 {
     if (ucs_likely((ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) &&
-                   uct_tcp_ep_ctx_buf_empty(&ep->tx))) {
+                   uct_tcp_ep_tx_ready(ep))) {
         return UCS_OK;
     } else if (ucs_unlikely(ep->conn_state == UCT_TCP_EP_CONN_STATE_CLOSED)) {
         return UCS_ERR_CONNECTION_RESET;
@@ -75,6 +100,11 @@ static inline ucs_status_t uct_tcp_ep_check_tx_res(uct_tcp_ep_t *ep)
                                   UCT_TCP_EP_FLAG_CTX_TYPE_RX)) &&
                    (ep->flags & UCT_TCP_EP_FLAG_CONNECT_TO_EP));
         return UCS_ERR_NO_RESOURCE;
+    } else if ((ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) &&
+               uct_tcp_ep_ctx_buf_empty(&ep->tx)) {
+        /* too many MSG_ZEROCOPY sends are in-flight, their completions are
+         * reported by error events on the socket */
+        return UCS_ERR_NO_RESOURCE;
     }
 
     ucs_assertv((ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTING) ||
@@ -130,8 +160,28 @@ int uct_tcp_ep_is_self(const uct_tcp_ep_t *ep)
     return uct_tcp_iface_is_self_addr(iface, (struct sockaddr*)&ep->peer_addr);
 }
 
+static void uct_tcp_ep_msg_zcopy_reset(uct_tcp_ep_t *ep, ucs_status_t status)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_put_completion_t *put_comp;
+
+    /* notifications are not reported after the socket is closed */
+    ucs_queue_for_each_extract(put_comp, &ep->msg_zcopy.comp_q, elem, 1) {
+        uct_invoke_completion(put_comp->comp, status);
+        ucs_mpool_put_inline(put_comp);
+    }
+
+    if (uct_tcp_ep_msg_zcopy_inflight(ep) != 0) {
+        ep->msg_zcopy.comp_sn = ep->msg_zcopy.sent_sn;
+        uct_tcp_iface_outstanding_dec(iface);
+    }
+}
+
 static void uct_tcp_ep_cleanup(uct_tcp_ep_t *ep)
 {
+    uct_tcp_ep_msg_zcopy_reset(ep, UCS_ERR_CANCELED);
+
     if (ep->tx.buf != NULL) {
         uct_tcp_ep_ctx_reset(&ep->tx);
     }
@@ -241,6 +291,16 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface, int fd,
     ucs_list_head_init(&self->list);
     ucs_queue_head_init(&self->pending_q);
     ucs_queue_head_init(&self->put_comp_q);
+    ucs_queue_head_init(&self->msg_zcopy.comp_q);
+    ucs_queue_head_init(&self->get.op_q);
+    ucs_queue_head_init(&self->get.rsp_q);
+    ucs_queue_head_init(&self->get.comp_q);
+
+    self->msg_zcopy.sent_sn = 0;
+    self->msg_zcopy.comp_sn = 0;
+    self->get.sn             = 0;
+    self->get.comp_sn        = 0;
+    self->get.rsp_num_failed = 0;
 
     if (dest_addr != NULL) {
         memcpy(&self->peer_addr[0], dest_addr, iface->config.sockaddr_len);
@@ -341,19 +401,102 @@ uct_tcp_ep_tx_completed(uct_tcp_ep_t *ep, size_t sent_length)
     ep->tx.offset      += sent_length;
 }
 
+static UCS_F_ALWAYS_INLINE void uct_tcp_ep_msg_zcopy_sent(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    if (uct_tcp_ep_msg_zcopy_inflight(ep) == 0) {
+        uct_tcp_iface_outstanding_inc(iface);
+    }
+
+    ep->msg_zcopy.sent_sn++;
+}
+
+/* Invoke the completion if the MSG_ZEROCOPY sends and GET operations it waits
+ * for are completed, otherwise add it to the queue of the first uncompleted
+ * kind of operations */
+static void uct_tcp_ep_comp_progress(uct_tcp_ep_t *ep,
+                                     uct_tcp_ep_put_completion_t *put_comp)
+{
+    if (UCS_CIRCULAR_COMPARE32(put_comp->wait_put_sn, >,
+                               ep->msg_zcopy.comp_sn)) {
+        ucs_queue_push(&ep->msg_zcopy.comp_q, &put_comp->elem);
+    } else if (UCS_CIRCULAR_COMPARE32(put_comp->wait_get_sn, >,
+                                      ep->get.comp_sn)) {
+        ucs_queue_push(&ep->get.comp_q, &put_comp->elem);
+    } else {
+        uct_invoke_completion(put_comp->comp, UCS_OK);
+        ucs_mpool_put_inline(put_comp);
+    }
+}
+
+/* Add the completion which waits for the outstanding MSG_ZEROCOPY sends and
+ * GET operations */
+static ucs_status_t
+uct_tcp_ep_outstanding_comp_add(uct_tcp_ep_t *ep, uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_put_completion_t *put_comp;
+
+    if ((uct_tcp_ep_msg_zcopy_inflight(ep) == 0) &&
+        !uct_tcp_ep_get_inflight(ep)) {
+        return UCS_OK;
+    }
+
+    if (comp != NULL) {
+        put_comp = ucs_mpool_get_inline(&iface->tx_mpool);
+        if (ucs_unlikely(put_comp == NULL)) {
+            ucs_error("tcp_ep %p: unable to allocate outstanding operations "
+                      "completion from mpool", ep);
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        put_comp->wait_put_sn = ep->msg_zcopy.sent_sn;
+        put_comp->wait_get_sn = ep->get.sn;
+        put_comp->comp        = comp;
+        uct_tcp_ep_comp_progress(ep, put_comp);
+    }
+
+    return UCS_INPROGRESS;
+}
+
 static UCS_F_ALWAYS_INLINE void
 uct_tcp_ep_zcopy_completed(uct_tcp_ep_t *ep, uct_completion_t *comp,
                            ucs_status_t status)
 {
-    ep->flags &= ~UCT_TCP_EP_FLAG_ZCOPY_TX;
-    if (comp != NULL) {
+    if ((ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX) && (status == UCS_OK)) {
+        /* the user's buffers can be still referenced by the kernel */
+        status = uct_tcp_ep_outstanding_comp_add(ep, comp);
+    }
+
+    ep->flags &= ~(UCT_TCP_EP_FLAG_ZCOPY_TX | UCT_TCP_EP_FLAG_MSG_ZCOPY_TX);
+    if ((comp != NULL) && (status != UCS_INPROGRESS)) {
         uct_invoke_completion(comp, status);
     }
 }
 
+static void uct_tcp_ep_get_completed(uct_tcp_ep_t *ep,
+                                     uct_tcp_ep_get_op_t *get_op,
+                                     ucs_status_t status)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    if (get_op->comp != NULL) {
+        uct_invoke_completion(get_op->comp, status);
+    }
+
+    ucs_mpool_put_inline(get_op);
+    ep->get.comp_sn++;
+    uct_tcp_iface_outstanding_dec(iface);
+}
+
 static void uct_tcp_ep_purge(uct_tcp_ep_t *ep, ucs_status_t status)
 {
     uct_tcp_ep_put_completion_t *put_comp;
+    uct_tcp_ep_get_op_t *get_op;
     uct_tcp_ep_zcopy_tx_t *ctx;
 
     ucs_debug("tcp_ep %p: purge outstanding operations with status %s", ep,
@@ -369,6 +512,31 @@ static void uct_tcp_ep_purge(uct_tcp_ep_t *ep, ucs_status_t status)
         uct_invoke_completion(put_comp->comp, status);
         ucs_mpool_put_inline(put_comp);
     }
+
+    ucs_queue_for_each_extract(put_comp, &ep->msg_zcopy.comp_q, elem, 1) {
+        uct_invoke_completion(put_comp->comp, status);
+        ucs_mpool_put_inline(put_comp);
+    }
+
+    if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_GET_RX;
+        if (ep->rx.buf != NULL) {
+            uct_tcp_ep_ctx_reset(&ep->rx);
+        }
+    }
+
+    ucs_queue_for_each_extract(get_op, &ep->get.op_q, elem, 1) {
+        uct_tcp_ep_get_completed(ep, get_op, status);
+    }
+
+    ucs_queue_for_each_extract(put_comp, &ep->get.comp_q, elem, 1) {
+        uct_invoke_completion(put_comp->comp, status);
+        ucs_mpool_put_inline(put_comp);
+    }
+
+    ucs_queue_for_each_extract(get_op, &ep->get.rsp_q, elem, 1) {
+        ucs_mpool_put_inline(get_op);
+    }
 }
 
 static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
@@ -391,6 +559,11 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
         uct_tcp_ep_ptr_map_del(self);
     }
 
+    if (self->flags & UCT_TCP_EP_FLAG_URING_RX) {
+        /* the posted receive refers to the EP and to its RX buffer */
+        uct_tcp_uring_cancel(iface->uring, self);
+    }
+
     uct_tcp_ep_remove_ctx_cap(self, UCT_TCP_EP_CTX_CAPS);
     uct_tcp_ep_purge(self, UCS_ERR_CANCELED);
 
@@ -678,6 +851,7 @@ static ucs_status_t uct_tcp_ep_create_socket_and_connect(uct_tcp_ep_t *ep)
                                             uct_tcp_iface_t);
     struct sockaddr *saddr = (struct sockaddr*)ep->peer_addr;
     ucs_status_t status;
+    int msg_zcopy;
 
     status = ucs_socket_create(saddr->sa_family, SOCK_STREAM, 0, &ep->fd);
     if (status != UCS_OK) {
@@ -689,11 +863,18 @@ static ucs_status_t uct_tcp_ep_create_socket_and_connect(uct_tcp_ep_t *ep)
         goto err;
     }
 
-    status = uct_tcp_iface_set_sockopt(iface, ep->fd, iface->config.conn_nb);
+    status = uct_tcp_iface_set_sockopt(iface, ep->fd, iface->config.conn_nb,
+                                       &msg_zcopy);
     if (status != UCS_OK) {
         goto err;
     }
 
+    if (msg_zcopy) {
+        ep->flags |= UCT_TCP_EP_FLAG_MSG_ZCOPY_SOCK;
+    } else {
+        ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_SOCK;
+    }
+
     status = uct_tcp_ep_keepalive_enable(ep);
     if (status != UCS_OK) {
         goto err;
@@ -724,8 +905,10 @@ void uct_tcp_ep_replace_ep(uct_tcp_ep_t *to_ep, uct_tcp_ep_t *from_ep)
     int events             = from_ep->events;
 
     uct_tcp_ep_mod_events(from_ep, 0, from_ep->events);
-    to_ep->fd   = from_ep->fd;
-    from_ep->fd = -1;
+    to_ep->fd     = from_ep->fd;
+    from_ep->fd   = -1;
+    to_ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_SOCK;
+    to_ep->flags |= from_ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_SOCK;
     uct_tcp_ep_mod_events(to_ep, events, 0);
 
     to_ep->conn_retries++;
@@ -736,6 +919,22 @@ void uct_tcp_ep_replace_ep(uct_tcp_ep_t *to_ep, uct_tcp_ep_t *from_ep)
     ucs_queue_splice(&to_ep->pending_q, &from_ep->pending_q);
     ucs_queue_splice(&to_ep->put_comp_q, &from_ep->put_comp_q);
 
+    if (ucs_queue_is_empty(&to_ep->get.rsp_q)) {
+        to_ep->get.rsp_num_failed += from_ep->get.rsp_num_failed;
+    } else {
+        ucs_queue_tail_elem_non_empty(&to_ep->get.rsp_q, uct_tcp_ep_get_op_t,
+                                      elem)->num_failed +=
+                from_ep->get.rsp_num_failed;
+    }
+    from_ep->get.rsp_num_failed = 0;
+    ucs_queue_splice(&to_ep->get.rsp_q, &from_ep->get.rsp_q);
+
+    /* MSG_ZEROCOPY sends and GET requests are done only on connected EPs */
+    ucs_assert(uct_tcp_ep_msg_zcopy_inflight(to_ep) == 0);
+    ucs_assert(uct_tcp_ep_msg_zcopy_inflight(from_ep) == 0);
+    ucs_assert(!uct_tcp_ep_get_inflight(to_ep));
+    ucs_assert(!uct_tcp_ep_get_inflight(from_ep));
+
     to_ep->flags |= from_ep->flags & (UCT_TCP_EP_FLAG_ZCOPY_TX           |
                                       UCT_TCP_EP_FLAG_PUT_RX             |
                                       UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK |
@@ -1028,8 +1227,10 @@ static inline void uct_tcp_ep_handle_put_ack(uct_tcp_ep_t *ep,
     ucs_queue_for_each_extract(put_comp, &ep->put_comp_q, elem,
                                (UCS_CIRCULAR_COMPARE32(put_comp->wait_put_sn,
                                                        <=, put_ack->sn))) {
-        uct_invoke_completion(put_comp->comp, UCS_OK);
-        ucs_mpool_put_inline(put_comp);
+        /* PUT data could be sent with MSG_ZEROCOPY, so the completion
+         * has to wait until the kernel releases the user's buffers */
+        put_comp->wait_put_sn = ep->msg_zcopy.sent_sn;
+        uct_tcp_ep_comp_progress(ep, put_comp);
     }
 }
 
@@ -1037,14 +1238,58 @@ void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep)
 {
     uct_pending_req_priv_queue_t *priv;
 
-    uct_pending_queue_dispatch(priv, &ep->pending_q,
-                               uct_tcp_ep_ctx_buf_empty(&ep->tx));
+    uct_pending_queue_dispatch(priv, &ep->pending_q, uct_tcp_ep_tx_ready(ep));
     if (uct_tcp_ep_ctx_buf_empty(&ep->tx)) {
-        ucs_assert(ucs_queue_is_empty(&ep->pending_q));
+        ucs_assert(ucs_queue_is_empty(&ep->pending_q) ||
+                   !uct_tcp_ep_tx_ready(ep));
         uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVWRITE);
     }
 }
 
+unsigned uct_tcp_ep_msg_zcopy_progress(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_put_completion_t *put_comp;
+    ucs_status_t status;
+    uint32_t count;
+
+    if (uct_tcp_ep_msg_zcopy_inflight(ep) == 0) {
+        return 0;
+    }
+
+    status = ucs_socket_zcopy_completions(ep->fd, &count);
+    if (status != UCS_OK) {
+        /* socket errors are detected and handled by the data progress */
+        return 0;
+    }
+
+    ucs_assertv(count <= uct_tcp_ep_msg_zcopy_inflight(ep),
+                "tcp_ep %p: count=%u inflight=%u", ep, count,
+                uct_tcp_ep_msg_zcopy_inflight(ep));
+    ep->msg_zcopy.comp_sn += count;
+    if (uct_tcp_ep_msg_zcopy_inflight(ep) == 0) {
+        uct_tcp_iface_outstanding_dec(iface);
+    }
+
+    ucs_queue_for_each_extract(put_comp, &ep->msg_zcopy.comp_q, elem,
+                               UCS_CIRCULAR_COMPARE32(put_comp->wait_put_sn,
+                                                      <=,
+                                                      ep->msg_zcopy.comp_sn)) {
+        uct_tcp_ep_comp_progress(ep, put_comp);
+    }
+
+    if (uct_tcp_ep_get_rsp_pending(ep)) {
+        uct_tcp_ep_post_get_rsp(ep);
+    }
+
+    if (!ucs_queue_is_empty(&ep->pending_q)) {
+        uct_tcp_ep_pending_queue_dispatch(ep);
+    }
+
+    return 1;
+}
+
 static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep, ucs_status_t status)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -1126,6 +1371,45 @@ static inline ssize_t uct_tcp_ep_send(uct_tcp_ep_t *ep)
     return sent_length;
 }
 
+static ucs_status_t
+uct_tcp_ep_msg_zcopy_sendv(uct_tcp_ep_t *ep, uct_tcp_ep_zcopy_tx_t *ctx,
+                           size_t *length_p)
+{
+    struct iovec *iov = &ctx->iov[ctx->iov_index];
+    size_t iov_cnt    = ctx->iov_cnt - ctx->iov_index;
+    size_t hdr_iov_cnt, sent_length;
+    ucs_status_t status;
+
+    *length_p = 0;
+
+    /* the headers are located in the TX buffer, which is reused as soon as
+     * the operation is completed, so they have to be copied by the kernel */
+    if (ctx->iov_index < ctx->hdr_iov_cnt) {
+        hdr_iov_cnt = ctx->hdr_iov_cnt - ctx->iov_index;
+        status      = ucs_socket_sendmsg_nb(ep->fd, iov, hdr_iov_cnt, MSG_MORE,
+                                            length_p);
+        if ((status != UCS_OK) ||
+            (*length_p < ucs_iovec_total_length(iov, hdr_iov_cnt))) {
+            return status;
+        }
+
+        iov     += hdr_iov_cnt;
+        iov_cnt -= hdr_iov_cnt;
+    }
+
+    status = ucs_socket_sendmsg_nb(ep->fd, iov, iov_cnt,
+                                   UCS_SOCKET_MSG_ZEROCOPY, &sent_length);
+    if (status == UCS_OK) {
+        uct_tcp_ep_msg_zcopy_sent(ep);
+        *length_p += sent_length;
+    } else if ((status == UCS_ERR_NO_PROGRESS) && (*length_p > 0)) {
+        /* the headers were sent */
+        return UCS_OK;
+    }
+
+    return status;
+}
+
 static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
 {
     uct_tcp_ep_zcopy_tx_t *ctx = (uct_tcp_ep_zcopy_tx_t*)ep->tx.buf;
@@ -1135,8 +1419,14 @@ static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
     ucs_assertv((ep->tx.offset < ep->tx.length) &&
                 (ctx->iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, &ctx->iov[ctx->iov_index],
-                                 ctx->iov_cnt - ctx->iov_index, &sent_length);
+    if (ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX) {
+        status = uct_tcp_ep_msg_zcopy_sendv(ep, ctx, &sent_length);
+    } else {
+        status = ucs_socket_sendv_nb(ep->fd, &ctx->iov[ctx->iov_index],
+                                     ctx->iov_cnt - ctx->iov_index,
+                                     &sent_length);
+    }
+
     if (ucs_unlikely(status != UCS_OK)) {
         if (status == UCS_ERR_NO_PROGRESS) {
             ucs_assert(sent_length == 0);
@@ -1242,6 +1532,7 @@ ucs_status_t uct_tcp_ep_handle_io_err(uct_tcp_ep_t *ep, const char *op_str,
         return io_status;
     } else if ((io_status == UCS_ERR_NOT_CONNECTED) &&
                (ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED)) {
+        uct_tcp_ep_msg_zcopy_reset(ep, io_status);
         uct_tcp_ep_mod_events(ep, 0, ep->events);
         ucs_close_fd(&ep->fd);
         /* if this connection is needed for the local side, it will be
@@ -1280,19 +1571,13 @@ static inline void uct_tcp_ep_handle_recv_err(uct_tcp_ep_t *ep,
     }
 }
 
-static inline unsigned uct_tcp_ep_recv(uct_tcp_ep_t *ep, size_t recv_length)
+static inline unsigned
+uct_tcp_ep_recv_handle(uct_tcp_ep_t *ep, ucs_status_t status,
+                       size_t recv_length)
 {
     uct_tcp_iface_t UCS_V_UNUSED *iface = ucs_derived_of(ep->super.super.iface,
                                                          uct_tcp_iface_t);
-    ucs_status_t status;
-
-    if (ucs_unlikely(recv_length == 0)) {
-        return 1;
-    }
 
-    status = ucs_socket_recv_nb(ep->fd, UCS_PTR_BYTE_OFFSET(ep->rx.buf,
-                                                            ep->rx.length), 0,
-                                &recv_length);
     if (ucs_unlikely(status != UCS_OK)) {
         uct_tcp_ep_handle_recv_err(ep, status);
         return 0;
@@ -1307,6 +1592,20 @@ static inline unsigned uct_tcp_ep_recv(uct_tcp_ep_t *ep, size_t recv_length)
     return 1;
 }
 
+static inline unsigned uct_tcp_ep_recv(uct_tcp_ep_t *ep, size_t recv_length)
+{
+    ucs_status_t status;
+
+    if (ucs_unlikely(recv_length == 0)) {
+        return 1;
+    }
+
+    status = ucs_socket_recv_nb(ep->fd, UCS_PTR_BYTE_OFFSET(ep->rx.buf,
+                                                            ep->rx.length), 0,
+                                &recv_length);
+    return uct_tcp_ep_recv_handle(ep, status, recv_length);
+}
+
 static inline void uct_tcp_ep_check_tx_completion(uct_tcp_ep_t *ep)
 {
     if (ucs_likely(!uct_tcp_ep_ctx_buf_need_progress(&ep->tx))) {
@@ -1347,12 +1646,18 @@ static unsigned uct_tcp_ep_progress_data_tx(void *arg)
         uct_tcp_ep_post_put_ack(ep);
     }
 
+    if (uct_tcp_ep_get_rsp_pending(ep)) {
+        uct_tcp_ep_post_get_rsp(ep);
+    }
+
     if (!ucs_queue_is_empty(&ep->pending_q)) {
         uct_tcp_ep_pending_queue_dispatch(ep);
         return ret;
     }
 
-    if (uct_tcp_ep_ctx_buf_empty(&ep->tx)) {
+    /* keep polling for TX readiness while GET responses wait for TX
+     * resources, to retry sending them */
+    if (uct_tcp_ep_ctx_buf_empty(&ep->tx) && !uct_tcp_ep_get_rsp_pending(ep)) {
         ucs_assert(ucs_queue_is_empty(&ep->pending_q));
         uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVWRITE);
     }
@@ -1431,17 +1736,122 @@ static inline void uct_tcp_ep_handle_put_req(uct_tcp_ep_t *ep,
     ep->flags |= UCT_TCP_EP_FLAG_PUT_RX;
 }
 
-static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
+static inline void uct_tcp_ep_handle_get_req(uct_tcp_ep_t *ep,
+                                             uct_tcp_ep_get_req_hdr_t *get_req)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
-    unsigned handled       = 0;
+    uct_tcp_ep_get_op_t *get_op;
+
+    ucs_assert(get_req->addr || !get_req->length);
+
+    get_op = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_likely(get_op != NULL)) {
+        get_op->comp       = NULL;
+        get_op->addr       = get_req->addr;
+        get_op->length     = get_req->length;
+        get_op->num_failed = 0;
+        ucs_queue_push(&ep->get.rsp_q, &get_op->elem);
+    } else {
+        /* the responses are matched to the requests by their order, so the
+         * error response is sent after the responses to the previous
+         * requests */
+        ucs_diag("tcp_ep %p: unable to allocate GET response from mpool, "
+                 "responding with an error", ep);
+        if (ucs_queue_is_empty(&ep->get.rsp_q)) {
+            ep->get.rsp_num_failed++;
+        } else {
+            ucs_queue_tail_elem_non_empty(&ep->get.rsp_q, uct_tcp_ep_get_op_t,
+                                          elem)->num_failed++;
+        }
+    }
+
+    uct_tcp_ep_post_get_rsp(ep);
+}
+
+/* Complete the oldest outstanding GET operation */
+static void uct_tcp_ep_get_op_done(uct_tcp_ep_t *ep,
+                                   uct_tcp_ep_get_op_t *get_op,
+                                   ucs_status_t status)
+{
+    uct_tcp_ep_put_completion_t *put_comp;
+
+    ucs_queue_pull_non_empty(&ep->get.op_q);
+    uct_tcp_ep_get_completed(ep, get_op, status);
+
+    ucs_queue_for_each_extract(put_comp, &ep->get.comp_q, elem,
+                               UCS_CIRCULAR_COMPARE32(put_comp->wait_get_sn,
+                                                      <=, ep->get.comp_sn)) {
+        uct_tcp_ep_comp_progress(ep, put_comp);
+    }
+}
+
+static inline ucs_status_t
+uct_tcp_ep_get_rx_advance(uct_tcp_ep_t *ep, uct_tcp_ep_get_op_t *get_op,
+                          size_t recv_length)
+{
+    ucs_assert(recv_length <= get_op->length);
+    get_op->addr   += recv_length;
+    get_op->length -= recv_length;
+
+    if (get_op->length != 0) {
+        return UCS_INPROGRESS;
+    }
+
+    if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_GET_RX;
+        uct_tcp_ep_ctx_reset(&ep->rx);
+    }
+
+    uct_tcp_ep_get_op_done(ep, get_op, UCS_OK);
+    return UCS_OK;
+}
+
+static inline void uct_tcp_ep_handle_get_rsp(uct_tcp_ep_t *ep,
+                                             uct_tcp_ep_get_rsp_hdr_t *get_rsp,
+                                             size_t extra_recvd_length)
+{
+    uct_tcp_ep_get_op_t *get_op;
+    size_t copied_length;
+
+    ucs_assertv(!ucs_queue_is_empty(&ep->get.op_q), "ep=%p", ep);
+    get_op = ucs_queue_head_elem_non_empty(&ep->get.op_q, uct_tcp_ep_get_op_t,
+                                           elem);
+    if (ucs_unlikely(get_rsp->status != UCS_OK)) {
+        ucs_assertv(get_rsp->length == 0, "ep=%p: GET error response length "
+                    "%zu", ep, get_rsp->length);
+        uct_tcp_ep_get_op_done(ep, get_op, (ucs_status_t)get_rsp->status);
+        return;
+    }
+
+    ucs_assertv(get_op->length == get_rsp->length,
+                "ep=%p: GET length %zu, response length %zu", ep,
+                get_op->length, get_rsp->length);
+
+    copied_length  = ucs_min(get_op->length, extra_recvd_length);
+    memcpy((void*)(uintptr_t)get_op->addr,
+           UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset), copied_length);
+    ep->rx.offset += copied_length;
+
+    if (uct_tcp_ep_get_rx_advance(ep, get_op, copied_length) == UCS_OK) {
+        return;
+    }
+
+    /* The rest of the response data is received directly to the user's
+     * buffer, keep EP RX buffer allocated until the receive is completed */
+    ucs_assert(ep->rx.offset == ep->rx.length);
+    uct_tcp_ep_ctx_rewind(&ep->rx);
+    ep->flags |= UCT_TCP_EP_FLAG_GET_RX;
+}
+
+/* Get the length of the next receive to the EP RX buffer, allocate the buffer
+ * if needed. Returns 0 if there are no resources to receive. */
+static inline int uct_tcp_ep_am_rx_prepare(uct_tcp_iface_t *iface,
+                                           uct_tcp_ep_t *ep,
+                                           size_t *recv_length_p)
+{
     uct_tcp_am_hdr_t *hdr;
-    size_t recv_length;
     size_t recvd_length;
-    size_t remaining;
-
-    ucs_trace_func("ep=%p", ep);
 
     if (!uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
         if (ucs_unlikely(uct_tcp_ep_ctx_buf_alloc(
@@ -1450,26 +1860,33 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
         }
 
         /* post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size;
+        *recv_length_p = iface->config.rx_seg_size;
     } else if (ep->rx.length < sizeof(*hdr)) {
         ucs_assert((ep->rx.buf != NULL) && (ep->rx.offset == 0));
 
         /* do partial receive of the remaining part of the hdr
          * and post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size - ep->rx.length;
+        *recv_length_p = iface->config.rx_seg_size - ep->rx.length;
     } else {
         ucs_assert((ep->rx.buf != NULL) &&
                    ((ep->rx.length - ep->rx.offset) >= sizeof(*hdr)));
 
         /* do partial receive of the remaining user data */
-        hdr          = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
-        recvd_length = ep->rx.length - ep->rx.offset - sizeof(*hdr);
-        recv_length  = ucs_max(0, (ssize_t)(hdr->length - recvd_length));
+        hdr            = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
+        recvd_length   = ep->rx.length - ep->rx.offset - sizeof(*hdr);
+        *recv_length_p = ucs_max(0, (ssize_t)(hdr->length - recvd_length));
     }
 
-    if (!uct_tcp_ep_recv(ep, recv_length)) {
-        goto out;
-    }
+    return 1;
+}
+
+/* Handle the active messages which were received to the EP RX buffer */
+static unsigned uct_tcp_ep_am_rx_handle(uct_tcp_iface_t *iface,
+                                        uct_tcp_ep_t *ep)
+{
+    unsigned handled = 0;
+    uct_tcp_am_hdr_t *hdr;
+    size_t remaining;
 
     /* Parse received active messages */
     while (uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
@@ -1526,6 +1943,20 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
             ucs_assert(hdr->length == sizeof(uint32_t));
             uct_tcp_ep_handle_put_ack(ep, (uct_tcp_ep_put_ack_hdr_t*)(hdr + 1));
             handled++;
+        } else if (hdr->am_id == UCT_TCP_EP_GET_REQ_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_req_hdr_t));
+            uct_tcp_ep_handle_get_req(ep, (uct_tcp_ep_get_req_hdr_t*)(hdr + 1));
+            handled++;
+        } else if (hdr->am_id == UCT_TCP_EP_GET_RSP_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_rsp_hdr_t));
+            uct_tcp_ep_handle_get_rsp(ep, (uct_tcp_ep_get_rsp_hdr_t*)(hdr + 1),
+                                      ep->rx.length - ep->rx.offset);
+            handled++;
+            if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+                /* GET RX is in progress, the rest of the response data is
+                 * received directly to the user's buffer */
+                goto out;
+            }
         } else if (hdr->am_id == UCT_TCP_EP_KEEPALIVE_AM_ID) {
             /* just ignore keepalive requests */
             handled++;
@@ -1547,6 +1978,76 @@ out:
     return handled;
 }
 
+static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    size_t recv_length;
+
+    ucs_trace_func("ep=%p", ep);
+
+    if (!uct_tcp_ep_am_rx_prepare(iface, ep, &recv_length) ||
+        !uct_tcp_ep_recv(ep, recv_length)) {
+        return 0;
+    }
+
+    return uct_tcp_ep_am_rx_handle(iface, ep);
+}
+
+int uct_tcp_ep_uring_prep_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    size_t recv_length;
+
+    /* only AM data receive of connected EPs is batched, connection
+     * establishment and PUT/GET receive are done in place */
+    if ((ep->conn_state != UCT_TCP_EP_CONN_STATE_CONNECTED) ||
+        (ep->flags & (UCT_TCP_EP_FLAG_PUT_RX | UCT_TCP_EP_FLAG_GET_RX))) {
+        return 0;
+    }
+
+    if (!uct_tcp_ep_am_rx_prepare(iface, ep, &recv_length) ||
+        (recv_length == 0)) {
+        return 0;
+    }
+
+    if (uct_tcp_uring_prep_recv(iface->uring, ep->fd,
+                                UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.length),
+                                recv_length, ep) != UCS_OK) {
+        if (ep->rx.length == 0) {
+            /* release the buffer allocated above, it will be allocated again
+             * by the in-place receive */
+            uct_tcp_ep_ctx_reset(&ep->rx);
+        }
+
+        return 0;
+    }
+
+    ep->flags |= UCT_TCP_EP_FLAG_URING_RX;
+    return 1;
+}
+
+unsigned uct_tcp_ep_uring_complete_rx(void *user_data, int result, void *arg)
+{
+    uct_tcp_ep_t *ep       = (uct_tcp_ep_t*)user_data;
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    size_t recv_length;
+    ucs_status_t status;
+
+    ucs_trace_func("ep=%p result=%d", ep, result);
+
+    ep->flags &= ~UCT_TCP_EP_FLAG_URING_RX;
+    status = ucs_socket_io_result(ep->fd, "recv", (result < 0) ? -1 : result,
+                                  (result < 0) ? -result : 0, &recv_length);
+    if (!uct_tcp_ep_recv_handle(ep, status, recv_length)) {
+        return 0;
+    }
+
+    return uct_tcp_ep_am_rx_handle(iface, ep);
+}
+
 static inline ucs_status_t
 uct_tcp_ep_am_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
                       uint8_t am_id, uct_tcp_am_hdr_t **hdr)
@@ -1600,14 +2101,43 @@ static unsigned uct_tcp_ep_progress_put_rx(uct_tcp_ep_t *ep)
     return 1;
 }
 
+static unsigned uct_tcp_ep_progress_get_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_get_op_t *get_op;
+    size_t recv_length;
+    ucs_status_t status;
+
+    get_op      = ucs_queue_head_elem_non_empty(&ep->get.op_q,
+                                                uct_tcp_ep_get_op_t, elem);
+    recv_length = get_op->length;
+    status      = ucs_socket_recv_nb(ep->fd, (void*)(uintptr_t)get_op->addr,
+                                     0, &recv_length);
+    if (ucs_unlikely(status != UCS_OK)) {
+        if (status != UCS_ERR_NO_PROGRESS) {
+            uct_tcp_ep_handle_recv_err(ep, status);
+        }
+
+        /* EP RX buffer is kept allocated until GET RX is completed */
+        return 0;
+    }
+
+    ucs_assertv(recv_length, "ep=%p", ep);
+
+    uct_tcp_ep_get_rx_advance(ep, get_op, recv_length);
+
+    return 1;
+}
+
 static unsigned uct_tcp_ep_progress_data_rx(void *arg)
 {
     uct_tcp_ep_t *ep = (uct_tcp_ep_t*)arg;
 
-    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_RX)) {
-        return uct_tcp_ep_progress_am_rx(ep);
-    } else {
+    if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX) {
         return uct_tcp_ep_progress_put_rx(ep);
+    } else if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+        return uct_tcp_ep_progress_get_rx(ep);
+    } else {
+        return uct_tcp_ep_progress_am_rx(ep);
     }
 }
 
@@ -1746,7 +2276,13 @@ uct_tcp_ep_am_sendv(uct_tcp_ep_t *ep, int short_sendv, uct_tcp_am_hdr_t *hdr,
     ucs_assertv((ep->tx.length <= send_limit) &&
                 (iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, &sent_length);
+    if (ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX) {
+        ucs_assert(iov == ((uct_tcp_ep_zcopy_tx_t*)ep->tx.buf)->iov);
+        status = uct_tcp_ep_msg_zcopy_sendv(ep, ep->tx.buf, &sent_length);
+    } else {
+        status = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, &sent_length);
+    }
+
     if (ucs_unlikely((status != UCS_OK) && (status != UCS_ERR_NO_PROGRESS))) {
         return uct_tcp_ep_handle_send_err(ep, status);
     }
@@ -2007,11 +2543,19 @@ uct_tcp_ep_prepare_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, uint8_t am_id
     /* User-defined payload */
     ucs_iov_iter_init(&uct_iov_iter);
     io_vec_cnt       = iovcnt;
+    ctx->hdr_iov_cnt = ctx->iov_cnt;
+    ctx->iov_index   = 0;
     *zcopy_payload_p = uct_iov_to_iovec(&ctx->iov[ctx->iov_cnt], &io_vec_cnt,
                                         iov, iovcnt, SIZE_MAX, &uct_iov_iter);
     *ctx_p           = ctx;
     ctx->iov_cnt    += io_vec_cnt;
 
+    if ((ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_SOCK) &&
+        (*zcopy_payload_p >= iface->config.zcopy.msg_zcopy_thresh) &&
+        (*zcopy_payload_p > 0)) {
+        ep->flags |= UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
+    }
+
     return UCS_OK;
 }
 
@@ -2043,6 +2587,7 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, iface->config.rx_seg_size,
                                  header, ctx->iov, ctx->iov_cnt);
     if (ucs_unlikely(status != UCS_OK)) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
         return status;
     }
 
@@ -2054,6 +2599,11 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
         return UCS_INPROGRESS;
     }
 
+    if (ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
+        return uct_tcp_ep_outstanding_comp_add(ep, comp);
+    }
+
     return UCS_OK;
 }
 
@@ -2076,6 +2626,7 @@ uct_tcp_ep_put_comp_add(uct_tcp_ep_t *ep, uct_completion_t *comp, int wait_sn)
     }
 
     put_comp->wait_put_sn = ep->tx.put_sn;
+    put_comp->wait_get_sn = ep->get.sn;
     put_comp->comp        = comp;
     ucs_queue_push(&ep->put_comp_q, &put_comp->elem);
 
@@ -2116,6 +2667,7 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, UCT_TCP_EP_PUT_ZCOPY_MAX,
                                  &put_req, ctx->iov, ctx->iov_cnt);
     if (ucs_unlikely(status != UCS_OK)) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
         return status;
     }
 
@@ -2141,11 +2693,178 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
         uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, &put_req,
                                          sizeof(put_req), NULL);
+    } else {
+        /* the completion is reported after PUT ACK is received and the sent
+         * data is released by the kernel */
+        ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
     }
 
     return UCS_INPROGRESS;
 }
 
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    uct_tcp_ep_get_req_hdr_t *get_req;
+    uct_tcp_ep_get_op_t *get_op;
+    ucs_status_t status;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, 1ul, "get_zcopy");
+    UCT_CHECK_LENGTH(uct_iov_total_length(iov, iovcnt), 0,
+                     UCT_TCP_EP_GET_ZCOPY_MAX - sizeof(uct_tcp_am_hdr_t) -
+                     sizeof(uct_tcp_ep_get_rsp_hdr_t), "get_zcopy");
+
+    status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_GET_REQ_AM_ID, &hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    get_op = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(get_op == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate GET operation from mpool", ep);
+        uct_tcp_ep_ctx_reset(&ep->tx);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    get_op->comp   = comp;
+    get_op->addr   = (iovcnt != 0) ? (uintptr_t)iov[0].buffer : 0;
+    get_op->length = uct_iov_total_length(iov, iovcnt);
+
+    ucs_assertv(hdr != NULL, "ep=%p", ep);
+    hdr->length     = sizeof(*get_req);
+    get_req         = (uct_tcp_ep_get_req_hdr_t*)(hdr + 1);
+    get_req->addr   = remote_addr;
+    get_req->length = get_op->length;
+
+    status = uct_tcp_ep_am_send(ep, hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ucs_mpool_put_inline(get_op);
+        return status;
+    }
+
+    /* The response data is received in the order of the requests, the
+     * operation is completed when all its data is received to the user's
+     * buffer */
+    ucs_queue_push(&ep->get.op_q, &get_op->elem);
+    ep->get.sn++;
+    uct_tcp_iface_outstanding_inc(iface);
+
+    UCT_TL_EP_STAT_OP(&ep->super, GET, ZCOPY, get_op->length);
+    return UCS_INPROGRESS;
+}
+
+/* Answer a GET request which could not be served with an error, the
+ * initiator completes the operation with this status */
+static ucs_status_t
+uct_tcp_ep_post_get_rsp_error(uct_tcp_ep_t *ep, ucs_status_t rsp_status)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    uct_tcp_ep_get_rsp_hdr_t *get_rsp;
+    ucs_status_t status;
+
+    status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_GET_RSP_AM_ID, &hdr);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ucs_assertv(hdr != NULL, "ep=%p", ep);
+    hdr->length     = sizeof(*get_rsp);
+    get_rsp         = (uct_tcp_ep_get_rsp_hdr_t*)(hdr + 1);
+    get_rsp->length = 0;
+    get_rsp->status = rsp_status;
+    return uct_tcp_ep_am_send(ep, hdr);
+}
+
+/* Send the responses to the received GET requests while there are TX
+ * resources, the rest is sent from TX progress. If sending fails, the
+ * connection is failed, and the initiator completes its outstanding GET
+ * operations with an error when its EP is purged */
+static void uct_tcp_ep_post_get_rsp(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface           = ucs_derived_of(ep->super.super.iface,
+                                                      uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_tx_t *ctx       = NULL;
+    uct_tcp_ep_get_rsp_hdr_t get_rsp = {0}; /* Suppress Cppcheck false-positive */
+    uct_tcp_ep_get_op_t *get_op;
+    ucs_status_t status;
+    uct_iov_t iov;
+
+    for (;;) {
+        while (ep->get.rsp_num_failed > 0) {
+            status = uct_tcp_ep_post_get_rsp_error(ep, UCS_ERR_NO_MEMORY);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                goto out_no_res;
+            } else if (status != UCS_OK) {
+                return;
+            }
+
+            --ep->get.rsp_num_failed;
+        }
+
+        if (ucs_queue_is_empty(&ep->get.rsp_q)) {
+            return;
+        }
+
+        get_op = ucs_queue_head_elem_non_empty(&ep->get.rsp_q,
+                                               uct_tcp_ep_get_op_t, elem);
+
+        iov.buffer = (void*)(uintptr_t)get_op->addr;
+        iov.length = get_op->length;
+        iov.memh   = UCT_MEM_HANDLE_NULL;
+        iov.stride = 0;
+        iov.count  = 1;
+
+        status = uct_tcp_ep_prepare_zcopy(iface, ep, UCT_TCP_EP_GET_RSP_AM_ID,
+                                          &get_rsp, sizeof(get_rsp), &iov, 1,
+                                          "get_rsp",
+                                          /* Set a payload length directly to
+                                           * the TX length, since GET response
+                                           * doesn't set the payload length to
+                                           * TCP AM hdr */
+                                          &ep->tx.length, &ctx);
+        if (status == UCS_ERR_NO_RESOURCE) {
+            goto out_no_res;
+        } else if (status != UCS_OK) {
+            ucs_error("tcp_ep %p: failed to prepare GET response: %s", ep,
+                      ucs_status_string(status));
+            return;
+        }
+
+        ucs_queue_pull_non_empty(&ep->get.rsp_q);
+        ctx->super.length      = sizeof(get_rsp);
+        get_rsp.length         = ep->tx.length;
+        ep->get.rsp_num_failed = get_op->num_failed;
+        ucs_mpool_put_inline(get_op);
+
+        status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super,
+                                     UCT_TCP_EP_GET_ZCOPY_MAX, &get_rsp,
+                                     ctx->iov, ctx->iov_cnt);
+        if (ucs_unlikely(status != UCS_OK)) {
+            ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
+            return;
+        }
+
+        if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
+            uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, &get_rsp,
+                                             sizeof(get_rsp), NULL);
+            return;
+        }
+
+        ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
+    }
+
+out_no_res:
+    /* retry from TX progress, also when the TX buffer could not be allocated
+     * and there is no outstanding send to report TX readiness */
+    uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
+}
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags)
 {
@@ -2225,6 +2944,15 @@ ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
         return UCS_INPROGRESS;
     }
 
+    status = uct_tcp_ep_outstanding_comp_add(ep, comp);
+    if (status != UCS_OK) {
+        if (status == UCS_INPROGRESS) {
+            UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
+        }
+
+        return status;
+    }
+
     UCT_TL_EP_STAT_FLUSH(&ep->super);
     return UCS_OK;
 }
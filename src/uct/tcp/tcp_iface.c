@@ -23,6 +23,12 @@
 
 extern ucs_class_t UCS_CLASS_DECL_NAME(uct_tcp_iface_t);
 
+const char *uct_tcp_io_engine_names[] = {
+    [UCT_TCP_IO_ENGINE_EPOLL] = "epoll",
+    [UCT_TCP_IO_ENGINE_URING] = "uring",
+    [UCT_TCP_IO_ENGINE_LAST]  = NULL
+};
+
 static ucs_config_field_t uct_tcp_iface_config_table[] = {
   {"", "MAX_NUM_EPS=256", NULL,
    ucs_offsetof(uct_tcp_iface_config_t, super),
@@ -45,6 +51,14 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Threshold for switching from send() to sendmsg() for short active messages",
    ucs_offsetof(uct_tcp_iface_config_t, sendv_thresh), UCS_CONFIG_TYPE_MEMUNITS},
 
+  {"MSG_ZEROCOPY_THRESH", "inf",
+   "Minimal payload size of AM and PUT Zcopy operations which is sent with\n"
+   "MSG_ZEROCOPY flag, without copying the data to the kernel. Completion of\n"
+   "such operation is reported after the kernel releases the user's buffers.\n"
+   "\"inf\" disables zero-copy send.",
+   ucs_offsetof(uct_tcp_iface_config_t, msg_zcopy_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
   {"PREFER_DEFAULT", "y",
    "Give higher priority to the default network interface on the host",
    ucs_offsetof(uct_tcp_iface_config_t, prefer_default), UCS_CONFIG_TYPE_BOOL},
@@ -53,6 +67,10 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Enable PUT Zcopy support",
    ucs_offsetof(uct_tcp_iface_config_t, put_enable), UCS_CONFIG_TYPE_BOOL},
 
+  {"GET_ENABLE", "y",
+   "Enable GET Zcopy support",
+   ucs_offsetof(uct_tcp_iface_config_t, get_enable), UCS_CONFIG_TYPE_BOOL},
+
   {"CONN_NB", "n",
    "Enable non-blocking connection establishment. It may improve startup "
    "time, but can lead to connection resets due to high load on TCP/IP stack",
@@ -74,6 +92,13 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
 
   UCT_TCP_SEND_RECV_BUF_FIELDS(ucs_offsetof(uct_tcp_iface_config_t, sockopt)),
 
+  {"BUSY_POLL", "0",
+   "Time to busy poll on the device receive queue when reading from a socket\n"
+   "without available data (SO_BUSY_POLL socket option). Reduces the latency\n"
+   "of receiving at the expense of CPU usage. 0 - disabled.",
+   ucs_offsetof(uct_tcp_iface_config_t, sockopt_busy_poll),
+   UCS_CONFIG_TYPE_TIME_UNITS},
+
   UCT_TCP_SYN_CNT(ucs_offsetof(uct_tcp_iface_config_t, syn_cnt)),
 
   UCT_IFACE_MPOOL_CONFIG_FIELDS("TX_", -1, 8, 128m, 1.0, "send",
@@ -111,6 +136,15 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
                 UCS_CONFIG_TYPE_TIME_UNITS},
 #endif /* UCT_TCP_EP_KEEPALIVE */
 
+  {"IO_ENGINE", "epoll",
+   "Socket IO engine:\n"
+   " epoll - issue a separate system call for every socket operation.\n"
+   " uring - receive from all the sockets which are reported as readable by a\n"
+   "         single event set poll using a single io_uring system call. Falls\n"
+   "         back to epoll if io_uring is not supported by the system.",
+   ucs_offsetof(uct_tcp_iface_config_t, io_engine),
+                UCS_CONFIG_TYPE_ENUM(uct_tcp_io_engine_names)},
+
   {"EP_BIND_SRC_ADDR", "try",
    "Bind client socket to the local network interface before connecting to the "
    "remote peer",
@@ -345,6 +379,17 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface,
             attr->cap.put.opt_zcopy_align  = 1;
             attr->cap.flags               |= UCT_IFACE_FLAG_PUT_ZCOPY;
         }
+
+        if (iface->config.get_enable) {
+            /* GET, the response data is received directly to a single
+             * user's buffer */
+            attr->cap.get.max_iov          = 1;
+            attr->cap.get.max_zcopy        = UCT_TCP_EP_GET_ZCOPY_MAX -
+                                             sizeof(uct_tcp_am_hdr_t) -
+                                             sizeof(uct_tcp_ep_get_rsp_hdr_t);
+            attr->cap.get.opt_zcopy_align  = 1;
+            attr->cap.flags               |= UCT_IFACE_FLAG_GET_ZCOPY;
+        }
     }
 
     attr->bandwidth.dedicated = 0;
@@ -379,11 +424,27 @@ static void uct_tcp_iface_handle_events(void *callback_data,
                                         ucs_event_set_types_t events,
                                         void *arg)
 {
-    unsigned *count  = (unsigned*)arg;
-    uct_tcp_ep_t *ep = (uct_tcp_ep_t*)callback_data;
+    unsigned *count        = (unsigned*)arg;
+    uct_tcp_ep_t *ep       = (uct_tcp_ep_t*)callback_data;
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
 
     ucs_assertv(ep->conn_state != UCT_TCP_EP_CONN_STATE_CLOSED, "ep=%p", ep);
 
+    if (events & UCS_EVENT_SET_EVERR) {
+        *count += uct_tcp_ep_msg_zcopy_progress(ep);
+    }
+
+    if (ep->flags & UCT_TCP_EP_FLAG_URING_RX) {
+        /* the data is received by the operation posted to io_uring */
+        events &= ~UCS_EVENT_SET_EVREAD;
+    } else if ((iface->uring != NULL) && (events == UCS_EVENT_SET_EVREAD) &&
+               uct_tcp_ep_uring_prep_rx(ep)) {
+        /* defer the receive to the batch which is submitted to io_uring
+         * after all the events are collected */
+        return;
+    }
+
     if (events & UCS_EVENT_SET_EVREAD) {
         *count += uct_tcp_ep_cm_state[ep->conn_state].rx_progress(ep);
     }
@@ -405,6 +466,13 @@ unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
         status = ucs_event_set_wait(iface->event_set, &read_events,
                                     0, uct_tcp_iface_handle_events,
                                     (void *)&count);
+        if (iface->uring != NULL) {
+            /* must complete before the next wait, since the sockets are
+             * still reported as readable until the data is received */
+            count += uct_tcp_uring_submit(iface->uring,
+                                          uct_tcp_ep_uring_complete_rx, NULL);
+        }
+
         max_events -= read_events;
         ucs_trace_poll("iface=%p ucs_event_set_wait() returned %d: "
                        "read events=%u, total=%u",
@@ -469,7 +537,7 @@ uct_tcp_iface_connect_handler(int listen_fd, ucs_event_set_types_t events,
 }
 
 ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
-                                       int set_nb)
+                                       int set_nb, int *msg_zcopy_p)
 {
     ucs_status_t status;
 
@@ -493,6 +561,24 @@ ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
         return status;
     }
 
+    /* the options below are optional, failing to set them affects only the
+     * given socket */
+    *msg_zcopy_p = 0;
+    if (iface->config.zcopy.msg_zcopy_thresh != UCS_MEMUNITS_INF) {
+        if (ucs_socket_enable_zcopy(fd) == UCS_OK) {
+            *msg_zcopy_p = 1;
+        } else {
+            ucs_diag("tcp_iface %p: MSG_ZEROCOPY is not supported on fd %d, "
+                     "Zcopy operations will copy the data", iface, fd);
+        }
+    }
+
+    if ((iface->sockopt.busy_poll != 0) &&
+        (ucs_socket_set_busy_poll(fd, iface->sockopt.busy_poll) != UCS_OK)) {
+        ucs_diag("tcp_iface %p: SO_BUSY_POLL is not supported on fd %d, "
+                 "the socket will not be busy polled", iface, fd);
+    }
+
     return ucs_tcp_base_set_syn_cnt(fd, iface->config.syn_cnt);
 }
 
@@ -502,6 +588,7 @@ static uct_iface_ops_t uct_tcp_iface_ops = {
     .ep_am_bcopy              = uct_tcp_ep_am_bcopy,
     .ep_am_zcopy              = uct_tcp_ep_am_zcopy,
     .ep_put_zcopy             = uct_tcp_ep_put_zcopy,
+    .ep_get_zcopy             = uct_tcp_ep_get_zcopy,
     .ep_pending_add           = uct_tcp_ep_pending_add,
     .ep_pending_purge         = uct_tcp_ep_pending_purge,
     .ep_flush                 = uct_tcp_ep_flush,
@@ -714,8 +801,10 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
 
     self->config.zcopy.max_hdr     = self->config.tx_seg_size -
                                      self->config.zcopy.hdr_offset;
+    self->config.zcopy.msg_zcopy_thresh = config->msg_zcopy_thresh;
     self->config.prefer_default    = config->prefer_default;
     self->config.put_enable        = config->put_enable;
+    self->config.get_enable        = config->get_enable;
     self->config.conn_nb           = config->conn_nb;
     self->config.max_poll          = config->max_poll;
     self->config.max_conn_retries  = config->max_conn_retries;
@@ -723,9 +812,12 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
     self->sockopt.nodelay          = config->sockopt_nodelay;
     self->sockopt.sndbuf           = config->sockopt.sndbuf;
     self->sockopt.rcvbuf           = config->sockopt.rcvbuf;
+    self->sockopt.busy_poll        = config->sockopt_busy_poll;
     self->config.keepalive.cnt     = config->keepalive.cnt;
     self->config.keepalive.intvl   = config->keepalive.intvl;
     self->config.ep_bind_src_addr  = config->ep_bind_src_addr;
+    self->config.io_engine         = config->io_engine;
+    self->uring                    = NULL;
     self->port_range.first         = config->port_range.first;
     self->port_range.last          = config->port_range.last;
 
@@ -808,14 +900,30 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         goto err_cleanup_rx_mpool;
     }
 
+    if (self->config.io_engine == UCT_TCP_IO_ENGINE_URING) {
+        status = uct_tcp_uring_create(ucs_max(ucs_min(self->config.max_poll,
+                                          ucs_sys_event_set_max_wait_events),
+                                              1),
+                                      &self->uring);
+        if (status != UCS_OK) {
+            ucs_diag("tcp_iface %p: io_uring engine is not available (%s), "
+                     "using epoll", self, ucs_status_string(status));
+            self->config.io_engine = UCT_TCP_IO_ENGINE_EPOLL;
+            self->uring            = NULL;
+        }
+    }
+
     status = uct_tcp_iface_listener_init(self);
     if (status != UCS_OK) {
-        goto err_cleanup_event_set;
+        goto err_destroy_uring;
     }
 
     return UCS_OK;
 
-err_cleanup_event_set:
+err_destroy_uring:
+    if (self->uring != NULL) {
+        uct_tcp_uring_destroy(self->uring);
+    }
     ucs_event_set_cleanup(self->event_set);
 err_cleanup_rx_mpool:
     ucs_mpool_cleanup(&self->rx_mpool, 1);
@@ -890,6 +998,9 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_iface_t)
     ucs_mpool_cleanup(&self->tx_mpool, 1);
 
     ucs_close_fd(&self->listen_fd);
+    if (self->uring != NULL) {
+        uct_tcp_uring_destroy(self->uring);
+    }
     ucs_event_set_cleanup(self->event_set);
 }
 
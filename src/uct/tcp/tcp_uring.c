@@ -0,0 +1,441 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "tcp.h"
+
+#include <ucs/arch/atomic.h>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+
+#if HAVE_LINUX_IO_URING_H && HAVE_DECL___NR_IO_URING_SETUP && \
+    HAVE_DECL___NR_IO_URING_ENTER && HAVE_DECL___NR_IO_URING_REGISTER && \
+    HAVE_DECL_IORING_OP_RECV
+#  define UCT_TCP_HAVE_URING 1
+#else
+#  define UCT_TCP_HAVE_URING 0
+#endif
+
+#if UCT_TCP_HAVE_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+
+/**
+ * Submission or completion ring mapped from the kernel
+ */
+typedef struct uct_tcp_uring_ring {
+    void                *mem;        /* Mapped memory */
+    size_t              size;        /* Size of the mapped memory */
+    volatile unsigned   *head;       /* Ring head, consumer index */
+    volatile unsigned   *tail;       /* Ring tail, producer index */
+    unsigned            mask;        /* Ring size - 1 */
+    unsigned            entries;     /* Number of ring entries */
+} uct_tcp_uring_ring_t;
+
+
+struct uct_tcp_uring {
+    int                  fd;         /* io_uring file descriptor */
+    uct_tcp_uring_ring_t sq;         /* Submission queue ring */
+    uct_tcp_uring_ring_t cq;         /* Completion queue ring */
+    unsigned             *sq_array;  /* SQ index array */
+    struct io_uring_sqe  *sqes;      /* SQ entries */
+    size_t               sqes_size;  /* Size of the mapped SQ entries */
+    struct io_uring_cqe  *cqes;      /* CQ entries */
+    unsigned             sq_tail;    /* Local SQ tail, published on submit */
+    unsigned             cq_head;    /* Local CQ head, published after
+                                        reaping */
+    unsigned             to_submit;  /* Number of prepared SQ entries */
+    unsigned             inflight;   /* Number of submitted entries which were
+                                        not reaped yet */
+    int                  failed;     /* io_uring_enter() failed with a
+                                        non-recoverable error */
+};
+
+
+static int uct_tcp_uring_setup(unsigned entries, struct io_uring_params *p)
+{
+    return syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int uct_tcp_uring_enter(int fd, unsigned to_submit,
+                               unsigned min_complete, unsigned flags)
+{
+    return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                   NULL, 0);
+}
+
+static int uct_tcp_uring_register(int fd, unsigned opcode, void *arg,
+                                  unsigned nr_args)
+{
+    return syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static ucs_status_t uct_tcp_uring_check_recv_op(uct_tcp_uring_t *uring)
+{
+    struct io_uring_probe *probe;
+    size_t probe_size;
+    ucs_status_t status;
+
+    probe_size = sizeof(*probe) + (IORING_OP_LAST * sizeof(probe->ops[0]));
+    probe      = ucs_calloc(1, probe_size, "io_uring_probe");
+    if (probe == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    if (uct_tcp_uring_register(uring->fd, IORING_REGISTER_PROBE, probe,
+                               IORING_OP_LAST) < 0) {
+        ucs_debug("io_uring_register(PROBE) failed: %m");
+        status = UCS_ERR_UNSUPPORTED;
+    } else if ((probe->last_op < IORING_OP_RECV) ||
+               !(probe->ops[IORING_OP_RECV].flags & IO_URING_OP_SUPPORTED)) {
+        ucs_debug("io_uring does not support IORING_OP_RECV");
+        status = UCS_ERR_UNSUPPORTED;
+    } else {
+        status = UCS_OK;
+    }
+
+    ucs_free(probe);
+    return status;
+}
+
+static void uct_tcp_uring_unmap(uct_tcp_uring_t *uring)
+{
+    if (uring->sqes != MAP_FAILED) {
+        munmap(uring->sqes, uring->sqes_size);
+    }
+
+    if ((uring->cq.mem != MAP_FAILED) && (uring->cq.mem != uring->sq.mem)) {
+        munmap(uring->cq.mem, uring->cq.size);
+    }
+
+    if (uring->sq.mem != MAP_FAILED) {
+        munmap(uring->sq.mem, uring->sq.size);
+    }
+}
+
+ucs_status_t uct_tcp_uring_create(unsigned entries, uct_tcp_uring_t **uring_p)
+{
+    struct io_uring_params params = {0};
+    uct_tcp_uring_t *uring;
+    ucs_status_t status;
+
+    uring = ucs_calloc(1, sizeof(*uring), "tcp_uring");
+    if (uring == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    uring->sq.mem = MAP_FAILED;
+    uring->cq.mem = MAP_FAILED;
+    uring->sqes   = MAP_FAILED;
+
+    uring->fd = uct_tcp_uring_setup(entries, &params);
+    if (uring->fd < 0) {
+        ucs_debug("io_uring_setup(%u) failed: %m", entries);
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_free;
+    }
+
+    status = uct_tcp_uring_check_recv_op(uring);
+    if (status != UCS_OK) {
+        goto err_close;
+    }
+
+    uring->sq.size = params.sq_off.array +
+                     (params.sq_entries * sizeof(unsigned));
+    uring->cq.size = params.cq_off.cqes +
+                     (params.cq_entries * sizeof(struct io_uring_cqe));
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        uring->sq.size = ucs_max(uring->sq.size, uring->cq.size);
+        uring->cq.size = uring->sq.size;
+    }
+
+    uring->sq.mem = mmap(NULL, uring->sq.size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, uring->fd,
+                         IORING_OFF_SQ_RING);
+    if (uring->sq.mem == MAP_FAILED) {
+        ucs_error("failed to map io_uring submission ring: %m");
+        status = UCS_ERR_IO_ERROR;
+        goto err_close;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        uring->cq.mem = uring->sq.mem;
+    } else {
+        uring->cq.mem = mmap(NULL, uring->cq.size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, uring->fd,
+                             IORING_OFF_CQ_RING);
+        if (uring->cq.mem == MAP_FAILED) {
+            ucs_error("failed to map io_uring completion ring: %m");
+            status = UCS_ERR_IO_ERROR;
+            goto err_unmap;
+        }
+    }
+
+    uring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    uring->sqes      = mmap(NULL, uring->sqes_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, uring->fd,
+                            IORING_OFF_SQES);
+    if (uring->sqes == MAP_FAILED) {
+        ucs_error("failed to map io_uring submission entries: %m");
+        status = UCS_ERR_IO_ERROR;
+        goto err_unmap;
+    }
+
+    uring->sq.head    = UCS_PTR_BYTE_OFFSET(uring->sq.mem, params.sq_off.head);
+    uring->sq.tail    = UCS_PTR_BYTE_OFFSET(uring->sq.mem, params.sq_off.tail);
+    uring->sq.mask    = *(unsigned*)UCS_PTR_BYTE_OFFSET(uring->sq.mem,
+                                                        params.sq_off.ring_mask);
+    uring->sq.entries = params.sq_entries;
+    uring->sq_array   = UCS_PTR_BYTE_OFFSET(uring->sq.mem, params.sq_off.array);
+    uring->sq_tail    = *uring->sq.tail;
+    uring->cq.head    = UCS_PTR_BYTE_OFFSET(uring->cq.mem, params.cq_off.head);
+    uring->cq.tail    = UCS_PTR_BYTE_OFFSET(uring->cq.mem, params.cq_off.tail);
+    uring->cq.mask    = *(unsigned*)UCS_PTR_BYTE_OFFSET(uring->cq.mem,
+                                                        params.cq_off.ring_mask);
+    uring->cq.entries = params.cq_entries;
+    uring->cqes       = UCS_PTR_BYTE_OFFSET(uring->cq.mem, params.cq_off.cqes);
+    uring->cq_head    = *uring->cq.head;
+    uring->to_submit  = 0;
+    uring->inflight   = 0;
+    uring->failed     = 0;
+
+    ucs_debug("created io_uring fd %d with %u sq entries, %u cq entries",
+              uring->fd, uring->sq.entries, uring->cq.entries);
+    *uring_p = uring;
+    return UCS_OK;
+
+err_unmap:
+    uct_tcp_uring_unmap(uring);
+err_close:
+    close(uring->fd);
+err_free:
+    ucs_free(uring);
+    return status;
+}
+
+void uct_tcp_uring_destroy(uct_tcp_uring_t *uring)
+{
+    uct_tcp_uring_unmap(uring);
+    close(uring->fd);
+    ucs_free(uring);
+}
+
+ucs_status_t uct_tcp_uring_prep_recv(uct_tcp_uring_t *uring, int fd,
+                                     void *buffer, size_t length,
+                                     void *user_data)
+{
+    struct io_uring_sqe *sqe;
+    unsigned index;
+
+    if (ucs_unlikely(uring->failed)) {
+        return UCS_ERR_IO_ERROR;
+    }
+
+    /* SQ size does not exceed CQ size, so bounding the number of entries
+     * which were not reaped yet by SQ size also prevents CQ overflow */
+    if ((uring->inflight + uring->to_submit) == uring->sq.entries) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    index = uring->sq_tail & uring->sq.mask;
+    sqe   = &uring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = IORING_OP_RECV;
+    sqe->fd        = fd;
+    sqe->addr      = (uintptr_t)buffer;
+    sqe->len       = ucs_min(length, UINT_MAX);
+    /* never block in the kernel, the socket was reported as readable */
+    sqe->msg_flags = MSG_DONTWAIT;
+    sqe->user_data = (uintptr_t)user_data;
+
+    uring->sq_array[index] = index;
+    ++uring->sq_tail;
+    ++uring->to_submit;
+    return UCS_OK;
+}
+
+static unsigned uct_tcp_uring_reap(uct_tcp_uring_t *uring,
+                                   uct_tcp_uring_complete_cb_t cb, void *arg)
+{
+    unsigned count = 0;
+    struct io_uring_cqe *cqe;
+    uint64_t user_data;
+    int result;
+
+    ucs_memory_cpu_load_fence();
+    while (uring->cq_head != *uring->cq.tail) {
+        cqe       = &uring->cqes[uring->cq_head & uring->cq.mask];
+        user_data = cqe->user_data;
+        result    = cqe->res;
+
+        /* advance the local head before the callback, so the entry is not
+         * scanned by uct_tcp_uring_cancel() called from the callback */
+        ++uring->cq_head;
+        --uring->inflight;
+
+        /* zero user data marks a canceled operation */
+        if (user_data != 0) {
+            count += cb((void*)(uintptr_t)user_data, result, arg);
+        }
+    }
+
+    ucs_memory_cpu_store_fence();
+    *uring->cq.head = uring->cq_head;
+    return count;
+}
+
+/* Take back the entries which were not consumed by the kernel, and complete
+ * them with -EAGAIN, so the sockets are received from on the next poll */
+static unsigned uct_tcp_uring_rewind(uct_tcp_uring_t *uring,
+                                     uct_tcp_uring_complete_cb_t cb, void *arg)
+{
+    unsigned head  = *uring->sq.head;
+    unsigned count = 0;
+    uint64_t user_data;
+
+    /* without SQPOLL, the kernel consumes entries only during
+     * io_uring_enter(), so moving the tail back is safe */
+    *uring->sq.tail  = head;
+    uring->inflight -= uring->sq_tail - head;
+
+    while (uring->sq_tail != head) {
+        user_data = uring->sqes[head & uring->sq.mask].user_data;
+        ++head;
+        if (user_data != 0) {
+            count += cb((void*)(uintptr_t)user_data, -EAGAIN, arg);
+        }
+    }
+
+    uring->sq_tail = head;
+    return count;
+}
+
+unsigned uct_tcp_uring_submit(uct_tcp_uring_t *uring,
+                              uct_tcp_uring_complete_cb_t cb, void *arg)
+{
+    unsigned count = 0;
+    unsigned to_submit;
+    int ret;
+
+    if (uring->to_submit > 0) {
+        /* publish the prepared entries */
+        ucs_memory_cpu_store_fence();
+        *uring->sq.tail   = uring->sq_tail;
+        uring->inflight  += uring->to_submit;
+        uring->to_submit  = 0;
+    }
+
+    /* submit all entries and wait for their completions with a single system
+     * call. the operations do not block, so waiting for all of them does not
+     * stall the progress */
+    while (uring->inflight > 0) {
+        to_submit = *uring->sq.tail - *uring->sq.head;
+        ret       = uct_tcp_uring_enter(uring->fd, to_submit, uring->inflight,
+                                        IORING_ENTER_GETEVENTS);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if ((errno == EAGAIN) || (errno == EBUSY) || (errno == ENOMEM)) {
+                /* out of kernel resources, retry on the next progress */
+                ucs_debug("io_uring_enter(fd=%d, to_submit=%u) failed: %m",
+                          uring->fd, to_submit);
+            } else {
+                ucs_diag("io_uring_enter(fd=%d, to_submit=%u) failed: %m, "
+                         "falling back to socket receive", uring->fd,
+                         to_submit);
+                uring->failed = 1;
+            }
+            break;
+        }
+
+        count += uct_tcp_uring_reap(uring, cb, arg);
+        if ((ret == 0) && (to_submit > 0)) {
+            /* the kernel did not consume any entry, retry later */
+            break;
+        }
+    }
+
+    /* complete whatever is already available, and return the entries which
+     * were not submitted to the sockets */
+    count += uct_tcp_uring_reap(uring, cb, arg);
+    count += uct_tcp_uring_rewind(uring, cb, arg);
+    return count;
+}
+
+void uct_tcp_uring_cancel(uct_tcp_uring_t *uring, void *user_data)
+{
+    unsigned index;
+    int ret;
+
+    /* entries which were not consumed by the kernel are replaced by no-op */
+    for (index = *uring->sq.head; index != uring->sq_tail; ++index) {
+        if (uring->sqes[index & uring->sq.mask].user_data ==
+            (uintptr_t)user_data) {
+            uring->sqes[index & uring->sq.mask].opcode    = IORING_OP_NOP;
+            uring->sqes[index & uring->sq.mask].user_data = 0;
+        }
+    }
+
+    /* entries which were consumed by the kernel must complete before the
+     * buffers they refer to are released. the receive does not block, so
+     * the wait is short */
+    while ((*uring->cq.tail - uring->cq_head) <
+           (uring->inflight - (*uring->sq.tail - *uring->sq.head))) {
+        ret = uct_tcp_uring_enter(uring->fd, 0, 1, IORING_ENTER_GETEVENTS);
+        if ((ret < 0) && (errno != EINTR)) {
+            ucs_error("io_uring_enter(fd=%d) failed: %m", uring->fd);
+            break;
+        }
+
+        ucs_memory_cpu_load_fence();
+    }
+
+    /* completions which were not reaped yet are skipped */
+    for (index = uring->cq_head; index != *uring->cq.tail; ++index) {
+        if (uring->cqes[index & uring->cq.mask].user_data ==
+            (uintptr_t)user_data) {
+            uring->cqes[index & uring->cq.mask].user_data = 0;
+        }
+    }
+}
+
+#else
+
+ucs_status_t uct_tcp_uring_create(unsigned entries, uct_tcp_uring_t **uring_p)
+{
+    ucs_debug("io_uring support is not compiled in");
+    return UCS_ERR_UNSUPPORTED;
+}
+
+void uct_tcp_uring_destroy(uct_tcp_uring_t *uring)
+{
+}
+
+ucs_status_t uct_tcp_uring_prep_recv(uct_tcp_uring_t *uring, int fd,
+                                     void *buffer, size_t length,
+                                     void *user_data)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+unsigned uct_tcp_uring_submit(uct_tcp_uring_t *uring,
+                              uct_tcp_uring_complete_cb_t cb, void *arg)
+{
+    return 0;
+}
+
+void uct_tcp_uring_cancel(uct_tcp_uring_t *uring, void *user_data)
+{
+}
+
+#endif
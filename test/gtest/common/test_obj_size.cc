@@ -44,6 +44,8 @@ UCS_TEST_F(test_obj_size, size) {
 
 #if ENABLE_DEBUG_DATA
     UCS_TEST_SKIP_R("Debug data");
+#elif ENABLE_REQUEST_TRACE
+    UCS_TEST_SKIP_R("Request trace");
 #elif defined (ENABLE_STATS)
     UCS_TEST_SKIP_R("Statistic enabled");
 #elif UCS_ENABLE_ASSERT
@@ -209,6 +209,8 @@ void test_perf::test_params_init(const test_spec &test,
     params.thread_count    = 1;
     params.wait_mode       = test.wait_mode;
     params.flags           = test.test_flags | flags;
+    params.pattern         = UCX_PERF_PATTERN_PAIRS;
+    params.pattern_round   = 0;
     params.uct.am_hdr_size = 8;
     params.alignment       = ucs_get_page_size();
     params.max_outstanding = test.max_outstanding;
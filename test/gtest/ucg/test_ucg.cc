@@ -0,0 +1,274 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#include <common/test.h>
+extern "C" {
+#include <ucg/api/ucg.h>
+}
+
+#include <functional>
+#include <pthread.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+
+/* Runs the members of a group as threads of the test process */
+class test_ucg : public ucs::test {
+protected:
+    struct member {
+        test_ucg *test;
+        unsigned rank;
+    };
+
+    static ucs_status_t
+    oob_bcast(void *buffer, size_t length, unsigned root, void *arg)
+    {
+        member *self = reinterpret_cast<member*>(arg);
+        test_ucg *test = self->test;
+
+        if (self->rank == root) {
+            test->m_oob_buffer.assign((char*)buffer, (char*)buffer + length);
+        }
+        pthread_barrier_wait(&test->m_oob_barrier);
+        if (self->rank != root) {
+            memcpy(buffer, &test->m_oob_buffer[0], length);
+        }
+        pthread_barrier_wait(&test->m_oob_barrier);
+        return UCS_OK;
+    }
+
+    ucs_status_t group_create(unsigned member_count, unsigned rank,
+                              ucg_group_h *group_p)
+    {
+        member self = {this, rank};
+        ucg_group_params_t params;
+
+        params.field_mask   = UCG_GROUP_PARAM_FIELD_MEMBER_COUNT |
+                              UCG_GROUP_PARAM_FIELD_MY_RANK      |
+                              UCG_GROUP_PARAM_FIELD_OOB_BCAST    |
+                              UCG_GROUP_PARAM_FIELD_OOB_ARG;
+        params.member_count = member_count;
+        params.my_rank      = rank;
+        params.oob_bcast    = oob_bcast;
+        params.oob_arg      = &self;
+
+        return ucg_group_create(&params, group_p);
+    }
+
+    void member_run(unsigned member_count, unsigned rank, size_t count)
+    {
+        ucg_group_h group;
+        ucs_status_t status;
+
+        status = group_create(member_count, rank, &group);
+        if (status != UCS_OK) {
+            m_errors[rank] = "ucg_group_create failed";
+            return;
+        }
+
+        check_bcast(group, member_count, rank, count * sizeof(uint64_t));
+        check_reduce(group, member_count, rank, count);
+        check_allreduce(group, member_count, rank, count);
+        ucg_barrier(group);
+
+        ucg_group_destroy(group);
+    }
+
+    void check_bcast(ucg_group_h group, unsigned member_count, unsigned rank,
+                     size_t length)
+    {
+        std::vector<char> buffer(length);
+        unsigned root;
+        size_t i;
+
+        for (root = 0; root < member_count; ++root) {
+            for (i = 0; i < length; ++i) {
+                buffer[i] = (rank == root) ? (char)(i + root) : 0;
+            }
+
+            ucg_bcast(group, &buffer[0], length, root);
+
+            for (i = 0; i < length; ++i) {
+                if (buffer[i] != (char)(i + root)) {
+                    m_errors[rank] = "bcast data mismatch";
+                    return;
+                }
+            }
+        }
+    }
+
+    void check_reduce(ucg_group_h group, unsigned member_count, unsigned rank,
+                      size_t count)
+    {
+        std::vector<int64_t> sbuf(count), rbuf(count);
+        unsigned root;
+        size_t i;
+
+        for (i = 0; i < count; ++i) {
+            sbuf[i] = rank + i;
+        }
+
+        for (root = 0; root < member_count; ++root) {
+            ucg_reduce(group, &sbuf[0], &rbuf[0], count, UCG_DT_INT64,
+                       UCG_OP_SUM, root);
+            if (rank != root) {
+                continue;
+            }
+
+            for (i = 0; i < count; ++i) {
+                if (rbuf[i] != (int64_t)(member_count * (member_count - 1) / 2 +
+                                         member_count * i)) {
+                    m_errors[rank] = "reduce result mismatch";
+                    return;
+                }
+            }
+        }
+    }
+
+    void check_allreduce(ucg_group_h group, unsigned member_count,
+                         unsigned rank, size_t count)
+    {
+        std::vector<double> buffer(count);
+        size_t i;
+
+        for (i = 0; i < count; ++i) {
+            buffer[i] = rank * 0.5 + i;
+        }
+
+        /* In-place */
+        ucg_allreduce(group, &buffer[0], &buffer[0], count, UCG_DT_DOUBLE,
+                      UCG_OP_MAX);
+
+        for (i = 0; i < count; ++i) {
+            if (buffer[i] != ((member_count - 1) * 0.5 + i)) {
+                m_errors[rank] = "allreduce result mismatch";
+                return;
+            }
+        }
+    }
+
+    /* Run a function with the rank of each member, on a thread per member */
+    void run_members(unsigned num_threads,
+                     const std::function<void(unsigned)> &func)
+    {
+        std::vector<std::thread> threads;
+        unsigned rank;
+
+        pthread_barrier_init(&m_oob_barrier, NULL, num_threads);
+
+        for (rank = 0; rank < num_threads; ++rank) {
+            threads.push_back(std::thread(func, rank));
+        }
+
+        for (rank = 0; rank < num_threads; ++rank) {
+            threads[rank].join();
+        }
+
+        pthread_barrier_destroy(&m_oob_barrier);
+    }
+
+    void run(unsigned member_count, size_t count)
+    {
+        unsigned rank;
+
+        m_errors.assign(member_count, std::string());
+        run_members(member_count, [this, member_count, count](unsigned rank) {
+            member_run(member_count, rank, count);
+        });
+
+        for (rank = 0; rank < member_count; ++rank) {
+            EXPECT_EQ("", m_errors[rank]) << "rank " << rank;
+        }
+    }
+
+    void test_group_sizes()
+    {
+        static const unsigned member_counts[] = {1, 2, 5, 9};
+
+        for (unsigned i = 0; i < ucs_static_array_size(member_counts); ++i) {
+            UCS_TEST_MESSAGE << "members: " << member_counts[i];
+            run(member_counts[i], 1000);
+        }
+    }
+
+    pthread_barrier_t        m_oob_barrier;
+    std::vector<char>        m_oob_buffer;
+    std::vector<std::string> m_errors;
+};
+
+UCS_TEST_F(test_ucg, auto_algorithm) {
+    test_group_sizes();
+}
+
+UCS_TEST_F(test_ucg, flat, "UCG_ALGORITHM?=flat") {
+    test_group_sizes();
+}
+
+UCS_TEST_F(test_ucg, tree, "UCG_ALGORITHM?=tree", "UCG_TREE_RADIX?=2") {
+    test_group_sizes();
+}
+
+UCS_TEST_F(test_ucg, small_slot, "UCG_SLOT_SIZE?=128") {
+    test_group_sizes();
+}
+
+UCS_TEST_F(test_ucg, invalid_params) {
+    ucg_group_params_t params;
+    ucg_group_h group;
+    ucs_status_t status;
+
+    params.field_mask   = UCG_GROUP_PARAM_FIELD_MEMBER_COUNT |
+                          UCG_GROUP_PARAM_FIELD_MY_RANK;
+    params.member_count = 2;
+    params.my_rank      = 0;
+
+    scoped_log_handler wrap_err(wrap_errors_logger);
+    status = ucg_group_create(&params, &group);
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, status);
+}
+
+UCS_TEST_F(test_ucg, member_count_mismatch, "UCG_TIMEOUT=100ms") {
+    std::vector<ucs_status_t> statuses(2, UCS_OK);
+
+    /* Rank 1 fails to join the group of rank 0, which times out waiting */
+    scoped_log_handler wrap_err(wrap_errors_logger);
+    run_members(2, [this, &statuses](unsigned rank) {
+        ucg_group_h group;
+
+        statuses[rank] = group_create(2 + rank, rank, &group);
+    });
+
+    EXPECT_EQ(UCS_ERR_TIMED_OUT, statuses[0]);
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, statuses[1]);
+}
+
+UCS_TEST_F(test_ucg, member_timeout, "UCG_TIMEOUT=100ms") {
+    std::vector<ucg_group_h> groups(2, NULL);
+    ucs_status_t status;
+
+    run_members(2, [this, &groups](unsigned rank) {
+        ASSERT_UCS_OK(group_create(2, rank, &groups[rank]));
+    });
+
+    ASSERT_TRUE((groups[0] != NULL) && (groups[1] != NULL));
+
+    /* Rank 1 does not enter the barrier */
+    {
+        scoped_log_handler wrap_err(wrap_errors_logger);
+        status = ucg_barrier(groups[0]);
+        EXPECT_EQ(UCS_ERR_TIMED_OUT, status);
+
+        /* The group is out of sync */
+        status = ucg_barrier(groups[0]);
+        EXPECT_EQ(UCS_ERR_TIMED_OUT, status);
+
+        /* Rank 1 times out waiting for rank 0 in the barrier of destroy */
+        ucg_group_destroy(groups[1]);
+    }
+
+    ucg_group_destroy(groups[0]);
+}
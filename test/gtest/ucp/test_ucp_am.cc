@@ -18,6 +18,7 @@
 
 extern "C" {
 #include <ucp/core/ucp_context.h>
+#include <ucp/core/ucp_aggr.h>
 #include <ucp/core/ucp_am.h>
 #include <ucp/core/ucp_ep.inl>
 #include <ucp/core/ucp_resource.h>
@@ -1455,6 +1456,298 @@ UCS_TEST_P(test_ucp_am_nbx_eager_data_release, multi)
 
 UCP_INSTANTIATE_TEST_CASE(test_ucp_am_nbx_eager_data_release)
 
+
+class test_ucp_am_nbx_batch : public test_ucp_am_nbx {
+public:
+    test_ucp_am_nbx_batch()
+    {
+        modify_config("RNDV_THRESH", "inf");
+        m_num_batches     = 0;
+        m_last_single_seq = -1;
+        m_hold_data       = false;
+    }
+
+    static void
+    am_batch_cb(void *arg, ucp_am_recv_msg_t *msgs, size_t count)
+    {
+        test_ucp_am_nbx_batch *self = reinterpret_cast<test_ucp_am_nbx_batch*>(
+                arg);
+        self->am_batch_handler(msgs, count);
+    }
+
+    void am_batch_handler(ucp_am_recv_msg_t *msgs, size_t count)
+    {
+        uint64_t seq;
+
+        EXPECT_GT(count, 0u);
+        ++m_num_batches;
+
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(sizeof(seq), msgs[i].header_length);
+            memcpy(&seq, msgs[i].header, sizeof(seq));
+
+            /* Fragments of large messages may be sent on several lanes, so
+             * the messages are not always received in the order they were
+             * sent, but each of them is received once, and single-fragment
+             * messages are received in order */
+            ASSERT_LT(seq, m_sizes.size());
+            EXPECT_FALSE(m_received[seq]) << "seq " << seq;
+            m_received[seq] = true;
+            if (is_single_fragment(m_sizes[seq])) {
+                EXPECT_GT((int64_t)seq, m_last_single_seq);
+                m_last_single_seq = seq;
+            }
+            EXPECT_TRUE(msgs[i].param.recv_attr & UCP_AM_RECV_ATTR_FLAG_DATA);
+            EXPECT_EQ(m_sizes[seq], msgs[i].length);
+            mem_buffer::pattern_check(msgs[i].data, msgs[i].length,
+                                      SEED + seq);
+
+            if (m_hold_data) {
+                m_held_data.push_back(msgs[i].data);
+                msgs[i].status = UCS_INPROGRESS;
+            }
+
+            m_recv_counter++;
+        }
+    }
+
+    void set_am_batch_handler(entity &e, unsigned flags = 0)
+    {
+        ucp_am_handler_param_t param;
+
+        param.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID       |
+                           UCP_AM_HANDLER_PARAM_FIELD_FLAGS    |
+                           UCP_AM_HANDLER_PARAM_FIELD_BATCH_CB |
+                           UCP_AM_HANDLER_PARAM_FIELD_ARG;
+        param.id         = TEST_AM_NBX_ID;
+        param.flags      = UCP_AM_FLAG_BATCH | flags;
+        param.batch_cb   = am_batch_cb;
+        param.arg        = this;
+
+        ASSERT_UCS_OK(ucp_worker_set_am_recv_handler(e.worker(), &param));
+    }
+
+    void test_batch(const std::vector<size_t> &sizes)
+    {
+        std::vector<std::vector<char> > sbufs(sizes.size());
+        std::vector<uint64_t> seqs(sizes.size());
+        std::vector<ucs_status_ptr_t> sptrs;
+        ucp_request_param_t param;
+        uint64_t seq;
+
+        m_sizes           = sizes;
+        m_last_single_seq = -1;
+        m_received.assign(sizes.size(), false);
+        reset_counters();
+        set_am_batch_handler(receiver());
+
+        for (seq = 0; seq < sizes.size(); ++seq) {
+            param.op_attr_mask = send_op_attr_mask(seq);
+            sbufs[seq].resize(sizes[seq]);
+            mem_buffer::pattern_fill(sbufs[seq].data(), sizes[seq], SEED + seq);
+            seqs[seq] = seq;
+            sptrs.push_back(update_counter_and_send_am(&seqs[seq], sizeof(seq),
+                                                       sbufs[seq].data(),
+                                                       sizes[seq],
+                                                       TEST_AM_NBX_ID,
+                                                       &param));
+        }
+
+        wait_receives();
+        requests_wait(sptrs);
+        EXPECT_EQ(m_send_counter, m_recv_counter);
+    }
+
+    bool is_single_fragment(size_t size)
+    {
+        /* Leave room for the protocol headers */
+        return size <= (fragment_size() / 2);
+    }
+
+    virtual uint32_t send_op_attr_mask(uint64_t seq) const
+    {
+        return 0;
+    }
+
+    std::vector<size_t> m_sizes;
+    std::vector<bool>   m_received;
+    std::vector<void*>  m_held_data;
+    unsigned            m_num_batches;
+    int64_t             m_last_single_seq;
+    bool                m_hold_data;
+};
+
+UCS_TEST_P(test_ucp_am_nbx_batch, small)
+{
+    test_batch(std::vector<size_t>(1000, 8));
+
+    /* Small messages received by one progress call are delivered together */
+    EXPECT_LT(m_num_batches, m_recv_counter);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_batch, mixed_sizes)
+{
+    std::vector<size_t> sizes;
+
+    /* Multi-fragment messages are delivered in batches of one message, after
+     * the eager messages which were received before them */
+    for (int i = 0; i < 100; ++i) {
+        sizes.push_back((i % 10 == 0) ? fragment_size() * 2 : i);
+    }
+
+    test_batch(sizes);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_batch, hold_data)
+{
+    m_hold_data = true;
+    test_batch(std::vector<size_t>(100, 64));
+
+    for (void *data : m_held_data) {
+        ucp_am_data_release(receiver().worker(), data);
+    }
+}
+
+UCS_TEST_P(test_ucp_am_nbx_batch, invalid_handler)
+{
+    ucp_am_handler_param_t param;
+
+    /* Batch callback is required with the batch flag */
+    param.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID    |
+                       UCP_AM_HANDLER_PARAM_FIELD_FLAGS |
+                       UCP_AM_HANDLER_PARAM_FIELD_CB;
+    param.id         = TEST_AM_NBX_ID;
+    param.flags      = UCP_AM_FLAG_BATCH;
+    param.cb         = am_data_cb;
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+              ucp_worker_set_am_recv_handler(receiver().worker(), &param));
+
+    scoped_log_handler wrap_err(wrap_errors_logger);
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+              ucp_worker_set_am_handler(receiver().worker(), TEST_AM_NBX_ID,
+                                        NULL, NULL, UCP_AM_FLAG_BATCH));
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_am_nbx_batch)
+
+
+class test_ucp_am_nbx_aggregate : public test_ucp_am_nbx_batch {
+public:
+    test_ucp_am_nbx_aggregate()
+    {
+        m_no_aggregate = false;
+    }
+
+    static void get_test_variants(variant_vec_t &variants)
+    {
+        test_ucp_am_nbx::get_test_variants(variants);
+        for (ucp_test_variant &variant : variants) {
+            variant.ctx_params.features |= UCP_FEATURE_WAKEUP;
+        }
+    }
+
+protected:
+    virtual ucp_ep_params_t get_ep_params()
+    {
+        ucp_ep_params_t ep_params = test_ucp_am_nbx::get_ep_params();
+        ep_params.field_mask     |= UCP_EP_PARAM_FIELD_FLAGS;
+        ep_params.flags          |= UCP_EP_PARAMS_FLAGS_AGGREGATE;
+        return ep_params;
+    }
+
+    virtual uint32_t send_op_attr_mask(uint64_t seq) const
+    {
+        return (m_no_aggregate && (seq % 3 == 0)) ?
+               UCP_OP_ATTR_FLAG_NO_AGGREGATE : 0;
+    }
+
+    size_t aggregated_length()
+    {
+        ucp_ep_aggr_t *aggr = sender().ep()->ext->aggr;
+        return (aggr == NULL) ? 0 : aggr->length;
+    }
+
+    /* Send small messages, which are held until the endpoint is flushed */
+    void send_aggregated(size_t count)
+    {
+        std::vector<char> sbuf(32, 'a');
+        ucp_request_param_t param;
+        ucs_status_ptr_t sptr;
+
+        reset_counters();
+        set_am_batch_handler(receiver());
+        m_sizes.assign(count, sbuf.size());
+        m_received.assign(m_sizes.size(), false);
+
+        param.op_attr_mask = 0;
+        for (uint64_t seq = 0; seq < m_sizes.size(); ++seq) {
+            mem_buffer::pattern_fill(sbuf.data(), sbuf.size(), SEED + seq);
+            sptr = update_counter_and_send_am(&seq, sizeof(seq), sbuf.data(),
+                                              sbuf.size(), TEST_AM_NBX_ID,
+                                              &param);
+            EXPECT_EQ(UCS_OK, UCS_PTR_STATUS(sptr));
+        }
+
+        progress();
+        EXPECT_EQ(0u, m_recv_counter);
+        EXPECT_GT(aggregated_length(), 0u);
+    }
+
+    bool m_no_aggregate;
+};
+
+UCS_TEST_P(test_ucp_am_nbx_aggregate, small)
+{
+    EXPECT_TRUE(sender().ep()->flags & UCP_EP_FLAG_AGGREGATE);
+    test_batch(std::vector<size_t>(1000, 8));
+}
+
+UCS_TEST_P(test_ucp_am_nbx_aggregate, mixed_sizes)
+{
+    std::vector<size_t> sizes;
+
+    /* Messages which are too large to be aggregated are sent after the
+     * aggregated messages which precede them */
+    for (int i = 0; i < 300; ++i) {
+        sizes.push_back((i % 10 == 0) ? fragment_size() * 2 : i);
+    }
+
+    test_batch(sizes);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_aggregate, no_aggregate)
+{
+    m_no_aggregate = true;
+    test_batch(std::vector<size_t>(300, 16));
+}
+
+UCS_TEST_P(test_ucp_am_nbx_aggregate, flush, "AGGREGATE_TIMEOUT=1000s")
+{
+    send_aggregated(10);
+
+    flush_ep(sender());
+    EXPECT_EQ(0u, aggregated_length());
+    wait_receives();
+    EXPECT_EQ(m_send_counter, m_recv_counter);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_aggregate, arm, "AGGREGATE_TIMEOUT=1000s")
+{
+    send_aggregated(10);
+
+    /* The worker can not sleep while it holds messages, since the peer may
+     * not reply before it gets them */
+    for (int i = 0; (i < 10) && (aggregated_length() > 0); ++i) {
+        EXPECT_EQ(UCS_ERR_BUSY, ucp_worker_arm(sender().worker()));
+    }
+
+    EXPECT_EQ(0u, aggregated_length());
+    wait_receives();
+    EXPECT_EQ(m_send_counter, m_recv_counter);
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_am_nbx_aggregate)
+
 class test_ucp_am_nbx_align : public test_ucp_am_nbx_reply {
 public:
     test_ucp_am_nbx_align()
@@ -280,3 +280,209 @@ INSTANTIATE_TEST_SUITE_P(iov, test_ucp_dt_iter,
 
 INSTANTIATE_TEST_SUITE_P(generic, test_ucp_dt_iter,
                         testing::ValuesIn(test_ucp_dt_iter::enum_dt_generic_params()));
+
+class test_ucp_dt_strided : public ucs::test {
+protected:
+    virtual void init() {
+        ucp_params_t ctx_params;
+        ctx_params.field_mask = UCP_PARAM_FIELD_FEATURES;
+        ctx_params.features   = UCP_FEATURE_TAG;
+        UCS_TEST_CREATE_HANDLE(ucp_context_h, m_ucph, ucp_cleanup, ucp_init,
+                               &ctx_params, NULL);
+    }
+
+    virtual void cleanup() {
+        m_ucph.reset();
+    }
+
+    /* Reference packing, block by block */
+    void gather(const std::vector<char> &buffer, size_t block_size,
+                const std::vector<ucp_dt_strided_dim_t> &dims, size_t extent,
+                size_t count, std::vector<char> &packed)
+    {
+        std::vector<size_t> index(dims.size(), 0);
+
+        packed.clear();
+        for (size_t i = 0; i < count; ++i) {
+            for (;;) {
+                size_t offset = i * extent;
+                for (size_t dim = 0; dim < dims.size(); ++dim) {
+                    offset += index[dim] * dims[dim].stride;
+                }
+                packed.insert(packed.end(), &buffer[offset],
+                              &buffer[offset] + block_size);
+
+                size_t dim;
+                for (dim = 0; dim < dims.size(); ++dim) {
+                    if (++index[dim] < dims[dim].count) {
+                        break;
+                    }
+                    index[dim] = 0;
+                }
+                if (dim == dims.size()) {
+                    break;
+                }
+            }
+        }
+    }
+
+    void test_strided(size_t block_size,
+                      const std::vector<ucp_dt_strided_dim_t> &dims,
+                      size_t count)
+    {
+        const ucp_dt_strided_dim_t &outer = dims.back();
+        size_t extent                     = outer.count * outer.stride;
+        ucp_dt_strided_params_t params;
+        ucp_datatype_t datatype;
+
+        params.field_mask = UCP_DT_STRIDED_PARAM_FIELD_BLOCK_SIZE |
+                            UCP_DT_STRIDED_PARAM_FIELD_DIMS;
+        params.block_size = block_size;
+        params.dims       = &dims[0];
+        params.num_dims   = dims.size();
+        ASSERT_UCS_OK(ucp_dt_create_strided(&params, &datatype));
+
+        std::vector<char> buffer(count * extent + block_size);
+        std::vector<char> expected;
+        ucs::fill_random(buffer);
+        gather(buffer, block_size, dims, extent, count, expected);
+
+        ucp_datatype_attr_t attr;
+        attr.field_mask = UCP_DATATYPE_ATTR_FIELD_PACKED_SIZE |
+                          UCP_DATATYPE_ATTR_FIELD_COUNT;
+        attr.count      = count;
+        ASSERT_UCS_OK(ucp_dt_query(datatype, &attr));
+        EXPECT_EQ(expected.size(), attr.packed_size);
+
+        /* Pack in random segments */
+        ucp_request_param_t param;
+        param.op_attr_mask = 0;
+
+        ucp_datatype_iter_t dt_iter, next_iter;
+        uint8_t sg_count;
+        ASSERT_UCS_OK(ucp_datatype_iter_init(m_ucph.get(), &buffer[0], count,
+                                             datatype, 0, 1, &dt_iter,
+                                             &sg_count, &param));
+        EXPECT_EQ(0, sg_count);
+        ASSERT_EQ(expected.size(), dt_iter.length);
+
+        std::vector<char> packed(expected.size() + 1);
+        while (!ucp_datatype_iter_is_end(&dt_iter)) {
+            size_t seg_size = (ucs::rand() % (3 * block_size)) + 1;
+            ucp_datatype_iter_next_pack(&dt_iter, NULL, seg_size, &next_iter,
+                                        &packed[dt_iter.offset]);
+            ucp_datatype_iter_copy_position(&dt_iter, &next_iter,
+                                            UCP_DT_MASK_ALL);
+        }
+        ucp_datatype_iter_cleanup(&dt_iter, 1, UCP_DT_MASK_ALL);
+        packed.resize(expected.size());
+        EXPECT_EQ(expected, packed);
+
+        /* Unpack in random order into a fresh buffer, and pack it again */
+        std::vector<char> unpacked(buffer.size(), 0);
+        param.op_attr_mask = UCP_OP_ATTR_FIELD_DATATYPE;
+        param.datatype     = datatype;
+        ASSERT_UCS_OK(ucp_datatype_iter_init_unpack(m_ucph.get(),
+                                                    &unpacked[0], count,
+                                                    &dt_iter, &param));
+
+        std::vector<std::pair<size_t, size_t> > segments;
+        for (size_t offset = 0; offset < expected.size();) {
+            size_t seg_size = std::min((ucs::rand() % (3 * block_size)) + 1,
+                                       expected.size() - offset);
+            segments.push_back(std::make_pair(offset, seg_size));
+            offset += seg_size;
+        }
+        std::random_shuffle(segments.begin(), segments.end(), ucs::rand_range);
+
+        for (size_t i = 0; i < segments.size(); ++i) {
+            ASSERT_UCS_OK(ucp_datatype_iter_unpack(&dt_iter, NULL,
+                                                   segments[i].second,
+                                                   segments[i].first,
+                                                   &expected[segments[i].first]));
+        }
+        ucp_datatype_iter_cleanup(&dt_iter, 1, UCP_DT_MASK_ALL);
+
+        std::vector<char> repacked;
+        gather(unpacked, block_size, dims, extent, count, repacked);
+        EXPECT_EQ(expected, repacked);
+
+        ucp_dt_destroy(datatype);
+    }
+
+    static std::vector<ucp_dt_strided_dim_t>
+    make_dims(size_t count0, size_t stride0, size_t count1 = 0,
+              size_t stride1 = 0, size_t count2 = 0, size_t stride2 = 0)
+    {
+        std::vector<ucp_dt_strided_dim_t> dims;
+        ucp_dt_strided_dim_t dim;
+
+        dim.count  = count0;
+        dim.stride = stride0;
+        dims.push_back(dim);
+        if (count1 != 0) {
+            dim.count  = count1;
+            dim.stride = stride1;
+            dims.push_back(dim);
+        }
+        if (count2 != 0) {
+            dim.count  = count2;
+            dim.stride = stride2;
+            dims.push_back(dim);
+        }
+        return dims;
+    }
+
+    ucs::handle<ucp_context_h> m_ucph;
+};
+
+UCS_TEST_F(test_ucp_dt_strided, vector) {
+    static const size_t block_sizes[] = {1, 4, 8, 13, 16, 32, 100};
+
+    for (size_t i = 0; i < ucs_static_array_size(block_sizes); ++i) {
+        size_t block_size = block_sizes[i];
+        test_strided(block_size, make_dims(7, block_size * 3), 3);
+    }
+}
+
+UCS_TEST_F(test_ucp_dt_strided, nested) {
+    /* Face of a 3D array of doubles, orthogonal to the Y axis */
+    const size_t nx = 10, ny = 6, nz = 5;
+    test_strided(8, make_dims(nx, 8, nz, nx * ny * 8), 2);
+
+    /* Face orthogonal to the X axis */
+    test_strided(8, make_dims(ny, nx * 8, nz, nx * ny * 8), 2);
+
+    /* 3D sub-block */
+    test_strided(4, make_dims(3, 8, 4, 40, 2, 200), 3);
+}
+
+UCS_TEST_F(test_ucp_dt_strided, contig_dims) {
+    /* Dimensions without gaps are folded into the block */
+    test_strided(8, make_dims(4, 8, 3, 64), 5);
+    test_strided(8, make_dims(4, 8, 3, 32), 5);
+    test_strided(2, make_dims(1, 100, 5, 10, 3, 50), 4);
+}
+
+UCS_TEST_F(test_ucp_dt_strided, invalid_params) {
+    ucp_dt_strided_dim_t dim = {0, 8};
+    ucp_dt_strided_params_t params;
+    ucp_datatype_t datatype;
+
+    params.field_mask = UCP_DT_STRIDED_PARAM_FIELD_BLOCK_SIZE |
+                        UCP_DT_STRIDED_PARAM_FIELD_DIMS;
+    params.block_size = 8;
+    params.dims       = &dim;
+    params.num_dims   = 1;
+
+    {
+        scoped_log_handler wrap_err(wrap_errors_logger);
+        EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+                  ucp_dt_create_strided(&params, &datatype));
+
+        dim.count       = 4;
+        params.num_dims = UCP_DT_STRIDED_MAX_DIMS + 1;
+        EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+                  ucp_dt_create_strided(&params, &datatype));
+    }
+}
@@ -11,6 +11,8 @@
 #include <common/test_perf.h>
 #include <ucp/core/ucp_types.h>
 
+#include <set>
+
 extern "C" {
 #include <ucp/core/ucp_context.h>
 }
@@ -439,3 +441,74 @@ UCS_TEST_P(test_ucp_wait_mem, envelope) {
 }
 
 UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_wait_mem, shm, "shm")
+
+
+class test_ucp_perf_pattern : public ucs::test {
+protected:
+    void check_matching(ucx_perf_params_t &params, unsigned group_size,
+                        std::set<std::pair<unsigned, unsigned> > &pairs)
+    {
+        for (unsigned i = 0; i < group_size; ++i) {
+            unsigned num_peers = 0;
+            for (unsigned j = 0; j < group_size; ++j) {
+                if (!ucx_perf_pattern_is_peer(&params, group_size, i, j)) {
+                    continue;
+                }
+
+                EXPECT_NE(i, j);
+                EXPECT_TRUE(ucx_perf_pattern_is_peer(&params, group_size, j,
+                                                     i));
+                pairs.insert(std::make_pair(std::min(i, j), std::max(i, j)));
+                ++num_peers;
+            }
+
+            EXPECT_EQ(1u, num_peers) << "rank " << i << " round "
+                                     << params.pattern_round;
+        }
+    }
+};
+
+UCS_TEST_F(test_ucp_perf_pattern, matchings) {
+    static const ucx_perf_pattern_t patterns[] = {
+        UCX_PERF_PATTERN_PAIRS,
+        UCX_PERF_PATTERN_PERMUTATION,
+        UCX_PERF_PATTERN_ALL_TO_ALL
+    };
+    ucx_perf_params_t params = {};
+
+    for (unsigned group_size = 2; group_size <= 16; group_size += 2) {
+        for (unsigned p = 0; p < ucs_static_array_size(patterns); ++p) {
+            std::set<std::pair<unsigned, unsigned> > pairs;
+            unsigned num_rounds;
+
+            params.pattern = patterns[p];
+            num_rounds     = ucx_perf_pattern_num_rounds(params.pattern,
+                                                         group_size);
+            for (params.pattern_round = 0; params.pattern_round < num_rounds;
+                 ++params.pattern_round) {
+                check_matching(params, group_size, pairs);
+            }
+
+            /* All-to-all covers every pair exactly once */
+            EXPECT_EQ(num_rounds * (group_size / 2), pairs.size());
+            if (params.pattern == UCX_PERF_PATTERN_ALL_TO_ALL) {
+                EXPECT_EQ(group_size * (group_size - 1) / 2, pairs.size());
+            }
+        }
+    }
+}
+
+UCS_TEST_F(test_ucp_perf_pattern, incast) {
+    ucx_perf_params_t params = {};
+    unsigned group_size      = 8;
+
+    params.pattern = UCX_PERF_PATTERN_INCAST;
+    EXPECT_EQ(1u, ucx_perf_pattern_num_rounds(params.pattern, group_size));
+
+    for (unsigned i = 0; i < group_size; ++i) {
+        for (unsigned j = 0; j < group_size; ++j) {
+            EXPECT_EQ((i != j) && ((i == 0) || (j == 0)),
+                      !!ucx_perf_pattern_is_peer(&params, group_size, i, j));
+        }
+    }
+}
@@ -10,6 +10,7 @@
 #include <common/mem_buffer.h>
 #include <unordered_map>
 #include <memory>
+#include <dirent.h>
 
 extern "C" {
 #include <ucp/core/ucp_rkey.h>
@@ -18,6 +19,8 @@ extern "C" {
 #include <ucp/proto/proto_debug.h>
 #include <ucp/proto/proto_perf.h>
 #include <ucp/proto/proto_init.h>
+#include <ucp/proto/proto_cache.h>
+#include <ucp/proto/proto_feedback.h>
 #include <ucs/datastruct/linear_func.h>
 #include <ucp/proto/proto_select.inl>
 #include <ucp/core/ucp_worker.inl>
@@ -212,6 +215,237 @@ UCP_INSTANTIATE_TEST_CASE(test_ucp_proto)
 UCP_INSTANTIATE_TEST_CASE_TLS_GPU_AWARE(test_ucp_proto, shm_ipc,
                                         "shm,cuda_ipc,rocm_ipc")
 
+class test_ucp_proto_feedback : public test_ucp_proto {
+protected:
+    virtual void init() {
+        modify_config("PROTO_FEEDBACK", "y");
+        test_ucp_proto::init();
+    }
+
+    ucp_proto_select_elem_t *tag_send_select_elem() {
+        ucp_worker_cfg_index_t ep_cfg_index = sender().ep()->cfg_index;
+        ucp_proto_select_param_t select_param;
+
+        select_param.op_id_flags   = UCP_OP_ID_TAG_SEND;
+        select_param.op_attr       = 0;
+        select_param.dt_class      = UCP_DATATYPE_CONTIG;
+        select_param.mem_type      = UCS_MEMORY_TYPE_HOST;
+        select_param.sys_dev       = UCS_SYS_DEVICE_ID_UNKNOWN;
+        select_param.sg_count      = 1;
+        select_param.op.padding[0] = 0;
+        select_param.op.padding[1] = 0;
+
+        return ucp_proto_select_lookup_slow(
+                worker(),
+                &ucp_worker_ep_config(worker(), ep_cfg_index)->proto_select, 0,
+                ep_cfg_index, UCP_WORKER_CFG_INDEX_NULL, &select_param);
+    }
+};
+
+UCS_TEST_P(test_ucp_proto_feedback, update_selection) {
+    const size_t msg_length   = UCS_KBYTE;
+    const size_t other_length = msg_length / 2;
+
+    /* Complete wireup to select protocols for the final configuration */
+    flush_ep(sender());
+
+    ucp_proto_select_elem_t *select_elem = tag_send_select_elem();
+    ASSERT_NE(nullptr, select_elem);
+
+    const ucp_proto_threshold_elem_t *thresh =
+            ucp_proto_select_thresholds_search(select_elem, msg_length);
+    const ucp_proto_init_elem_t *init_elem   = thresh->proto_config.init_elem;
+    const void *other_proto                  =
+            ucp_proto_select_thresholds_search(select_elem, other_length)
+                    ->proto_config.proto;
+    ASSERT_NE(nullptr, init_elem);
+
+    ucp_proto_feedback_t *feedback = init_elem->feedback;
+    ASSERT_NE(nullptr, feedback);
+    if (feedback->num_protocols < 2) {
+        UCS_TEST_SKIP_R("single protocol");
+    }
+
+    /* Report the selected protocol as much slower than estimated on the
+     * message size range of msg_length */
+    unsigned proto_idx = init_elem - feedback->protocols;
+    feedback->buckets[(proto_idx * UCP_PROTO_FEEDBACK_NUM_BUCKETS) +
+                      ucp_proto_feedback_bucket_index(msg_length)].scale = 1e6;
+    ucp_proto_select_feedback_update(worker(), feedback);
+
+    /* Another protocol is selected for this range, and the previous
+     * thresholds are kept for requests in progress */
+    select_elem = tag_send_select_elem();
+    EXPECT_EQ(1u, feedback->num_updates);
+    EXPECT_EQ(1u, ucs_array_length(&feedback->retired));
+    EXPECT_NE(thresh->proto_config.proto,
+              ucp_proto_select_thresholds_search(select_elem, msg_length)
+                      ->proto_config.proto);
+
+    /* Other message size ranges are not affected */
+    EXPECT_EQ(other_proto,
+              ucp_proto_select_thresholds_search(select_elem, other_length)
+                      ->proto_config.proto);
+
+    /* Send with the updated selection */
+    std::string send_data(msg_length, 'x'), recv_data(msg_length, 0);
+    ucp_request_param_t param;
+    param.op_attr_mask = 0;
+    void *rreq = ucp_tag_recv_nbx(receiver().worker(), &recv_data[0],
+                                  recv_data.size(), 1, UCP_TAG_MASK_FULL,
+                                  &param);
+    void *sreq = ucp_tag_send_nbx(sender().ep(), send_data.c_str(),
+                                  send_data.size(), 1, &param);
+    ASSERT_UCS_OK(request_wait(sreq));
+    ASSERT_UCS_OK(request_wait(rreq));
+    EXPECT_EQ(send_data, recv_data);
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_proto_feedback, tcp, "tcp")
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_proto_feedback, shm, "shm")
+
+class test_ucp_proto_cache : public test_ucp_proto {
+protected:
+    virtual void init() {
+        char tmpl[] = "/tmp/ucx_proto_cache_XXXXXX";
+
+        ASSERT_NE(nullptr, mkdtemp(tmpl));
+        m_cache_dir = tmpl;
+        modify_config("PROTO_CACHE_DIR", m_cache_dir);
+        test_ucp_proto::init();
+    }
+
+    virtual void cleanup() {
+        test_ucp_proto::cleanup();
+
+        for (const auto &file_name : cache_files()) {
+            unlink((m_cache_dir + "/" + file_name).c_str());
+        }
+        rmdir(m_cache_dir.c_str());
+    }
+
+    std::vector<std::string> cache_files() const {
+        std::vector<std::string> file_names;
+        struct dirent *entry;
+        DIR *dir;
+
+        dir = opendir(m_cache_dir.c_str());
+        if (dir == NULL) {
+            return file_names;
+        }
+
+        while ((entry = readdir(dir)) != NULL) {
+            if (entry->d_name[0] != '.') {
+                file_names.push_back(entry->d_name);
+            }
+        }
+
+        closedir(dir);
+        return file_names;
+    }
+
+    static ucp_proto_select_param_t tag_send_param() {
+        ucp_proto_select_param_t select_param;
+
+        select_param.op_id_flags   = UCP_OP_ID_TAG_SEND;
+        select_param.op_attr       = 0;
+        select_param.dt_class      = UCP_DATATYPE_CONTIG;
+        select_param.mem_type      = UCS_MEMORY_TYPE_HOST;
+        select_param.sys_dev       = UCS_SYS_DEVICE_ID_UNKNOWN;
+        select_param.sg_count      = 1;
+        select_param.op.padding[0] = 0;
+        select_param.op.padding[1] = 0;
+        return select_param;
+    }
+
+    static const ucp_proto_select_elem_t *select_elem(entity &e) {
+        ucp_proto_select_param_t select_param = tag_send_param();
+        ucp_worker_h worker                   = e.worker();
+        ucp_worker_cfg_index_t ep_cfg_index   = e.ep()->cfg_index;
+
+        return ucp_proto_select_lookup_slow(
+                worker, &ucp_worker_ep_config(worker, ep_cfg_index)->proto_select,
+                0, ep_cfg_index, UCP_WORKER_CFG_INDEX_NULL, &select_param);
+    }
+
+    static ucp_proto_id_mask_t
+    thresholds_proto_mask(const ucp_proto_select_elem_t *elem) {
+        const ucp_proto_threshold_elem_t *thresh = elem->thresholds;
+        ucp_proto_id_mask_t proto_mask           = 0;
+
+        do {
+            proto_mask |= UCS_BIT(thresh->proto_config.init_elem->proto_id);
+        } while ((thresh++)->max_msg_length != SIZE_MAX);
+
+        return proto_mask;
+    }
+
+    static ucp_proto_id_mask_t
+    init_proto_mask(const ucp_proto_select_elem_t *elem) {
+        ucp_proto_id_mask_t proto_mask = 0;
+        const ucp_proto_init_elem_t *init_elem;
+
+        ucs_array_for_each(init_elem, &elem->proto_init.protocols) {
+            proto_mask |= UCS_BIT(init_elem->proto_id);
+        }
+
+        return proto_mask;
+    }
+
+    std::string m_cache_dir;
+};
+
+UCS_TEST_P(test_ucp_proto_cache, reuse) {
+    /* Use two new entities, so both have the same kind of connection */
+    entity *e1 = create_entity();
+    e1->connect(&receiver(), get_ep_params());
+    /* Complete wireup to select protocols for the final configuration */
+    flush_ep(*e1);
+
+    const ucp_proto_select_elem_t *elem1 = select_elem(*e1);
+    ASSERT_NE(nullptr, elem1);
+
+    /* Flush the cache file of the first worker */
+    ucp_proto_cache_destroy(e1->worker());
+    EXPECT_EQ(1, cache_files().size());
+
+    entity *e2 = create_entity();
+    e2->connect(&receiver(), get_ep_params());
+    flush_ep(*e2);
+
+    const ucp_proto_select_elem_t *elem2 = select_elem(*e2);
+    ASSERT_NE(nullptr, elem2);
+
+    /* The second worker found the entry of the first one */
+    ucp_proto_select_param_t select_param = tag_send_param();
+    ucp_proto_id_mask_t cached_mask;
+    ASSERT_TRUE(ucp_proto_cache_lookup(e2->worker(), e2->ep()->cfg_index,
+                                       UCP_WORKER_CFG_INDEX_NULL, &select_param,
+                                       &cached_mask));
+    EXPECT_EQ(thresholds_proto_mask(elem1), cached_mask);
+
+    /* Only the protocols selected by the first worker are probed, and the
+     * selection result is the same */
+    EXPECT_EQ(cached_mask, init_proto_mask(elem2));
+    if (init_proto_mask(elem1) != cached_mask) {
+        EXPECT_LT(ucs_array_length(&elem2->proto_init.protocols),
+                  ucs_array_length(&elem1->proto_init.protocols));
+    }
+
+    const ucp_proto_threshold_elem_t *thresh1 = elem1->thresholds;
+    const ucp_proto_threshold_elem_t *thresh2 = elem2->thresholds;
+    for (;; ++thresh1, ++thresh2) {
+        EXPECT_EQ(thresh1->proto_config.proto, thresh2->proto_config.proto);
+        ASSERT_EQ(thresh1->max_msg_length, thresh2->max_msg_length);
+        if (thresh1->max_msg_length == SIZE_MAX) {
+            break;
+        }
+    }
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_proto_cache, all, "all")
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_proto_cache, tcp, "tcp")
+
 class test_perf_node : public test_ucp_proto {
 };
 
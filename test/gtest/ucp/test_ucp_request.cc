@@ -14,6 +14,8 @@ extern "C" {
 #include <ucp/rndv/proto_rndv.h>
 }
 
+#include <fstream>
+
 
 class test_ucp_request : public ucp_test {
 public:
@@ -104,6 +106,159 @@ UCS_TEST_P(test_ucp_request, test_request_query)
 
 UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_request, all, "all")
 
+class test_ucp_request_trace : public ucp_test {
+public:
+    virtual void init()
+    {
+        if (!ENABLE_REQUEST_TRACE) {
+            UCS_TEST_SKIP_R("request tracing is disabled");
+        }
+
+        m_file_path = "/tmp/ucx_request_trace_" + ucs::to_string(getpid());
+        unlink(m_file_path.c_str());
+        modify_config("REQUEST_TRACE_FILE", m_file_path);
+        ucp_test::init();
+        sender().connect(&receiver(), get_ep_params());
+    }
+
+    virtual void cleanup()
+    {
+        ucp_test::cleanup();
+        if (!m_file_path.empty()) {
+            unlink(m_file_path.c_str());
+        }
+    }
+
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant(variants, UCP_FEATURE_TAG);
+    }
+
+protected:
+    void send_recv(unsigned count, size_t size)
+    {
+        std::vector<char> sbuf(size, 's'), rbuf(size);
+        ucp_request_param_t param;
+
+        param.op_attr_mask = 0;
+        for (unsigned i = 0; i < count; ++i) {
+            void *rreq = ucp_tag_recv_nbx(receiver().worker(), rbuf.data(),
+                                          size, 0, 0, &param);
+            void *sreq = ucp_tag_send_nbx(sender().ep(), sbuf.data(), size, 0,
+                                          &param);
+            ASSERT_UCS_OK(request_wait(sreq));
+            ASSERT_UCS_OK(request_wait(rreq));
+        }
+    }
+
+    /* Destroy the sender worker, which writes its remaining traced requests,
+     * and return the records of all blocks in the file */
+    std::vector<ucp_request_trace_record_t>
+    sender_records(size_t *num_blocks_p = NULL)
+    {
+        std::vector<ucp_request_trace_record_t> records;
+        ucp_request_trace_header_t header;
+        size_t num_blocks = 0;
+        size_t offset;
+
+        flush_workers();
+        disconnect(sender());
+        sender().destroy_worker();
+
+        std::ifstream file(m_file_path.c_str(), std::ios::binary);
+        while (file.read((char*)&header, sizeof(header))) {
+            EXPECT_EQ(UCP_REQUEST_TRACE_FILE_MAGIC, header.magic);
+            EXPECT_EQ(UCP_REQUEST_TRACE_FILE_VERSION, header.version);
+            EXPECT_EQ(UCP_REQUEST_TRACE_STAGE_LAST, header.num_stages);
+
+            file.seekg(UCP_REQUEST_TRACE_NAME_MAX *
+                               (header.num_stages + header.num_ops +
+                                header.num_protocols),
+                       std::ios::cur);
+            offset = records.size();
+            records.resize(offset + header.num_records);
+            file.read((char*)&records[offset],
+                      header.num_records * sizeof(ucp_request_trace_record_t));
+            EXPECT_TRUE(file.good());
+            ++num_blocks;
+        }
+
+        if (num_blocks == 0) {
+            ADD_FAILURE() << "failed to read " << m_file_path;
+        }
+
+        if (num_blocks_p != NULL) {
+            *num_blocks_p = num_blocks;
+        }
+
+        return records;
+    }
+
+    std::string m_file_path;
+};
+
+UCS_TEST_P(test_ucp_request_trace, rndv, "RNDV_THRESH=0",
+           "REQUEST_TRACE_SAMPLE=1")
+{
+    static const unsigned count = 16;
+    static const size_t size    = 65536;
+
+    send_recv(count, size);
+
+    std::vector<ucp_request_trace_record_t> records = sender_records();
+    ASSERT_EQ(count, records.size());
+    for (const auto &record : records) {
+        EXPECT_EQ(size, record.length);
+        EXPECT_EQ(UCP_OP_ID_TAG_SEND, record.op_id);
+
+        /* Stages which every rendezvous request goes through */
+        uint64_t stamps[UCP_REQUEST_TRACE_STAGE_LAST];
+        memcpy(stamps, record.stamps, sizeof(stamps));
+        EXPECT_NE(0, stamps[UCP_REQUEST_TRACE_STAGE_SUBMIT]);
+        EXPECT_GE(stamps[UCP_REQUEST_TRACE_STAGE_SELECTED],
+                  stamps[UCP_REQUEST_TRACE_STAGE_SUBMIT]);
+        EXPECT_GE(stamps[UCP_REQUEST_TRACE_STAGE_POSTED],
+                  stamps[UCP_REQUEST_TRACE_STAGE_SELECTED]);
+        EXPECT_GE(stamps[UCP_REQUEST_TRACE_STAGE_REMOTE],
+                  stamps[UCP_REQUEST_TRACE_STAGE_POSTED]);
+        EXPECT_GE(stamps[UCP_REQUEST_TRACE_STAGE_COMPLETE],
+                  stamps[UCP_REQUEST_TRACE_STAGE_REMOTE]);
+    }
+}
+
+UCS_TEST_P(test_ucp_request_trace, sample, "REQUEST_TRACE_SAMPLE=4")
+{
+    static const unsigned count = 64;
+
+    /* Large enough to not be sent inline without a request */
+    send_recv(count, 4096);
+
+    std::vector<ucp_request_trace_record_t> records = sender_records();
+    EXPECT_EQ(count / 4, records.size());
+    for (const auto &record : records) {
+        EXPECT_EQ(0, record.stamps[UCP_REQUEST_TRACE_STAGE_REMOTE]);
+        EXPECT_GE(record.stamps[UCP_REQUEST_TRACE_STAGE_COMPLETE],
+                  record.stamps[UCP_REQUEST_TRACE_STAGE_SUBMIT]);
+    }
+}
+
+UCS_TEST_P(test_ucp_request_trace, buffer_full, "REQUEST_TRACE_SAMPLE=1",
+           "REQUEST_TRACE_BUFFER_SIZE=4")
+{
+    static const unsigned count = 18;
+    size_t num_blocks;
+
+    send_recv(count, 4096);
+
+    /* Full buffers are written while running, the rest on worker destroy */
+    std::vector<ucp_request_trace_record_t> records = sender_records(
+            &num_blocks);
+    EXPECT_EQ(count, records.size());
+    EXPECT_EQ(ucs_div_round_up(count, 4), num_blocks);
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_request_trace, all, "all")
+
 class test_proto_reset : public ucp_test {
 public:
     typedef enum {
@@ -657,6 +657,62 @@ UCS_TEST_P(test_ucp_stream, send_zero_ending_iov_recv_data) {
     }
 }
 
+UCS_TEST_P(test_ucp_stream, recv_ring) {
+    const size_t      ring_size = 4 * UCS_KBYTE;
+    std::vector<char> ring_buffer(ring_size);
+    std::vector<char> sbuf, check_pattern, rbuf;
+    ucp_stream_ring_t ring;
+    size_t            length, offset;
+    ucs_status_ptr_t  sstatus;
+
+    ring.buffer = ring_buffer.data();
+    ring.size   = ring_size;
+    ASSERT_UCS_OK(ucp_stream_ring_set(receiver().ep(), &ring));
+
+    /* Data which does not fit in the ring is written when it is released */
+    for (size_t i = 3; i < 16 * ring_size; i *= 2) {
+        sbuf.resize(i);
+        ucs::fill_random(sbuf, i);
+        check_pattern.insert(check_pattern.end(), sbuf.begin(), sbuf.end());
+        ucp::data_type_desc_t dt_desc(DATATYPE, sbuf.data(), i);
+        sstatus = stream_send_nb(dt_desc);
+        EXPECT_FALSE(UCS_PTR_IS_ERR(sstatus));
+        request_wait(sstatus);
+    }
+
+    do {
+        progress();
+        while (ring.head != ring.tail) {
+            offset = ring.head & (ring_size - 1);
+            length = std::min<size_t>(ring.tail - ring.head,
+                                      ring_size - offset);
+            rbuf.insert(rbuf.end(), ring_buffer.begin() + offset,
+                        ring_buffer.begin() + offset + length);
+            ASSERT_UCS_OK(ucp_stream_ring_release(receiver().ep(), length));
+        }
+    } while (rbuf.size() < check_pattern.size());
+
+    EXPECT_EQ(check_pattern, rbuf);
+    EXPECT_EQ(UCS_ERR_UNSUPPORTED,
+              UCS_PTR_STATUS(ucp_stream_recv_data_nb(receiver().ep(),
+                                                     &length)));
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+              ucp_stream_ring_release(receiver().ep(), 1));
+    ASSERT_UCS_OK(ucp_stream_ring_set(receiver().ep(), NULL));
+}
+
+UCS_TEST_P(test_ucp_stream, recv_ring_invalid) {
+    std::vector<char> ring_buffer(1000);
+    ucp_stream_ring_t ring;
+
+    ring.buffer = ring_buffer.data();
+    ring.size   = ring_buffer.size();
+
+    scoped_log_handler wrap_err(wrap_errors_logger);
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+              ucp_stream_ring_set(receiver().ep(), &ring));
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_stream)
 
 class test_ucp_stream_many2one : public test_ucp_stream_base {
@@ -14,6 +14,7 @@ extern "C" {
 #include <ucp/core/ucp_types.h>
 #include <ucp/rndv/proto_rndv.h>
 #include <ucp/core/ucp_ep.inl>
+#include <ucp/tag/tag_match.h>
 }
 
 using namespace ucs; /* For vector<char> serialization */
@@ -84,6 +85,8 @@ protected:
     }
 
     void send_recv_unexp(bool immediate);
+    void send_recv_exp_wildcard_order();
+    void send_nb_multiple_recv_unexp();
     static ucs_status_t m_req_status;
 };
 
@@ -119,6 +122,57 @@ void test_ucp_tag_match::send_recv_unexp(bool immediate)
     EXPECT_EQ(send_data, recv_data);
 }
 
+void test_ucp_tag_match::send_recv_exp_wildcard_order()
+{
+    /* Expected receives with full, class-indexed and wildcard queue masks */
+    static const struct {
+        ucp_tag_t tag;
+        ucp_tag_t tag_mask;
+    } recvs[] = {
+        {0x10,  0xff},
+        {0x110, UCP_TAG_MASK_FULL},
+        {0x100, 0xf00},
+        {0x10,  0xf},
+        {0x110, UCP_TAG_MASK_FULL},
+        {0x210, 0xff},
+        {0x0,   0xf00}
+    };
+    /* Sent tags and the index of the receive expected to match each of them */
+    static const struct {
+        ucp_tag_t tag;
+        uint64_t  recv_index;
+    } sends[] = {
+        {0x20,  3},
+        {0x110, 0},
+        {0x110, 1},
+        {0x110, 2},
+        {0x110, 4},
+        {0x110, 5},
+        {0x20,  6}
+    };
+    std::vector<uint64_t> recv_data(ucs_static_array_size(recvs), UINT64_MAX);
+    std::vector<request*> rreqs;
+    uint64_t send_data;
+
+    for (size_t i = 0; i < ucs_static_array_size(recvs); ++i) {
+        rreqs.push_back(recv_nb(&recv_data[i], sizeof(recv_data[i]), DATATYPE,
+                                recvs[i].tag, recvs[i].tag_mask));
+        ASSERT_TRUE(!UCS_PTR_IS_ERR(rreqs.back()));
+    }
+
+    for (size_t i = 0; i < ucs_static_array_size(sends); ++i) {
+        send_data = sends[i].recv_index;
+        send_b(&send_data, sizeof(send_data), DATATYPE, sends[i].tag);
+    }
+
+    for (size_t i = 0; i < ucs_static_array_size(recvs); ++i) {
+        wait(rreqs[i]);
+        EXPECT_UCS_OK(rreqs[i]->status);
+        EXPECT_EQ(i, recv_data[i]) << "receive " << i;
+        request_free(rreqs[i]);
+    }
+}
+
 UCS_TEST_P(test_ucp_tag_match, send_recv_unexp)
 {
     send_recv_unexp(false);
@@ -378,6 +432,15 @@ UCS_TEST_P(test_ucp_tag_match, send2_nb_recv_medium_wildcard, "RNDV_THRESH=inf")
     }
 }
 
+UCS_TEST_P(test_ucp_tag_match, send_recv_exp_wildcard_order) {
+    send_recv_exp_wildcard_order();
+}
+
+UCS_TEST_P(test_ucp_tag_match, send_recv_exp_wildcard_order_mask_classes,
+           "TM_MASK_CLASSES=2") {
+    send_recv_exp_wildcard_order();
+}
+
 UCS_TEST_P(test_ucp_tag_match, send_recv_nb_partial_exp_medium) {
     static const size_t size = 50000;
 
@@ -495,7 +558,8 @@ UCS_TEST_P(test_ucp_tag_match, send_recv_nb_exp) {
     request_free(my_recv_req);
 }
 
-UCS_TEST_P(test_ucp_tag_match, send_nb_multiple_recv_unexp) {
+void test_ucp_tag_match::send_nb_multiple_recv_unexp()
+{
     const unsigned      num_requests = 1000;
     ucp_tag_recv_info_t info;
     ucs_status_t        status;
@@ -534,6 +598,117 @@ UCS_TEST_P(test_ucp_tag_match, send_nb_multiple_recv_unexp) {
     }
 }
 
+UCS_TEST_P(test_ucp_tag_match, send_nb_multiple_recv_unexp) {
+    send_nb_multiple_recv_unexp();
+}
+
+UCS_TEST_P(test_ucp_tag_match, send_nb_multiple_recv_unexp_spill,
+           "UNEXP_SPILL_THRESH=0") {
+    send_nb_multiple_recv_unexp();
+}
+
+UCS_TEST_P(test_ucp_tag_match, unexp_max_size, "UNEXP_SPILL_THRESH=0",
+           "UNEXP_MAX_SIZE=4k", "RNDV_THRESH=inf") {
+    const size_t max_length     = 4096;
+    const size_t msg_size       = 128;
+    const unsigned num_requests = 64;
+    ucp_tag_match_t *tm         = &receiver().worker()->tm;
+    std::vector<char> send_data(msg_size), recv_data(msg_size);
+    ucp_tag_recv_info_t info;
+    unsigned num_recvd;
+    ucs_status_t status;
+    request *req;
+
+    skip_loopback();
+    check_offload_support(false);
+    ucs::fill_random(send_data);
+
+    {
+        scoped_log_handler slh(hide_errors_logger);
+        for (unsigned i = 0; i < num_requests; ++i) {
+            req = send_nb(&send_data[0], msg_size, DATATYPE, 0x111337);
+            ASSERT_TRUE(!UCS_PTR_IS_ERR(req));
+            if (req != NULL) {
+                wait(req);
+                EXPECT_UCS_OK(req->status);
+                request_free(req);
+            }
+        }
+        short_progress_loop();
+    }
+
+    /* Messages above the limit are dropped */
+    EXPECT_LE(tm->unexpected.length, max_length);
+    EXPECT_GT(tm->unexpected.length, max_length / 2);
+    EXPECT_GT(tm->unexpected.num_dropped, 0ul);
+
+    num_recvd = 0;
+    while (ucp_tag_probe_nb(receiver().worker(), 0, 0, 0, &info) != NULL) {
+        status = recv_b(&recv_data[0], msg_size, DATATYPE, 0x1337, 0xffff,
+                        &info);
+        ASSERT_UCS_OK(status);
+        EXPECT_EQ(msg_size, info.length);
+        EXPECT_EQ(send_data, recv_data);
+        ++num_recvd;
+    }
+
+    EXPECT_EQ(num_requests, num_recvd + tm->unexpected.num_dropped);
+    EXPECT_EQ(0ul, tm->unexpected.length);
+}
+
+UCS_TEST_P(test_ucp_tag_match, unexp_max_size_reject, "UNEXP_MAX_SIZE=1",
+           "RNDV_THRESH=64k") {
+    const size_t eager_size     = 32 * UCS_KBYTE;
+    const size_t rndv_size      = 256 * UCS_KBYTE;
+    ucp_tag_match_t *tm         = &receiver().worker()->tm;
+    std::vector<char> send_data(rndv_size), recv_data(rndv_size);
+    ucp_tag_recv_info_t info;
+    request *req;
+
+    skip_loopback();
+    check_offload_support(false);
+    ucs::fill_random(send_data);
+
+    {
+        scoped_log_handler slh(hide_errors_logger);
+
+        /* Single and multi-fragment eager messages are dropped */
+        send_b(&send_data[0], 8, DATATYPE, 0x111337);
+        send_b(&send_data[0], eager_size, DATATYPE, 0x111337);
+        short_progress_loop();
+        EXPECT_EQ(2ul, tm->unexpected.num_dropped);
+
+        /* Synchronous eager and rendezvous sends complete with an error */
+        req = send_sync_nb(&send_data[0], 8, DATATYPE, 0x111337);
+        ASSERT_TRUE(!UCS_PTR_IS_ERR(req) && (req != NULL));
+        wait(req);
+        EXPECT_EQ(UCS_ERR_EXCEEDS_LIMIT, req->status);
+        request_free(req);
+
+        req = send_nb(&send_data[0], rndv_size, DATATYPE, 0x111337);
+        ASSERT_TRUE(!UCS_PTR_IS_ERR(req) && (req != NULL));
+        wait(req);
+        EXPECT_EQ(UCS_ERR_EXCEEDS_LIMIT, req->status);
+        request_free(req);
+    }
+
+    EXPECT_EQ(4ul, tm->unexpected.num_dropped);
+    EXPECT_EQ(0ul, tm->unexpected.length);
+    EXPECT_EQ(0u, kh_size(&tm->frag_hash));
+    EXPECT_EQ(0u, kh_size(&tm->frag_drop_hash));
+    EXPECT_TRUE(ucp_tag_probe_nb(receiver().worker(), 0, 0, 0, &info) == NULL);
+
+    /* Expected messages are not limited */
+    req = recv_nb(&recv_data[0], eager_size, DATATYPE, 0x1337, 0xffff);
+    ASSERT_TRUE(!UCS_PTR_IS_ERR(req));
+    send_b(&send_data[0], eager_size, DATATYPE, 0x111337);
+    wait(req);
+    EXPECT_UCS_OK(req->status);
+    EXPECT_EQ(eager_size, req->info.length);
+    EXPECT_TRUE(!memcmp(&send_data[0], &recv_data[0], eager_size));
+    request_free(req);
+}
+
 UCS_TEST_P(test_ucp_tag_match, sync_send_unexp) {
     ucp_tag_recv_info_t info;
     ucs_status_t        status;
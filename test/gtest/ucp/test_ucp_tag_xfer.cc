@@ -122,6 +122,8 @@ public:
     void test_xfer_contig(size_t size, bool expected, bool sync, bool truncated);
     void test_xfer_generic(size_t size, bool expected, bool sync, bool truncated);
     void test_xfer_iov(size_t size, bool expected, bool sync, bool truncated);
+    void test_xfer_strided(size_t size, bool expected, bool sync,
+                           bool truncated);
     void test_xfer_generic_err(size_t size, bool expected, bool sync, bool truncated);
 
 protected:
@@ -441,6 +443,57 @@ void test_ucp_tag_xfer::test_xfer_iov(size_t size, bool expected, bool sync,
                                "IOV"));
 }
 
+void test_ucp_tag_xfer::test_xfer_strided(size_t size, bool expected,
+                                          bool sync, bool truncated)
+{
+    /* Every element is 2 rows of 3 blocks of 8 bytes, with gaps between the
+     * blocks and between the rows */
+    const ucp_dt_strided_dim_t dims[] = {{3, 16}, {2, 64}};
+    const size_t block_size           = 8;
+    const size_t packed_size          = block_size * 3 * 2;
+    const size_t extent               = 2 * 64;
+    size_t count                      = size / packed_size;
+    ucp_dt_strided_params_t params;
+    ucp_datatype_t dt;
+
+    /* if count is zero, truncation has no effect */
+    if ((truncated) && (!count)) {
+        truncated = false;
+    }
+
+    params.field_mask = UCP_DT_STRIDED_PARAM_FIELD_BLOCK_SIZE |
+                        UCP_DT_STRIDED_PARAM_FIELD_DIMS;
+    params.block_size = block_size;
+    params.dims       = dims;
+    params.num_dims   = ucs_static_array_size(dims);
+    ASSERT_UCS_OK(ucp_dt_create_strided(&params, &dt));
+
+    std::vector<char> sendbuf(count * extent, 0);
+    std::vector<char> recvbuf(count * extent, 0);
+    std::vector<char> expbuf(count * extent, 0);
+
+    ucs::fill_random(sendbuf);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t row = 0; row < dims[1].count; ++row) {
+            for (size_t col = 0; col < dims[0].count; ++col) {
+                size_t offset = (i * extent) + (row * dims[1].stride) +
+                                (col * dims[0].stride);
+                memcpy(&expbuf[offset], &sendbuf[offset], block_size);
+            }
+        }
+    }
+
+    size_t recvd = do_xfer(sendbuf.data(), recvbuf.data(), count, dt, dt,
+                           expected, sync, truncated);
+    if (!truncated) {
+        ASSERT_EQ(count * packed_size, recvd);
+        EXPECT_TRUE(!check_buffers(expbuf, recvbuf, expbuf.size(), 1, 1, size,
+                                   expected, sync, "strided"));
+    }
+
+    ucp_dt_destroy(dt);
+}
+
 void test_ucp_tag_xfer::test_xfer_generic_err(size_t size, bool expected,
                                               bool sync, bool truncated)
 {
@@ -611,6 +664,16 @@ UCS_TEST_P(test_ucp_tag_xfer, contig_unexp) {
     test_xfer(&test_ucp_tag_xfer::test_xfer_contig, false, false, false);
 }
 
+UCS_TEST_P(test_ucp_tag_xfer, contig_exp_proto_feedback, "PROTO_FEEDBACK=y",
+           "PROTO_FEEDBACK_SAMPLES=1", "PROTO_FEEDBACK_TOLERANCE=0") {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_contig, true, false, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, contig_unexp_proto_feedback, "PROTO_FEEDBACK=y",
+           "PROTO_FEEDBACK_SAMPLES=1", "PROTO_FEEDBACK_TOLERANCE=0") {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_contig, false, false, false);
+}
+
 UCS_TEST_P(test_ucp_tag_xfer, generic_exp) {
     test_xfer(&test_ucp_tag_xfer::test_xfer_generic, true, false, false);
 }
@@ -639,6 +702,18 @@ UCS_TEST_P(test_ucp_tag_xfer, iov_unexp) {
     test_xfer(&test_ucp_tag_xfer::test_xfer_iov, false, false, false);
 }
 
+UCS_TEST_P(test_ucp_tag_xfer, strided_exp) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, true, false, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, strided_exp_truncated) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, true, false, true);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, strided_unexp) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, false, false, false);
+}
+
 UCS_TEST_P(test_ucp_tag_xfer, generic_err_exp, "PROTO_INDIRECT_ID=y") {
     test_xfer(&test_ucp_tag_xfer::test_xfer_generic_err, true, false, false);
 }
@@ -696,6 +771,17 @@ UCS_TEST_P(test_ucp_tag_xfer, iov_unexp_sync) {
     test_xfer(&test_ucp_tag_xfer::test_xfer_iov, false, true, false);
 }
 
+UCS_TEST_P(test_ucp_tag_xfer, strided_exp_sync) {
+    /* because ucp_tag_send_req return status (instead request) if send operation
+     * completed immediately */
+    skip_loopback();
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, true, true, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, strided_unexp_sync) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, false, true, false);
+}
+
 /* send_contig_recv_contig */
 
 UCS_TEST_P(test_ucp_tag_xfer, send_contig_recv_contig_exp, "RNDV_THRESH=1248576") {
@@ -178,6 +178,48 @@ UCS_TEST_P(test_ucp_wakeup, signal)
     EXPECT_EQ(UCS_OK, ucp_worker_arm(worker));
 }
 
+UCS_TEST_P(test_ucp_wakeup, busy_poll, "WAKEUP_BUSY_POLL=10ms")
+{
+    const ucp_datatype_t DATATYPE = ucp_dt_make_contig(1);
+    const uint64_t TAG            = 0xdeadbeef;
+    const unsigned COUNT          = 100;
+    ucp_worker_h recv_worker      = receiver().worker();
+    void *sreq, *rreq;
+
+    sender().connect(&receiver(), get_ep_params());
+
+    for (unsigned i = 0; i < COUNT; ++i) {
+        uint64_t send_data = i, recv_data = 0;
+
+        sreq = ucp_tag_send_nb(sender().ep(), &send_data, sizeof(send_data),
+                               DATATYPE, TAG, send_completion);
+        if (UCS_PTR_IS_PTR(sreq)) {
+            wait(sreq);
+        } else {
+            ASSERT_UCS_OK(UCS_PTR_STATUS(sreq));
+        }
+
+        rreq = ucp_tag_recv_nb(recv_worker, &recv_data, sizeof(recv_data),
+                               DATATYPE, TAG, (ucp_tag_t)-1, recv_completion);
+        while (!ucp_request_is_completed(rreq)) {
+            if (ucp_worker_progress(recv_worker)) {
+                continue;
+            }
+
+            ASSERT_UCS_OK(ucp_worker_wait(recv_worker));
+        }
+
+        ucp_request_release(rreq);
+        EXPECT_EQ(send_data, recv_data);
+    }
+
+    /* A signal is not consumed by busy polling, so it must be returned */
+    ASSERT_UCS_OK(ucp_worker_signal(recv_worker));
+    ASSERT_UCS_OK(ucp_worker_wait(recv_worker));
+
+    flush_worker(sender());
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_wakeup)
 
 class test_ucp_wakeup_external_epollfd : public test_ucp_wakeup {
@@ -1798,6 +1798,52 @@ public:
 
         return nullptr;
     }
+
+    void pack_address(ucp_worker_h worker, unsigned pack_flags, size_t *size_p,
+                      void **buffer_p)
+    {
+        ucs_status_t status = ucp_address_pack(worker, NULL,
+                                               &ucp_tl_bitmap_max,
+                                               UCP_ADDRESS_PACK_FLAGS_ALL |
+                                               pack_flags,
+                                               UCP_OBJECT_VERSION_V2, NULL,
+                                               UINT_MAX, size_p, buffer_p);
+        ASSERT_UCS_OK(status);
+    }
+
+    void check_profile_address(const ucp_unpacked_address_t &expected,
+                               const ucp_unpacked_address_t &unpacked)
+    {
+        EXPECT_EQ(expected.uuid, unpacked.uuid);
+        ASSERT_EQ(expected.address_count, unpacked.address_count);
+
+        for (unsigned i = 0; i < expected.address_count; ++i) {
+            const ucp_address_entry_t &ae = expected.address_list[i];
+            const ucp_address_entry_t &pe = unpacked.address_list[i];
+
+            EXPECT_EQ(ae.tl_name_csum, pe.tl_name_csum);
+            EXPECT_EQ(ae.md_index, pe.md_index);
+            EXPECT_EQ(ae.dev_index, pe.dev_index);
+            EXPECT_EQ(ae.sys_dev, pe.sys_dev);
+            EXPECT_EQ(ae.dev_num_paths, pe.dev_num_paths);
+            EXPECT_EQ(ae.iface_attr.flags, pe.iface_attr.flags);
+            EXPECT_EQ(ae.iface_attr.priority, pe.iface_attr.priority);
+            EXPECT_EQ(0u, pe.num_ep_addrs);
+
+            ASSERT_EQ(ae.dev_addr_len, pe.dev_addr_len);
+            if (ae.dev_addr_len > 0) {
+                EXPECT_EQ(0, memcmp(ae.dev_addr, pe.dev_addr,
+                                    ae.dev_addr_len));
+            }
+
+            auto attr = get_iface_attr(&ae);
+            ASSERT_EQ(ae.iface_addr == NULL, pe.iface_addr == NULL);
+            if ((ae.iface_addr != NULL) && (attr != nullptr)) {
+                EXPECT_EQ(0, memcmp(ae.iface_addr, pe.iface_addr,
+                                    attr->iface_addr_len));
+            }
+        }
+    }
 };
 
 // On some systems TCP has very low BW and high latency, which would be
@@ -1870,4 +1916,139 @@ UCS_TEST_SKIP_COND_P(test_ucp_address_v2, diff_seg_sizes,
     send_recv(receiver().ep(), e->worker(), e->ep(), size, 1);
 }
 
+UCS_TEST_P(test_ucp_address_v2, profile) {
+    ucp_worker_h worker = sender().worker();
+    ucp_unpacked_address_t unpacked_address, profile_address, ref_address;
+    size_t size, profile_size, ref_size;
+    void *buffer, *profile_buffer, *ref_buffer;
+    ucs_status_t status;
+
+    pack_address(worker, 0, &size, &buffer);
+    pack_address(worker, UCP_ADDRESS_PACK_FLAG_PROFILE, &profile_size,
+                 &profile_buffer);
+    pack_address(worker, UCP_ADDRESS_PACK_FLAG_PROFILE |
+                         UCP_ADDRESS_PACK_FLAG_PROFILE_REF,
+                 &ref_size, &ref_buffer);
+    UCS_TEST_MESSAGE << "address " << size << " profile " << profile_size
+                     << " reference " << ref_size;
+    EXPECT_LT(ref_size, size);
+
+    status = ucp_address_unpack(worker, buffer, UCP_ADDRESS_PACK_FLAGS_ALL,
+                                &unpacked_address);
+    ASSERT_UCS_OK(status);
+
+    /* The profile is cached by the worker when it unpacks the profile body */
+    status = ucp_address_unpack(worker, profile_buffer,
+                                UCP_ADDRESS_PACK_FLAGS_ALL, &profile_address);
+    ASSERT_UCS_OK(status);
+    check_profile_address(unpacked_address, profile_address);
+
+    status = ucp_address_unpack(worker, ref_buffer, UCP_ADDRESS_PACK_FLAGS_ALL,
+                                &ref_address);
+    ASSERT_UCS_OK(status);
+    check_profile_address(unpacked_address, ref_address);
+
+    ucs_free(ref_address.address_list);
+    ucs_free(profile_address.address_list);
+    ucs_free(unpacked_address.address_list);
+    ucs_free(ref_buffer);
+    ucs_free(profile_buffer);
+    ucs_free(buffer);
+}
+
+UCS_TEST_P(test_ucp_address_v2, profile_unknown) {
+    ucp_worker_h worker = receiver().worker();
+    ucp_unpacked_address_t unpacked_address, ref_address;
+    size_t profile_size, ref_size;
+    void *profile_buffer, *ref_buffer;
+    ucs_status_t status;
+
+    if (is_loopback()) {
+        UCS_TEST_SKIP_R("a worker knows its own profile");
+    }
+
+    pack_address(sender().worker(), UCP_ADDRESS_PACK_FLAG_PROFILE |
+                                    UCP_ADDRESS_PACK_FLAG_PROFILE_REF,
+                 &ref_size, &ref_buffer);
+
+    /* The receiver does not know the profile yet. Drop the profiles it has
+     * cached, since its own profile may be the same as the sender's */
+    UCS_ASYNC_BLOCK(&worker->async);
+    ucp_address_profile_cache_cleanup(worker);
+    ucp_address_profile_cache_init(worker);
+    UCS_ASYNC_UNBLOCK(&worker->async);
+    {
+        scoped_log_handler wrap_err(wrap_errors_logger);
+        status = ucp_address_unpack(worker, ref_buffer,
+                                    UCP_ADDRESS_PACK_FLAGS_ALL, &ref_address);
+        EXPECT_EQ(UCS_ERR_NO_ELEM, status);
+    }
+
+    pack_address(sender().worker(), UCP_ADDRESS_PACK_FLAG_PROFILE,
+                 &profile_size, &profile_buffer);
+    status = ucp_address_unpack(worker, profile_buffer,
+                                UCP_ADDRESS_PACK_FLAGS_ALL, &unpacked_address);
+    ASSERT_UCS_OK(status);
+
+    status = ucp_address_unpack(worker, ref_buffer, UCP_ADDRESS_PACK_FLAGS_ALL,
+                                &ref_address);
+    ASSERT_UCS_OK(status);
+    check_profile_address(unpacked_address, ref_address);
+
+    ucs_free(ref_address.address_list);
+    ucs_free(unpacked_address.address_list);
+    ucs_free(profile_buffer);
+    ucs_free(ref_buffer);
+}
+
+UCS_TEST_P(test_ucp_address_v2, profile_wireup, "ADDRESS_PROFILE=y") {
+    sender().connect(&receiver(), get_ep_params());
+    if (!is_loopback()) {
+        receiver().connect(&sender(), get_ep_params());
+    }
+
+    send_recv(sender().ep(), receiver().worker(), receiver().ep(), 1, 1);
+    send_recv(receiver().ep(), sender().worker(), sender().ep(), 1, 1);
+}
+
+UCS_TEST_P(test_ucp_address_v2, profile_ref_ep_create, "ADDRESS_PROFILE=y") {
+    ucp_worker_h worker = sender().worker();
+    ucp_unpacked_address_t unpacked_address;
+    ucp_ep_params_t ep_params;
+    ucp_worker_attr_t attr;
+    ucs_status_t status;
+    ucp_ep_h ep;
+
+    if (!is_loopback()) {
+        /* Learn the profile of the receiver from its full address */
+        attr.field_mask = UCP_WORKER_ATTR_FIELD_ADDRESS;
+        ASSERT_UCS_OK(ucp_worker_query(receiver().worker(), &attr));
+
+        UCS_ASYNC_BLOCK(&worker->async);
+        status = ucp_address_unpack(worker, attr.address,
+                                    ucp_worker_default_address_pack_flags(
+                                            worker),
+                                    &unpacked_address);
+        UCS_ASYNC_UNBLOCK(&worker->async);
+        ucp_worker_release_address(receiver().worker(), attr.address);
+        ASSERT_UCS_OK(status);
+        ucs_free(unpacked_address.address_list);
+    }
+
+    attr.field_mask    = UCP_WORKER_ATTR_FIELD_ADDRESS |
+                         UCP_WORKER_ATTR_FIELD_ADDRESS_FLAGS;
+    attr.address_flags = UCP_WORKER_ADDRESS_FLAG_PROFILE_REF;
+    ASSERT_UCS_OK(ucp_worker_query(receiver().worker(), &attr));
+
+    ep_params             = get_ep_params();
+    ep_params.field_mask |= UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+    ep_params.address     = attr.address;
+    status                = ucp_ep_create(worker, &ep_params, &ep);
+    ucp_worker_release_address(receiver().worker(), attr.address);
+    ASSERT_UCS_OK(status);
+
+    send_recv(ep, receiver().worker(), NULL, 1, 1);
+    disconnect(ep);
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_address_v2)
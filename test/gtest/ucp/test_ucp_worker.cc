@@ -11,6 +11,7 @@
 extern "C" {
 #include <ucp/core/ucp_worker.h>
 #include <ucp/core/ucp_worker.inl>
+#include <ucp/core/ucp_progress_thread.h>
 #include <ucp/core/ucp_request.h>
 #include <ucp/wireup/address.h>
 #include <ucp/wireup/wireup_ep.h>
@@ -767,6 +768,116 @@ UCS_TEST_P(test_ucp_worker_thread_mode, query)
 
 UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_worker_thread_mode, all, "all")
 
+class test_ucp_worker_progress_thread : public ucp_test {
+public:
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant(variants, UCP_FEATURE_TAG | UCP_FEATURE_WAKEUP);
+    }
+
+    /// @override
+    virtual void init()
+    {
+        modify_config("PROGRESS_THREAD_TLS", "tcp,posix,sysv");
+        ucp_test::init();
+        sender().connect(&receiver(), get_ep_params());
+    }
+
+    /// @override
+    virtual ucp_worker_params_t get_worker_params()
+    {
+        ucp_worker_params_t params = ucp_test::get_worker_params();
+
+        params.thread_mode = UCS_THREAD_MODE_SINGLE;
+        return params;
+    }
+
+protected:
+    void send_recv(size_t size, unsigned count, bool wakeup)
+    {
+        ucp_request_param_t param = {};
+
+        for (unsigned i = 0; i < count; ++i) {
+            std::string send_data(size, 'a' + (i % 26));
+            std::string recv_data(size, '0');
+
+            void *rreq = ucp_tag_recv_nbx(receiver().worker(), &recv_data[0],
+                                          size, i, (ucp_tag_t)-1, &param);
+            void *sreq = ucp_tag_send_nbx(sender().ep(), &send_data[0], size,
+                                          i, &param);
+            ASSERT_UCS_OK(request_wait(sreq));
+            ASSERT_UCS_OK(request_wait(rreq, {}, 0, wakeup));
+            ASSERT_EQ(send_data, recv_data);
+        }
+    }
+
+    bool receiver_has_events()
+    {
+        const ucp_worker_h worker = receiver().worker();
+
+        for (unsigned i = 0; i < worker->progress_threads.count; ++i) {
+            if (ucp_progress_thread_is_busy(
+                        worker->progress_threads.threads[i])) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+UCS_TEST_P(test_ucp_worker_progress_thread, tag_send_recv)
+{
+    EXPECT_NE(0u, receiver().worker()->progress_threads.count);
+
+    for (size_t size = 1; size <= UCS_MBYTE; size *= 8) {
+        send_recv(size, 32, false);
+    }
+}
+
+UCS_TEST_P(test_ucp_worker_progress_thread, wakeup)
+{
+    send_recv(64, 32, true);
+}
+
+UCS_TEST_P(test_ucp_worker_progress_thread, progress_on_thread)
+{
+    const size_t size         = 8;
+    ucp_request_param_t param = {};
+    std::string send_data(size, 'a');
+    std::string recv_data(size, '0');
+
+    /* The worker thread mode is not changed by the progress threads */
+    ucp_worker_attr_t attr;
+    attr.field_mask = UCP_WORKER_ATTR_FIELD_THREAD_MODE;
+    ASSERT_UCS_OK(ucp_worker_query(receiver().worker(), &attr));
+    EXPECT_EQ(UCS_THREAD_MODE_SINGLE, attr.thread_mode);
+
+    /* Complete the wireup */
+    send_recv(size, 1, false);
+
+    void *rreq = ucp_tag_recv_nbx(receiver().worker(), &recv_data[0], size, 0,
+                                  (ucp_tag_t)-1, &param);
+    void *sreq = ucp_tag_send_nbx(sender().ep(), &send_data[0], size, 0,
+                                  &param);
+
+    /* The message is received while only the sender worker is progressed */
+    ucs_time_t deadline = ucs_get_time() + ucs_time_from_sec(10.0);
+    while (!receiver_has_events() && (ucs_get_time() < deadline)) {
+        sender().progress();
+    }
+
+    EXPECT_TRUE(receiver_has_events());
+    EXPECT_EQ(std::string(size, '0'), recv_data);
+
+    ASSERT_UCS_OK(request_wait(sreq));
+    ASSERT_UCS_OK(request_wait(rreq));
+    EXPECT_EQ(send_data, recv_data);
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_worker_progress_thread, tcp, "tcp")
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_worker_progress_thread, shm, "shm")
+
 class test_ucp_worker_address_query : public ucp_test {
 public:
     test_ucp_worker_address_query()
@@ -476,3 +476,66 @@ UCS_TEST_F(test_callbackq, oneshot_ordering) {
     dispatch(100);
     EXPECT_EQ(remaining_user_ids.size(), m_total_count);
 }
+
+UCS_TEST_F(test_callbackq, oneshot_with_spill) {
+    static const unsigned num_callbacks = UCS_CALLBACKQ_FAST_COUNT + 2;
+    static const unsigned num_rounds    = 10;
+    std::vector<callback_ctx> ctx(num_callbacks);
+    std::vector<callback_ctx> oneshot_ctx(num_rounds);
+    std::vector<callback_ctx> inbox_ctx(num_rounds);
+
+    /* Some of the callbacks do not fit the fast-path array */
+    for (unsigned i = 0; i < num_callbacks; ++i) {
+        init_ctx(&ctx[i]);
+        add(&ctx[i]);
+    }
+
+    /* Every dispatch calls each callback once, also when it has to dispatch
+     * a oneshot callback which was added to the inbox after the proxy */
+    for (unsigned round = 0; round < num_rounds; ++round) {
+        init_ctx(&oneshot_ctx[round]);
+        init_ctx(&inbox_ctx[round]);
+        oneshot_ctx[round].command = COMMAND_ADD_ANOTHER_ONESHOT;
+        oneshot_ctx[round].to_add  = &inbox_ctx[round];
+        add_oneshot(&oneshot_ctx[round]);
+        dispatch();
+
+        EXPECT_EQ(1u, oneshot_ctx[round].count) << "round=" << round;
+        EXPECT_EQ(1u, inbox_ctx[round].count) << "round=" << round;
+        for (unsigned i = 0; i < num_callbacks; ++i) {
+            EXPECT_EQ(round + 1, ctx[i].count)
+                    << "round=" << round << " i=" << i;
+        }
+    }
+
+    for (unsigned i = 0; i < num_callbacks; ++i) {
+        remove(&ctx[i]);
+    }
+}
+
+UCS_MT_TEST_F(test_callbackq, oneshot_mt_producers, 4) {
+    static const unsigned count = 1000;
+
+    if (barrier()) /*1*/ {
+        /* Dispatch while the other threads add callbacks concurrently */
+        uint32_t expected = count * (num_threads() - 1);
+        ucs_time_t deadline = ucs_get_time() +
+                              ucs_time_from_sec(60.0 * ucs::test_time_multiplier());
+        while ((m_total_count < expected) && (ucs_get_time() < deadline)) {
+            dispatch();
+        }
+        EXPECT_EQ(expected, m_total_count);
+        barrier(); /*2*/
+    } else {
+        std::vector<callback_ctx> ctx(count);
+        for (unsigned i = 0; i < count; ++i) {
+            init_ctx(&ctx[i], &ctx, i);
+            add_oneshot(&ctx[i]);
+        }
+
+        barrier(); /*2*/
+        for (unsigned i = 0; i < count; ++i) {
+            EXPECT_EQ(1u, ctx[i].count) << "i=" << i;
+        }
+    }
+}
@@ -10,6 +10,7 @@ extern "C" {
 #include <ucs/time/time.h>
 #include <ucs/profile/profile.h>
 #include <ucs/config/parser.h>
+#include <ucs/vfs/base/vfs_obj.h>
 #include <ucp/api/ucp.h>
 }
 
@@ -104,6 +105,12 @@ protected:
                                unsigned num_locations, uint64_t exp_count,
                                unsigned exp_num_records, const void **ptr);
 
+    void test_hists(const ucs_profile_location_t *locations,
+                    unsigned num_locations, uint64_t exp_count,
+                    const void **ptr);
+
+    void test_vfs_hist(uint64_t exp_count);
+
     void test_nesting(const ucs_profile_location_t *loc, int nesting,
                       const std::string &exp_name, int exp_nesting);
 
@@ -281,6 +288,47 @@ void test_profile::test_thread_locations(
            num_locations;
 }
 
+void test_profile::test_hists(const ucs_profile_location_t *locations,
+                              unsigned num_locations, uint64_t exp_count,
+                              const void **ptr)
+{
+    const ucs_profile_hist_t *hists =
+            reinterpret_cast<const ucs_profile_hist_t*>(*ptr);
+
+    for (unsigned i = 0; i < num_locations; ++i) {
+        uint64_t count = 0;
+        for (unsigned bucket = 0; bucket < UCS_PROFILE_HIST_NUM_BUCKETS;
+             ++bucket) {
+            count += hists[i].counts[bucket];
+        }
+
+        /* Only scopes have elapsed time */
+        if (locations[i].type == UCS_PROFILE_TYPE_SCOPE_END) {
+            EXPECT_EQ(exp_count, count) << locations[i].name;
+            EXPECT_LE(ucs_profile_hist_percentile(&hists[i], 50.0),
+                      ucs_profile_hist_percentile(&hists[i], 99.9));
+        } else {
+            EXPECT_EQ(0u, count) << locations[i].name;
+        }
+    }
+
+    *ptr = hists + num_locations;
+}
+
+void test_profile::test_vfs_hist(uint64_t exp_count)
+{
+    ucs_string_buffer_t strb = UCS_STRING_BUFFER_INITIALIZER;
+
+    ASSERT_UCS_OK(ucs_vfs_path_read_file("/ucs/profile/histogram", &strb));
+    std::string hist_str = ucs_string_buffer_cstr(&strb);
+    ucs_string_buffer_cleanup(&strb);
+
+    EXPECT_NE(std::string::npos,
+              hist_str.find("profile_test_func1 (test_profile.cc:"));
+    EXPECT_NE(std::string::npos,
+              hist_str.find("count " + std::to_string(exp_count) + " p50 "));
+}
+
 void test_profile::test_nesting(const ucs_profile_location_t *loc, int nesting,
                                 const std::string &exp_name, int exp_nesting)
 {
@@ -312,6 +360,10 @@ void test_profile::do_test(unsigned int_mode, const std::string& str_mode)
     scoped_profile p(*this, PROFILE_FILENAME, str_mode.c_str());
     run_profiled_code(ITER);
 
+    if (int_mode & UCS_BIT(UCS_PROFILE_MODE_HIST)) {
+        test_vfs_hist(ITER * num_threads());
+    }
+
     std::string data = p.read();
     const void *ptr  = &data[0];
 
@@ -349,6 +401,10 @@ void test_profile::do_test(unsigned int_mode, const std::string& str_mode)
         test_thread_locations(thread_hdr, num_locations, exp_count,
                               exp_num_records, &ptr);
 
+        if (hdr->mode & UCS_BIT(UCS_PROFILE_MODE_HIST)) {
+            test_hists(locations, num_locations, ITER, &ptr);
+        }
+
         const ucs_profile_record_t *records =
                 reinterpret_cast<const ucs_profile_record_t*>(ptr);
         uint64_t prev_ts = records[0].timestamp;
@@ -420,9 +476,44 @@ UCS_TEST_P(test_profile, log_accum) {
             "log,accum");
 }
 
+UCS_TEST_P(test_profile, hist) {
+    do_test(UCS_BIT(UCS_PROFILE_MODE_HIST), "hist");
+}
+
+UCS_TEST_P(test_profile, hist_accum) {
+    do_test(UCS_BIT(UCS_PROFILE_MODE_HIST) | UCS_BIT(UCS_PROFILE_MODE_ACCUM),
+            "hist,accum");
+}
+
 INSTANTIATE_TEST_SUITE_P(st, test_profile, ::testing::Values(1));
 INSTANTIATE_TEST_SUITE_P(mt, test_profile, ::testing::Values(2, 4, 8));
 
+class test_profile_hist : public ucs::test {
+};
+
+UCS_TEST_F(test_profile_hist, buckets) {
+    ucs_profile_hist_t hist = {};
+    unsigned bucket;
+
+    for (bucket = 0; bucket < UCS_PROFILE_HIST_NUM_BUCKETS; ++bucket) {
+        uint64_t start = ucs_profile_hist_bucket_start(bucket);
+        EXPECT_EQ(bucket, ucs_profile_hist_bucket(start));
+        if (bucket > 0) {
+            EXPECT_EQ(bucket - 1, ucs_profile_hist_bucket(start - 1));
+        }
+    }
+    EXPECT_EQ(UCS_PROFILE_HIST_NUM_BUCKETS - 1,
+              ucs_profile_hist_bucket(UINT64_MAX));
+
+    /* 90 samples of 100, and 10 samples of 10000 */
+    hist.counts[ucs_profile_hist_bucket(100)]   = 90;
+    hist.counts[ucs_profile_hist_bucket(10000)] = 10;
+    EXPECT_NEAR(100.0, ucs_profile_hist_percentile(&hist, 50.0), 100.0 / 8);
+    EXPECT_NEAR(100.0, ucs_profile_hist_percentile(&hist, 90.0), 100.0 / 8);
+    EXPECT_NEAR(10000.0, ucs_profile_hist_percentile(&hist, 99.0),
+                10000.0 / 8);
+}
+
 class test_profile_perf : public test_profile {
 };
 
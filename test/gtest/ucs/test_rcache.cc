@@ -960,6 +960,37 @@ UCS_TEST_F(test_rcache_stats, unmap_dereg) {
     munmap(mem, size1);
 }
 
+UCS_TEST_F(test_rcache_stats, hits_fast_after_unmap) {
+    static const size_t size1 = 1024 * 1024;
+    void *mem = alloc_pages(size1, PROT_READ|PROT_WRITE);
+    region *r1, *r2;
+    void *ptr;
+
+    r1 = get(mem, size1);
+    put(r1);
+
+    /* Hit the region which was just looked up */
+    r2 = get(mem, size1);
+    EXPECT_EQ(r1, r2);
+    EXPECT_EQ(1, get_counter(UCS_RCACHE_HITS_FAST));
+    put(r2);
+
+    munmap(mem, size1);
+    EXPECT_EQ(1, get_counter(UCS_RCACHE_UNMAP_INVALIDATES));
+
+    /* Map the same address again, the invalidated region must not be hit */
+    ptr = mmap(mem, size1, PROT_READ|PROT_WRITE,
+               MAP_PRIVATE|MAP_ANONYMOUS|MAP_FIXED, -1, 0);
+    ASSERT_EQ(mem, ptr);
+
+    r1 = get(mem, size1);
+    EXPECT_EQ(1, get_counter(UCS_RCACHE_HITS_FAST));
+    EXPECT_EQ(2, get_counter(UCS_RCACHE_MISSES));
+    put(r1);
+
+    munmap(mem, size1);
+}
+
 UCS_TEST_F(test_rcache_stats, unmap_dereg_with_lock) {
     static const size_t size1 = 1024 * 1024;
     void *mem = alloc_pages(size1, PROT_READ|PROT_WRITE);
@@ -972,9 +1003,9 @@ UCS_TEST_F(test_rcache_stats, unmap_dereg_with_lock) {
      * We can have more unmap events if releasing the region structure triggers
      * releasing memory back to the OS.
      */
-    pthread_rwlock_wrlock(&m_rcache->pgt_lock);
+    ucs_rcache_pgt_wrlock(m_rcache);
     munmap(mem, size1);
-    pthread_rwlock_unlock(&m_rcache->pgt_lock);
+    ucs_rcache_pgt_wrunlock(m_rcache);
 
     EXPECT_GE(get_counter(UCS_RCACHE_UNMAPS), 1);
     EXPECT_EQ(0, get_counter(UCS_RCACHE_UNMAP_INVALIDATES));
@@ -1026,9 +1057,9 @@ UCS_TEST_F(test_rcache_stats, hits_slow) {
     r1 = get(mem2, size1);
 
     /* generate unmap event under lock, to roce using invalidation queue */
-    pthread_rwlock_rdlock(&m_rcache->pgt_lock);
+    ucs_rcache_pgt_rdlock(m_rcache);
     munmap(mem1, size1);
-    pthread_rwlock_unlock(&m_rcache->pgt_lock);
+    ucs_rcache_pgt_rdunlock(m_rcache);
 
     EXPECT_EQ(1, get_counter(UCS_RCACHE_UNMAPS));
 
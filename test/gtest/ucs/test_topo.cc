@@ -168,3 +168,45 @@ UCS_TEST_F(test_topo, numa_distance) {
         }
     }
 }
+
+UCS_TEST_F(test_topo, numa_node_of_cpu_mask) {
+    ucs_cpu_set_t cpu_mask;
+
+    UCS_CPU_ZERO(&cpu_mask);
+    EXPECT_EQ(UCS_NUMA_NODE_UNDEFINED, ucs_numa_node_of_cpu_mask(&cpu_mask));
+
+    UCS_CPU_SET(0, &cpu_mask);
+    EXPECT_EQ(ucs_numa_node_of_cpu(0), ucs_numa_node_of_cpu_mask(&cpu_mask));
+}
+
+UCS_TEST_F(test_topo, numa_mem_bind) {
+    const size_t page_size = ucs_get_page_size();
+    const size_t length    = 4 * page_size;
+    ucs_status_t status;
+    void *ptr;
+
+    ptr = mmap(NULL, length, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(MAP_FAILED, ptr);
+
+    EXPECT_UCS_OK(ucs_numa_mem_bind(ptr, length, UCS_NUMA_POLICY_DEFAULT,
+                                    UCS_NUMA_NODE_DEFAULT));
+
+    /* Range which does not contain a whole page is left unchanged */
+    EXPECT_UCS_OK(ucs_numa_mem_bind(UCS_PTR_BYTE_OFFSET(ptr, 1),
+                                    page_size - 1, UCS_NUMA_POLICY_BIND,
+                                    UCS_NUMA_NODE_DEFAULT));
+
+    status = ucs_numa_mem_bind(UCS_PTR_BYTE_OFFSET(ptr, 1), length - 1,
+                               UCS_NUMA_POLICY_PREFERRED,
+                               UCS_NUMA_NODE_DEFAULT);
+    if (status == UCS_ERR_IO_ERROR) {
+        /* Containers may not allow to change the memory policy */
+        UCS_TEST_MESSAGE << "mbind() is not permitted";
+    } else {
+        EXPECT_UCS_OK(status);
+    }
+
+    memset(ptr, 0, length);
+    munmap(ptr, length);
+}
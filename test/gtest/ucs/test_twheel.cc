@@ -257,3 +257,104 @@ UCS_TEST_F(twheel, delayed_sweep) {
     GTEST_FAIL() << "Timers were not triggered after timeout";
 }
 
+
+class twheel_levels : public twheel {
+protected:
+    struct level_timer {
+        ucs_wtimer_t  timer;
+        uint64_t      tick;       /* Expected expiration tick */
+        uint64_t      fired_tick; /* Tick it was dispatched at, or 0 */
+        twheel_levels *self;
+    };
+
+    static void level_timer_func(ucs_wtimer_t *self)
+    {
+        struct level_timer *t = ucs_container_of(self, struct level_timer,
+                                                 timer);
+        t->fired_tick = t->self->m_wheel.now >> t->self->m_wheel.res_order;
+    }
+
+    void add_timers(std::vector<struct level_timer> &timers,
+                    uint64_t max_ticks)
+    {
+        uint64_t current = m_wheel.now >> m_wheel.res_order;
+
+        for (size_t i = 0; i < timers.size(); ++i) {
+            uint64_t ticks       = 1 + (ucs::rand() % max_ticks);
+            timers[i].tick       = current + ticks;
+            timers[i].fired_tick = 0;
+            timers[i].self       = this;
+            ucs_wtimer_init(&timers[i].timer, level_timer_func);
+            ASSERT_UCS_OK(ucs_wtimer_add(&m_wheel, &timers[i].timer,
+                                         ticks * m_wheel.res));
+        }
+    }
+
+    /* Advance the wheel time one tick at a time */
+    void sweep_ticks(uint64_t num_ticks)
+    {
+        ucs_time_t now = m_wheel.now;
+
+        for (uint64_t i = 0; i < num_ticks; ++i) {
+            now += m_wheel.res;
+            ucs_twheel_sweep(&m_wheel, now);
+        }
+    }
+};
+
+UCS_TEST_F(twheel_levels, expiration) {
+    /* Spread the timers over the first three levels */
+    static const uint64_t max_ticks = UCS_TWHEEL_NUM_SLOTS *
+                                      UCS_TWHEEL_NUM_SLOTS * 4;
+    std::vector<struct level_timer> timers(10000);
+
+    add_timers(timers, max_ticks);
+    EXPECT_EQ(timers.size(), m_wheel.count);
+
+    sweep_ticks(max_ticks + 1);
+    EXPECT_TRUE(ucs_twheel_is_empty(&m_wheel));
+    for (size_t i = 0; i < timers.size(); ++i) {
+        EXPECT_EQ(timers[i].tick, timers[i].fired_tick) << "timer " << i;
+    }
+}
+
+UCS_TEST_F(twheel_levels, remove) {
+    static const uint64_t max_ticks = UCS_TWHEEL_NUM_SLOTS *
+                                      UCS_TWHEEL_NUM_SLOTS;
+    std::vector<struct level_timer> timers(1000);
+
+    add_timers(timers, max_ticks);
+    sweep_ticks(max_ticks / 2);
+
+    for (size_t i = 0; i < timers.size(); i += 2) {
+        ucs_wtimer_remove(&m_wheel, &timers[i].timer);
+    }
+
+    sweep_ticks(max_ticks);
+    EXPECT_TRUE(ucs_twheel_is_empty(&m_wheel));
+    for (size_t i = 0; i < timers.size(); ++i) {
+        if ((i % 2) == 0) {
+            /* Removed timers fire only if they expired before removal */
+            EXPECT_TRUE((timers[i].fired_tick == 0) ||
+                        (timers[i].fired_tick == timers[i].tick));
+        } else {
+            EXPECT_EQ(timers[i].tick, timers[i].fired_tick) << "timer " << i;
+        }
+    }
+}
+
+UCS_TEST_F(twheel_levels, delayed_sweep) {
+    static const uint64_t max_ticks = UCS_TWHEEL_NUM_SLOTS *
+                                      UCS_TWHEEL_NUM_SLOTS *
+                                      UCS_TWHEEL_NUM_SLOTS;
+    std::vector<struct level_timer> timers(1000);
+
+    add_timers(timers, max_ticks);
+
+    /* A single sweep past the last expiration dispatches all timers */
+    ucs_twheel_sweep(&m_wheel, m_wheel.now + (max_ticks + 1) * m_wheel.res);
+    EXPECT_TRUE(ucs_twheel_is_empty(&m_wheel));
+    for (size_t i = 0; i < timers.size(); ++i) {
+        EXPECT_NE(0u, timers[i].fired_tick) << "timer " << i;
+    }
+}
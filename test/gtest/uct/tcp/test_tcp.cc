@@ -231,6 +231,21 @@ private:
     }
 
 protected:
+    typedef struct {
+        volatile unsigned count;
+        size_t            length;
+    } am_count_arg_t;
+
+    static ucs_status_t
+    am_count_handler(void *arg, void *data, size_t length, unsigned flags)
+    {
+        am_count_arg_t *count_arg = (am_count_arg_t*)arg;
+
+        EXPECT_EQ(count_arg->length, length);
+        ++count_arg->count;
+        return UCS_OK;
+    }
+
     uct_tcp_iface *m_tcp_iface;
     entity        *m_ent;
 };
@@ -287,4 +302,288 @@ UCS_TEST_P(test_uct_tcp, check_addr_len)
 }
 
 
+UCS_TEST_P(test_uct_tcp, uring_many2one_am_bcopy, "TCP_IO_ENGINE=uring")
+{
+    static const unsigned num_senders = 8;
+    const unsigned num_sends          = 1000 / ucs::test_time_multiplier();
+    ucs::ptr_vector<mapped_buffer> buffers;
+    am_count_arg_t arg;
+    ucs_status_t status;
+
+    if (m_tcp_iface->uring == NULL) {
+        UCS_TEST_SKIP_R("io_uring is not supported");
+    }
+
+    EXPECT_EQ(UCT_TCP_IO_ENGINE_URING, m_tcp_iface->config.io_engine);
+
+    for (unsigned i = 0; i < num_senders; ++i) {
+        entity *sender = create_entity(0);
+        m_entities.push_back(sender);
+        sender->connect(0, *m_ent, i);
+        buffers.push_back(new mapped_buffer(
+                sender->iface_attr().cap.am.max_bcopy, 0, *sender));
+    }
+
+    arg.count  = 0;
+    arg.length = buffers.at(0).length();
+    status     = uct_iface_set_am_handler(m_ent->iface(), 0, am_count_handler,
+                                          &arg, 0);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < num_sends; ++i) {
+        unsigned sender_num   = i % num_senders;
+        const entity &sender  = ent(sender_num + 1);
+        mapped_buffer &buffer = buffers.at(sender_num);
+        ssize_t packed_len;
+
+        buffer.pattern_fill(i);
+        for (;;) {
+            packed_len = uct_ep_am_bcopy(sender.ep(0), 0, mapped_buffer::pack,
+                                         &buffer, 0);
+            if (packed_len != UCS_ERR_NO_RESOURCE) {
+                break;
+            }
+
+            progress();
+        }
+
+        ASSERT_EQ((ssize_t)buffer.length(), packed_len);
+    }
+
+    wait_for_value(&arg.count, num_sends, true);
+    EXPECT_EQ(num_sends, arg.count);
+
+    status = uct_iface_set_am_handler(m_ent->iface(), 0, NULL, NULL, 0);
+    ASSERT_UCS_OK(status);
+
+    flush();
+}
+
+
+UCS_TEST_P(test_uct_tcp, uring_destroy_ep_inflight_rx, "TCP_IO_ENGINE=uring")
+{
+    am_count_arg_t arg;
+    ucs_status_t status;
+
+    if (m_tcp_iface->uring == NULL) {
+        UCS_TEST_SKIP_R("io_uring is not supported");
+    }
+
+    entity *sender = create_entity(0);
+    m_entities.push_back(sender);
+    sender->connect(0, *m_ent, 0);
+
+    arg.count  = 0;
+    arg.length = sizeof(uint64_t);
+    status     = uct_iface_set_am_handler(m_ent->iface(), 0, am_count_handler,
+                                          &arg, 0);
+    ASSERT_UCS_OK(status);
+
+    /* wait for the connection establishment */
+    do {
+        status = uct_ep_am_short(sender->ep(0), 0, 0, NULL, 0);
+        progress();
+    } while (status == UCS_ERR_NO_RESOURCE);
+    ASSERT_UCS_OK(status);
+    wait_for_value(&arg.count, 1u, true);
+    EXPECT_EQ(1u, arg.count);
+
+    uct_tcp_ep_t *ep = ucs_derived_of(sender->ep(0), uct_tcp_ep_t);
+    ASSERT_EQ(UCT_TCP_EP_CONN_STATE_CONNECTED, ep->conn_state);
+    ASSERT_TRUE(uct_tcp_ep_uring_prep_rx(ep));
+    EXPECT_TRUE(ep->flags & UCT_TCP_EP_FLAG_URING_RX);
+
+    /* the posted receive must not complete on the destroyed EP */
+    sender->destroy_ep(0);
+    short_progress_loop();
+
+    status = uct_iface_set_am_handler(m_ent->iface(), 0, NULL, NULL, 0);
+    ASSERT_UCS_OK(status);
+}
+
+
+UCS_TEST_P(test_uct_tcp, msg_zcopy_am_zcopy, "TCP_MSG_ZEROCOPY_THRESH=1")
+{
+    const unsigned num_sends = 100 / ucs::test_time_multiplier();
+    uct_completion_t comp    = {(uct_completion_callback_t)ucs_empty_function,
+                                0, UCS_OK};
+    am_count_arg_t arg;
+    ucs_status_t status;
+
+    entity *sender = create_entity(0);
+    m_entities.push_back(sender);
+    sender->connect(0, *m_ent, 0);
+
+    uct_tcp_ep_t *ep = ucs_derived_of(sender->ep(0), uct_tcp_ep_t);
+    if (!(ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_SOCK)) {
+        UCS_TEST_SKIP_R("MSG_ZEROCOPY is not supported");
+    }
+
+    mapped_buffer buffer(sender->iface_attr().cap.am.max_zcopy, 0, *sender);
+    UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, buffer.ptr(), buffer.length(),
+                            buffer.memh(), 1);
+
+    arg.count  = 0;
+    arg.length = buffer.length();
+    status     = uct_iface_set_am_handler(m_ent->iface(), 0, am_count_handler,
+                                          &arg, 0);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < num_sends; ++i) {
+        ++comp.count;
+        do {
+            status = uct_ep_am_zcopy(sender->ep(0), 0, NULL, 0, iov, iovcnt,
+                                     0, &comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+
+        if (status == UCS_OK) {
+            --comp.count;
+        } else {
+            ASSERT_EQ(UCS_INPROGRESS, status);
+        }
+    }
+
+    /* the completions are reported by the kernel notifications */
+    wait_for_value(&comp.count, 0, true);
+    EXPECT_EQ(0, comp.count);
+    EXPECT_EQ(UCS_OK, comp.status);
+
+    wait_for_value(&arg.count, num_sends, true);
+    EXPECT_EQ(num_sends, arg.count);
+
+    flush();
+
+    EXPECT_GT(ep->msg_zcopy.sent_sn, 0u);
+    EXPECT_EQ(ep->msg_zcopy.sent_sn, ep->msg_zcopy.comp_sn);
+
+    status = uct_iface_set_am_handler(m_ent->iface(), 0, NULL, NULL, 0);
+    ASSERT_UCS_OK(status);
+}
+
+
+UCS_TEST_P(test_uct_tcp, get_zcopy)
+{
+    /* the largest response is received directly to the user's buffer */
+    const size_t lengths[] = {1, m_tcp_iface->config.rx_seg_size / 2,
+                              m_tcp_iface->config.rx_seg_size * 4};
+    uct_completion_t comp  = {(uct_completion_callback_t)ucs_empty_function,
+                              0, UCS_OK};
+    ucs::ptr_vector<mapped_buffer> local_bufs, remote_bufs;
+    ucs_status_t status;
+
+    entity *sender = create_entity(0);
+    m_entities.push_back(sender);
+    sender->connect(0, *m_ent, 0);
+
+    /* start all operations before waiting to have several responses
+     * in-flight */
+    for (size_t i = 0; i < ucs_static_array_size(lengths); ++i) {
+        local_bufs.push_back(new mapped_buffer(lengths[i], 0, *sender));
+        remote_bufs.push_back(new mapped_buffer(lengths[i], i + 1, *m_ent));
+
+        mapped_buffer &local  = local_bufs.at(i);
+        mapped_buffer &remote = remote_bufs.at(i);
+        local.memset(0);
+
+        UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, local.ptr(), local.length(),
+                                local.memh(), 1);
+
+        ++comp.count;
+        do {
+            status = uct_ep_get_zcopy(sender->ep(0), iov, iovcnt,
+                                      remote.addr(), remote.rkey(), &comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+
+        ASSERT_EQ(UCS_INPROGRESS, status);
+    }
+
+    wait_for_value(&comp.count, 0, true);
+    EXPECT_EQ(0, comp.count);
+    EXPECT_EQ(UCS_OK, comp.status);
+
+    for (size_t i = 0; i < ucs_static_array_size(lengths); ++i) {
+        local_bufs.at(i).pattern_check(i + 1);
+    }
+
+    flush();
+
+    uct_tcp_ep_t *ep = (uct_tcp_ep_t*)sender->ep(0);
+    EXPECT_EQ(ucs_static_array_size(lengths), ep->get.sn);
+    EXPECT_EQ(ep->get.sn, ep->get.comp_sn);
+}
+
+
+UCS_TEST_P(test_uct_tcp, get_zcopy_rsp_no_memory, "TCP_TX_MAX_BUFS=64")
+{
+    static const size_t length = 64;
+    static const unsigned num_gets = 4;
+    uct_completion_t comp          = {(uct_completion_callback_t)
+                                      ucs_empty_function, 0, UCS_OK};
+    std::vector<void*> bufs;
+    ucs_status_t status;
+    void *buf;
+
+    entity *sender = create_entity(0);
+    m_entities.push_back(sender);
+    sender->connect(0, *m_ent, 0);
+
+    mapped_buffer local(length, 0, *sender);
+    mapped_buffer remote(length, 1, *m_ent);
+    UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, local.ptr(), local.length(),
+                            local.memh(), 1);
+
+    /* establish the connection by a successful GET */
+    ++comp.count;
+    do {
+        status = uct_ep_get_zcopy(sender->ep(0), iov, iovcnt, remote.addr(),
+                                  remote.rkey(), &comp);
+        progress();
+    } while (status == UCS_ERR_NO_RESOURCE);
+    ASSERT_EQ(UCS_INPROGRESS, status);
+    wait_for_value(&comp.count, 0, true);
+    ASSERT_EQ(UCS_OK, comp.status);
+
+    /* the target can't allocate the responses */
+    while ((buf = ucs_mpool_get(&m_tcp_iface->tx_mpool)) != NULL) {
+        bufs.push_back(buf);
+    }
+
+    scoped_log_handler slh(hide_warns_logger);
+    for (unsigned i = 0; i < num_gets; ++i) {
+        ++comp.count;
+        do {
+            status = uct_ep_get_zcopy(sender->ep(0), iov, iovcnt,
+                                      remote.addr(), remote.rkey(), &comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_EQ(UCS_INPROGRESS, status);
+    }
+
+    /* the requests are not dropped, the error responses are sent when the
+     * target has TX resources again */
+    short_progress_loop();
+    EXPECT_EQ(num_gets, comp.count);
+
+    while (!bufs.empty()) {
+        ucs_mpool_put(bufs.back());
+        bufs.pop_back();
+    }
+
+    wait_for_value(&comp.count, 0, true);
+    EXPECT_EQ(0, comp.count);
+    EXPECT_EQ(UCS_ERR_NO_MEMORY, comp.status);
+
+    uct_tcp_ep_t *ep = ucs_derived_of(sender->ep(0), uct_tcp_ep_t);
+    EXPECT_EQ(num_gets + 1, ep->get.comp_sn);
+}
+
+
 _UCT_INSTANTIATE_TEST_CASE(test_uct_tcp, tcp)
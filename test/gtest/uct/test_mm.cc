@@ -6,7 +6,9 @@
 
 extern "C" {
 #include <uct/api/uct.h>
+#include <uct/api/v2/uct_v2.h>
 #include <uct/sm/mm/base/mm_md.h>
+#include <uct/sm/mm/base/mm_ep.h>
 #include <ucs/time/time.h>
 }
 #include "uct_p2p_test.h"
@@ -110,6 +112,77 @@ public:
         return UCS_OK;
     }
 
+    static ucs_status_t mm_am_batch_handler(void *arg, void *data,
+                                            size_t length, unsigned flags) {
+        std::vector<uint64_t> *recv_data = (std::vector<uint64_t>*)arg;
+        uint64_t *test_mm_hdr            = (uint64_t*)data;
+
+        EXPECT_EQ(2 * sizeof(uint64_t), length);
+        EXPECT_EQ(0xbeef, *test_mm_hdr);
+        recv_data->push_back(*(test_mm_hdr + 1));
+        return UCS_OK;
+    }
+
+    void test_am_short_batch()
+    {
+        /* batch size is not a divisor of the FIFO size, to exercise partial
+         * batches and FIFO wrap-around */
+        const size_t num_msgs   = 1000;
+        const size_t batch_size = 37;
+        std::vector<uint64_t> send_data(num_msgs);
+        std::vector<uct_am_short_batch_elem_t> elems(num_msgs);
+        std::vector<uint64_t> recv_data;
+        size_t num_sent;
+        ssize_t ret;
+
+        for (size_t i = 0; i < num_msgs; ++i) {
+            send_data[i]     = i;
+            elems[i].id      = 0;
+            elems[i].header  = 0xbeef;
+            elems[i].payload = &send_data[i];
+            elems[i].length  = sizeof(send_data[i]);
+        }
+
+        uct_iface_set_am_handler(m_e2->iface(), 0, mm_am_batch_handler,
+                                 &recv_data, 0);
+
+        ucs_time_t deadline = ucs::get_deadline();
+        num_sent            = 0;
+        while ((num_sent < num_msgs) && (ucs_get_time() < deadline)) {
+            ret = uct_ep_am_short_batch(m_e1->ep(0), &elems[num_sent],
+                                        ucs_min(batch_size,
+                                                num_msgs - num_sent),
+                                        0);
+            if (ret == UCS_ERR_NO_RESOURCE) {
+                progress();
+                continue;
+            }
+
+            ASSERT_GT(ret, 0);
+            num_sent += ret;
+        }
+
+        ASSERT_EQ(num_msgs, num_sent);
+        while ((recv_data.size() < num_msgs) && (ucs_get_time() < deadline)) {
+            progress();
+        }
+
+        ASSERT_EQ(num_msgs, recv_data.size());
+        for (size_t i = 0; i < num_msgs; ++i) {
+            EXPECT_EQ(i, recv_data[i]) << "message " << i << " out of order";
+        }
+    }
+
+    static ucs_status_t mm_am_zcopy_handler(void *arg, void *data,
+                                            size_t length, unsigned flags) {
+        std::vector<uint8_t> *recv_data = (std::vector<uint8_t>*)arg;
+
+        EXPECT_FALSE(flags & UCT_CB_PARAM_FLAG_DESC);
+        recv_data->insert(recv_data->end(), (uint8_t*)data,
+                          (uint8_t*)data + length);
+        return UCS_OK;
+    }
+
     bool check_md_caps(uint64_t flags) {
         FOR_EACH_ENTITY(iter) {
             if (!(ucs_test_all_flags((*iter)->md_attr().flags, flags))) {
@@ -218,6 +291,127 @@ UCS_TEST_SKIP_COND_P(test_uct_mm, open_for_posix,
     free(recv_buffer);
 }
 
+UCS_TEST_SKIP_COND_P(test_uct_mm, am_short_batch,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC))
+{
+    test_am_short_batch();
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_mm, am_short_batch_fifo_lanes,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "MM_FIFO_LANES=3")
+{
+    test_am_short_batch();
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_mm, fifo_lanes_fairness,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "MM_FIFO_LANES=4", "MM_FIFO_MAX_POLL=4")
+{
+    const uint64_t heavy_data = 1, light_data = 2;
+    std::vector<uint64_t> recv_data;
+    size_t num_heavy, num_before_light;
+    ucs_status_t status;
+
+    entity *e3 = uct_test::create_entity(0);
+    m_entities.push_back(e3);
+    e3->connect(0, *m_e2, 0);
+
+    /* The two senders write to different lanes of the receiver FIFO */
+    ASSERT_NE(ucs_derived_of(m_e1->ep(0), uct_mm_ep_t)->fifo_ctl,
+              ucs_derived_of(e3->ep(0), uct_mm_ep_t)->fifo_ctl);
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, mm_am_batch_handler,
+                             &recv_data, 0);
+
+    /* The heavy sender fills its lane before the receiver polls */
+    num_heavy = 0;
+    do {
+        status = uct_ep_am_short(m_e1->ep(0), 0, 0xbeef, &heavy_data,
+                                 sizeof(heavy_data));
+        num_heavy += (status == UCS_OK);
+    } while (status == UCS_OK);
+    ASSERT_EQ(UCS_ERR_NO_RESOURCE, status);
+    ASSERT_GT(num_heavy, 4u);
+
+    ASSERT_UCS_OK(uct_ep_am_short(e3->ep(0), 0, 0xbeef, &light_data,
+                                  sizeof(light_data)));
+
+    /* The message of the light sender is not received after all the messages
+     * of the heavy sender, since every lane has its own polling window */
+    ucs_time_t deadline = ucs::get_deadline();
+    while ((std::find(recv_data.begin(), recv_data.end(), light_data) ==
+            recv_data.end()) &&
+           (ucs_get_time() < deadline)) {
+        m_e2->progress();
+    }
+
+    num_before_light = std::find(recv_data.begin(), recv_data.end(),
+                                 light_data) - recv_data.begin();
+    ASSERT_LT(num_before_light, recv_data.size());
+    EXPECT_LE(num_before_light, 4u);
+    EXPECT_LT(num_before_light, num_heavy);
+
+    while ((recv_data.size() < (num_heavy + 1)) &&
+           (ucs_get_time() < deadline)) {
+        m_e2->progress();
+    }
+    EXPECT_EQ(num_heavy + 1, recv_data.size());
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_mm, am_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "MM_AM_ZCOPY=y")
+{
+    const size_t num_msgs = 16;
+    const size_t msg_size = 4096;
+    uct_completion_t comp = {(uct_completion_callback_t)ucs_empty_function,
+                             0, UCS_OK};
+    std::vector<uint8_t> recv_data;
+    uct_allocated_memory_t mem;
+    ucs_status_t status;
+    uct_iov_t iov;
+
+    m_e1->mem_alloc(num_msgs * msg_size, UCT_MD_MEM_ACCESS_ALL, &mem);
+    ASSERT_EQ(UCT_ALLOC_METHOD_MD, mem.method);
+    for (size_t i = 0; i < num_msgs * msg_size; ++i) {
+        ((uint8_t*)mem.address)[i] = i * 7;
+    }
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, mm_am_zcopy_handler,
+                             &recv_data, 0);
+
+    for (size_t i = 0; i < num_msgs; ++i) {
+        iov.buffer = UCS_PTR_BYTE_OFFSET(mem.address, i * msg_size);
+        iov.length = msg_size;
+        iov.memh   = mem.memh;
+        iov.stride = 0;
+        iov.count  = 1;
+
+        ++comp.count;
+        do {
+            status = uct_ep_am_zcopy(m_e1->ep(0), 0, NULL, 0, &iov, 1, 0,
+                                     &comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_EQ(UCS_INPROGRESS, status);
+    }
+
+    /* send completion means the receiver has consumed the message */
+    wait_for_value(&comp.count, 0, true);
+    EXPECT_EQ(0, comp.count);
+    ASSERT_EQ(num_msgs * msg_size, recv_data.size());
+    EXPECT_EQ(0, memcmp(&recv_data[0], mem.address, recv_data.size()));
+
+    m_e1->mem_free(&mem);
+}
+
 UCS_TEST_SKIP_COND_P(test_uct_mm, alloc,
                      !check_md_caps(UCT_MD_FLAG_ALLOC)) {
 
@@ -269,4 +463,20 @@ UCS_TEST_SKIP_COND_P(test_uct_mm, reg,
     ASSERT_UCS_OK(status);
 }
 
+UCS_TEST_SKIP_COND_P(test_uct_mm, numa_node,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "NUMA_NODE=0", "NUMA_POLICY=bind")
+{
+    EXPECT_EQ(0, m_e1->iface_attr().numa_node);
+    EXPECT_EQ(0, m_e2->iface_attr().numa_node);
+
+    /* The receive FIFO and descriptors are bound to the node */
+    test_am_short_batch();
+}
+
+UCS_TEST_P(test_uct_mm, numa_policy_default, "NUMA_POLICY=default") {
+    EXPECT_EQ(UCS_NUMA_NODE_UNDEFINED, m_e1->iface_attr().numa_node);
+}
+
 UCT_INSTANTIATE_MM_TEST_CASE(test_uct_mm)